@@ -50,7 +50,7 @@ struct StartUp {
 };
 StartUp startup;
 
-enum class EMode { input, output, make_complete, astar, dijkstra };
+enum class EMode { input, output, make_complete, astar, dijkstra, implicit_astar };
 
 static void bench(benchpress::context &ctx, const EMode mode) {
     graph_undirected<Coord, int, double> grid_graph;
@@ -140,6 +140,29 @@ static void bench(benchpress::context &ctx, const EMode mode) {
 
             break;
         }
+
+        /// Benchmarking A* on the grid, without materialising it
+        case EMode::implicit_astar: {
+            using Cell = std::pair<int, int>;
+            implicit_graph<Cell, int> g{[](const Cell &c, std::vector<std::pair<Cell, int>> &out) {
+                const Cell moves[]{{c.first + 1, c.second}, {c.first - 1, c.second}, {c.first, c.second + 1}, {c.first, c.second - 1}};
+                for (const Cell &m : moves) {
+                    if (std::abs(m.first) < MAX && std::abs(m.second) < MAX) {
+                        out.emplace_back(m, 1);
+                    }
+                }
+            }};
+            const Cell start{-MAX + 1, -MAX + 1}, end{MAX - 1, MAX - 1};
+
+            ctx.reset_timer();
+            for (size_t i{0}; i < ctx.num_iterations(); ++i) {
+                implicit_graph<Cell, int>::search_path p{g.astar(start, end, [&end](const Cell &c) -> int {
+                    return std::abs(end.first - c.first) + std::abs(end.second - c.second);
+                })};
+            }
+
+            break;
+        }
     }
 }
 
@@ -153,3 +176,4 @@ BENCHMARKING_I(EMode::output,        "dump     grid_graph.txt")
 BENCHMARKING_I(EMode::make_complete, "make_complete a graph of 1000 nodes")
 BENCHMARKING_I(EMode::astar,         "astar    on a graph of 50 nodes")
 BENCHMARKING_I(EMode::dijkstra,      "dijkstra on a graph of 50 nodes")
+BENCHMARKING_I(EMode::implicit_astar, "astar    on an implicit grid")
@@ -32,10 +32,15 @@
 #ifndef ROOT_GRAPH_FINAL_H
 #define ROOT_GRAPH_FINAL_H
 
+#include <algorithm>
+#include <deque>
 #include <fstream>
 #include <iomanip>
+#include <list>
 #include <map>
 #include <queue>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #ifdef INCLUDE_JSON_FILE
@@ -87,6 +92,22 @@ concept GraphCost = std::copyable<T> && std::equality_comparable<T> && std::tota
     t * t;
     t / t;
 };
+
+template<typename F, typename Arg>
+concept SearchGoal = std::predicate<F&, Arg>;
+
+template<typename F, typename Arg, typename Cost>
+concept SearchHeuristic = std::invocable<F&, Arg> && std::convertible_to<std::invoke_result_t<F&, Arg>, Cost>;
+#endif
+
+#if defined(GRAPH_HAS_CPP_20)
+    #define GRAPH_SEARCH_GOAL(F, Arg)            SearchGoal<F, Arg>
+    #define GRAPH_SEARCH_HEURISTIC(F, Arg, Cost) SearchHeuristic<F, Arg, Cost>
+    #define GRAPH_REQUIRES(R, ...)               R requires (__VA_ARGS__)
+#else
+    #define GRAPH_SEARCH_GOAL(F, Arg)            detail::is_callable_as<F, Arg, bool>::value
+    #define GRAPH_SEARCH_HEURISTIC(F, Arg, Cost) detail::is_callable_as<F, Arg, Cost>::value
+    #define GRAPH_REQUIRES(R, ...)               typename std::enable_if<(__VA_ARGS__), R>::type
 #endif
 
 #if defined(__clang__)
@@ -100,14 +121,22 @@ concept GraphCost = std::copyable<T> && std::equality_comparable<T> && std::tota
 #endif
 
 #include <iostream>
-#include <list>
 #include <memory>
 #include <tuple>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include <memory>
 #include <string>
 #include <istream>
+#include <list>
+#include <tuple>
+#include <vector>
+#if defined(GRAPH_HAS_CPP_17)
+    #include <memory_resource>
+    #include <string_view>
+#endif
 
 /// allow to disable exceptions
 #if (defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)) && not defined(GRAPH_NOEXCEPTION)
@@ -125,8 +154,13 @@ concept GraphCost = std::copyable<T> && std::equality_comparable<T> && std::tota
     #define GRAPH_CATCH(exception) if (false)
 #endif
 
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
 #include <functional>
 #include <limits>
+#include <mutex>
+#include <thread>
 #include <sstream>
 
 /**
@@ -343,6 +377,12 @@ namespace detail {
     template <Nature> struct is_undirected             : std::false_type { };
     template <>       struct is_undirected<UNDIRECTED> : std::true_type  { };
 
+#if defined(GRAPH_HAS_CPP_17)
+    template <class T> using allocator = std::pmr::polymorphic_allocator<T>;
+#else
+    template <class T> using allocator = std::allocator<T>;
+#endif
+
 #include <utility>
 
     /// distinguish value type between map::iterator and shared_ptr: @see https://stackoverflow.com/a/31409532
@@ -368,6 +408,100 @@ namespace detail {
         return (*v).second;
     }
 
+    template <typename Map, typename = void>
+    struct has_transparent_compare : std::false_type { };
+
+    template <typename Map>
+    struct has_transparent_compare<Map, void_t<typename Map::key_compare::is_transparent> > : std::true_type { };
+
+    template <typename Map, typename = void>
+    struct has_transparent_hash : std::false_type { };
+
+    template <typename Map>
+    struct has_transparent_hash<Map, void_t<typename Map::hasher::is_transparent> > : std::true_type { };
+
+    template <typename Map>
+    struct is_transparent_map : std::integral_constant<bool, has_transparent_compare<Map>::value || has_transparent_hash<Map>::value> { };
+
+    /// distinguish containers able to allocate room for their elements up front
+    template <typename T, typename = void>
+    struct has_reserve : std::false_type { };
+
+    template <typename T>
+    struct has_reserve<T, void_t<decltype(std::declval<T&>().reserve(std::size_t()))> > : std::true_type { };
+
+    template <class C>
+    void reserve(C &c, std::size_t n, std::true_type) { c.reserve(n); }
+    template <class C>
+    void reserve(C &, std::size_t, std::false_type) {}
+
+    template <class C>
+    void reserve(C &c, std::size_t n) { reserve(c, n, has_reserve<C>()); }
+
+    template <typename T, typename = void>
+    struct has_shrink_to_fit : std::false_type { };
+
+    template <typename T>
+    struct has_shrink_to_fit<T, void_t<decltype(std::declval<T&>().shrink_to_fit())> > : std::true_type { };
+
+    template <class C>
+    void shrink_to_fit(C &c, std::true_type) { c.shrink_to_fit(); }
+    template <class C>
+    void shrink_to_fit(C &, std::false_type) {}
+
+    template <class C>
+    void shrink_to_fit(C &c) { shrink_to_fit(c, has_shrink_to_fit<C>()); }
+
+    template <typename F, typename Arg, typename R, typename = void>
+    struct is_callable_as : std::false_type { };
+
+    template <typename F, typename Arg, typename R>
+    struct is_callable_as<F, Arg, R, void_t<decltype(std::declval<F&>()(std::declval<Arg>()))> >
+            : std::is_convertible<decltype(std::declval<F&>()(std::declval<Arg>())), R> { };
+
+    template <class V, class = typename std::enable_if<is_map_iterator<V>::value>::type>
+    typename std::pointer_traits<typename std::iterator_traits<V>::value_type::second_type>::element_type*
+    get_pointer(const V &v, const V &end) {
+        if (v == end || (*v).second == nullptr) {
+            return nullptr;
+        }
+        return &*(*v).second;
+    }
+
+    template <class Key>
+    std::vector<std::size_t> sorted_permutation(const std::vector<Key> &keys) {
+        std::vector<std::size_t> sorted;
+        if (!std::is_sorted(keys.cbegin(), keys.cend())) {
+            sorted.resize(keys.size());
+            for (std::size_t i{0}; i < keys.size(); ++i) {
+                sorted[i] = i;
+            }
+            std::sort(sorted.begin(), sorted.end(), [&keys](std::size_t lhs, std::size_t rhs) {
+                return keys[lhs] < keys[rhs];
+            });
+        }
+        return sorted;
+    }
+
+    template <class Key>
+    std::size_t find_index(const std::vector<Key> &keys, const std::vector<std::size_t> &sorted, const Key &k) {
+        if (!sorted.empty()) {
+            typename std::vector<std::size_t>::const_iterator it{std::lower_bound(sorted.cbegin(), sorted.cend(), k, [&keys](std::size_t i, const Key & key) {
+                return keys[i] < key;
+            })};
+            if (it == sorted.cend() || k < keys[*it]) {
+                return keys.size();
+            }
+            return *it;
+        }
+
+        typename std::vector<Key>::const_iterator it{std::lower_bound(keys.cbegin(), keys.cend(), k)};
+        if (it == keys.cend() || k < *it) {
+            return keys.size();
+        }
+        return static_cast<std::size_t>(it - keys.cbegin());
+    }
+
 #include <cxxabi.h>
 
     /// @return the human-readable name of @tparam T
@@ -432,6 +566,587 @@ namespace detail {
         }
         return is;
     }
+
+    template <class Key>
+    struct key_hash : std::hash<Key> { };
+
+#if defined(GRAPH_HAS_CPP_17)
+    template <>
+    struct key_hash<std::string> {
+        using is_transparent = void;
+
+        std::size_t operator()(std::string_view s) const noexcept {
+            return std::hash<std::string_view>()(s);
+        }
+    };
+#endif
+
+    template <class Key, class Value, class Hash = std::hash<Key>>
+    class hash_map {
+      public:
+        using key_type               = Key;
+        using mapped_type            = Value;
+        using value_type             = std::pair<const Key, Value>;
+        using size_type              = std::size_t;
+        using hasher                 = Hash;
+        using iterator               = typename std::list<value_type, allocator<value_type>>::iterator;
+        using const_iterator         = typename std::list<value_type, allocator<value_type>>::const_iterator;
+        using reverse_iterator       = typename std::list<value_type, allocator<value_type>>::reverse_iterator;
+        using const_reverse_iterator = typename std::list<value_type, allocator<value_type>>::const_reverse_iterator;
+        using allocator_type         = allocator<value_type>;
+
+        hash_map() = default;
+        explicit hash_map(const allocator_type &alloc) : _elements(alloc), _slots(alloc) {}
+        hash_map(const hash_map &other) : _elements(other._elements), _hash(other._hash) {
+            rehash(_elements.size());
+        }
+        hash_map(hash_map &&) noexcept = default;
+        /// The assignments of the list would assign the `const Key` of the elements in place: they are rebuilt instead
+        hash_map &operator=(const hash_map &other) {
+            if (this != &other) {
+                _elements.clear();
+                for (const value_type &v : other._elements) {
+                    _elements.emplace_back(v);
+                }
+                _hash = other._hash;
+                rehash(_elements.size());
+            }
+            return *this;
+        }
+        hash_map &operator=(hash_map &&other) {
+            if (this != &other) {
+                _elements.clear();
+                _hash = std::move(other._hash);
+                if (_elements.get_allocator() == other._elements.get_allocator()) {
+                    /// The nodes change hands: the iterators of the table stay valid
+                    _elements.splice(_elements.end(), other._elements);
+                    _slots = std::move(other._slots);
+                    other._slots.clear();
+                } else {
+                    /// With different resources the elements are moved one by one: their iterators change
+                    for (value_type &v : other._elements) {
+                        _elements.emplace_back(std::move(v));
+                    }
+                    other.clear();
+                    rehash(_elements.size());
+                }
+            }
+            return *this;
+        }
+
+        iterator               begin()         noexcept { return _elements.begin();   }
+        const_iterator         begin()   const noexcept { return _elements.begin();   }
+        const_iterator         cbegin()  const noexcept { return _elements.cbegin();  }
+        iterator               end()           noexcept { return _elements.end();     }
+        const_iterator         end()     const noexcept { return _elements.end();     }
+        const_iterator         cend()    const noexcept { return _elements.cend();    }
+        reverse_iterator       rbegin()        noexcept { return _elements.rbegin();  }
+        const_reverse_iterator rbegin()  const noexcept { return _elements.rbegin();  }
+        const_reverse_iterator crbegin() const noexcept { return _elements.crbegin(); }
+        reverse_iterator       rend()          noexcept { return _elements.rend();    }
+        const_reverse_iterator rend()    const noexcept { return _elements.rend();    }
+        const_reverse_iterator crend()   const noexcept { return _elements.crend();   }
+
+        [[nodiscard]] bool empty()    const noexcept { return _elements.empty();    }
+        [[nodiscard]] size_type size()     const noexcept { return _elements.size();     }
+        [[nodiscard]] size_type max_size() const noexcept { return _elements.max_size(); }
+
+        allocator_type get_allocator() const noexcept { return _elements.get_allocator(); }
+
+        iterator find(const key_type &k) {
+            const size_type slot{find_slot(k)};
+            return slot == npos ? _elements.end() : _slots[slot].element;
+        }
+        const_iterator find(const key_type &k) const {
+            const size_type slot{find_slot(k)};
+            return slot == npos ? _elements.cend() : const_iterator(_slots[slot].element);
+        }
+        size_type count(const key_type &k) const {
+            return find_slot(k) == npos ? 0 : 1;
+        }
+
+        /// heterogeneous lookups, when the @ref hasher is transparent: @p k is hashed and compared as is
+        template <class K, class H = Hash, class = typename H::is_transparent>
+        iterator find(const K &k) {
+            const size_type slot{find_slot(k)};
+            return slot == npos ? _elements.end() : _slots[slot].element;
+        }
+        template <class K, class H = Hash, class = typename H::is_transparent>
+        const_iterator find(const K &k) const {
+            const size_type slot{find_slot(k)};
+            return slot == npos ? _elements.cend() : const_iterator(_slots[slot].element);
+        }
+        template <class K, class H = Hash, class = typename H::is_transparent>
+        size_type count(const K &k) const {
+            return find_slot(k) == npos ? 0 : 1;
+        }
+
+        template <class... Args>
+        std::pair<iterator, bool> emplace(const key_type &k, Args &&... args) {
+            return emplace_key(k, std::forward<Args>(args)...);
+        }
+        /// @p k is only moved from if it is inserted
+        template <class... Args>
+        std::pair<iterator, bool> emplace(key_type &&k, Args &&... args) {
+            return emplace_key(std::move(k), std::forward<Args>(args)...);
+        }
+        std::pair<iterator, bool> insert(const value_type &val) {
+            return emplace(val.first, val.second);
+        }
+        /// the position is only a hint, as for `std::map`: new elements are appended
+        iterator insert(const_iterator, const value_type &val) {
+            return insert(val).first;
+        }
+
+        iterator erase(const_iterator position) {
+            unplace(position);
+            return _elements.erase(position);
+        }
+        iterator erase(const_iterator first, const_iterator last) {
+            for (const_iterator it{first}; it != last; ++it) {
+                unplace(it);
+            }
+            return _elements.erase(first, last);
+        }
+        size_type erase(const key_type &k) {
+            const_iterator it{find(k)};
+            if (it == _elements.cend()) {
+                return 0;
+            }
+            erase(it);
+            return 1;
+        }
+
+        void clear() noexcept {
+            _elements.clear();
+            _slots.clear();
+        }
+
+        /// allocate the table for @p n elements without any further rehash
+        void reserve(size_type n) {
+            if (2 * n > _slots.size()) {
+                size_type capacity{16};
+                while (capacity < 2 * n) {
+                    capacity *= 2;
+                }
+                rehash(capacity / 2);
+            }
+        }
+
+        /// reallocate the table to fit the current number of elements
+        void shrink_to_fit() {
+            std::vector<slot, allocator<slot>>(_slots.get_allocator()).swap(_slots);
+            rehash(_elements.size());
+        }
+
+        void swap(hash_map &other) noexcept {
+            _elements.swap(other._elements);
+            _slots.swap(other._slots);
+            std::swap(_hash, other._hash);
+        }
+
+      private:
+        struct slot {
+            std::size_t hash{0};
+            iterator    element;
+        };
+
+        static constexpr size_type npos = static_cast<size_type>(-1);
+
+        std::list<value_type, allocator<value_type>> _elements;
+        std::vector<slot, allocator<slot>>           _slots;
+        hasher                _hash;
+
+        template <class K>
+        std::size_t hash(const K &k) const {
+            const std::size_t h{_hash(k)};
+            return h == 0 ? 1 : h;
+        }
+
+        template <class K>
+        size_type find_slot(const K &k) const {
+            return _slots.empty() ? npos : find_slot(k, hash(k));
+        }
+        template <class K>
+        size_type find_slot(const K &k, std::size_t h) const {
+            if (_slots.empty()) {
+                return npos;
+            }
+            const size_type mask{_slots.size() - 1};
+            for (size_type i{h & mask}; _slots[i].hash != 0; i = (i + 1) & mask) {
+                if (_slots[i].hash == h && _slots[i].element->first == k) {
+                    return i;
+                }
+            }
+            return npos;
+        }
+
+        template <class K, class... Args>
+        std::pair<iterator, bool> emplace_key(K &&k, Args &&... args) {
+            const std::size_t h{hash(k)};
+            const size_type slot{find_slot(k, h)};
+            if (slot != npos) {
+                return std::make_pair(_slots[slot].element, false);
+            }
+
+            reserve(_elements.size() + 1);
+            _elements.emplace_back(std::piecewise_construct, std::forward_as_tuple(std::forward<K>(k)), std::forward_as_tuple(std::forward<Args>(args)...));
+            place(h, --_elements.end());
+            return std::make_pair(--_elements.end(), true);
+        }
+
+        void place(std::size_t h, iterator element) {
+            const size_type mask{_slots.size() - 1};
+            size_type i{h & mask};
+            while (_slots[i].hash != 0) {
+                i = (i + 1) & mask;
+            }
+            _slots[i].hash    = h;
+            _slots[i].element = element;
+        }
+
+        /// backward-shift deletion: no tombstone is left in the table
+        void unplace(const_iterator element) {
+            const size_type mask{_slots.size() - 1};
+            size_type i{find_slot(element->first)};
+            for (size_type j{(i + 1) & mask}; _slots[j].hash != 0; j = (j + 1) & mask) {
+                const size_type home{_slots[j].hash & mask};
+                /// slot j may move back into i only if its home does not lie in (i, j]
+                if (((j - home) & mask) >= ((j - i) & mask)) {
+                    _slots[i] = _slots[j];
+                    i = j;
+                }
+            }
+            _slots[i].hash = 0;
+        }
+
+        void rehash(size_type n) {
+            size_type capacity{n == 0 ? size_type(0) : size_type(16)};
+            while (capacity < 2 * n) {
+                capacity *= 2;
+            }
+
+            _slots.assign(capacity, slot());
+            for (iterator it{_elements.begin()}; it != _elements.end(); ++it) {
+                place(hash(it->first), it);
+            }
+        }
+    };
+
+    template <class Key, class Value, class Hash>
+    constexpr typename hash_map<Key, Value, Hash>::size_type hash_map<Key, Value, Hash>::npos;
+
+    template <class Priority, std::size_t D = 4>
+    class indexed_heap {
+        static_assert(D >= 2, "An indexed heap needs at least two children per node");
+
+      public:
+        using size_type = std::size_t;
+
+        static constexpr size_type npos = std::numeric_limits<size_type>::max();
+
+        explicit indexed_heap(size_type n = 0) : _positions(n, npos) {}
+
+        bool      empty() const noexcept { return _heap.empty(); }
+        size_type size()  const noexcept { return _heap.size(); }
+
+        bool contains(size_type id) const noexcept { return id < _positions.size() && _positions[id] != npos; }
+
+        size_type       top()          const { return _heap.front().id; }
+        const Priority &top_priority() const { return _heap.front().priority; }
+
+        bool push(size_type id, const Priority &priority) {
+            if (id >= _positions.size()) {
+                _positions.resize(id + 1, npos);
+            }
+
+            size_type position{_positions[id]};
+            if (position == npos) {
+                position = _heap.size();
+                _heap.push_back(entry{priority, id});
+            } else if (priority < _heap[position].priority) {
+                _heap[position].priority = priority;
+            } else {
+                return false;
+            }
+            sift_up(position);
+            return true;
+        }
+
+        size_type pop() {
+            const size_type id{_heap.front().id};
+            _positions[id] = npos;
+
+            if (_heap.size() > 1) {
+                _heap.front() = std::move(_heap.back());
+                _heap.pop_back();
+                sift_down(0);
+            } else {
+                _heap.pop_back();
+            }
+            return id;
+        }
+
+        void clear() noexcept {
+            for (const entry &e : _heap) {
+                _positions[e.id] = npos;
+            }
+            _heap.clear();
+        }
+
+      private:
+        struct entry {
+            Priority  priority;
+            size_type id;
+        };
+
+        std::vector<entry>     _heap;
+        std::vector<size_type> _positions;
+
+        void place(entry &&e, size_type position) {
+            _positions[e.id] = position;
+            _heap[position]  = std::move(e);
+        }
+
+        void sift_up(size_type position) {
+            entry e{std::move(_heap[position])};
+            while (position > 0) {
+                const size_type parent{(position - 1) / D};
+                if (!(e.priority < _heap[parent].priority)) {
+                    break;
+                }
+                place(std::move(_heap[parent]), position);
+                position = parent;
+            }
+            place(std::move(e), position);
+        }
+
+        void sift_down(size_type position) {
+            entry e{std::move(_heap[position])};
+            for (;;) {
+                const size_type first{position * D + 1};
+                if (first >= _heap.size()) {
+                    break;
+                }
+
+                size_type smallest{first};
+                const size_type last{first + D < _heap.size() ? first + D : _heap.size()};
+                for (size_type child{first + 1}; child < last; ++child) {
+                    if (_heap[child].priority < _heap[smallest].priority) {
+                        smallest = child;
+                    }
+                }
+                if (!(_heap[smallest].priority < e.priority)) {
+                    break;
+                }
+                place(std::move(_heap[smallest]), position);
+                position = smallest;
+            }
+            place(std::move(e), position);
+        }
+    };
+
+    template <class Priority, std::size_t D>
+    constexpr typename indexed_heap<Priority, D>::size_type indexed_heap<Priority, D>::npos;
+
+    template <class Key, class Value>
+    class radix_heap {
+        static_assert(std::is_unsigned<Key>::value, "A radix heap needs unsigned integral keys");
+
+      public:
+        using size_type  = std::size_t;
+        using value_type = std::pair<Key, Value>;
+
+        radix_heap() : _buckets(std::numeric_limits<Key>::digits + 1) {}
+
+        bool      empty() const noexcept { return _size == 0; }
+        size_type size()  const noexcept { return _size; }
+
+        void push(Key key, const Value &value) {
+            _buckets[bucket(key)].emplace_back(key, value);
+            ++_size;
+        }
+
+        value_type pop() {
+            if (_buckets[0].empty()) {
+                size_type i{1};
+                while (_buckets[i].empty()) {
+                    ++i;
+                }
+
+                _last = _buckets[i].front().first;
+                for (const value_type &e : _buckets[i]) {
+                    if (e.first < _last) {
+                        _last = e.first;
+                    }
+                }
+                for (value_type &e : _buckets[i]) {
+                    _buckets[bucket(e.first)].push_back(std::move(e));
+                }
+                _buckets[i].clear();
+            }
+
+            value_type e{std::move(_buckets[0].back())};
+            _buckets[0].pop_back();
+            --_size;
+            return e;
+        }
+
+      private:
+        std::vector<std::vector<value_type>> _buckets;
+        Key                                  _last = 0;
+        size_type                            _size = 0;
+
+        size_type bucket(Key key) const noexcept {
+            unsigned long long diff{static_cast<unsigned long long>(key ^ _last)};
+#if defined(__GNUC__) || defined(__clang__)
+            return diff == 0 ? 0 : size_type(std::numeric_limits<unsigned long long>::digits - __builtin_clzll(diff));
+#else
+            size_type n{0};
+            for (; diff != 0; diff >>= 1) {
+                ++n;
+            }
+            return n;
+#endif
+        }
+    };
+
+    template <class T>
+    class shared_slot {
+      public:
+        shared_slot() = default;
+        shared_slot(const shared_slot &other) : _ptr(other.load()) {}
+        shared_slot &operator=(const shared_slot &other) {
+            store(other.load());
+            return *this;
+        }
+
+        std::shared_ptr<const T> load() const {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _ptr;
+        }
+        void store(std::shared_ptr<const T> ptr) {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _ptr.swap(ptr);
+            }
+
+        }
+        void swap(shared_slot &other) {
+            std::shared_ptr<const T> ptr{load()};
+            store(other.load());
+            other.store(std::move(ptr));
+        }
+
+      private:
+        mutable std::mutex       _mutex;
+        std::shared_ptr<const T> _ptr;
+    };
+
+    class thread_pool {
+      public:
+        using size_type = std::size_t;
+
+        explicit thread_pool(size_type nbr_threads, size_type nbr_shares = std::numeric_limits<size_type>::max()) {
+            if (nbr_threads == 0) {
+                nbr_threads = std::thread::hardware_concurrency();
+            }
+            _errors.resize(std::max<size_type>(std::min(nbr_threads, nbr_shares), 1));
+        }
+
+        thread_pool(const thread_pool &) = delete;
+        thread_pool &operator=(const thread_pool &) = delete;
+
+        ~thread_pool() {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _stop = true;
+            }
+            _start.notify_all();
+            for (std::thread &t : _workers) {
+                t.join();
+            }
+        }
+
+        size_type size() const noexcept { return _errors.size(); }
+
+        void run(const std::function<void(size_type)> &task) {
+            for (size_type id{_workers.size() + 1}; id < size(); ++id) {
+                _workers.emplace_back(&thread_pool::work, this, id);
+            }
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _task    = &task;
+                _pending = _workers.size();
+                ++_generation;
+            }
+            _start.notify_all();
+
+            call(task, 0);
+
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _done.wait(lock, [this] { return _pending == 0; });
+                _task = nullptr;
+            }
+
+            for (std::exception_ptr &error : _errors) {
+                if (error) {
+                    std::exception_ptr first{std::move(error)};
+                    std::fill(_errors.begin(), _errors.end(), nullptr);
+                    std::rethrow_exception(first);
+                }
+            }
+        }
+
+      private:
+        std::vector<std::thread> _workers;
+        std::mutex               _mutex;
+        std::condition_variable  _start;
+        std::condition_variable  _done;
+
+        std::vector<std::exception_ptr> _errors;
+
+        const std::function<void(size_type)>* _task = nullptr;
+        size_type                             _generation = 0;
+        size_type                             _pending = 0;
+        bool                                  _stop = false;
+
+        void work(size_type id) {
+            size_type seen{0};
+            for (;;) {
+                const std::function<void(size_type)>* task;
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    _start.wait(lock, [this, seen] { return _stop || _generation != seen; });
+                    if (_stop) {
+                        return;
+                    }
+                    seen = _generation;
+                    task = _task;
+                }
+
+                call(*task, id);
+
+                bool last;
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    last = --_pending == 0;
+                }
+                if (last) {
+                    _done.notify_one();
+                }
+            }
+        }
+
+        void call(const std::function<void(size_type)> &task, size_type id) {
+            GRAPH_TRY {
+                task(id);
+            } GRAPH_CATCH(...) {
+                _errors[id] = std::current_exception();
+            }
+        }
+    };
 }
 
 // C++11 compatibility for make_unique
@@ -462,28 +1177,32 @@ class basic_node {
     /**
      * @brief Represents an edge in the graph
      *
-     * An edge connects two nodes and has an associated cost.
+     * An edge connects two nodes and has an associated cost. The cost is
+     * stored inline, except for undirected edges whose both directions
+     * share a single slot owned by the graph.
      */
     class edge {
         template <class T, class C, class c1, class c2> friend class basic_node;
-        template <class K, class T, class C, Nature N> friend class graph;
+        template <class K, class T, class C, Nature N, class I> friend class graph;
 
-        std::weak_ptr<basic_node<Data, Cost, Container, constContainer >> _target;
-        std::shared_ptr<Cost> _cost;
+        basic_node<Data, Cost, Container, constContainer>* _target;
+        mutable Cost _cost;
+        Cost* _shared_cost{nullptr};
+        std::size_t _in_position{0};
 
         /**
          * @brief Create a tuple representation of the edge for comparison
-         * @return Tuple containing cost and target node
+         * @return Tuple referring to the cost and the target node
          */
-        std::tuple<Cost, basic_node<Data, Cost, Container, constContainer >> tie() const;
+        std::tuple<const Cost&, const basic_node<Data, Cost, Container, constContainer>&> tie() const;
 
       public:
         /**
          * @brief Construct a new edge object
-         * @param ptr Shared pointer to the target node
+         * @param ptr Pointer to the target node
          * @param cost Cost of the edge
          */
-        explicit edge(const std::weak_ptr<basic_node<Data, Cost, Container, constContainer >> &ptr, Cost cost);
+        explicit edge(basic_node<Data, Cost, Container, constContainer>* ptr, Cost cost);
 
         /**
          * @brief Copy constructor
@@ -491,6 +1210,13 @@ class basic_node {
          */
         edge(const edge& other);
 
+        /**
+         * @brief Copy assignment operator
+         * @param other Edge to copy
+         * @return Reference to this edge
+         */
+        edge &operator=(const edge& other) = default;
+
         /**
          * @brief Compare edges by cost
          * @param other Edge to compare with
@@ -518,32 +1244,70 @@ class basic_node {
         Cost& cost() const;
     };
 
-    using ListEdges = std::list<edge>;
+    using ListEdges = std::vector<edge, detail::allocator<edge>>;
+    using EdgesAllocator = detail::allocator<edge>;
     using EdgesIterator = typename ListEdges::iterator;
     using ConstEdgesIterator = typename ListEdges::const_iterator;
 
   private:
-    template <class K, class T, class C, Nature N> friend class graph;
+    template <class K, class T, class C, Nature N, class I> friend class graph;
 
     ListEdges _out_edges;
 
-    const Cost infinity = std::numeric_limits<Cost>::has_infinity ? std::numeric_limits<Cost>::infinity() :
-                          std::numeric_limits<Cost>::max();
+    /// reverse link of an edge: its source and the position of the edge in the source out-edges
+    struct in_edge {
+        basic_node* _source;
+        std::size_t _position;
+    };
 
-    std::size_t _in_degree{0};
+    using ListInEdges = std::vector<in_edge, detail::allocator<in_edge>>;
 
-    void increment_in_degree(int n = 1);
-    void decrement_in_degree(int n = 1);
+    /// edges whose target is this node, kept in sync with the out-edges of their sources
+    ListInEdges _in_edges;
 
-    /// used for UNDIRECTED graphs: same Cost in memory for both directions
-    bool set_edge(constContainer other, std::shared_ptr<Cost> cost);
+    /// out-degree from which the position of each edge is hashed by target
+    static constexpr std::size_t edges_index_threshold = 16;
 
-    std::tuple<Data, std::size_t, ListEdges> tie() const;
+    using EdgesIndex = std::unordered_map<const basic_node*, std::size_t, std::hash<const basic_node*>, std::equal_to<const basic_node*>,
+                                          detail::allocator<std::pair<const basic_node* const, std::size_t>>>;
 
-    ListEdges get_edges() const;
+    /// position of each edge in _out_edges, keyed by target; empty while the node has few edges
+    EdgesIndex _edges_index;
 
-    template <class T, class C, class X, class Y>
-    friend constexpr bool operator==(const basic_node<T, C, X, Y> &n1, const basic_node<T, C, X, Y> &n2) noexcept;
+    const Cost infinity = std::numeric_limits<Cost>::has_infinity ? std::numeric_limits<Cost>::infinity() :
+                          std::numeric_limits<Cost>::max();
+
+    /// used for UNDIRECTED graphs: same Cost in memory for both directions
+    bool set_edge(constContainer other, Cost* shared_cost);
+
+    std::tuple<Data, std::size_t, ListEdges> tie() const;
+
+    const ListEdges &get_edges() const;
+
+    /// position of the edge to target in _out_edges, or _out_edges.size() if there is none
+    std::size_t find_edge(const basic_node* target) const;
+
+    /// append an edge whose target is not adjacent yet
+    EdgesIterator push_edge(basic_node* target, Cost cost);
+
+    /// same as push_edge, but leaves _edges_index to be rebuilt once the edges are all appended
+    void append_edge(basic_node* target, Cost cost);
+
+    /// remove the edge at position, swapping the last edge into its place
+    void erase_edge(std::size_t position);
+
+    /// remove the reverse link at position, swapping the last reverse link into its place
+    void erase_in_edge(std::size_t position);
+
+    void rebuild_edges_index();
+
+    /// allocate room for @p out_degree edges from the node and @p in_degree edges to it
+    void reserve_edges(std::size_t out_degree, std::size_t in_degree);
+
+    void shrink_to_fit();
+
+    template <class T, class C, class X, class Y>
+    friend constexpr bool operator==(const basic_node<T, C, X, Y> &n1, const basic_node<T, C, X, Y> &n2) noexcept;
 
     template <class T, class C, class X, class Y>
     friend constexpr bool operator!=(const basic_node<T, C, X, Y> &n1, const basic_node<T, C, X, Y> &n2) noexcept;
@@ -590,6 +1354,20 @@ class basic_node {
      */
     explicit basic_node(const Data& data);
 
+    /**
+     * @brief Construct with data, allocating the edges with @p alloc
+     * @param data Data to store in the node
+     * @param alloc Allocator of the out-edges
+     */
+    basic_node(const Data& data, const EdgesAllocator& alloc);
+
+    /**
+     * @brief Construct by moving the data, allocating the edges with @p alloc
+     * @param data Data to move into the node
+     * @param alloc Allocator of the out-edges
+     */
+    basic_node(Data&& data, const EdgesAllocator& alloc);
+
     /**
      * @brief Move assignment operator (deleted)
      */
@@ -664,33 +1442,28 @@ class basic_node {
      * @return Pair containing iterator to edge and boolean indicating if new edge was created
      */
     std::pair<EdgesIterator, bool> add_edge(constContainer other, Cost cost = Cost(1)) {
-        std::shared_ptr<basic_node<Data, Cost, Container, constContainer >> ptr{
-            detail::get_value(other, cend_container)
-        };
+        basic_node<Data, Cost, Container, constContainer>* ptr{detail::get_pointer(other, cend_container)};
 
         if (ptr == nullptr) {
             GRAPH_THROW(unexpected_nullptr)
         }
 
-        for (EdgesIterator it{_out_edges.begin()}; it != _out_edges.end(); ++it) {
-            if (it->_target.lock() == ptr) {
-                it->cost() = cost;
-                return std::make_pair(it, false);
-            }
+        const std::size_t position{find_edge(ptr)};
+        if (position != _out_edges.size()) {
+            EdgesIterator it{_out_edges.begin() + static_cast<std::ptrdiff_t>(position)};
+            it->cost() = cost;
+            return std::make_pair(it, false);
         }
 
         // Link doesn't exist
-        ptr->increment_in_degree();
-        _out_edges.emplace_back(
-            std::weak_ptr<basic_node<Data, Cost, Container, constContainer >> (ptr),
-            cost
-        );
-        std::pair<EdgesIterator, bool> result{std::make_pair(--_out_edges.end(), true)};
-        return result;
+        return std::make_pair(push_edge(ptr, cost), true);
     }
 
     /**
      * @brief Delete an edge to another node
+     *
+     * The last edge of the node takes the place of the deleted one.
+     *
      * @param other Const iterator to target node
      * @return true if edge was deleted, false otherwise
      */
@@ -725,6 +1498,40 @@ class basic_node {
 
 };
 
+/**
+ * @brief Index policy storing the nodes in a `std::map`
+ *
+ * Lookups are O(log V) key comparisons and the nodes are iterated in the
+ * order of their keys. This is the default policy of @ref graph.
+ *
+ * @since version 1.2
+ */
+struct ordered_index {
+#if defined(GRAPH_HAS_CPP_14)
+    /// Transparent comparator: keys can be looked up from any type comparable with them
+    template <class Key, class Value>
+    using map = std::map<Key, Value, std::less<>, detail::allocator<std::pair<const Key, Value>>>;
+#else
+    template <class Key, class Value>
+    using map = std::map<Key, Value, std::less<Key>, detail::allocator<std::pair<const Key, Value>>>;
+#endif
+};
+
+/**
+ * @brief Index policy storing the nodes in an open-addressing hash map
+ *
+ * Lookups hash the key once and compare it with `==` on a hit only. The
+ * nodes are iterated in insertion order. `std::hash<Key>` must be defined,
+ * and keys must still be ordered for the dense representations, which sort them.
+ * Under C++17, `std::string` keys are also looked up from a `std::string_view`.
+ *
+ * @since version 1.2
+ */
+struct unordered_index {
+    template <class Key, class Value>
+    using map = detail::hash_map<Key, Value, detail::key_hash<Key>>;
+};
+
 /**
  * @brief A generalized class of Graph
  *
@@ -741,27 +1548,46 @@ class basic_node {
  *           Aliased as member type Graph::graphed_type
  * @tparam Cost Type of the cost between nodes. Default is std::size_t
  * @tparam Nat Nature of the graph (DIRECTED or UNDIRECTED). Default is UNDIRECTED
+ * @tparam Index Container policy of the nodes: @ref ordered_index (default)
+ *               or @ref unordered_index for hashed lookups of the keys
  *
  * @since version 1.0.0
  */
-template <class Key, class T, class Cost = std::size_t, Nature Nat = UNDIRECTED>
+template <class Key, class T, class Cost = std::size_t, Nature Nat = UNDIRECTED, class Index = ordered_index>
 class graph {
   public:
     class node;
     using Degree = detail::basic_degree<Nat>;
     class search_path;
     class shortest_paths;
+    class frozen_graph;
+    class adjacency_matrix;
+    class distance_matrix;
 
   private:
     using PtrNode  = std::shared_ptr<node>;
-    using MapNodes = std::map<Key, PtrNode>;
+    using MapNodes = typename Index::template map<Key, PtrNode>;
 
     MapNodes _nodes;
     std::size_t _num_edges = 0;
 
+    /// Cost slots shared by both directions of UNDIRECTED edges; addresses are stable
+    std::deque<Cost, detail::allocator<Cost>>    _shared_costs;
+    std::vector<Cost*, detail::allocator<Cost*>> _free_costs;
+
+    /// Dense indices of the nodes, all below `_indices_bound`; the ones of erased nodes are reused first
+    std::size_t                                              _indices_bound = 0;
+    std::vector<std::size_t, detail::allocator<std::size_t>> _free_indices;
+
+    /// Snapshot handed to the readers, and number of publications
+    detail::shared_slot<frozen_graph> _published;
+    std::size_t                       _version = 0;
+
+    PtrNode new_node(const T &x) const;
+    PtrNode new_node(T &&x) const;
+
     const Cost infinity = std::numeric_limits<cost_type>::has_infinity ? std::numeric_limits<Cost>::infinity() :
                           std::numeric_limits<Cost>::max();
-    class path_comparator;
     struct iterator_comparator;
 
   public:
@@ -797,6 +1623,8 @@ class graph {
 
     using size_type    = std::size_t;
 
+    using allocator_type = detail::allocator<value_type>;
+
     using iterator               = typename MapNodes::iterator;
 
     using const_iterator         = typename MapNodes::const_iterator;
@@ -884,6 +1712,22 @@ class graph {
      */
     explicit graph();
 
+    /**
+     * @brief Construct an empty graph allocating all its memory with @p alloc
+     *
+     * Since C++17 the allocator is a `std::pmr::polymorphic_allocator`: passing a
+     * `std::pmr::memory_resource*`, such as a `std::pmr::monotonic_buffer_resource`,
+     * builds the nodes, their out-edges and the shared costs on it. Releasing the
+     * elements into a monotonic arena costs nothing, so `clear()` and the destructor
+     * only run the destructors of the keys and values.
+     * A copy of the graph uses the default resource.
+     *
+     * @param alloc Allocator of the graph
+     *
+     * @since version 1.2
+     */
+    explicit graph(const allocator_type& alloc);
+
     /**
      * @brief Construct a graph from an input stream
      *
@@ -927,11 +1771,12 @@ class graph {
      *
      * Assigns the contents of one graph to another by moving.
      * The moved-from graph is left in a valid but unspecified state.
+     * When the two allocators differ, the elements are copied into the resource of this graph, which may throw.
      *
      * @param other Graph to move from
      * @return Reference to this graph
      */
-    graph &operator=(graph&& other) noexcept;
+    graph &operator=(graph&& other) noexcept(std::allocator_traits<allocator_type>::is_always_equal::value);
 
     /**
      * @brief Virtual destructor
@@ -961,6 +1806,53 @@ class graph {
      */
     [[nodiscard]] size_type max_size() const noexcept;
 
+    /**
+     * @brief Allocate room for nodes up front
+     *
+     * A hashed index is sized so that inserting up to @p n nodes does not rehash
+     * it; an ordered index allocates its nodes one by one and is left as is.
+     *
+     * @param n Number of nodes expected in the graph
+     */
+    void reserve_nodes(size_type n);
+
+    /**
+     * @brief Allocate room for the edges of a node up front
+     *
+     * Adding up to @p degree edges from the node then neither grows its edges
+     * nor rehashes their index. On UNDIRECTED graphs, the edges to the node are
+     * reserved as well.
+     *
+     * @param position Iterator to the node
+     * @param degree Number of edges expected from the node
+     */
+    void reserve_edges(const_iterator position, size_type degree);
+
+    /**
+     * @brief Allocate room for the edges of a node up front (key version)
+     *
+     * The node is created if it does not exist yet, as with @ref add_edge.
+     *
+     * @param key Key of the node
+     * @param degree Number of edges expected from the node
+     */
+    void reserve_edges(const key_type& key, size_type degree);
+
+    /**
+     * @brief Give back the memory left unused by deletions
+     *
+     * The node index, the edges of every node and the pool of shared costs are
+     * reallocated to fit their current size, and the dense indices of the nodes
+     * used by the search algorithms are renumbered. Iterators to the nodes remain valid.
+     */
+    void shrink_to_fit();
+
+    /**
+     * @brief Get the allocator of the graph
+     * @return Copy of the allocator given at construction
+     */
+    [[nodiscard]] allocator_type get_allocator() const noexcept;
+
     /**
      * @brief Access or insert a node with the specified key
      *
@@ -1112,6 +2004,9 @@ class graph {
     /**
      * @brief Insert a node with specified key and node
      *
+     * The new node gets the data of @p node and, through add_edge, an edge to the node with the key of each of its targets.
+     * Nothing is allocated if @p key is already in the graph.
+     *
      * @param position Hint for where to insert the node
      * @param key Key for the new node
      * @param node Node to insert
@@ -1143,7 +2038,8 @@ class graph {
     /**
      * @brief Emplace a node with the specified key and node
      *
-     * Constructs a new node in-place with the given key and node.
+     * Constructs a new node in-place with the data of the given node and, through add_edge, an edge to the node with
+     * the key of each of its targets. Nothing is allocated if @p key is already in the graph.
      *
      * @param key Key for the new node
      * @param node Node to emplace
@@ -1151,6 +2047,40 @@ class graph {
      */
     std::pair<iterator, bool> emplace(const key_type &, const node &);
 
+    /**
+     * @brief Emplace a node by moving the specified key and data
+     *
+     * @param key Key for the new node (moved from only if it is inserted)
+     * @param data Data for the new node (moved from only if it is inserted)
+     * @return Pair containing iterator to the node and boolean indicating if insertion occurred
+     */
+    std::pair<iterator, bool> emplace(key_type &&, graphed_type &&);
+
+    /**
+     * @brief Insert a node whose data is constructed in place, if the key does not exist yet
+     *
+     * Nothing is allocated nor constructed when the key already exists: @p args are left untouched.
+     * Otherwise the data is constructed once from @p args and moved into the new node.
+     *
+     * @param key Key for the node
+     * @param args Arguments forwarded to the constructor of the data
+     * @return Pair containing iterator to the node and boolean indicating if insertion occurred
+     * @since version 1.2
+     */
+    template <class... Args>
+    std::pair<iterator, bool> try_emplace(const key_type &key, Args &&... args);
+
+    /**
+     * @brief Insert a node whose data is constructed in place, if the key does not exist yet (move version)
+     *
+     * @param key Key for the node, moved from only if it is inserted
+     * @param args Arguments forwarded to the constructor of the data
+     * @return Pair containing iterator to the node and boolean indicating if insertion occurred
+     * @since version 1.2
+     */
+    template <class... Args>
+    std::pair<iterator, bool> try_emplace(key_type &&key, Args &&... args);
+
     /**
      * @brief Add a node with the specified key
      *
@@ -1175,7 +2105,7 @@ class graph {
     /**
      * @brief Add a node with the specified key and node
      *
-     * If a node with the given key doesn't exist, creates a new node with the given node's data.
+     * If a node with the given key doesn't exist, creates a new node with the given node's data and edges, as emplace does.
      *
      * @param key Key for the node
      * @param node Node to copy data from
@@ -1183,6 +2113,15 @@ class graph {
      */
     std::pair<iterator, bool> add_node(const key_type &, const node &);
 
+    /**
+     * @brief Add a node by moving the specified key and data
+     *
+     * @param key Key for the node (moved from only if it is inserted)
+     * @param data Data for the node (moved from only if it is inserted)
+     * @return Pair containing iterator to the node and boolean indicating if insertion occurred
+     */
+    std::pair<iterator, bool> add_node(key_type &&, graphed_type &&);
+
     /**
      * @brief Add an edge between two nodes (iterator version)
      *
@@ -1211,11 +2150,29 @@ class graph {
      * @brief Make the graph complete with specified edge cost
      *
      * Adds edges between all pairs of nodes with the given cost.
+     * The previous edges are cleared first, so the new ones are appended to
+     * reserved storage without any search: O(V^2).
      *
      * @param cost Cost for all edges
      */
     void make_complete(cost_type cost);
 
+    /**
+     * @brief Replace the content of the graph with a list of edges
+     *
+     * Each element of [first, last) is a (from, to, cost) tuple read with `std::get`.
+     * The endpoints become nodes holding default values, in the order of their first
+     * appearance, and the last cost given to a duplicate edge wins, as with @ref add_edge.
+     * Each endpoint is looked up once in the node index, then the edges are sorted in bulk by source,
+     * so the adjacency is built without any per-edge search.
+     *
+     * @tparam InputIterator Iterator over (from, to, cost) tuples
+     * @param first Iterator to the first edge
+     * @param last Iterator to one past the last edge
+     */
+    template <class InputIterator>
+    void assign_edges(InputIterator first, InputIterator last);
+
     /**
      * @brief Erase a node
      *
@@ -1278,6 +2235,38 @@ class graph {
      */
     size_type del_node(const key_type& key);
 
+    /**
+     * @brief Delete a batch of nodes by key
+     *
+     * The nodes are marked first, then all their incident edges are removed in a
+     * single sweep over their adjacency: an edge between two deleted nodes is not
+     * unlinked on either side. Unknown and repeated keys are ignored.
+     *
+     * @tparam Range Container of keys, iterated with a range-based for loop
+     * @param keys Keys of the nodes to delete
+     * @return Number of nodes removed
+     */
+    template <class Range>
+    size_type del_nodes(const Range& keys);
+
+    /**
+     * @brief Delete a batch of nodes by key (initializer list version)
+     *
+     * @param keys Keys of the nodes to delete
+     * @return Number of nodes removed
+     */
+    size_type del_nodes(std::initializer_list<key_type> keys);
+
+    /**
+     * @brief Delete the nodes satisfying a predicate
+     *
+     * The whole graph is scanned once to mark the nodes, then they are removed as with @ref del_nodes.
+     *
+     * @param predicate Function called on every node, returning true for the nodes to delete
+     * @return Number of nodes removed
+     */
+    size_type del_nodes_if(std::function<bool(const_iterator)> predicate);
+
     /**
      * @brief Clear all nodes and edges from the graph
      */
@@ -1305,6 +2294,26 @@ class graph {
      */
     size_type del_edge(const key_type& from_key, const key_type& to_key);
 
+    /**
+     * @brief Delete a batch of edges by key
+     *
+     * Each element is a (from, to) pair read with `std::get`; unknown nodes and missing edges are ignored.
+     *
+     * @tparam Range Container of pairs of keys, iterated with a range-based for loop
+     * @param edges Endpoints of the edges to delete
+     * @return Number of edges removed
+     */
+    template <class Range>
+    size_type del_edges(const Range& edges);
+
+    /**
+     * @brief Delete a batch of edges by key (initializer list version)
+     *
+     * @param edges Endpoints of the edges to delete
+     * @return Number of edges removed
+     */
+    size_type del_edges(std::initializer_list<std::pair<key_type, key_type>> edges);
+
     /**
      * @brief Clear all edges from the graph
      */
@@ -1334,8 +2343,10 @@ class graph {
      * @brief Swap the contents of two graphs
      *
      * Exchanges the contents of this graph with another graph.
+     * As with the standard containers, the allocators are not swapped.
      *
      * @param other Graph to swap with
+     * @pre `get_allocator() == other.get_allocator()`; use a move assignment to transfer a graph to another resource
      */
     void swap(graph& other) noexcept;
 
@@ -1363,6 +2374,15 @@ class graph {
      */
     const_iterator find(const key_type &) const;
 
+    template <class K, class = typename std::enable_if<detail::is_transparent_map<MapNodes>::value && !std::is_same<K, Key>::value>::type>
+    size_type count(const K &) const;
+
+    template <class K, class = typename std::enable_if<detail::is_transparent_map<MapNodes>::value && !std::is_same<K, Key>::value>::type>
+    iterator find(const K &);
+
+    template <class K, class = typename std::enable_if<detail::is_transparent_map<MapNodes>::value && !std::is_same<K, Key>::value>::type>
+    const_iterator find(const K &) const;
+
     /**
      * @brief Check if a node exists (iterator version)
      *
@@ -1578,12 +2598,13 @@ class graph {
      * @tparam D Data type
      * @tparam C Cost type
      * @tparam N Nature type
+     * @tparam I Index policy
      * @param os Output stream
      * @param g Graph to output
      * @return Reference to the output stream
      */
-    template<class K, class D, class C, Nature N>
-    friend std::ostream & operator<<(std::ostream& os, const graph<K, D, C, N> &g);
+    template<class K, class D, class C, Nature N, class I>
+    friend std::ostream & operator<<(std::ostream& os, const graph<K, D, C, N, I> &g);
 
     /**
      * @brief Input stream operator
@@ -1594,12 +2615,13 @@ class graph {
      * @tparam D Data type
      * @tparam C Cost type
      * @tparam N Nature type
+     * @tparam I Index policy
      * @param is Input stream
      * @param g Graph to load into
      * @return Reference to the input stream
      */
-    template<class K, class D, class C, Nature N>
-    friend std::istream & operator>>(std::istream& is, graph<K, D, C, N> &g);
+    template<class K, class D, class C, Nature N, class I>
+    friend std::istream & operator>>(std::istream& is, graph<K, D, C, N, I> &g);
 
     /**
      * @brief Load a graph from a file
@@ -1682,11 +2704,12 @@ class graph {
      * @tparam D Data type of other graph
      * @tparam C Cost type of other graph
      * @tparam N Nature type of other graph
+     * @tparam I Index policy of other graph
      * @param other Graph to compare with
      * @return true if graphs are equal, false otherwise
      */
-    template<class K, class D, class C, Nature N>
-    bool operator==(const graph<K, D, C, N> &other) const noexcept;
+    template<class K, class D, class C, Nature N, class I>
+    bool operator==(const graph<K, D, C, N, I> &other) const noexcept;
 
     /**
      * @brief Inequality operator
@@ -1697,23 +2720,33 @@ class graph {
      * @tparam D Data type of other graph
      * @tparam C Cost type of other graph
      * @tparam N Nature type of other graph
+     * @tparam I Index policy of other graph
      * @param other Graph to compare with
      * @return true if graphs are not equal, false otherwise
      */
-    template<class K, class D, class C, Nature N>
-    bool operator!=(const graph<K, D, C, N> &other) const noexcept;
+    template<class K, class D, class C, Nature N, class I>
+    bool operator!=(const graph<K, D, C, N, I> &other) const noexcept;
 
     class node : public basic_node<graphed_type, cost_type, iterator, const_iterator> {
       public:
+        using EdgesAllocator = typename basic_node<graphed_type, cost_type, iterator, const_iterator>::EdgesAllocator;
+
         explicit node();
 
         explicit node(const graphed_type &);
 
+        node(const graphed_type &, const EdgesAllocator &);
+
+        node(graphed_type &&, const EdgesAllocator &);
+
         node &operator=(const graphed_type &);
 
       private:
         friend class graph;
 
+        /// Dense index of the node in its graph, see @ref graph::attach_node
+        size_type _index = std::numeric_limits<size_type>::max();
+
         void set_iterator_values(iterator this_, iterator end, const_iterator cend);
     };
 
@@ -1727,6 +2760,9 @@ class graph {
     search_path bfs(const_iterator start, std::list<const_iterator>           target_list) const;
     search_path bfs(const_iterator start, std::function<bool(const_iterator)> is_goal)     const;
 
+    template <class Goal> auto bfs(key_type       start, Goal is_goal) const -> GRAPH_REQUIRES(search_path, GRAPH_SEARCH_GOAL(Goal, key_type));
+    template <class Goal> auto bfs(const_iterator start, Goal is_goal) const -> GRAPH_REQUIRES(search_path, GRAPH_SEARCH_GOAL(Goal, const_iterator));
+
     search_path dfs(key_type       start, key_type                            target)      const;
     search_path dfs(key_type       start, std::list<key_type>                 target_list) const;
     search_path dfs(key_type       start, std::function<bool(key_type)>       is_goal)     const;
@@ -1735,6 +2771,9 @@ class graph {
     search_path dfs(const_iterator start, std::list<const_iterator>           target_list) const;
     search_path dfs(const_iterator start, std::function<bool(const_iterator)> is_goal)     const;
 
+    template <class Goal> auto dfs(key_type       start, Goal is_goal) const -> GRAPH_REQUIRES(search_path, GRAPH_SEARCH_GOAL(Goal, key_type));
+    template <class Goal> auto dfs(const_iterator start, Goal is_goal) const -> GRAPH_REQUIRES(search_path, GRAPH_SEARCH_GOAL(Goal, const_iterator));
+
     search_path dls(key_type       start, key_type                            target,      size_type depth) const;
     search_path dls(key_type       start, std::list<key_type>                 target_list, size_type depth) const;
     search_path dls(key_type       start, std::function<bool(key_type)>       is_goal,     size_type depth) const;
@@ -1759,6 +2798,9 @@ class graph {
     search_path ucs(const_iterator start, std::list<const_iterator>           target_list) const;
     search_path ucs(const_iterator start, std::function<bool(const_iterator)> is_goal)     const;
 
+    template <class Goal> auto ucs(key_type       start, Goal is_goal) const -> GRAPH_REQUIRES(search_path, GRAPH_SEARCH_GOAL(Goal, key_type));
+    template <class Goal> auto ucs(const_iterator start, Goal is_goal) const -> GRAPH_REQUIRES(search_path, GRAPH_SEARCH_GOAL(Goal, const_iterator));
+
     search_path astar(key_type       start, key_type                            target,      std::function<cost_type(const_iterator)> heuristic) const;
     search_path astar(key_type       start, std::list<key_type>                 target_list, std::function<cost_type(const_iterator)> heuristic) const;
     search_path astar(key_type       start, std::function<bool(key_type)>       is_goal,     std::function<cost_type(const_iterator)> heuristic) const;
@@ -1767,6 +2809,22 @@ class graph {
     search_path astar(const_iterator start, std::list<const_iterator>           target_list, std::function<cost_type(const_iterator)> heuristic) const;
     search_path astar(const_iterator start, std::function<bool(const_iterator)> is_goal,     std::function<cost_type(const_iterator)> heuristic) const;
 
+    template <class Heuristic>
+    auto astar(key_type       start, key_type                  target,      Heuristic heuristic) const -> GRAPH_REQUIRES(search_path, GRAPH_SEARCH_HEURISTIC(Heuristic, const_iterator, cost_type));
+    template <class Heuristic>
+    auto astar(key_type       start, std::list<key_type>       target_list, Heuristic heuristic) const -> GRAPH_REQUIRES(search_path, GRAPH_SEARCH_HEURISTIC(Heuristic, const_iterator, cost_type));
+    template <class Goal, class Heuristic>
+    auto astar(key_type       start, Goal                      is_goal,     Heuristic heuristic) const
+        -> GRAPH_REQUIRES(search_path, GRAPH_SEARCH_GOAL(Goal, key_type) && GRAPH_SEARCH_HEURISTIC(Heuristic, const_iterator, cost_type));
+
+    template <class Heuristic>
+    auto astar(const_iterator start, const_iterator            target,      Heuristic heuristic) const -> GRAPH_REQUIRES(search_path, GRAPH_SEARCH_HEURISTIC(Heuristic, const_iterator, cost_type));
+    template <class Heuristic>
+    auto astar(const_iterator start, std::list<const_iterator> target_list, Heuristic heuristic) const -> GRAPH_REQUIRES(search_path, GRAPH_SEARCH_HEURISTIC(Heuristic, const_iterator, cost_type));
+    template <class Goal, class Heuristic>
+    auto astar(const_iterator start, Goal                      is_goal,     Heuristic heuristic) const
+        -> GRAPH_REQUIRES(search_path, GRAPH_SEARCH_GOAL(Goal, const_iterator) && GRAPH_SEARCH_HEURISTIC(Heuristic, const_iterator, cost_type));
+
     shortest_paths dijkstra(key_type       start)                                                  const;
     shortest_paths dijkstra(key_type       start, key_type                            target)      const;
     shortest_paths dijkstra(key_type       start, std::list<key_type>                 target_list) const;
@@ -1780,18 +2838,55 @@ class graph {
     shortest_paths bellman_ford(key_type       start) const;
     shortest_paths bellman_ford(const_iterator start) const;
 
+    shortest_paths bellman_ford(key_type       start, size_type nbr_threads) const;
+    shortest_paths bellman_ford(const_iterator start, size_type nbr_threads) const;
+
+    shortest_paths delta_stepping(key_type       start, cost_type delta, size_type nbr_threads = 0) const;
+    shortest_paths delta_stepping(const_iterator start, cost_type delta, size_type nbr_threads = 0) const;
+
+    distance_matrix all_pairs_shortest_paths(bool keep_paths = false, size_type nbr_threads = 0) const;
+
+    distance_matrix johnson(bool keep_paths = false, size_type nbr_threads = 0) const;
+
+    frozen_graph freeze() const;
+
+    adjacency_matrix to_matrix() const;
+
+    using snapshot_type = std::shared_ptr<const frozen_graph>;
+
+    /**
+     * @brief Freeze the current state of the graph and make it the current snapshot
+     *
+     * Writer side: must not run concurrently with another modification of the graph.
+     * The previous snapshot stays valid for the readers still holding it.
+     *
+     * @return the version of the new snapshot, one more than the previous one
+     * @since version 1.2
+     */
+    size_type publish();
+
+    /**
+     * @brief Last published snapshot
+     *
+     * Reader side: safe to call from any thread, even while the writer modifies the graph or publishes.
+     * The returned snapshot is then queried without any lock.
+     *
+     * @return the last published snapshot, or an empty one of version 0 if nothing was published yet
+     * @since version 1.2
+     */
+    snapshot_type snapshot() const;
+
+    [[nodiscard]] size_type get_version() const noexcept;
+
     class search_path final : std::deque<std::pair<graph::const_iterator, cost_type >> {
-        template <bool> friend search_path graph::abstract_first_search(graph::const_iterator, std::function<bool(const_iterator)>) const;
+        template <bool, class Goal> friend search_path graph::abstract_first_search(graph::const_iterator, Goal &) const;
 
         friend search_path graph::dls   (graph::const_iterator, std::function<bool(const_iterator)>, size_type)                                const;
         friend search_path graph::iddfs (graph::const_iterator, std::function<bool(const_iterator)>)                                           const;
-        friend search_path graph::ucs   (graph::const_iterator, std::function<bool(const_iterator)>)                                           const;
-        friend search_path graph::astar (graph::const_iterator, std::function<bool(const_iterator)>, std::function<cost_type(const_iterator)>) const;
+        template <class Goal, class Heuristic> friend bool graph::best_first_search(graph::const_iterator, Goal &, Heuristic &, bool, search_path &) const;
 
         friend class shortest_paths;
 
-        friend bool path_comparator::operator()(const search_path &, const search_path &) const;
-
         using Container = std::deque<std::pair<graph::const_iterator, cost_type >>;
 
       public:
@@ -1839,19 +2934,33 @@ class graph {
         }
     };
 
-    class shortest_paths final : std::map<graph::const_iterator, std::pair<graph::const_iterator, cost_type>, iterator_comparator> {
+    class shortest_paths final : std::vector<std::pair<graph::const_iterator, std::pair<graph::const_iterator, cost_type>>> {
+        const graph*          _graph;
         graph::const_iterator _start;
+        /// Position in the container of the node of each dense index
+        std::vector<size_type> _positions;
 
         friend shortest_paths graph::dijkstra    (graph::const_iterator, std::function<bool(const_iterator)>) const;
+        friend void           graph::dijkstra    (std::function<bool(const_iterator)> &, shortest_paths &, std::true_type)  const;
+        friend void           graph::dijkstra    (std::function<bool(const_iterator)> &, shortest_paths &, std::false_type) const;
         friend shortest_paths graph::bellman_ford(graph::const_iterator)                                      const;
+        friend shortest_paths graph::bellman_ford(graph::const_iterator, size_type)                           const;
+        friend shortest_paths graph::delta_stepping(graph::const_iterator, cost_type, size_type)              const;
+
+        using Container = std::vector<std::pair<graph::const_iterator, std::pair<graph::const_iterator, cost_type>>>;
 
-        using Container = std::map<graph::const_iterator, std::pair<graph::const_iterator, cost_type>, iterator_comparator>;
+        shortest_paths(const graph &g, graph::const_iterator start);
 
-        explicit shortest_paths(graph::const_iterator start);
+        /// @return the predecessor and the distance of the node @p n
+        typename Container::value_type::second_type       &entry(const typename node::basic_node* n);
+        const typename Container::value_type::second_type &entry(const typename node::basic_node* n) const;
+
+        /// @return the predecessor and the distance of the node at @p it, or nullptr if it was not in the graph during the search
+        const typename Container::value_type::second_type *find_entry(graph::const_iterator it) const;
 
       public:
         using value_type             = typename Container::value_type;
-        using mapped_type            = typename Container::mapped_type;
+        using mapped_type            = typename value_type::second_type;
         using reference              = typename Container::reference;
         using const_reference        = typename Container::const_reference;
         using iterator               = typename Container::iterator;
@@ -1869,14 +2978,24 @@ class graph {
         using Container::crend;
 
         shortest_paths(const shortest_paths &);
+        shortest_paths(shortest_paths &&) noexcept = default;
         ~shortest_paths() = default;
 
+        shortest_paths &operator=(const shortest_paths &) = default;
+        shortest_paths &operator=(shortest_paths &&) noexcept = default;
+
         using Container::empty;
         using Container::size;
 
-        /// @return the father of current in the optimal path from _start to current
+        /// @return the father of current in the optimal path from _start to current, graph::cend() if current is unreached
+        /// or was added to the graph after the search
         graph::const_iterator get_previous(graph::const_iterator current) const;
 
+        /// @return the cost of the optimal path from _start to target, the infinity of cost_type if target is unreached
+        /// or was added to the graph after the search
+        cost_type get_distance(graph::key_type target) const;
+        cost_type get_distance(graph::const_iterator target) const;
+
         /// @return the re-build path from the start node to the target
         search_path get_path(graph::key_type target) const;
         search_path get_path(graph::const_iterator target) const;
@@ -1889,2109 +3008,4605 @@ class graph {
         }
     };
 
-  private:
-    /// Helper functions and classes
-    class path_comparator : public std::function<bool(search_path, search_path)> {
-        std::function<cost_type(const_iterator)> _heuristic;
+    class frozen_graph final {
+        friend frozen_graph graph::freeze() const;
+        friend size_type    graph::publish();
+
+        std::vector<key_type>     _keys;
+        std::vector<size_type>    _sorted;
+        std::vector<graphed_type> _values;
+        std::vector<size_type>    _offsets;
+        std::vector<size_type>    _targets;
+        std::vector<cost_type>    _costs;
+        size_type                 _num_edges{0};
+        size_type                 _version{0};
 
       public:
-        explicit path_comparator(std::function<cost_type(const_iterator)> heuristic);
+        class search_path;
+        class shortest_paths;
 
-        bool operator() (const search_path &, const search_path &) const;
-    };
+        frozen_graph() = default;
 
-    struct iterator_comparator : std::function<bool(const_iterator, const_iterator)> {
-        bool operator()(const const_iterator &, const const_iterator &) const;
-    };
+        [[nodiscard]] bool      empty()         const noexcept;
+        [[nodiscard]] size_type size()          const noexcept;
+        [[nodiscard]] size_type get_nbr_nodes() const noexcept;
+        [[nodiscard]] size_type get_nbr_edges() const noexcept;
+        [[nodiscard]] Nature    get_nature()    const noexcept;
 
-    bool is_cyclic_rec(const_iterator current, std::list<const_iterator> path) const;
+        /// @return the version given by @ref graph::publish, or 0 for a snapshot made by @ref graph::freeze
+        [[nodiscard]] size_type get_version()   const noexcept;
 
-    template <bool insertFront> search_path abstract_first_search(const_iterator start, std::function<bool(const_iterator)> is_goal) const;
-};
+        /// @return the index of the node @param key, or `size()` if it does not exist
+        size_type find(const key_type &key) const;
 
-template <class Key, class T, class Cost = std::size_t>
-using graph_directed   = graph<Key, T, Cost, DIRECTED>;
+        const key_type     &get_key(size_type index) const;
+        const graphed_type &get    (size_type index) const;
 
-template <class Key, class T, class Cost = std::size_t>
-using graph_undirected = graph<Key, T, Cost, UNDIRECTED>;
+        /// @return the out-degree of the node @param index
+        size_type degree(size_type index) const;
 
-template <class Data, class Cost, class Container, class constContainer>
-basic_node<Data, Cost, Container, constContainer>::edge::edge(const std::weak_ptr<basic_node<Data, Cost, Container, constContainer >> &ptr, Cost c) : _target(ptr),
-    _cost(std::make_shared<Cost>(c)) {}
+        /// @return the range of positions `[edges_begin(i), edges_end(i))` of the out-edges of the node @param index
+        size_type edges_begin(size_type index) const;
+        size_type edges_end  (size_type index) const;
 
-template <class Data, class Cost, class Container, class constContainer>
-basic_node<Data, Cost, Container, constContainer>::edge::edge(const edge &e) : _target(e._target), _cost(e._cost) {}
+        size_type        target(size_type edge) const;
+        const cost_type &cost  (size_type edge) const;
 
-template <class Data, class Cost, class Container, class constContainer>
-std::tuple<Cost, basic_node<Data, Cost, Container, constContainer >> basic_node<Data, Cost, Container, constContainer>::edge::tie() const {
-    return std::tie(*_cost, *_target.lock().get());
-}
+        bool existing_edge(size_type from, size_type to) const;
 
-template <class Data, class Cost, class Container, class constContainer>
-bool basic_node<Data, Cost, Container, constContainer>::edge::operator<(const edge &other) const {
-    return tie() < other.tie();
-}
+        /// @return the cost of the edge between @param from and @param to, or infinity if it does not exist
+        cost_type get_cost(size_type from, size_type to) const;
 
-template <class Data, class Cost, class Container, class constContainer>
-bool basic_node<Data, Cost, Container, constContainer>::edge::operator==(const edge &other) const {
-    return tie() == other.tie();
-}
+        search_path bfs  (size_type start, size_type target) const;
+        search_path astar(size_type start, size_type target, std::function<cost_type(size_type)> heuristic) const;
 
-template <class Data, class Cost, class Container, class constContainer>
-constContainer basic_node<Data, Cost, Container, constContainer>::edge::target() const {
-    return _target.lock()->container_from_this;
-}
+        shortest_paths dijkstra(size_type start) const;
 
-template <class Data, class Cost, class Container, class constContainer>
-Cost & basic_node<Data, Cost, Container, constContainer>::edge::cost() const {
-    return *_cost;
-}
+        class search_path final : std::vector<std::pair<size_type, cost_type>> {
+            using Container = std::vector<std::pair<size_type, cost_type>>;
 
-template <class Data, class Cost, class Container, class constContainer>
-std::tuple<Data, std::size_t, std::list<typename basic_node<Data, Cost, Container, constContainer>::edge >> basic_node<Data, Cost, Container, constContainer>::tie() const {
-    return std::tie(_data, _in_degree, _out_edges);
-}
+          public:
+            using value_type     = typename Container::value_type;
+            using const_iterator = typename Container::const_iterator;
 
-template <class Data, class Cost, class Container, class constContainer>
-std::list<typename basic_node<Data, Cost, Container, constContainer>::edge> basic_node<Data, Cost, Container, constContainer>::get_edges() const {
-    return _out_edges;
-}
+            using Container::begin;
+            using Container::cbegin;
+            using Container::end;
+            using Container::cend;
+            using Container::empty;
+            using Container::size;
+            using Container::front;
+            using Container::back;
+            using Container::operator[];
+            using Container::push_back;
+            using Container::emplace_back;
 
-template <class Data, class Cost, class Container, class constContainer>
-void basic_node<Data, Cost, Container, constContainer>::increment_in_degree(int n) {
-    _in_degree += n;
-}
+            cost_type total_cost() const;
 
-template <class Data, class Cost, class Container, class constContainer>
-void basic_node<Data, Cost, Container, constContainer>::decrement_in_degree(int n) {
-    _in_degree -= n;
-}
+            bool contain(size_type index) const;
+        };
 
-template <class Data, class Cost, class Container, class constContainer>
-bool basic_node<Data, Cost, Container, constContainer>::set_edge(constContainer other, std::shared_ptr<Cost> cost) {
-    std::pair<basic_node<Data, Cost, Container, constContainer>::EdgesIterator, bool> new_edge{add_edge(other, *cost)};
+        class shortest_paths final {
+            friend shortest_paths frozen_graph::dijkstra(size_type) const;
 
-    new_edge.first->_cost = cost;
+            size_type              _start;
+            std::vector<cost_type> _distances;
+            std::vector<size_type> _previous;
 
-    return new_edge.second;
-}
+            shortest_paths(size_type start, size_type nbr_nodes);
 
-template <class Data, class Cost, class Container, class constContainer>
-basic_node<Data, Cost, Container, constContainer>::basic_node() : basic_node(Data()) {}
+          public:
+            /// @return the father of @param current in the optimal path from the start, or `size()` if unreachable
+            size_type get_previous(size_type current) const;
 
-template <class Data, class Cost, class Container, class constContainer>
-basic_node<Data, Cost, Container, constContainer>::basic_node(const Data &d) : _data(d) {}
+            /// @return the distance from the start to @param current, or infinity if unreachable
+            cost_type get_distance(size_type current) const;
 
-template <class Data, class Cost, class Container, class constContainer>
-basic_node<Data, Cost, Container, constContainer>::basic_node(const basic_node &n) {
-    *this = n;
-}
+            /// @return the re-build path from the start node to the target
+            search_path get_path(size_type target) const;
 
-template <class Data, class Cost, class Container, class constContainer>
-basic_node<Data, Cost, Container, constContainer> &basic_node<Data, Cost, Container, constContainer>::operator=(const basic_node &n) {
-    _data               = n._data;
-    _out_edges          = n._out_edges;
-    _in_degree          = n._in_degree;
-    container_from_this = n.container_from_this;
+            [[nodiscard]] size_type size() const noexcept;
+        };
+    };
 
-    return *this;
-}
+    class adjacency_matrix final {
+        friend adjacency_matrix graph::to_matrix() const;
 
-template <class Data, class Cost, class Container, class constContainer>
-basic_node<Data, Cost, Container, constContainer>::~basic_node() = default;
+        std::vector<key_type>     _keys;
+        std::vector<size_type>    _sorted;
+        std::vector<graphed_type> _values;
+        std::vector<cost_type>    _costs;
+        std::vector<bool>         _existing;
+        size_type                 _num_edges{0};
 
-template <class Data, class Cost, class Container, class constContainer>
-Data & basic_node<Data, Cost, Container, constContainer>::get() {
-    return _data;
-}
+        void mirror_edge(size_type from, size_type to, std::true_type);
+        void mirror_edge(size_type from, size_type to, std::false_type);
 
-template <class Data, class Cost, class Container, class constContainer>
-Data basic_node<Data, Cost, Container, constContainer>::get() const {
-    return _data;
-}
+      public:
+        adjacency_matrix() = default;
 
-template <class Data, class Cost, class Container, class constContainer>
-Cost & basic_node<Data, Cost, Container, constContainer>::get_cost(Container other) {
-    std::shared_ptr<basic_node<Data, Cost, Container, constContainer >> ptr(detail::get_value(other, end_container));
+        [[nodiscard]] bool      empty()         const noexcept;
+        [[nodiscard]] size_type size()          const noexcept;
+        [[nodiscard]] size_type get_nbr_nodes() const noexcept;
+        [[nodiscard]] size_type get_nbr_edges() const noexcept;
+        [[nodiscard]] Nature    get_nature()    const noexcept;
 
-    if (ptr == nullptr) {
-        GRAPH_THROW(unexpected_nullptr)
-    }
+        /// @return the index of the node @param key, or `size()` if it does not exist
+        size_type find(const key_type &key) const;
 
-    for (EdgesIterator it{_out_edges.begin()}; it != _out_edges.end(); ++it)
-        if (it->_target.lock() == ptr) {
-            return it->cost();
-        }
+        const key_type     &get_key(size_type index) const;
+        const graphed_type &get    (size_type index) const;
 
-    /// Link doesn't exist
-    _out_edges.emplace_back(std::weak_ptr<basic_node<Data, Cost, Container, constContainer >> (detail::get_value(other, end_container)), infinity);
-    ptr->increment_in_degree();
-    return (--_out_edges.end())->cost();
-}
+        bool existing_edge(size_type from, size_type to) const;
 
-template <class Data, class Cost, class Container, class constContainer>
-Cost basic_node<Data, Cost, Container, constContainer>::get_cost(constContainer other) const {
-    std::shared_ptr<basic_node<Data, Cost, Container, constContainer >> ptr(detail::get_value(other, cend_container));
+        /// @return the cost of the edge between @param from and @param to, or infinity if it does not exist
+        cost_type get_cost(size_type from, size_type to) const;
 
-    if (ptr == nullptr) {
-        GRAPH_THROW(unexpected_nullptr)
-    }
+        /// add the edge between @param from and @param to, or update its cost
+        /// @return true if the edge is new
+        bool add_edge(size_type from, size_type to, cost_type cost);
 
-    for (auto it = _out_edges.begin(); it != _out_edges.end(); ++it)
-        if (it->_target.lock() == ptr) {
-            return it->cost();
-        }
+        /// @return the number of removed edges (0 or 1)
+        size_type del_edge(size_type from, size_type to);
 
-    /// Link doesn't exist
-    return infinity;
-}
+        void clear_edges();
 
-template <class Data, class Cost, class Container, class constContainer>
-Cost & basic_node<Data, Cost, Container, constContainer>::operator[](Container other) {
-    return get_cost(other);
-}
+        /// add an edge of cost @param cost between every pair of distinct nodes, in O(size()^2) and without any allocation
+        void make_complete(cost_type cost);
 
-template <class Data, class Cost, class Container, class constContainer>
-Cost basic_node<Data, Cost, Container, constContainer>::operator[](constContainer other) const {
-    return get_cost(other);
-}
+        /// @return a graph holding the nodes and the edges of the matrix
+        graph to_graph() const;
+    };
 
-template <class Data, class Cost, class Container, class constContainer>
-template <class T_data>
-void basic_node<Data, Cost, Container, constContainer>::set(const T_data &d) {
-    _data = static_cast<Data>(d);
-}
+    class distance_matrix final {
+        friend distance_matrix graph::all_pairs_shortest_paths(bool, size_type) const;
+        friend distance_matrix graph::johnson                 (bool, size_type) const;
 
-template <class Data, class Cost, class Container, class constContainer>
-template <class T_cost>
-void basic_node<Data, Cost, Container, constContainer>::set_cost(Container other, const T_cost &c) {
-    std::shared_ptr<basic_node<Data, Cost, Container, constContainer >> ptr(detail::get_value(other, end_container));
+        std::vector<key_type>  _keys;
+        std::vector<size_type> _sorted;
+        std::vector<cost_type> _distances;
+        std::vector<size_type> _next;
 
-    if (ptr == nullptr) {
-        GRAPH_THROW(unexpected_nullptr)
-    }
+        distance_matrix(const graph &g, bool keep_paths, std::vector<size_type> &positions);
 
-    Cost new_cost{static_cast<Cost>(c)};
-    bool existing_edge{false};
+      public:
+        distance_matrix() = default;
 
-    for (EdgesIterator it{_out_edges.begin()}; it != _out_edges.end(); ++it) {
-        if (it->_target.lock() == ptr) {
-            it->cost() = new_cost;
-            existing_edge = true;
-        }
-    }
+        [[nodiscard]] bool      empty() const noexcept;
+        [[nodiscard]] size_type size()  const noexcept;
 
-    if (!existing_edge) {
-        this->add_edge(other, new_cost);
-    }
-}
+        /// @return true if the next hops were kept, so that the paths can be rebuilt
+        [[nodiscard]] bool has_paths() const noexcept;
 
-template <class Data, class Cost, class Container, class constContainer>
-bool basic_node<Data, Cost, Container, constContainer>::del_edge(constContainer other) {
-    return del_edge_if(other, [](const edge &) {
-        return true;
-    } );
-}
+        /// @return the index of the node @param key, or `size()` if it does not exist
+        size_type find(const key_type &key) const;
 
-template <class Data, class Cost, class Container, class constContainer>
-bool basic_node<Data, Cost, Container, constContainer>::del_edge_if(constContainer other, std::function<bool(const edge &)> predicate) {
-    for (EdgesIterator it{_out_edges.begin()}; it != _out_edges.end(); ) {
-        if (it->_target.lock() == detail::get_value(other, cend_container)) {
-            if (predicate(*it)) {
-                it = _out_edges.erase(it);
-                other->second->decrement_in_degree();
-                return true;
-            }
-            break;
-        }
-        ++it;
-    }
+        const key_type &get_key(size_type index) const;
 
-    return false;
-}
+        /// @return the cost of the shortest path from @param from to @param to, or infinity if there is none
+        cost_type get_distance(size_type from, size_type to) const;
 
-template <class Data, class Cost, class Container, class constContainer>
-std::size_t basic_node<Data, Cost, Container, constContainer>::clear_edges() {
-    const std::size_t NUM{_out_edges.size()};
+        /// @return the node following @param from on a shortest path to @param to, or `size()` if there is none
+        size_type get_next(size_type from, size_type to) const;
 
-    for (EdgesIterator it{_out_edges.begin()}; it != _out_edges.end(); ) {
-        it->_target.lock()->decrement_in_degree();
-        it = _out_edges.erase(it);
-    }
+        /// @return the indices of the nodes of a shortest path from @param from to @param to, both included; empty if there is none
+        std::vector<size_type> get_path(size_type from, size_type to) const;
+    };
 
-    return NUM;
-}
+  private:
+    /// Helper functions and classes
+    struct iterator_comparator : std::function<bool(const_iterator, const_iterator)> {
+        bool operator()(const const_iterator &, const const_iterator &) const;
+    };
 
-template <class Data, class Cost, class Container, class constContainer>
-std::pair<std::size_t, std::size_t> basic_node<Data, Cost, Container, constContainer>::degree() const {
-    return std::make_pair(_in_degree, _out_edges.size());
-}
+    bool is_cyclic_rec(const_iterator current, std::list<const_iterator> path) const;
 
-template <class Data, class Cost, class Container, class constContainer>
-bool basic_node<Data, Cost, Container, constContainer>::existing_adjacent_node(constContainer other) const {
-    std::shared_ptr<basic_node<Data, Cost, Container, constContainer >> ptr(detail::get_value(other, cend_container));
+    void attach_node(iterator position);
 
-    if (ptr == nullptr) {
-        return false;
-    }
+    void release_node(const_iterator position);
 
-    for (auto it = _out_edges.begin(); it != _out_edges.end(); ++it) {
-        if (it->_target.lock() == ptr) {
-            return true;
-        }
-    }
+    static size_type index_of(const typename node::basic_node* n);
 
-    /// Link doesn't exist
-    return false;
-}
+    void copy_edges(iterator position, const node &n);
 
-template <class Data, class Cost, class Container, class constContainer>
-constexpr bool operator==(const basic_node<Data, Cost, Container, constContainer> &n1, const basic_node<Data, Cost, Container, constContainer> &n2) noexcept {
-    return n1.tie() == n2.tie();
-}
+    void detach_nodes(const std::vector<const_iterator> &victims);
 
-template <class Data, class Cost, class Container, class constContainer>
-constexpr bool operator!=(const basic_node<Data, Cost, Container, constContainer> &n1, const basic_node<Data, Cost, Container, constContainer> &n2) noexcept {
-    return !(n1 == n2);
-}
+    Cost* acquire_shared_cost(cost_type cost);
+    void  release_shared_cost(Cost* slot);
 
-template <class Data, class Cost, class Container, class constContainer>
-constexpr bool operator<(const basic_node<Data, Cost, Container, constContainer> &n1, const basic_node<Data, Cost, Container, constContainer> &n2) noexcept {
-    return n1.tie() < n2.tie();
-}
+    using directed_tag = std::integral_constant<bool, detail::is_directed<Nat>::value>;
 
-template <class Data, class Cost, class Container, class constContainer>
-constexpr bool operator>(const basic_node<Data, Cost, Container, constContainer> &n1, const basic_node<Data, Cost, Container, constContainer> &n2) noexcept {
-    return n2 < n1;
-}
+    using integral_cost_tag = std::integral_constant<bool, std::is_integral<Cost>::value && !std::is_same<Cost, bool>::value>;
 
-template <class Data, class Cost, class Container, class constContainer>
-constexpr bool operator<=(const basic_node<Data, Cost, Container, constContainer> &n1, const basic_node<Data, Cost, Container, constContainer> &n2) noexcept {
-    return !(n2 < n1);
-}
+    void      add_opposite_edge(const_iterator from, const_iterator to, typename node::edge &e, std::true_type);
+    void      add_opposite_edge(const_iterator from, const_iterator to, typename node::edge &e, std::false_type);
+    void      push_opposite_edge(node* from, node* to, typename node::edge &e, std::true_type);
+    void      push_opposite_edge(node* from, node* to, typename node::edge &e, std::false_type);
+    size_type del_edge     (const_iterator from, const_iterator to, std::true_type);
+    size_type del_edge     (const_iterator from, const_iterator to, std::false_type);
+    size_type clear_edges  (const_iterator position, std::true_type);
+    size_type clear_edges  (const_iterator position, std::false_type);
+    bool      existing_edge(const_iterator from, const_iterator to, std::true_type)  const;
+    bool      existing_edge(const_iterator from, const_iterator to, std::false_type) const;
+    Degree    degree       (const_iterator position, std::true_type)  const;
+    Degree    degree       (const_iterator position, std::false_type) const;
 
-template <class Data, class Cost, class Container, class constContainer>
-constexpr bool operator>=(const basic_node<Data, Cost, Container, constContainer> &n1, const basic_node<Data, Cost, Container, constContainer> &n2) noexcept {
-    return !(n1 < n2);
-}
+    void      dijkstra     (std::function<bool(const_iterator)> &is_goal, shortest_paths &result, std::true_type)  const;
+    void      dijkstra     (std::function<bool(const_iterator)> &is_goal, shortest_paths &result, std::false_type) const;
 
-#include <memory>
-#include <set>
+    template <bool insertFront, class Goal> search_path abstract_first_search(const_iterator start, Goal &is_goal) const;
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::iterator graph<Key, T, Cost, Nat>::begin() noexcept {
-    return _nodes.begin();
-}
+    template <class Goal, class Heuristic>
+    bool best_first_search(const_iterator start, Goal &is_goal, Heuristic &heuristic, bool reject_negative, search_path &result) const;
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::iterator graph<Key, T, Cost, Nat>::end() noexcept {
-    return _nodes.end();
-}
+    void relax_block(cost_type* distances, size_type* next, size_type n, size_type k_begin, size_type k_end,
+                     size_type i_begin, size_type i_end, size_type j_begin, size_type j_end) const;
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::const_iterator graph<Key, T, Cost, Nat>::begin() const noexcept {
-    return _nodes.begin();
-}
+    struct null_heuristic {
+        cost_type operator()(const const_iterator &) const;
+    };
+};
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::const_iterator graph<Key, T, Cost, Nat>::cbegin() const noexcept {
-    return _nodes.cbegin();
-}
+template <class Key, class T, class Cost = std::size_t, class Index = ordered_index>
+using graph_directed   = graph<Key, T, Cost, DIRECTED, Index>;
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::const_iterator graph<Key, T, Cost, Nat>::end() const noexcept {
-    return _nodes.end();
-}
+template <class Key, class T, class Cost = std::size_t, class Index = ordered_index>
+using graph_undirected = graph<Key, T, Cost, UNDIRECTED, Index>;
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::const_iterator graph<Key, T, Cost, Nat>::cend() const noexcept {
-    return _nodes.cend();
-}
+template <class Key, class T, class Cost = std::size_t, Nature Nat = UNDIRECTED>
+using graph_unordered  = graph<Key, T, Cost, Nat, unordered_index>;
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::reverse_iterator graph<Key, T, Cost, Nat>::rbegin() noexcept {
-    return _nodes.rbegin();
-}
+/**
+ * @brief Search-only view of a graph whose edges are computed on demand
+ *
+ * Nothing is materialised up front: the out-edges of a node are asked to the
+ * neighbour function each time the node is expanded, and the state of a search
+ * (distance, predecessor) is only allocated for the nodes it discovers. This
+ * allows searching state spaces that are too large, or unbounded, to be stored
+ * in a @ref graph.
+ *
+ * Each discovered key gets a dense index in the order of discovery: the
+ * per-node state is kept in contiguous arrays and the key is only looked up
+ * once per relaxed edge.
+ *
+ * @tparam Key Type of the states. Must be ordered, or hashable with @ref unordered_index
+ * @tparam Cost Type of the cost between nodes. Default is std::size_t
+ * @tparam Index Container policy of the discovered keys: @ref ordered_index (default) or @ref unordered_index
+ *
+ * @since version 1.2
+ */
+template <class Key, class Cost = std::size_t, class Index = ordered_index>
+class implicit_graph final {
+  public:
+    class search_path;
+    class shortest_paths;
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::reverse_iterator graph<Key, T, Cost, Nat>::rend() noexcept {
-    return _nodes.rend();
-}
+    using key_type   = Key;
+    using cost_type  = Cost;
+    using size_type  = std::size_t;
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::const_reverse_iterator graph<Key, T, Cost, Nat>::rbegin() const noexcept {
-    return _nodes.rbegin();
-}
+    using neighbours_type     = std::vector<std::pair<key_type, cost_type>>;
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::const_reverse_iterator graph<Key, T, Cost, Nat>::crbegin() const noexcept {
-    return _nodes.crbegin();
-}
+    using neighbours_function = std::function<void(const key_type&, neighbours_type&)>;
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::const_reverse_iterator graph<Key, T, Cost, Nat>::rend() const noexcept {
-    return _nodes.rend();
-}
+    using invalid_argument = detail::invalid_argument;
+    using negative_edge    = detail::negative_edge;
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::const_reverse_iterator graph<Key, T, Cost, Nat>::crend() const noexcept {
-    return _nodes.crend();
-}
+    /**
+     * @param neighbours function computing the out-edges of a node
+     * @param max_expansions number of nodes a search expands before giving up; bounds the memory of a search
+     *                       on an infinite state space
+     */
+    explicit implicit_graph(neighbours_function neighbours, size_type max_expansions = std::numeric_limits<size_type>::max());
 
-template <class Key, class T, class Cost, Nature Nat>
-graph<Key, T, Cost, Nat>::graph() {
-    _nodes.clear();
-}
+    [[nodiscard]] size_type get_max_expansions() const noexcept;
+    void set_max_expansions(size_type max_expansions) noexcept;
 
-template <class Key, class T, class Cost, Nature Nat>
-graph<Key, T, Cost, Nat>::graph(std::istream &is) {
-    is >> *this;
-}
+    neighbours_type get_neighbours(const key_type &key) const;
 
-template <class Key, class T, class Cost, Nature Nat>
-graph<Key, T, Cost, Nat>::graph(const graph &other) {
-    *this = other;
-}
+    search_path bfs  (const key_type &start, const key_type &target) const;
+    search_path bfs  (const key_type &start, std::function<bool(key_type)> is_goal) const;
 
-template <class Key, class T, class Cost, Nature Nat>
-graph<Key, T, Cost, Nat>::graph(graph &&other) noexcept
-    : _nodes(std::move(other._nodes))
-    , _num_edges(other._num_edges) {
-    other._num_edges = 0;
-}
+    search_path ucs  (const key_type &start, const key_type &target) const;
+    search_path ucs  (const key_type &start, std::function<bool(key_type)> is_goal) const;
 
-template <class Key, class T, class Cost, Nature Nat>
-graph<Key, T, Cost, Nat> &graph<Key, T, Cost, Nat>::operator=(const graph &other) {
-    clear();
+    search_path astar(const key_type &start, const key_type &target,          std::function<cost_type(key_type)> heuristic) const;
+    search_path astar(const key_type &start, std::function<bool(key_type)> is_goal, std::function<cost_type(key_type)> heuristic) const;
 
-    for (const_iterator it{other.cbegin()}; it != other.cend(); ++it) {
-        add_node(it->first, it->second->get());
-    }
+    shortest_paths dijkstra(const key_type &start) const;
 
-    for (const_iterator it{other.cbegin()}; it != other.cend(); ++it) {
-        std::list<typename node::edge> list = it->second->get_edges();
-        for (typename node::edge e : list) {
-            graph::const_iterator i{e.target()};
-            add_edge(it->first, i->first, e.cost());
-        }
-    }
+    shortest_paths dijkstra(const key_type &start, std::function<bool(key_type)> is_goal) const;
 
-    return *this;
-}
+  private:
+    neighbours_function _neighbours;
+    size_type           _max_expansions;
 
-template <class Key, class T, class Cost, Nature Nat>
-graph<Key, T, Cost, Nat> &graph<Key, T, Cost, Nat>::operator=(graph&& other) noexcept {
-    // Handle self-assignment
-    if (this != &other) {
-        //swap(other);
-        // Move the resources directly for better performance
-        _nodes = std::move(other._nodes);
-        _num_edges = other._num_edges;
+    struct explored {
+        typename Index::template map<key_type, size_type> ids;
+        std::vector<key_type>  keys;
+        std::vector<cost_type> distances;
+        std::vector<size_type> previous;
+        std::vector<bool>      expanded;
 
-        // Reset the moved-from object to a valid state
-        other._num_edges = 0;
-    }
-    return *this;
-}
+        /// @return the index of @param key and whether it was discovered by this call
+        std::pair<size_type, bool> discover(const key_type &key, cost_type distance, size_type from);
 
-template <class Key, class T, class Cost, Nature Nat>
-graph<Key, T, Cost, Nat>::~graph() = default;
+        /// @return the index of @param key, or `keys.size()` if it was not discovered
+        size_type find(const key_type &key) const;
 
-template <class Key, class T, class Cost, Nature Nat>
-bool graph<Key, T, Cost, Nat>::empty() const noexcept {
-    return _nodes.empty();
-}
+        /// @return the path from the start (index 0) to the node @param target
+        search_path get_path(size_type target) const;
+    };
 
-template <class Key, class T, class Cost, Nature Nat>
-std::size_t graph<Key, T, Cost, Nat>::size() const noexcept {
-    return _nodes.size();
-}
+    search_path first_search(const key_type &start, std::function<bool(key_type)> is_goal) const;
 
-template <class Key, class T, class Cost, Nature Nat>
-std::size_t graph<Key, T, Cost, Nat>::max_size() const noexcept {
-    return _nodes.max_size();
-}
+    explored best_first_search(const key_type &start, std::function<bool(key_type)> is_goal,
+                               std::function<cost_type(key_type)> heuristic, size_type &goal) const;
 
-template <class Key, class T, class Cost, Nature Nat>
-T &graph<Key, T, Cost, Nat>::operator[](const key_type &k) {
-    return add_node(k).first->second->get();
-}
+  public:
 
-template <class Key, class T, class Cost, Nature Nat>
-T &graph<Key, T, Cost, Nat>::operator[](key_type &&k) {
-    return add_node(k).first->second->get();
-}
+    class search_path final : std::vector<std::pair<key_type, cost_type>> {
+        using Container = std::vector<std::pair<key_type, cost_type>>;
 
-#if defined(GRAPH_HAS_CPP_17)
-template <class Key, class T, class Cost, Nature Nat>
-std::optional<T> graph<Key, T, Cost, Nat>::operator[](key_type &&k) const {
-    const_iterator it{this->find(k)};
-    return it == cend() ? std::nullopt : std::optional<T>(it->second->get());
-}
-#else
-template <class Key, class T, class Cost, Nature Nat>
-T graph<Key, T, Cost, Nat>::operator[](key_type &&k) const {
-    const_iterator it{this->find(k)};
-    if (it == cend()) {
-        GRAPH_THROW_WITH(invalid_argument, "Unexistant node")
-    }
+      public:
+        using value_type     = typename Container::value_type;
+        using const_iterator = typename Container::const_iterator;
 
-    return it->second->get();
-}
-#endif
+        using Container::begin;
+        using Container::cbegin;
+        using Container::end;
+        using Container::cend;
+        using Container::empty;
+        using Container::size;
+        using Container::front;
+        using Container::back;
+        using Container::operator[];
+        using Container::push_back;
+        using Container::emplace_back;
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::cost_type &graph<Key, T, Cost, Nat>::operator()(iterator it1, iterator it2) {
-    if (!existing_edge(it1, it2)) {
-        add_edge(it1, it2, infinity);
-    }
+        cost_type total_cost() const;
 
-    return it1->second->get_cost(it2);
-}
+        bool contain(const key_type &key) const;
+    };
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::cost_type &graph<Key, T, Cost, Nat>::operator()(const key_type &k1, const key_type &k2) {
-    iterator it1{add_node(k1).first};
-    iterator it2{add_node(k2).first};
+    class shortest_paths final {
+        friend shortest_paths implicit_graph::dijkstra(const key_type &, std::function<bool(key_type)>) const;
 
-    return operator()(it1, it2);
-}
+        explored _explored;
 
-#if defined(GRAPH_HAS_CPP_17)
-template <class Key, class T, class Cost, Nature Nat>
-std::optional<typename graph<Key, T, Cost, Nat>::cost_type> graph<Key, T, Cost, Nat>::operator()(const_iterator it1, const_iterator it2) const {
-    return existing_edge(it1, it2) ? std::optional<cost_type>(it1->second->get_cost(it2)) : std::nullopt;
-}
+        explicit shortest_paths(explored &&e);
 
-template <class Key, class T, class Cost, Nature Nat>
-std::optional<typename graph<Key, T, Cost, Nat>::cost_type> graph<Key, T, Cost, Nat>::operator()(const key_type &k1, const key_type &k2) const {
-    return operator()(this->find(k1), this->find(k2));
-}
-#else
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::cost_type graph<Key, T, Cost, Nat>::operator()(const_iterator it1, const_iterator it2) const {
-    if (!existing_edge(it1, it2)) {
-        GRAPH_THROW_WITH(invalid_argument, "Unexistant edge")
-    }
+      public:
+        /// @return whether the shortest path to @param key is known
+        bool contain(const key_type &key) const;
 
-    return it1->second->get_cost(it2);
-}
+        /// @return the distance from the start to @param key, or infinity if it is not known
+        cost_type get_distance(const key_type &key) const;
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::cost_type graph<Key, T, Cost, Nat>::operator()(const key_type &k1, const key_type &k2) const {
-    return operator()(this->find(k1), this->find(k2));
-}
-#endif
+        /// @return the re-build path from the start node to @param target, empty if it is not known
+        search_path get_path(const key_type &target) const;
 
-template <class Key, class T, class Cost, Nature Nat>
-std::pair<typename graph<Key, T, Cost, Nat>::iterator, bool> graph<Key, T, Cost, Nat>::insert(const graph<Key, T, cost_type, Nat>::value_type &val) {
-    std::pair<iterator, bool> p{_nodes.insert(val)};
-    p.first->second->set_iterator_values(p.first, end(), cend());
-    return p;
-}
+        /// @return the number of keys discovered by the search, including the ones left in its frontier
+        [[nodiscard]] size_type size() const noexcept;
+    };
+};
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::iterator graph<Key, T, Cost, Nat>::insert(const_iterator position, const value_type &val) {
-    iterator it{_nodes.insert(position, val)};
-    it->second->set_iterator_values(it, end(), cend());
-    return it;
-}
+template <class Data, class Cost, class Container, class constContainer>
+basic_node<Data, Cost, Container, constContainer>::edge::edge(basic_node<Data, Cost, Container, constContainer>* ptr, Cost c) : _target(ptr),
+    _cost(c) {}
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::iterator graph<Key, T, Cost, Nat>::insert(const_iterator position, const key_type &k, graphed_type &x) {
-    return insert(position, std::make_pair(k, std::make_shared<node>(x)));
-}
+template <class Data, class Cost, class Container, class constContainer>
+basic_node<Data, Cost, Container, constContainer>::edge::edge(const edge &e) : _target(e._target), _cost(e._cost), _shared_cost(e._shared_cost),
+    _in_position(e._in_position) {}
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::iterator graph<Key, T, Cost, Nat>::insert(const_iterator position, const key_type &k, const node &n) {
-    return insert(position, std::make_pair(k, std::make_shared<node>(n)));
+template <class Data, class Cost, class Container, class constContainer>
+std::tuple<const Cost&, const basic_node<Data, Cost, Container, constContainer>&> basic_node<Data, Cost, Container, constContainer>::edge::tie() const {
+    return std::tie(cost(), *_target);
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-std::pair<typename graph<Key, T, Cost, Nat>::iterator, bool> graph<Key, T, Cost, Nat>::emplace(const key_type &k) {
-    return emplace(k, node());
+template <class Data, class Cost, class Container, class constContainer>
+bool basic_node<Data, Cost, Container, constContainer>::edge::operator<(const edge &other) const {
+    return tie() < other.tie();
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-std::pair<typename graph<Key, T, Cost, Nat>::iterator, bool> graph<Key, T, Cost, Nat>::emplace(const key_type &k, const graphed_type &x) {
-    return emplace(k, node(x));
+template <class Data, class Cost, class Container, class constContainer>
+bool basic_node<Data, Cost, Container, constContainer>::edge::operator==(const edge &other) const {
+    return tie() == other.tie();
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-std::pair<typename graph<Key, T, Cost, Nat>::iterator, bool> graph<Key, T, Cost, Nat>::emplace(const key_type &k, const node &n) {
-    std::pair<iterator, bool> p{_nodes.emplace(k, std::make_shared<node>(n))};
-    p.first->second->set_iterator_values(p.first, end(), cend());
-    return p;
+template <class Data, class Cost, class Container, class constContainer>
+constContainer basic_node<Data, Cost, Container, constContainer>::edge::target() const {
+    return _target->container_from_this;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-std::pair<typename graph<Key, T, Cost, Nat>::iterator, bool> graph<Key, T, Cost, Nat>::add_node(const key_type &k) {
-    return emplace(k);
+template <class Data, class Cost, class Container, class constContainer>
+Cost & basic_node<Data, Cost, Container, constContainer>::edge::cost() const {
+    return _shared_cost == nullptr ? _cost : *_shared_cost;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-std::pair<typename graph<Key, T, Cost, Nat>::iterator, bool> graph<Key, T, Cost, Nat>::add_node(const key_type &k, const graphed_type &x) {
-    return emplace(k, x);
+template <class Data, class Cost, class Container, class constContainer>
+std::tuple<Data, std::size_t, typename basic_node<Data, Cost, Container, constContainer>::ListEdges> basic_node<Data, Cost, Container, constContainer>::tie() const {
+    return std::tuple<Data, std::size_t, ListEdges>(_data, _in_edges.size(), _out_edges);
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-std::pair<typename graph<Key, T, Cost, Nat>::iterator, bool> graph<Key, T, Cost, Nat>::add_node(const key_type &k, const node &n) {
-    return emplace(k, n);
+template <class Data, class Cost, class Container, class constContainer>
+const typename basic_node<Data, Cost, Container, constContainer>::ListEdges &basic_node<Data, Cost, Container, constContainer>::get_edges() const {
+    return _out_edges;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-bool graph<Key, T, Cost, Nat>::add_edge(const_iterator it1, const_iterator it2, cost_type cost) {
-    std::pair<typename std::list<typename node::edge>::const_iterator, bool> new_edge{it1->second->add_edge(it2, cost)};
+template <class Data, class Cost, class Container, class constContainer>
+constexpr std::size_t basic_node<Data, Cost, Container, constContainer>::edges_index_threshold;
 
-    if (get_nature() == UNDIRECTED) {
-        it2->second->set_edge(it1, new_edge.first->_cost);
+template <class Data, class Cost, class Container, class constContainer>
+std::size_t basic_node<Data, Cost, Container, constContainer>::find_edge(const basic_node *target) const {
+    if (!_edges_index.empty()) {
+        typename EdgesIndex::const_iterator it{_edges_index.find(target)};
+        return it == _edges_index.cend() ? _out_edges.size() : it->second;
     }
 
-    if (new_edge.second) {
-        _num_edges++;
+    /// Few edges: a linear scan over contiguous memory is cheaper than hashing
+    for (std::size_t i{0}; i < _out_edges.size(); ++i) {
+        if (_out_edges[i]._target == target) {
+            return i;
+        }
     }
-
-    return true;
+    return _out_edges.size();
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-bool graph<Key, T, Cost, Nat>::add_edge(const key_type &k1, const key_type &k2, cost_type cost) {
-    return add_edge(emplace(k1).first, emplace(k2).first, cost);
+template <class Data, class Cost, class Container, class constContainer>
+void basic_node<Data, Cost, Container, constContainer>::append_edge(basic_node* target, Cost cost) {
+    _out_edges.emplace_back(target, cost);
+    _out_edges.back()._in_position = target->_in_edges.size();
+    target->_in_edges.push_back(in_edge{this, _out_edges.size() - 1});
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-void graph<Key, T, Cost, Nat>::make_complete(cost_type cost) {
-    clear_edges();
+template <class Data, class Cost, class Container, class constContainer>
+typename basic_node<Data, Cost, Container, constContainer>::EdgesIterator basic_node<Data, Cost, Container, constContainer>::push_edge(basic_node* target, Cost cost) {
+    append_edge(target, cost);
 
-    if (cost != infinity) {
-        for (iterator it1{begin()}; it1 != end(); ++it1) {
-            for (iterator it2{begin()}; it2 != end(); ++it2) {
-                if (it1 != it2) {
-                    add_edge(it1, it2, cost);
-                }
-            }
-        }
+    if (!_edges_index.empty()) {
+        _edges_index.emplace(target, _out_edges.size() - 1);
+    } else if (_out_edges.size() >= edges_index_threshold) {
+        rebuild_edges_index();
     }
-}
-
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::iterator graph<Key, T, Cost, Nat>::erase(const_iterator position) {
-    clear_edges(position);
 
-    return _nodes.erase(position);
+    return --_out_edges.end();
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::iterator graph<Key, T, Cost, Nat>::erase(const_iterator first, const_iterator last) {
-    for (const_iterator it{first}; it != last && it != cend(); ++it) {
-        clear_edges(it);
+template <class Data, class Cost, class Container, class constContainer>
+void basic_node<Data, Cost, Container, constContainer>::erase_edge(std::size_t position) {
+    const bool indexed{!_edges_index.empty()};
+    if (indexed) {
+        _edges_index.erase(_out_edges[position]._target);
     }
+    _out_edges[position]._target->erase_in_edge(_out_edges[position]._in_position);
 
-    return _nodes.erase(first, last);
-}
-
-template <class Key, class T, class Cost, Nature Nat>
-std::size_t graph<Key, T, Cost, Nat>::erase(const key_type &k) {
-    const_iterator it{this->find(k)};
-    if (it == cend()) {
-        return 0;
+    if (position + 1 != _out_edges.size()) {
+        _out_edges[position] = _out_edges.back();
+        _out_edges[position]._target->_in_edges[_out_edges[position]._in_position]._position = position;
+        if (indexed) {
+            _edges_index[_out_edges[position]._target] = position;
+        }
     }
+    _out_edges.pop_back();
 
-    clear_edges(it);
-    return _nodes.erase(k);
+    /// Hysteresis: the index is only dropped well below the threshold
+    if (indexed && _out_edges.size() < edges_index_threshold / 2) {
+        _edges_index.clear();
+    }
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::iterator graph<Key, T, Cost, Nat>::del_node(const_iterator position) {
-    return erase(position);
+template <class Data, class Cost, class Container, class constContainer>
+void basic_node<Data, Cost, Container, constContainer>::rebuild_edges_index() {
+    _edges_index.clear();
+    if (_out_edges.size() >= edges_index_threshold) {
+        _edges_index.reserve(_out_edges.size());
+        for (std::size_t i{0}; i < _out_edges.size(); ++i) {
+            _edges_index.emplace(_out_edges[i]._target, i);
+        }
+    }
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::iterator graph<Key, T, Cost, Nat>::del_nodes(const_iterator first, const_iterator last) {
-    return erase(first, last);
+template <class Data, class Cost, class Container, class constContainer>
+void basic_node<Data, Cost, Container, constContainer>::reserve_edges(std::size_t out_degree, std::size_t in_degree) {
+    _out_edges.reserve(out_degree);
+    _in_edges.reserve(in_degree);
+    /// The buckets are kept while the index is empty, so building it at the threshold does not rehash
+    if (out_degree >= edges_index_threshold) {
+        _edges_index.reserve(out_degree);
+    }
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-std::size_t graph<Key, T, Cost, Nat>::del_node(const key_type &k) {
-    return erase(k);
-}
-template <class Key, class T, class Cost, Nature Nat>
-void graph<Key, T, Cost, Nat>::clear() noexcept {
-    _nodes.clear();
-    _num_edges = 0;
+template <class Data, class Cost, class Container, class constContainer>
+void basic_node<Data, Cost, Container, constContainer>::shrink_to_fit() {
+    _out_edges.shrink_to_fit();
+    _in_edges.shrink_to_fit();
+    if (_edges_index.empty()) {
+        EdgesIndex(_edges_index.get_allocator()).swap(_edges_index);
+    } else {
+        _edges_index.rehash(0);
+    }
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-std::size_t graph<Key, T, Cost, Nat>::del_edge(const_iterator it1, const_iterator it2) {
-    size_type result{0};
-    if (it1 != end() && it2 != end()) {
-        result = static_cast<size_type>(it1->second->del_edge(it2));
-
-        if (get_nature() == UNDIRECTED) {
-            it2->second->del_edge(it1);
-        }
-
-        _num_edges -= result;
+template <class Data, class Cost, class Container, class constContainer>
+void basic_node<Data, Cost, Container, constContainer>::erase_in_edge(std::size_t position) {
+    if (position + 1 != _in_edges.size()) {
+        _in_edges[position] = _in_edges.back();
+        _in_edges[position]._source->_out_edges[_in_edges[position]._position]._in_position = position;
     }
-    return result;
+    _in_edges.pop_back();
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-std::size_t graph<Key, T, Cost, Nat>::del_edge(const key_type &k1, const key_type &k2) {
-    return del_edge(this->find(k1), this->find(k2));
-}
+template <class Data, class Cost, class Container, class constContainer>
+bool basic_node<Data, Cost, Container, constContainer>::set_edge(constContainer other, Cost* shared_cost) {
+    std::pair<basic_node<Data, Cost, Container, constContainer>::EdgesIterator, bool> new_edge{add_edge(other, *shared_cost)};
 
-template <class Key, class T, class Cost, Nature Nat>
-void graph<Key, T, Cost, Nat>::clear_edges() {
-    for (const_iterator it{cbegin()}; it != cend(); ++it) {
-        clear_edges(it);
-    }
-    _num_edges = 0;
+    new_edge.first->_shared_cost = shared_cost;
+
+    return new_edge.second;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-std::size_t graph<Key, T, Cost, Nat>::clear_edges(const_iterator it) {
-    size_type result{0};
-    if (it != cend()) {
-        for (const_iterator it1{cbegin()}; it1 != cend(); ++it1) {
-            del_edge(it1, it);
-        }
+template <class Data, class Cost, class Container, class constContainer>
+basic_node<Data, Cost, Container, constContainer>::basic_node() : basic_node(Data()) {}
 
-        if (get_nature() == DIRECTED) {
-            result += it->second->clear_edges();
-        }
+template <class Data, class Cost, class Container, class constContainer>
+basic_node<Data, Cost, Container, constContainer>::basic_node(const Data &d) : _data(d) {}
 
-        _num_edges -= result;
-    }
-    return result;
-}
+template <class Data, class Cost, class Container, class constContainer>
+basic_node<Data, Cost, Container, constContainer>::basic_node(const Data &d, const EdgesAllocator &alloc) : _out_edges(alloc), _in_edges(alloc),
+    _edges_index(alloc), _data(d) {}
 
-template <class Key, class T, class Cost, Nature Nat>
-std::size_t graph<Key, T, Cost, Nat>::clear_edges(const key_type &k) {
-    return clear_edges(find(k));
-}
+template <class Data, class Cost, class Container, class constContainer>
+basic_node<Data, Cost, Container, constContainer>::basic_node(Data &&d, const EdgesAllocator &alloc) : _out_edges(alloc), _in_edges(alloc),
+    _edges_index(alloc), _data(std::move(d)) {}
 
-template <class Key, class T, class Cost, Nature Nat>
-void graph<Key, T, Cost, Nat>::swap(graph &other) noexcept {
-    std::swap(_nodes,     other._nodes);
-    std::swap(_num_edges, other._num_edges);
+template <class Data, class Cost, class Container, class constContainer>
+basic_node<Data, Cost, Container, constContainer>::basic_node(const basic_node &n) {
+    *this = n;
 }
 
-namespace std {
-    template <class Key, class T, class Cost, Nature Nat>
-    void swap(graph<Key, T, Cost, Nat> &g1, graph<Key, T, Cost, Nat> &g2) noexcept {
-        g1.swap(g2);
+template <class Data, class Cost, class Container, class constContainer>
+basic_node<Data, Cost, Container, constContainer> &basic_node<Data, Cost, Container, constContainer>::operator=(const basic_node &n) {
+    if (this == &n) {
+        return *this;
     }
-}
 
-template <class Key, class T, class Cost, Nature Nat>
-std::size_t graph<Key, T, Cost, Nat>::count(const key_type &k) const {
-    return _nodes.count(k);
-}
+    /// Only the data is copied: the edges belong to the graph, which links the copy itself
+    _data = n._data;
+    container_from_this = n.container_from_this;
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::iterator graph<Key, T, Cost, Nat>::find(const key_type &k) {
-    return _nodes.find(k);
+    return *this;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::const_iterator graph<Key, T, Cost, Nat>::find(const key_type &k) const {
-    return _nodes.find(k);
-}
+template <class Data, class Cost, class Container, class constContainer>
+basic_node<Data, Cost, Container, constContainer>::~basic_node() = default;
 
-template <class Key, class T, class Cost, Nature Nat>
-bool graph<Key, T, Cost, Nat>::existing_node(const_iterator it) const {
-    return it != cend();
+template <class Data, class Cost, class Container, class constContainer>
+Data & basic_node<Data, Cost, Container, constContainer>::get() {
+    return _data;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-bool graph<Key, T, Cost, Nat>::existing_node(const key_type &k) const {
-    return existing_node(find(k));
+template <class Data, class Cost, class Container, class constContainer>
+Data basic_node<Data, Cost, Container, constContainer>::get() const {
+    return _data;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-bool graph<Key, T, Cost, Nat>::existing_edge(const_iterator it1, const_iterator it2) const {
-    if (it1 != cend() && it2 != cend()) {
-        if (get_nature() == DIRECTED) {
-            return it1->second->existing_adjacent_node(it2);
-        }
-        return it1->second->existing_adjacent_node(it2) && it2->second->existing_adjacent_node(it1);
+template <class Data, class Cost, class Container, class constContainer>
+Cost & basic_node<Data, Cost, Container, constContainer>::get_cost(Container other) {
+    basic_node<Data, Cost, Container, constContainer>* ptr{detail::get_pointer(other, end_container)};
+
+    if (ptr == nullptr) {
+        GRAPH_THROW(unexpected_nullptr)
     }
 
-    return false;
-}
+    const std::size_t position{find_edge(ptr)};
+    if (position != _out_edges.size()) {
+        return _out_edges[position].cost();
+    }
 
-template <class Key, class T, class Cost, Nature Nat>
-bool graph<Key, T, Cost, Nat>::existing_edge(const key_type &k1, const key_type &k2) const {
-    return existing_edge(this->find(k1), this->find(k2));
+    /// Link doesn't exist
+    return push_edge(ptr, infinity)->cost();
 }
-template <class Key, class T, class Cost, Nature Nat>
-bool graph<Key, T, Cost, Nat>::has_path_connecting(const_iterator from, const_iterator to) const {
-    if (from == cend() || to == cend()) {
+
+template <class Data, class Cost, class Container, class constContainer>
+Cost basic_node<Data, Cost, Container, constContainer>::get_cost(constContainer other) const {
+    basic_node<Data, Cost, Container, constContainer>* ptr{detail::get_pointer(other, cend_container)};
+
+    if (ptr == nullptr) {
         GRAPH_THROW(unexpected_nullptr)
     }
-    if (from == to) {
-        return true;
+
+    const std::size_t position{find_edge(ptr)};
+    if (position != _out_edges.size()) {
+        return _out_edges[position].cost();
     }
-    return !dfs(from, to).empty();
-}
 
-template <class Key, class T, class Cost, Nature Nat>
-bool graph<Key, T, Cost, Nat>::has_path_connecting(const key_type &from, const key_type &to) const {
-    return has_path_connecting(this->find(from), this->find(to));
+    /// Link doesn't exist
+    return infinity;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-std::size_t graph<Key, T, Cost, Nat>::get_nbr_nodes() const noexcept {
-    return _nodes.size();
+template <class Data, class Cost, class Container, class constContainer>
+Cost & basic_node<Data, Cost, Container, constContainer>::operator[](Container other) {
+    return get_cost(other);
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-std::size_t graph<Key, T, Cost, Nat>::get_nbr_edges() const noexcept {
-    return _num_edges;
+template <class Data, class Cost, class Container, class constContainer>
+Cost basic_node<Data, Cost, Container, constContainer>::operator[](constContainer other) const {
+    return get_cost(other);
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-Nature graph<Key, T, Cost, Nat>::get_nature() const {
-    return Nat;
+template <class Data, class Cost, class Container, class constContainer>
+template <class T_data>
+void basic_node<Data, Cost, Container, constContainer>::set(const T_data &d) {
+    _data = static_cast<Data>(d);
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::Degree graph<Key, T, Cost, Nat>::degree(const_iterator position) const {
-    if (get_nature() == DIRECTED) {
-        return position == cend() ? Degree::min() : Degree(position->second->degree().first, position->second->degree().second);
+template <class Data, class Cost, class Container, class constContainer>
+template <class T_cost>
+void basic_node<Data, Cost, Container, constContainer>::set_cost(Container other, const T_cost &c) {
+    basic_node<Data, Cost, Container, constContainer>* ptr{detail::get_pointer(other, end_container)};
+
+    if (ptr == nullptr) {
+        GRAPH_THROW(unexpected_nullptr)
     }
-    return position == cend() ? Degree::min() : Degree(position->second->degree().first, 0);
+
+    this->add_edge(other, static_cast<Cost>(c));
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::Degree graph<Key, T, Cost, Nat>::degree(const key_type &k) const {
-    return degree(find(k));
+template <class Data, class Cost, class Container, class constContainer>
+bool basic_node<Data, Cost, Container, constContainer>::del_edge(constContainer other) {
+    return del_edge_if(other, [](const edge &) {
+        return true;
+    } );
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-std::pair<typename graph<Key, T, Cost, Nat>::const_iterator, typename graph<Key, T, Cost, Nat>::Degree> graph<Key, T, Cost, Nat>::degree_max() const {
-    if (empty()) {
-        return std::make_pair(cend(), Degree::min());
+template <class Data, class Cost, class Container, class constContainer>
+bool basic_node<Data, Cost, Container, constContainer>::del_edge_if(constContainer other, std::function<bool(const edge &)> predicate) {
+    basic_node<Data, Cost, Container, constContainer>* ptr{detail::get_pointer(other, cend_container)};
+    if (ptr == nullptr) {
+        return false;
     }
 
-    Degree max{Degree::min()};
-    const_iterator cit;
-
-    for (const_iterator it{cbegin()}; it != cend(); ++it) {
-        Degree tmp{degree(it)};
-        if (max < tmp) {
-            max = tmp;
-            cit = it;
-        }
+    const std::size_t position{find_edge(ptr)};
+    if (position == _out_edges.size() || !predicate(_out_edges[position])) {
+        return false;
     }
 
-    return std::make_pair(cit, max);
+    erase_edge(position);
+    return true;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-std::pair<typename graph<Key, T, Cost, Nat>::const_iterator, typename graph<Key, T, Cost, Nat>::Degree> graph<Key, T, Cost, Nat>::degree_min() const {
-    if (empty()) {
-        return std::make_pair(cend(), Degree::min());
-    }
-
-    Degree min{Degree::max()};
-    const_iterator cit;
+template <class Data, class Cost, class Container, class constContainer>
+std::size_t basic_node<Data, Cost, Container, constContainer>::clear_edges() {
+    const std::size_t NUM{_out_edges.size()};
 
-    for (const_iterator it{cbegin()}; it != cend(); ++it) {
-        Degree tmp{degree(it)};
-        if (tmp < min) {
-            min = tmp;
-            cit = it;
-        }
+    for (EdgesIterator it{_out_edges.begin()}; it != _out_edges.end(); ++it) {
+        it->_target->erase_in_edge(it->_in_position);
     }
+    _out_edges.clear();
+    _edges_index.clear();
 
-    return std::make_pair(cit, min);
+    return NUM;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-std::map<Key, typename graph<Key, T, Cost, Nat>::Degree> graph<Key, T, Cost, Nat>::degrees() const {
-    std::map<key_type, Degree> result;
-
-    for (const_iterator it{cbegin()}; it != cend(); ++it) {
-        result.insert(std::make_pair(it->first, degree(it)));
-    }
-
-    return result;
+template <class Data, class Cost, class Container, class constContainer>
+std::pair<std::size_t, std::size_t> basic_node<Data, Cost, Container, constContainer>::degree() const {
+    return std::make_pair(_in_edges.size(), _out_edges.size());
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-template <class>
-std::vector<typename graph<Key, T, Cost, Nat>::node::edge> graph<Key, T, Cost, Nat>::get_in_edges(const_iterator to) const {
-    std::vector<typename node::edge> result;
+template <class Data, class Cost, class Container, class constContainer>
+bool basic_node<Data, Cost, Container, constContainer>::existing_adjacent_node(constContainer other) const {
+    basic_node<Data, Cost, Container, constContainer>* ptr{detail::get_pointer(other, cend_container)};
 
-    for (const_iterator it{cbegin()}; it != cend(); ++it) {
-        if (it != to) {
-            for (typename node::edge e : it->second->_out_edges) {
-                if (e.target() == to) {
-                    result.push_back(e);
-                }
-            }
-        }
+    if (ptr == nullptr) {
+        return false;
     }
 
-    return result;
+    return find_edge(ptr) != _out_edges.size();
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-template <class>
-std::vector<typename graph<Key, T, Cost, Nat>::node::edge> graph<Key, T, Cost, Nat>::get_in_edges(const key_type &to) const {
-    return get_in_edges(find(to));
+template <class Data, class Cost, class Container, class constContainer>
+constexpr bool operator==(const basic_node<Data, Cost, Container, constContainer> &n1, const basic_node<Data, Cost, Container, constContainer> &n2) noexcept {
+    return n1.tie() == n2.tie();
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-template <class>
-std::vector<typename graph<Key, T, Cost, Nat>::node::edge> graph<Key, T, Cost, Nat>::get_out_edges(const_iterator from) const {
-    return std::vector<typename node::edge>(from->second->_out_edges.begin(), from->second->_out_edges.end());
+template <class Data, class Cost, class Container, class constContainer>
+constexpr bool operator!=(const basic_node<Data, Cost, Container, constContainer> &n1, const basic_node<Data, Cost, Container, constContainer> &n2) noexcept {
+    return !(n1 == n2);
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-template <class>
-std::vector<typename graph<Key, T, Cost, Nat>::node::edge> graph<Key, T, Cost, Nat>::get_out_edges(const key_type &from) const {
-    return get_out_edges(find(from));
+template <class Data, class Cost, class Container, class constContainer>
+constexpr bool operator<(const basic_node<Data, Cost, Container, constContainer> &n1, const basic_node<Data, Cost, Container, constContainer> &n2) noexcept {
+    return n1.tie() < n2.tie();
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-template <class>
-std::vector<typename graph<Key, T, Cost, Nat>::node::edge> graph<Key, T, Cost, Nat>::get_edges(const_iterator i) const {
-    return std::vector<typename node::edge>(i->second->_out_edges.begin(), i->second->_out_edges.end());
+template <class Data, class Cost, class Container, class constContainer>
+constexpr bool operator>(const basic_node<Data, Cost, Container, constContainer> &n1, const basic_node<Data, Cost, Container, constContainer> &n2) noexcept {
+    return n2 < n1;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-template <class>
-std::vector<typename graph<Key, T, Cost, Nat>::node::edge> graph<Key, T, Cost, Nat>::get_edges(const key_type &i) const {
-    return get_edges(find(i));
+template <class Data, class Cost, class Container, class constContainer>
+constexpr bool operator<=(const basic_node<Data, Cost, Container, constContainer> &n1, const basic_node<Data, Cost, Container, constContainer> &n2) noexcept {
+    return !(n2 < n1);
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-template <class>
-bool graph<Key, T, Cost, Nat>::is_cyclic() const {
-    for (const_iterator it{cbegin()}; it != cend(); ++it) {
-        std::list<const_iterator> initPath;
-        if (is_cyclic_rec(it, initPath)) {
-            return true;
-        }
-    }
-    return false;
+template <class Data, class Cost, class Container, class constContainer>
+constexpr bool operator>=(const basic_node<Data, Cost, Container, constContainer> &n1, const basic_node<Data, Cost, Container, constContainer> &n2) noexcept {
+    return !(n1 < n2);
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-bool graph<Key, T, Cost, Nat>::is_cyclic_rec(const_iterator current, std::list<const_iterator> path) const {
-    for (const_iterator it : path) {
-        if (it == current && (get_nature() == DIRECTED || path.back() != current)) {
-            return true;
-        }
-    }
-    /*if (std::find(path.cbegin(), path.cend(), current) != path.cend()) {
-        return true;
-    }*/
-
-    path.push_back(current);
-    std::vector<typename node::edge> adjacent;
-    if (get_nature() == DIRECTED) {
-        adjacent = get_out_edges(current);
-    } else {
-        adjacent = get_edges(current);
-    }
-
-    for (typename std::vector<typename node::edge>::const_iterator it{adjacent.cbegin()}; it != adjacent.cend(); ++it) {
-        if (is_cyclic_rec(it->target(), path)) {
-            return true;
-        }
-        path.remove(it->target());
-    }
+#include <memory>
+#include <set>
 
-    return false;
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::iterator graph<Key, T, Cost, Nat, Index>::begin() noexcept {
+    return _nodes.begin();
 }
 
-/*
-template <class Key, class T, class Cost, Nature Nat>
-bool graph<Key, T, Cost, Nat>::is_isomorphic() const {
-    // TODO
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::iterator graph<Key, T, Cost, Nat, Index>::end() noexcept {
+    return _nodes.end();
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-std::vector<typename graph<Key, T, Cost, Nat>::const_iterator> graph<Key, T, Cost, Nat>::toposort() const {
-    // TODO
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::const_iterator graph<Key, T, Cost, Nat, Index>::begin() const noexcept {
+    return _nodes.begin();
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-std::set<std::vector<typename graph<Key, T, Cost, Nat>::const_iterator>, typename graph<Key, T, Cost, Nat>::iterator_comparator> graph<Key, T, Cost, Nat>::kosaraju_scc() const {
-    // TODO
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::const_iterator graph<Key, T, Cost, Nat, Index>::cbegin() const noexcept {
+    return _nodes.cbegin();
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-std::set<std::vector<typename graph<Key, T, Cost, Nat>::const_iterator>, typename graph<Key, T, Cost, Nat>::iterator_comparator> graph<Key, T, Cost, Nat>::tarjan_scc() const {
-    // TODO
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::const_iterator graph<Key, T, Cost, Nat, Index>::end() const noexcept {
+    return _nodes.end();
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-std::size_t graph<Key, T, Cost, Nat>::connected_components() const {
-    // TODO
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::const_iterator graph<Key, T, Cost, Nat, Index>::cend() const noexcept {
+    return _nodes.cend();
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-graph<Key, T, Cost, Nat> &graph<Key, T, Cost, Nat>::condensate(bool make_acyclic) {
-    // TODO
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::reverse_iterator graph<Key, T, Cost, Nat, Index>::rbegin() noexcept {
+    return _nodes.rbegin();
 }
-*/
 
-//template <class Key, class T, class Cost, Nature Nat>
-//std::vector<typename graph<Key, T, Cost, Nat>::const_iterator> graph<Key, T, Cost, Nat>::maximum_clique() const {
-// TODO: fix the bug
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::reverse_iterator graph<Key, T, Cost, Nat, Index>::rend() noexcept {
+    return _nodes.rend();
+}
 
-/*
-std::function<size_type(const_iterator)> heuristic = [](const_iterator it) -> size_type { return it->second->degree().first; };
-std::function<size_type(const_iterator, const_iterator)> comparator = [&heuristic](const_iterator it1, const_iterator it2) -> size_type { return heuristic(it1) > heuristic(it2); };
-std::list<const_iterator> Q;
-for (const_iterator it{cbegin()}; it != cend(); ++it) {
-    Q.emplace_back(it);
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::const_reverse_iterator graph<Key, T, Cost, Nat, Index>::rbegin() const noexcept {
+    return _nodes.rbegin();
 }
-//std::copy(cbegin(), cend(), std::back_inserter(Q));
-Q.sort(comparator);
 
-std::vector<const_iterator> result;
-std::function<size_type()> calculate_max_size = [&Q, &heuristic]() -> size_type {
-    for (size_type degree{heuristic(*Q.cbegin())}; degree > 0; --degree) {
-        if (std::count_if(Q.cbegin(), Q.cend(), [degree, &heuristic](const_iterator it) -> bool {
-        return heuristic(it) >= degree;
-        }) >= degree) {
-            return degree + 1;
-        }
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::const_reverse_iterator graph<Key, T, Cost, Nat, Index>::crbegin() const noexcept {
+    return _nodes.crbegin();
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::const_reverse_iterator graph<Key, T, Cost, Nat, Index>::rend() const noexcept {
+    return _nodes.rend();
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::const_reverse_iterator graph<Key, T, Cost, Nat, Index>::crend() const noexcept {
+    return _nodes.crend();
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+graph<Key, T, Cost, Nat, Index>::graph() {
+    _nodes.clear();
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+graph<Key, T, Cost, Nat, Index>::graph(const allocator_type &alloc)
+    : _nodes(alloc)
+    , _shared_costs(alloc)
+    , _free_costs(alloc)
+    , _free_indices(alloc) {}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+graph<Key, T, Cost, Nat, Index>::graph(std::istream &is) {
+    is >> *this;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+graph<Key, T, Cost, Nat, Index>::graph(const graph &other) {
+    *this = other;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+graph<Key, T, Cost, Nat, Index>::graph(graph &&other) noexcept
+    : _nodes(std::move(other._nodes))
+    , _num_edges(other._num_edges)
+    , _shared_costs(std::move(other._shared_costs))
+    , _free_costs(std::move(other._free_costs))
+    , _indices_bound(other._indices_bound)
+    , _free_indices(std::move(other._free_indices))
+    , _published(other._published)
+    , _version(other._version) {
+    other._num_edges     = 0;
+    other._indices_bound = 0;
+    other._free_indices.clear();
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+graph<Key, T, Cost, Nat, Index> &graph<Key, T, Cost, Nat, Index>::operator=(const graph &other) {
+    if (this == &other) {
+        return *this;
     }
-    return 0;
-};
-size_type max_size{calculate_max_size()};
+    clear();
 
-while (!Q.empty() && result.size() <= max_size) {
-    // DEBUG
-    std::cout << "Values inside Q: ";
-    for (const_iterator I : Q) {
-        std::cout << I->first << " ";
+    /// Structural copy in O(V + E): the nodes are appended in the iteration order of the other graph, and each
+    /// edge is pushed to its remapped target, with no lookup of the keys
+    using basic_node_type = typename node::basic_node;
+    std::vector<size_type> positions(other._indices_bound, other.size());
+    std::vector<basic_node_type*> copies;
+    copies.reserve(other.size());
+    detail::reserve(_nodes, other.size());
+    for (const_iterator it{other.cbegin()}; it != other.cend(); ++it) {
+        iterator copy{_nodes.insert(_nodes.cend(), value_type(it->first, new_node(it->second->get())))};
+        attach_node(copy);
+        copy->second->reserve_edges(it->second->_out_edges.size(), it->second->_in_edges.size());
+        positions[index_of(it->second.get())] = copies.size();
+        copies.push_back(copy->second.get());
     }
-    std::cout << std::endl;
 
-    const_iterator N{*Q.cbegin()};
-    // DEBUG
-    std::cout << "N: " << N->first << std::endl;
-    std::vector<const_iterator> current_clique({N});
+    size_type i{0};
+    for (const_iterator it{other.cbegin()}; it != other.cend(); ++it, ++i) {
+        for (const typename node::edge &e : it->second->_out_edges) {
+            const size_type j{positions[index_of(e._target)]};
+            typename node::EdgesIterator pushed{copies[i]->push_edge(copies[j], e.cost())};
 
-    // TODO: loop until neighbors of N { for each neighbor of N inside of Q { . . . }; };
-    std::vector<typename node::edge> adj{get_out_edges(N)};
-    for (typename std::vector<typename node::edge>::const_iterator edge{adj.cbegin()}; edge != adj.cend(); ++edge) {
-        // DEBUG
-        std::cout << "Values inside current_clique: ";
-        for (const_iterator I : current_clique) {
-            std::cout << I->first << " ";
+            /// UNDIRECTED: the opposite edge was already copied with its target; it shares its slot
+            if (e._shared_cost != nullptr) {
+                pushed->_shared_cost = j < i ? copies[j]->_out_edges[copies[j]->find_edge(copies[i])]._shared_cost : acquire_shared_cost(e.cost());
+            }
         }
-        std::cout << std::endl;
+    }
+    _num_edges = other._num_edges;
 
-        const_iterator X{edge->target()};
-        if (std::find(Q.cbegin(), Q.cend(), X) == Q.cend()) {
-            continue;
-        }
+    /// The snapshots are immutable: the copy shares them
+    _published = other._published;
+    _version   = other._version;
 
-        bool part_of_clique{true};
-        for (const_iterator it : current_clique) {
-            if (!existing_edge(it, X)) {
-                part_of_clique = false;
-                break;
-            }
-        }
-        if (part_of_clique) {
-            current_clique.push_back(X);
-        } else {
-            if (result.size() < current_clique.size()) {
-                result = current_clique;
-                // DEBUG
-                std::cout << "new clique discovered: size of " << result.size() << std::endl;
-            }
-            Q.remove(N);
+    return *this;
+}
 
-            std::function<bool(const_iterator)> PAF = [&result, &heuristic](const_iterator it) -> bool {
-                return heuristic(it) < result.size();
-            };
-            Q.erase(std::remove_if(Q.begin(), Q.end(), PAF), Q.cend());
-            max_size = calculate_max_size();
-        }
+template <class Key, class T, class Cost, Nature Nat, class Index>
+graph<Key, T, Cost, Nat, Index> &graph<Key, T, Cost, Nat, Index>::operator=(graph&& other) noexcept(std::allocator_traits<allocator_type>::is_always_equal::value) {
+    // Handle self-assignment
+    if (this != &other && get_allocator() != other.get_allocator()) {
+        /// The elements would be moved one by one to the other resource, invalidating the iterators kept by the nodes
+        *this = other;
+        other.clear();
+    } else if (this != &other) {
+        //swap(other);
+        // Move the resources directly for better performance
+        _nodes = std::move(other._nodes);
+        _num_edges = other._num_edges;
+        _shared_costs = std::move(other._shared_costs);
+        _free_costs = std::move(other._free_costs);
+        _indices_bound = other._indices_bound;
+        _free_indices = std::move(other._free_indices);
+        _published = other._published;
+        _version = other._version;
+
+        // Reset the moved-from object to a valid state
+        other._num_edges = 0;
+        other._indices_bound = 0;
+        other._free_indices.clear();
     }
-    // DEBUG
-    std::cout << std::endl;
+    return *this;
 }
-return result;
-
-// candidates <- sort each node in function of its degree
-// max clique size <= degree_max() + 1
 
-// current_clique_size = 0
-// result = null
-// for each node N in candidates
-//      current_clique = {N}
-//      for each neighbor X of N ordered by its degree
-//              if (X linked with all nodes of current_clique) then
-//                      current_clique += {X}
-//              else
-//                      if (result.size < current_clique.size)
-//                              result = current_clique
-//                      candidates -= {N}
-//                      for each node M in candidates
-//                              if (M.degree <= result.size)
-//                                      candidates -= {M}
+template <class Key, class T, class Cost, Nature Nat, class Index>
+graph<Key, T, Cost, Nat, Index>::~graph() = default;
 
-// clique = NULL
-// candidate = X (nodes of graph / candidate != NULL do
-//                                      choose xi wih degree max
-//                                      clique <- clique U {xi}
-//                                      candidate <- candidats ∧ { xj / (xj, xi) € A} (intersection of candidate and neighbors of xi)
-*/
-//}
+template <class Key, class T, class Cost, Nature Nat, class Index>
+bool graph<Key, T, Cost, Nat, Index>::empty() const noexcept {
+    return _nodes.empty();
+}
 
-template <class Key, class T, class Cost, Nature Nat>
-std::ostream &operator<<(std::ostream &os, const graph<Key, T, Cost, Nat> &g) {
-    return os << *g.generate_grp() << std::endl;
-    //return os << std::setw(4) << *g.generate_json() << std::endl;
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::size() const noexcept {
+    return _nodes.size();
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-std::istream &operator>>(std::istream &is, graph<Key, T, Cost, Nat> &g) {
-    GRAPH_TRY {
-        g.parse_from_grp(is);
-    } GRAPH_CATCH (...) {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::max_size() const noexcept {
+    return _nodes.max_size();
+}
 
-        GRAPH_THROW_WITH(parse_error, 0, "istream corrupted, fail to parse the graph")
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::reserve_nodes(size_type n) {
+    detail::reserve(_nodes, n);
+}
 
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::reserve_edges(const_iterator position, size_type degree) {
+    if (position != cend()) {
+        position->second->reserve_edges(degree, directed_tag::value ? position->second->_in_edges.size() : degree);
     }
+}
 
-    return is;
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::reserve_edges(const key_type &k, size_type degree) {
+    reserve_edges(emplace(k).first, degree);
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-void graph<Key, T, Cost, Nat>::load(const char* filename) {
-    const char* dot = strrchr(filename, '.');
-    std::string extension;
-    if (dot != nullptr && dot != filename) {
-        extension = dot + 1;
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::shrink_to_fit() {
+    detail::shrink_to_fit(_nodes);
+    for (const_iterator it{cbegin()}; it != cend(); ++it) {
+        it->second->shrink_to_fit();
     }
 
-    std::ifstream in(filename);
-    if (!in) {
-        GRAPH_THROW_WITH(invalid_argument, ("Unexistant file: '" + std::string(filename) + "'").c_str())
+    /// The released cost slots are given back by moving the live ones into a new pool
+    if (!_free_costs.empty()) {
+        std::deque<Cost, detail::allocator<Cost>> shared_costs(get_allocator());
+        for (const_iterator it{cbegin()}; it != cend(); ++it) {
+            typename node::basic_node* const u{it->second.get()};
+            for (typename node::edge &e : u->_out_edges) {
+                /// Each pair of directions is visited once, from its lowest node
+                if (e._shared_cost != nullptr && !std::less<typename node::basic_node*>()(e._target, u)) {
+                    shared_costs.push_back(*e._shared_cost);
+                    if (e._target != u) {
+                        e._target->_out_edges[e._target->find_edge(u)]._shared_cost = &shared_costs.back();
+                    }
+                    e._shared_cost = &shared_costs.back();
+                }
+            }
+        }
+        _shared_costs = std::move(shared_costs);
+        std::vector<Cost*, detail::allocator<Cost*>>(get_allocator()).swap(_free_costs);
     }
 
-    if (extension == "json") {
-        parse_from_json(in);
-    } else if (extension == "dot") {
-        GRAPH_THROW_WITH(invalid_argument, "Load from DOT file non supported yet")
-    } else {
-        GRAPH_TRY {
-            parse_from_grp(in);
-        } GRAPH_CATCH (exception & e) {
-            std::cerr << "Fail to load the file '" << filename << "'; wrong extension or corrupted file." << std::endl;
+    /// The dense indices are renumbered, so that the arrays of the search algorithms fit the number of nodes
+    if (!_free_indices.empty()) {
+        _indices_bound = 0;
+        for (const_iterator it{cbegin()}; it != cend(); ++it) {
+            it->second->_index = _indices_bound++;
         }
+        std::vector<std::size_t, detail::allocator<std::size_t>>(get_allocator()).swap(_free_indices);
     }
-    in.close();
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-std::unique_ptr<std::string> graph<Key, T, Cost, Nat>::generate_dot(const std::string &graph_name) const {
-    std::string dot;
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::allocator_type graph<Key, T, Cost, Nat, Index>::get_allocator() const noexcept {
+    return _nodes.get_allocator();
+}
 
-    const std::string tab{"    "};
+template <class Key, class T, class Cost, Nature Nat, class Index>
+T &graph<Key, T, Cost, Nat, Index>::operator[](const key_type &k) {
+    return add_node(k).first->second->get();
+}
 
-    /// Displaying nature + graph name
-    if (graph_name.find_first_not_of("abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789_-") != std::string::npos) {
-        GRAPH_THROW_WITH(invalid_argument, "Wrong graph name given; accepted characters: [a-zA-Z0-9_-]")
-    }
+template <class Key, class T, class Cost, Nature Nat, class Index>
+T &graph<Key, T, Cost, Nat, Index>::operator[](key_type &&k) {
+    return try_emplace(std::move(k)).first->second->get();
+}
 
-    if (get_nature() == DIRECTED) {
-        dot += "di";
-    }
-    dot += "graph ";
-    if (!graph_name.empty()) {
-        dot += graph_name + " ";
+#if defined(GRAPH_HAS_CPP_17)
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::optional<T> graph<Key, T, Cost, Nat, Index>::operator[](key_type &&k) const {
+    const_iterator it{this->find(k)};
+    return it == cend() ? std::nullopt : std::optional<T>(it->second->get());
+}
+#else
+template <class Key, class T, class Cost, Nature Nat, class Index>
+T graph<Key, T, Cost, Nat, Index>::operator[](key_type &&k) const {
+    const_iterator it{this->find(k)};
+    if (it == cend()) {
+        GRAPH_THROW_WITH(invalid_argument, "Unexistant node")
     }
-    dot += "{\n";
 
-    /// Displaying nodes' name
-    for (const_iterator it{cbegin()}; it != cend(); ++it) {
-        std::stringstream ss;
-        ss << it->first;
-        dot += tab + ss.str() + "\n";
+    return it->second->get();
+}
+#endif
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::cost_type &graph<Key, T, Cost, Nat, Index>::operator()(iterator it1, iterator it2) {
+    if (!existing_edge(it1, it2)) {
+        add_edge(it1, it2, infinity);
     }
 
-    if (get_nature() == DIRECTED) {
-        for_each(cbegin(), cend(), [this, &dot, tab](const value_type & element) {
-            std::list<typename node::edge> child{element.second->get_edges()};
-            for_each(child.cbegin(), child.cend(), [this, &dot, tab, &element](const typename node::edge & i) {
-                if (i.cost() != infinity) {
-                    std::stringstream ss;
-                    ss << tab << element.first << " -> " << i.target()->first << '\n';
-                    dot += ss.str();
-                }
-            });
-        });
-    } else {
-        std::set<std::pair<Key, Key >> list_edges;
-        for_each(cbegin(), cend(), [this, &dot, &list_edges](const value_type & element) {
-            std::list<typename node::edge> child{element.second->get_edges()};
-            for_each(child.cbegin(), child.cend(), [&dot, &list_edges, &element](const typename node::edge & i) {
-                const Key min{std::min(element.first, i.target()->first)};
-                const Key max{std::max(element.first, i.target()->first)};
-                list_edges.emplace(std::make_pair(min, max));
-            });
-        });
+    return it1->second->get_cost(it2);
+}
 
-        for_each(list_edges.cbegin(), list_edges.cend(), [&dot, tab](const std::pair<Key, Key> &p) {
-            std::stringstream ss;
-            ss << tab << p.first << " -- " << p.second << '\n';
-            dot += ss.str();
-        });
-    }
-    dot += '}';
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::cost_type &graph<Key, T, Cost, Nat, Index>::operator()(const key_type &k1, const key_type &k2) {
+    iterator it1{add_node(k1).first};
+    iterator it2{add_node(k2).first};
 
-    return std::make_unique<std::string>(std::forward<std::string>(dot));
+    return operator()(it1, it2);
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-void graph<Key, T, Cost, Nat>::save_to_dot(const char* filename, const std::string &graph_name) const {
-    std::ofstream out(filename);
-    out << *generate_dot(graph_name) << std::endl;
-    out.close();
+#if defined(GRAPH_HAS_CPP_17)
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::optional<typename graph<Key, T, Cost, Nat, Index>::cost_type> graph<Key, T, Cost, Nat, Index>::operator()(const_iterator it1, const_iterator it2) const {
+    return existing_edge(it1, it2) ? std::optional<cost_type>(it1->second->get_cost(it2)) : std::nullopt;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-std::unique_ptr<nlohmann::json> graph<Key, T, Cost, Nat>::generate_json() const {
-    nlohmann::json json;
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::optional<typename graph<Key, T, Cost, Nat, Index>::cost_type> graph<Key, T, Cost, Nat, Index>::operator()(const key_type &k1, const key_type &k2) const {
+    return operator()(this->find(k1), this->find(k2));
+}
+#else
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::cost_type graph<Key, T, Cost, Nat, Index>::operator()(const_iterator it1, const_iterator it2) const {
+    if (!existing_edge(it1, it2)) {
+        GRAPH_THROW_WITH(invalid_argument, "Unexistant edge")
+    }
 
-    using Set = std::list<typename node::edge>;
+    return it1->second->get_cost(it2);
+}
 
-    json["nature"] = get_nature();
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::cost_type graph<Key, T, Cost, Nat, Index>::operator()(const key_type &k1, const key_type &k2) const {
+    return operator()(this->find(k1), this->find(k2));
+}
+#endif
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::pair<typename graph<Key, T, Cost, Nat, Index>::iterator, bool> graph<Key, T, Cost, Nat, Index>::insert(const graph<Key, T, cost_type, Nat, Index>::value_type &val) {
+    std::pair<iterator, bool> p{_nodes.insert(val)};
+    if (p.second) {
+        attach_node(p.first);
+    }
+    return p;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::iterator graph<Key, T, Cost, Nat, Index>::insert(const_iterator position, const value_type &val) {
+    const size_type old_size{size()};
+    iterator it{_nodes.insert(position, val)};
+    if (size() != old_size) {
+        attach_node(it);
+    }
+    return it;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::iterator graph<Key, T, Cost, Nat, Index>::insert(const_iterator position, const key_type &k, graphed_type &x) {
+    return insert(position, std::make_pair(k, new_node(x)));
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::iterator graph<Key, T, Cost, Nat, Index>::insert(const_iterator position, const key_type &k, const node &n) {
+    iterator it{_nodes.find(k)};
+    if (it != end()) {
+        return it;
+    }
+
+    it = _nodes.insert(position, std::make_pair(k, new_node(n.get())));
+    attach_node(it);
+    copy_edges(it, n);
+    return it;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::pair<typename graph<Key, T, Cost, Nat, Index>::iterator, bool> graph<Key, T, Cost, Nat, Index>::emplace(const key_type &k) {
+    return try_emplace(k);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::pair<typename graph<Key, T, Cost, Nat, Index>::iterator, bool> graph<Key, T, Cost, Nat, Index>::emplace(const key_type &k, const graphed_type &x) {
+    return try_emplace(k, x);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::pair<typename graph<Key, T, Cost, Nat, Index>::iterator, bool> graph<Key, T, Cost, Nat, Index>::emplace(const key_type &k, const node &n) {
+    std::pair<iterator, bool> p{try_emplace(k, n.get())};
+    if (p.second) {
+        copy_edges(p.first, n);
+    }
+    return p;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::pair<typename graph<Key, T, Cost, Nat, Index>::iterator, bool> graph<Key, T, Cost, Nat, Index>::emplace(key_type &&k, graphed_type &&x) {
+    return try_emplace(std::move(k), std::move(x));
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+template <class... Args>
+std::pair<typename graph<Key, T, Cost, Nat, Index>::iterator, bool> graph<Key, T, Cost, Nat, Index>::try_emplace(const key_type &k, Args &&... args) {
+    /// Looked up first: an existing node costs no allocation
+    iterator it{_nodes.find(k)};
+    if (it != end()) {
+        return std::make_pair(it, false);
+    }
+
+    graphed_type data(std::forward<Args>(args)...);
+    std::pair<iterator, bool> p{_nodes.emplace(k, new_node(std::move(data)))};
+    attach_node(p.first);
+    return p;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+template <class... Args>
+std::pair<typename graph<Key, T, Cost, Nat, Index>::iterator, bool> graph<Key, T, Cost, Nat, Index>::try_emplace(key_type &&k, Args &&... args) {
+    iterator it{_nodes.find(k)};
+    if (it != end()) {
+        return std::make_pair(it, false);
+    }
+
+    graphed_type data(std::forward<Args>(args)...);
+    std::pair<iterator, bool> p{_nodes.emplace(std::move(k), new_node(std::move(data)))};
+    attach_node(p.first);
+    return p;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::pair<typename graph<Key, T, Cost, Nat, Index>::iterator, bool> graph<Key, T, Cost, Nat, Index>::add_node(const key_type &k) {
+    return emplace(k);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::pair<typename graph<Key, T, Cost, Nat, Index>::iterator, bool> graph<Key, T, Cost, Nat, Index>::add_node(const key_type &k, const graphed_type &x) {
+    return emplace(k, x);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::pair<typename graph<Key, T, Cost, Nat, Index>::iterator, bool> graph<Key, T, Cost, Nat, Index>::add_node(const key_type &k, const node &n) {
+    return emplace(k, n);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::pair<typename graph<Key, T, Cost, Nat, Index>::iterator, bool> graph<Key, T, Cost, Nat, Index>::add_node(key_type &&k, graphed_type &&x) {
+    return try_emplace(std::move(k), std::move(x));
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+bool graph<Key, T, Cost, Nat, Index>::add_edge(const_iterator it1, const_iterator it2, cost_type cost) {
+    std::pair<typename node::EdgesIterator, bool> new_edge{it1->second->add_edge(it2, cost)};
+    add_opposite_edge(it1, it2, *new_edge.first, directed_tag());
+
+    if (new_edge.second) {
+        _num_edges++;
+    }
+
+    return true;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+bool graph<Key, T, Cost, Nat, Index>::add_edge(const key_type &k1, const key_type &k2, cost_type cost) {
+    return add_edge(emplace(k1).first, emplace(k2).first, cost);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::make_complete(cost_type cost) {
+    clear_edges();
+
+    if (cost != infinity && !empty()) {
+        /// No edge is left: every edge is new, and is appended to reserved storage without any search
+        for (const_iterator it{cbegin()}; it != cend(); ++it) {
+            it->second->reserve_edges(size() - 1, size() - 1);
+        }
+
+        /// Row after row, so each node writes its out-edges contiguously; its index is then built once
+        for (const_iterator it1{cbegin()}; it1 != cend(); ++it1) {
+            for (const_iterator it2{cbegin()}; it2 != cend(); ++it2) {
+                if (it1 != it2) {
+                    it1->second->append_edge(it2->second.get(), cost);
+                }
+            }
+            it1->second->rebuild_edges_index();
+        }
+        if (!directed_tag::value) {
+            /// No cost is shared yet: the slots of every pair are appended in one step
+            _shared_costs.resize(size() * (size() - 1) / 2, cost);
+            typename std::deque<Cost, detail::allocator<Cost>>::iterator slot{_shared_costs.begin()};
+
+            /// The i-th row lists every other node in order: the opposite of (i, j) with i < j is the i-th edge of j
+            size_type i{0};
+            for (const_iterator it1{cbegin()}; it1 != cend(); ++it1, ++i) {
+                typename node::ListEdges &row{it1->second->_out_edges};
+                for (size_type j{i}; j < row.size(); ++j, ++slot) {
+                    typename node::edge &opposite{row[j]._target->_out_edges[i]};
+                    row[j]._shared_cost = opposite._shared_cost = &*slot;
+                }
+            }
+        }
+        _num_edges = directed_tag::value ? size() * (size() - 1) : size() * (size() - 1) / 2;
+    }
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+template <class InputIterator>
+void graph<Key, T, Cost, Nat, Index>::assign_edges(InputIterator first, InputIterator last) {
+    clear();
+
+    /// Nodes: the graph is empty, so the dense index of a node is its rank of insertion. The keys are looked up in
+    /// the index of the graph itself, which only requires what the index does: `operator<` or `std::hash`
+    std::vector<node*> nodes;
+    const auto node_index = [this, &nodes](const key_type &k) -> size_type {
+        iterator it{_nodes.find(k)};
+        if (it == _nodes.end()) {
+            it = _nodes.insert(_nodes.cend(), std::make_pair(k, new_node(graphed_type())));
+            attach_node(it);
+            nodes.push_back(it->second.get());
+        }
+        return index_of(it->second.get());
+    };
+
+    std::vector<cost_type> costs;
+    std::vector<size_type> from, to;
+    for (; first != last; ++first) {
+        from.push_back(node_index(std::get<0>(*first)));
+        to.push_back(node_index(std::get<1>(*first)));
+        costs.push_back(static_cast<cost_type>(std::get<2>(*first)));
+        if (!directed_tag::value && to.back() < from.back()) {
+            std::swap(from.back(), to.back());
+        }
+    }
+    const size_type nbr_edges{costs.size()};
+
+    /// Counting sort by source, stable so that the last duplicate of an edge comes last in its row
+    std::vector<size_type> offsets(nodes.size() + 1, 0);
+    for (size_type i{0}; i < nbr_edges; ++i) {
+        ++offsets[from[i] + 1];
+    }
+    for (size_type u{0}; u < nodes.size(); ++u) {
+        offsets[u + 1] += offsets[u];
+    }
+    std::vector<size_type> order(nbr_edges);
+    {
+        std::vector<size_type> cursor(offsets.cbegin(), offsets.cend() - 1);
+        for (size_type i{0}; i < nbr_edges; ++i) {
+            order[cursor[from[i]]++] = i;
+        }
+    }
+
+    /// Row by row, only the last occurrence of each target is kept
+    std::vector<size_type> latest(nodes.size());
+    std::vector<size_type> kept;
+    kept.reserve(nbr_edges);
+    std::vector<size_type> out_degree(nodes.size(), 0), in_degree(nodes.size(), 0);
+    for (size_type u{0}; u < nodes.size(); ++u) {
+        for (size_type k{offsets[u]}; k < offsets[u + 1]; ++k) {
+            latest[to[order[k]]] = k;
+        }
+        for (size_type k{offsets[u]}; k < offsets[u + 1]; ++k) {
+            const size_type v{to[order[k]]};
+            if (latest[v] == k) {
+                kept.push_back(order[k]);
+                ++out_degree[u];
+                ++in_degree[v];
+                if (!directed_tag::value && u != v) {
+                    ++out_degree[v];
+                    ++in_degree[u];
+                }
+            }
+        }
+    }
+
+    /// Adjacency: the edges are known to be distinct, so they are appended without any search
+    for (size_type u{0}; u < nodes.size(); ++u) {
+        nodes[u]->_out_edges.reserve(out_degree[u]);
+        nodes[u]->_in_edges.reserve(in_degree[u]);
+    }
+    for (size_type i : kept) {
+        push_opposite_edge(nodes[from[i]], nodes[to[i]], *nodes[from[i]]->push_edge(nodes[to[i]], costs[i]), directed_tag());
+    }
+    _num_edges = kept.size();
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::iterator graph<Key, T, Cost, Nat, Index>::erase(const_iterator position) {
+    clear_edges(position);
+    release_node(position);
+
+    return _nodes.erase(position);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::iterator graph<Key, T, Cost, Nat, Index>::erase(const_iterator first, const_iterator last) {
+    std::vector<const_iterator> victims;
+    for (const_iterator it{first}; it != last && it != cend(); ++it) {
+        victims.push_back(it);
+    }
+    detach_nodes(victims);
+    for (const_iterator it : victims) {
+        release_node(it);
+    }
+
+    return _nodes.erase(first, last);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::erase(const key_type &k) {
+    const_iterator it{this->find(k)};
+    if (it == cend()) {
+        return 0;
+    }
+
+    clear_edges(it);
+    release_node(it);
+    return _nodes.erase(k);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::iterator graph<Key, T, Cost, Nat, Index>::del_node(const_iterator position) {
+    return erase(position);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::iterator graph<Key, T, Cost, Nat, Index>::del_nodes(const_iterator first, const_iterator last) {
+    return erase(first, last);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::del_node(const key_type &k) {
+    return erase(k);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+template <class Range>
+std::size_t graph<Key, T, Cost, Nat, Index>::del_nodes(const Range &keys) {
+    std::vector<const_iterator> victims;
+    std::unordered_set<const typename node::basic_node*> marked;
+    for (const auto &k : keys) {
+        const_iterator it{find(k)};
+        if (it != cend() && marked.insert(it->second.get()).second) {
+            victims.push_back(it);
+        }
+    }
+
+    detach_nodes(victims);
+    for (const_iterator it : victims) {
+        release_node(it);
+        _nodes.erase(it);
+    }
+    return victims.size();
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::del_nodes(std::initializer_list<key_type> keys) {
+    return del_nodes<std::initializer_list<key_type>>(keys);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::del_nodes_if(std::function<bool(const_iterator)> predicate) {
+    std::vector<const_iterator> victims;
+    for (const_iterator it{cbegin()}; it != cend(); ++it) {
+        if (predicate(it)) {
+            victims.push_back(it);
+        }
+    }
+
+    detach_nodes(victims);
+    for (const_iterator it : victims) {
+        release_node(it);
+        _nodes.erase(it);
+    }
+    return victims.size();
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::detach_nodes(const std::vector<const_iterator> &victims) {
+    using basic_node = typename node::basic_node;
+
+    std::unordered_set<const basic_node*> marked;
+    marked.reserve(victims.size());
+    for (const_iterator it : victims) {
+        marked.insert(it->second.get());
+    }
+
+    for (const_iterator it : victims) {
+        basic_node* const victim{it->second.get()};
+
+        /// Edges from the other nodes: the sources lose them. Swap-and-pop only moves links already visited
+        typename node::ListInEdges &in_edges{victim->_in_edges};
+        for (size_type k{in_edges.size()}; k-- > 0;) {
+            if (k < in_edges.size() && marked.count(in_edges[k]._source) == 0) {
+                in_edges[k]._source->erase_edge(in_edges[k]._position);
+                --_num_edges;
+            }
+        }
+
+        /// Edges to the other nodes: the targets lose their reverse link
+        for (const typename node::edge &e : victim->_out_edges) {
+            const bool to_victim{marked.count(e._target) != 0};
+            if (!to_victim) {
+                e._target->erase_in_edge(e._in_position);
+            }
+
+            if (directed_tag::value) {
+                --_num_edges;
+            } else if (!to_victim || !std::less<const basic_node*>()(e._target, victim)) {
+                /// UNDIRECTED: the opposite direction from a survivor was counted above, and a pair of victims is handled from its lowest node
+                if (e._shared_cost != nullptr) {
+                    release_shared_cost(e._shared_cost);
+                }
+                if (to_victim) {
+                    --_num_edges;
+                }
+            }
+        }
+    }
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+template <class Range>
+std::size_t graph<Key, T, Cost, Nat, Index>::del_edges(const Range &edges) {
+    size_type result{0};
+    for (const auto &e : edges) {
+        result += del_edge(find(std::get<0>(e)), find(std::get<1>(e)));
+    }
+    return result;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::del_edges(std::initializer_list<std::pair<key_type, key_type>> edges) {
+    return del_edges<std::initializer_list<std::pair<key_type, key_type>>>(edges);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::clear() noexcept {
+    _nodes.clear();
+    _num_edges = 0;
+    _shared_costs.clear();
+    _free_costs.clear();
+    _indices_bound = 0;
+    _free_indices.clear();
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::del_edge(const_iterator it1, const_iterator it2) {
+    if (it1 == end() || it2 == end()) {
+        return 0;
+    }
+    return del_edge(it1, it2, directed_tag());
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::del_edge(const key_type &k1, const key_type &k2) {
+    return del_edge(this->find(k1), this->find(k2));
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::clear_edges() {
+    /// Every edge goes: no need to keep the reverse links in sync one by one
+    for (const_iterator it{cbegin()}; it != cend(); ++it) {
+        it->second->_out_edges.clear();
+        it->second->_edges_index.clear();
+        it->second->_in_edges.clear();
+    }
+    _num_edges = 0;
+    _shared_costs.clear();
+    _free_costs.clear();
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::clear_edges(const_iterator it) {
+    if (it == cend()) {
+        return 0;
+    }
+    return clear_edges(it, directed_tag());
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::clear_edges(const key_type &k) {
+    return clear_edges(find(k));
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::swap(graph &other) noexcept {
+    /// Precondition: equal allocators, so that each node stays released by the resource it came from
+    _nodes.swap(other._nodes);
+    std::swap(_num_edges, other._num_edges);
+    _shared_costs.swap(other._shared_costs);
+    _free_costs.swap(other._free_costs);
+    std::swap(_indices_bound, other._indices_bound);
+    _free_indices.swap(other._free_indices);
+    _published.swap(other._published);
+    std::swap(_version, other._version);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::PtrNode graph<Key, T, Cost, Nat, Index>::new_node(const graphed_type &x) const {
+    return std::allocate_shared<node>(detail::allocator<node>(get_allocator()), x, typename node::EdgesAllocator(get_allocator()));
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::PtrNode graph<Key, T, Cost, Nat, Index>::new_node(graphed_type &&x) const {
+    return std::allocate_shared<node>(detail::allocator<node>(get_allocator()), std::move(x), typename node::EdgesAllocator(get_allocator()));
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::copy_edges(iterator position, const node &n) {
+    /// Undirected edges to @p n itself append to its out-edges: only the ones present at the call are copied
+    const size_type nbr_edges{n._out_edges.size()};
+    for (size_type i{0}; i < nbr_edges; ++i) {
+        const typename node::edge &e{n._out_edges[i]};
+        const cost_type cost{e.cost()};
+        add_edge(position, emplace(e.target()->first).first, cost);
+    }
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+Cost* graph<Key, T, Cost, Nat, Index>::acquire_shared_cost(cost_type cost) {
+    if (!_free_costs.empty()) {
+        Cost* slot{_free_costs.back()};
+        _free_costs.pop_back();
+        *slot = cost;
+        return slot;
+    }
+
+    _shared_costs.push_back(cost);
+    return &_shared_costs.back();
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::release_shared_cost(Cost* slot) {
+    _free_costs.push_back(slot);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::attach_node(iterator position) {
+    position->second->set_iterator_values(position, end(), cend());
+    if (!_free_indices.empty()) {
+        position->second->_index = _free_indices.back();
+        _free_indices.pop_back();
+    } else {
+        position->second->_index = _indices_bound++;
+    }
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::release_node(const_iterator position) {
+    _free_indices.push_back(position->second->_index);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::index_of(const typename node::basic_node* n) {
+    /// every node of a graph is a graph::node
+    return static_cast<const node*>(n)->_index;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::add_opposite_edge(const_iterator, const_iterator, typename node::edge &, std::true_type) {}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::add_opposite_edge(const_iterator from, const_iterator to, typename node::edge &e, std::false_type) {
+    if (e._shared_cost == nullptr) {
+        e._shared_cost = acquire_shared_cost(e._cost);
+    }
+    to->second->set_edge(from, e._shared_cost);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::push_opposite_edge(node*, node*, typename node::edge &, std::true_type) {}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::push_opposite_edge(node* from, node* to, typename node::edge &e, std::false_type) {
+    e._shared_cost = acquire_shared_cost(e._cost);
+    if (from != to) {
+        to->push_edge(from, e._cost)->_shared_cost = e._shared_cost;
+    }
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::del_edge(const_iterator it1, const_iterator it2, std::true_type) {
+    const size_type result{static_cast<size_type>(it1->second->del_edge(it2))};
+    _num_edges -= result;
+    return result;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::del_edge(const_iterator it1, const_iterator it2, std::false_type) {
+    const size_type position{it1->second->find_edge(it2->second.get())};
+    if (position == it1->second->_out_edges.size()) {
+        return 0;
+    }
+
+    Cost* shared_cost{it1->second->_out_edges[position]._shared_cost};
+    it1->second->erase_edge(position);
+    it2->second->del_edge(it1);
+    if (shared_cost != nullptr) {
+        release_shared_cost(shared_cost);
+    }
+
+    --_num_edges;
+    return 1;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::clear_edges(const_iterator it, std::true_type) {
+    /// The reverse links give the sources directly, instead of visiting every node of the graph
+    typename node::ListInEdges &in_edges{it->second->_in_edges};
+    size_type result{in_edges.size()};
+    while (!in_edges.empty()) {
+        in_edges.back()._source->erase_edge(in_edges.back()._position);
+    }
+
+    result += it->second->clear_edges();
+    _num_edges -= result;
+    return result;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::clear_edges(const_iterator it, std::false_type) {
+    /// Both directions of an edge are linked: the reverse links give every neighbour
+    const typename node::ListInEdges &in_edges{it->second->_in_edges};
+    size_type result{0};
+    while (!in_edges.empty()) {
+        result += del_edge(in_edges.back()._source->container_from_this, it, std::false_type());
+    }
+    return result;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+bool graph<Key, T, Cost, Nat, Index>::existing_edge(const_iterator it1, const_iterator it2, std::true_type) const {
+    return it1->second->existing_adjacent_node(it2);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+bool graph<Key, T, Cost, Nat, Index>::existing_edge(const_iterator it1, const_iterator it2, std::false_type) const {
+    return it1->second->existing_adjacent_node(it2) && it2->second->existing_adjacent_node(it1);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::Degree graph<Key, T, Cost, Nat, Index>::degree(const_iterator position, std::true_type) const {
+    return Degree(position->second->degree().first, position->second->degree().second);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::Degree graph<Key, T, Cost, Nat, Index>::degree(const_iterator position, std::false_type) const {
+    return Degree(position->second->degree().first, 0);
+}
+
+namespace std {
+    template <class Key, class T, class Cost, Nature Nat, class Index>
+    void swap(graph<Key, T, Cost, Nat, Index> &g1, graph<Key, T, Cost, Nat, Index> &g2) noexcept {
+        g1.swap(g2);
+    }
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::count(const key_type &k) const {
+    return _nodes.count(k);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::iterator graph<Key, T, Cost, Nat, Index>::find(const key_type &k) {
+    return _nodes.find(k);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::const_iterator graph<Key, T, Cost, Nat, Index>::find(const key_type &k) const {
+    return _nodes.find(k);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+template <class K, class>
+std::size_t graph<Key, T, Cost, Nat, Index>::count(const K &k) const {
+    return _nodes.count(k);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+template <class K, class>
+typename graph<Key, T, Cost, Nat, Index>::iterator graph<Key, T, Cost, Nat, Index>::find(const K &k) {
+    return _nodes.find(k);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+template <class K, class>
+typename graph<Key, T, Cost, Nat, Index>::const_iterator graph<Key, T, Cost, Nat, Index>::find(const K &k) const {
+    return _nodes.find(k);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+bool graph<Key, T, Cost, Nat, Index>::existing_node(const_iterator it) const {
+    return it != cend();
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+bool graph<Key, T, Cost, Nat, Index>::existing_node(const key_type &k) const {
+    return existing_node(find(k));
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+bool graph<Key, T, Cost, Nat, Index>::existing_edge(const_iterator it1, const_iterator it2) const {
+    if (it1 != cend() && it2 != cend()) {
+        return existing_edge(it1, it2, directed_tag());
+    }
+
+    return false;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+bool graph<Key, T, Cost, Nat, Index>::existing_edge(const key_type &k1, const key_type &k2) const {
+    return existing_edge(this->find(k1), this->find(k2));
+}
+template <class Key, class T, class Cost, Nature Nat, class Index>
+bool graph<Key, T, Cost, Nat, Index>::has_path_connecting(const_iterator from, const_iterator to) const {
+    if (from == cend() || to == cend()) {
+        GRAPH_THROW(unexpected_nullptr)
+    }
+    if (from == to) {
+        return true;
+    }
+    return !dfs(from, to).empty();
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+bool graph<Key, T, Cost, Nat, Index>::has_path_connecting(const key_type &from, const key_type &to) const {
+    return has_path_connecting(this->find(from), this->find(to));
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::get_nbr_nodes() const noexcept {
+    return _nodes.size();
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::get_nbr_edges() const noexcept {
+    return _num_edges;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+Nature graph<Key, T, Cost, Nat, Index>::get_nature() const {
+    return Nat;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::Degree graph<Key, T, Cost, Nat, Index>::degree(const_iterator position) const {
+    return position == cend() ? Degree::min() : degree(position, directed_tag());
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::Degree graph<Key, T, Cost, Nat, Index>::degree(const key_type &k) const {
+    return degree(find(k));
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::pair<typename graph<Key, T, Cost, Nat, Index>::const_iterator, typename graph<Key, T, Cost, Nat, Index>::Degree> graph<Key, T, Cost, Nat, Index>::degree_max() const {
+    if (empty()) {
+        return std::make_pair(cend(), Degree::min());
+    }
+
+    Degree max{Degree::min()};
+    const_iterator cit;
+
+    for (const_iterator it{cbegin()}; it != cend(); ++it) {
+        Degree tmp{degree(it)};
+        if (max < tmp) {
+            max = tmp;
+            cit = it;
+        }
+    }
+
+    return std::make_pair(cit, max);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::pair<typename graph<Key, T, Cost, Nat, Index>::const_iterator, typename graph<Key, T, Cost, Nat, Index>::Degree> graph<Key, T, Cost, Nat, Index>::degree_min() const {
+    if (empty()) {
+        return std::make_pair(cend(), Degree::min());
+    }
+
+    Degree min{Degree::max()};
+    const_iterator cit;
+
+    for (const_iterator it{cbegin()}; it != cend(); ++it) {
+        Degree tmp{degree(it)};
+        if (tmp < min) {
+            min = tmp;
+            cit = it;
+        }
+    }
+
+    return std::make_pair(cit, min);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::map<Key, typename graph<Key, T, Cost, Nat, Index>::Degree> graph<Key, T, Cost, Nat, Index>::degrees() const {
+    std::map<key_type, Degree> result;
+
+    for (const_iterator it{cbegin()}; it != cend(); ++it) {
+        result.insert(std::make_pair(it->first, degree(it)));
+    }
+
+    return result;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+template <class>
+std::vector<typename graph<Key, T, Cost, Nat, Index>::node::edge> graph<Key, T, Cost, Nat, Index>::get_in_edges(const_iterator to) const {
+    std::vector<typename node::edge> result;
+    result.reserve(to->second->_in_edges.size());
+
+    for (const typename node::in_edge &link : to->second->_in_edges) {
+        if (link._source != to->second.get()) {
+            result.push_back(link._source->_out_edges[link._position]);
+        }
+    }
+
+    return result;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+template <class>
+std::vector<typename graph<Key, T, Cost, Nat, Index>::node::edge> graph<Key, T, Cost, Nat, Index>::get_in_edges(const key_type &to) const {
+    return get_in_edges(find(to));
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+template <class>
+std::vector<typename graph<Key, T, Cost, Nat, Index>::node::edge> graph<Key, T, Cost, Nat, Index>::get_out_edges(const_iterator from) const {
+    return std::vector<typename node::edge>(from->second->_out_edges.begin(), from->second->_out_edges.end());
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+template <class>
+std::vector<typename graph<Key, T, Cost, Nat, Index>::node::edge> graph<Key, T, Cost, Nat, Index>::get_out_edges(const key_type &from) const {
+    return get_out_edges(find(from));
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+template <class>
+std::vector<typename graph<Key, T, Cost, Nat, Index>::node::edge> graph<Key, T, Cost, Nat, Index>::get_edges(const_iterator i) const {
+    return std::vector<typename node::edge>(i->second->_out_edges.begin(), i->second->_out_edges.end());
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+template <class>
+std::vector<typename graph<Key, T, Cost, Nat, Index>::node::edge> graph<Key, T, Cost, Nat, Index>::get_edges(const key_type &i) const {
+    return get_edges(find(i));
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+template <class>
+bool graph<Key, T, Cost, Nat, Index>::is_cyclic() const {
+    for (const_iterator it{cbegin()}; it != cend(); ++it) {
+        std::list<const_iterator> initPath;
+        if (is_cyclic_rec(it, initPath)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+bool graph<Key, T, Cost, Nat, Index>::is_cyclic_rec(const_iterator current, std::list<const_iterator> path) const {
+    for (const_iterator it : path) {
+        if (it == current && (directed_tag::value || path.back() != current)) {
+            return true;
+        }
+    }
+    /*if (std::find(path.cbegin(), path.cend(), current) != path.cend()) {
+        return true;
+    }*/
+
+    path.push_back(current);
+    const typename node::ListEdges &adjacent{current->second->get_edges()};
+
+    for (typename node::ConstEdgesIterator it{adjacent.cbegin()}; it != adjacent.cend(); ++it) {
+        if (is_cyclic_rec(it->target(), path)) {
+            return true;
+        }
+        path.remove(it->target());
+    }
+
+    return false;
+}
+
+/*
+template <class Key, class T, class Cost, Nature Nat, class Index>
+bool graph<Key, T, Cost, Nat, Index>::is_isomorphic() const {
+    // TODO
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::vector<typename graph<Key, T, Cost, Nat, Index>::const_iterator> graph<Key, T, Cost, Nat, Index>::toposort() const {
+    // TODO
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::set<std::vector<typename graph<Key, T, Cost, Nat, Index>::const_iterator>, typename graph<Key, T, Cost, Nat, Index>::iterator_comparator> graph<Key, T, Cost, Nat, Index>::kosaraju_scc() const {
+    // TODO
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::set<std::vector<typename graph<Key, T, Cost, Nat, Index>::const_iterator>, typename graph<Key, T, Cost, Nat, Index>::iterator_comparator> graph<Key, T, Cost, Nat, Index>::tarjan_scc() const {
+    // TODO
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::connected_components() const {
+    // TODO
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+graph<Key, T, Cost, Nat, Index> &graph<Key, T, Cost, Nat, Index>::condensate(bool make_acyclic) {
+    // TODO
+}
+*/
+
+//template <class Key, class T, class Cost, Nature Nat, class Index>
+//std::vector<typename graph<Key, T, Cost, Nat, Index>::const_iterator> graph<Key, T, Cost, Nat, Index>::maximum_clique() const {
+// TODO: fix the bug
+
+/*
+std::function<size_type(const_iterator)> heuristic = [](const_iterator it) -> size_type { return it->second->degree().first; };
+std::function<size_type(const_iterator, const_iterator)> comparator = [&heuristic](const_iterator it1, const_iterator it2) -> size_type { return heuristic(it1) > heuristic(it2); };
+std::list<const_iterator> Q;
+for (const_iterator it{cbegin()}; it != cend(); ++it) {
+    Q.emplace_back(it);
+}
+//std::copy(cbegin(), cend(), std::back_inserter(Q));
+Q.sort(comparator);
+
+std::vector<const_iterator> result;
+std::function<size_type()> calculate_max_size = [&Q, &heuristic]() -> size_type {
+    for (size_type degree{heuristic(*Q.cbegin())}; degree > 0; --degree) {
+        if (std::count_if(Q.cbegin(), Q.cend(), [degree, &heuristic](const_iterator it) -> bool {
+        return heuristic(it) >= degree;
+        }) >= degree) {
+            return degree + 1;
+        }
+    }
+    return 0;
+};
+size_type max_size{calculate_max_size()};
+
+while (!Q.empty() && result.size() <= max_size) {
+    // DEBUG
+    std::cout << "Values inside Q: ";
+    for (const_iterator I : Q) {
+        std::cout << I->first << " ";
+    }
+    std::cout << std::endl;
+
+    const_iterator N{*Q.cbegin()};
+    // DEBUG
+    std::cout << "N: " << N->first << std::endl;
+    std::vector<const_iterator> current_clique({N});
+
+    // TODO: loop until neighbors of N { for each neighbor of N inside of Q { . . . }; };
+    const typename node::ListEdges &adj{N->second->get_edges()};
+    for (typename node::ConstEdgesIterator edge{adj.cbegin()}; edge != adj.cend(); ++edge) {
+        // DEBUG
+        std::cout << "Values inside current_clique: ";
+        for (const_iterator I : current_clique) {
+            std::cout << I->first << " ";
+        }
+        std::cout << std::endl;
+
+        const_iterator X{edge->target()};
+        if (std::find(Q.cbegin(), Q.cend(), X) == Q.cend()) {
+            continue;
+        }
+
+        bool part_of_clique{true};
+        for (const_iterator it : current_clique) {
+            if (!existing_edge(it, X)) {
+                part_of_clique = false;
+                break;
+            }
+        }
+        if (part_of_clique) {
+            current_clique.push_back(X);
+        } else {
+            if (result.size() < current_clique.size()) {
+                result = current_clique;
+                // DEBUG
+                std::cout << "new clique discovered: size of " << result.size() << std::endl;
+            }
+            Q.remove(N);
+
+            std::function<bool(const_iterator)> PAF = [&result, &heuristic](const_iterator it) -> bool {
+                return heuristic(it) < result.size();
+            };
+            Q.erase(std::remove_if(Q.begin(), Q.end(), PAF), Q.cend());
+            max_size = calculate_max_size();
+        }
+    }
+    // DEBUG
+    std::cout << std::endl;
+}
+return result;
+
+// candidates <- sort each node in function of its degree
+// max clique size <= degree_max() + 1
+
+// current_clique_size = 0
+// result = null
+// for each node N in candidates
+//      current_clique = {N}
+//      for each neighbor X of N ordered by its degree
+//              if (X linked with all nodes of current_clique) then
+//                      current_clique += {X}
+//              else
+//                      if (result.size < current_clique.size)
+//                              result = current_clique
+//                      candidates -= {N}
+//                      for each node M in candidates
+//                              if (M.degree <= result.size)
+//                                      candidates -= {M}
+
+// clique = NULL
+// candidate = X (nodes of graph / candidate != NULL do
+//                                      choose xi wih degree max
+//                                      clique <- clique U {xi}
+//                                      candidate <- candidats ∧ { xj / (xj, xi) € A} (intersection of candidate and neighbors of xi)
+*/
+//}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::ostream &operator<<(std::ostream &os, const graph<Key, T, Cost, Nat, Index> &g) {
+    return os << *g.generate_grp() << std::endl;
+    //return os << std::setw(4) << *g.generate_json() << std::endl;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::istream &operator>>(std::istream &is, graph<Key, T, Cost, Nat, Index> &g) {
+    GRAPH_TRY {
+        g.parse_from_grp(is);
+    } GRAPH_CATCH (...) {
+
+        GRAPH_THROW_WITH(parse_error, 0, "istream corrupted, fail to parse the graph")
+
+    }
+
+    return is;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::load(const char* filename) {
+    const char* dot = strrchr(filename, '.');
+    std::string extension;
+    if (dot != nullptr && dot != filename) {
+        extension = dot + 1;
+    }
+
+    std::ifstream in(filename);
+    if (!in) {
+        GRAPH_THROW_WITH(invalid_argument, ("Unexistant file: '" + std::string(filename) + "'").c_str())
+    }
+
+    if (extension == "json") {
+        parse_from_json(in);
+    } else if (extension == "dot") {
+        GRAPH_THROW_WITH(invalid_argument, "Load from DOT file non supported yet")
+    } else {
+        GRAPH_TRY {
+            parse_from_grp(in);
+        } GRAPH_CATCH (exception & e) {
+            std::cerr << "Fail to load the file '" << filename << "'; wrong extension or corrupted file." << std::endl;
+        }
+    }
+    in.close();
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::unique_ptr<std::string> graph<Key, T, Cost, Nat, Index>::generate_dot(const std::string &graph_name) const {
+    std::string dot;
+
+    const std::string tab{"    "};
+
+    /// Displaying nature + graph name
+    if (graph_name.find_first_not_of("abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789_-") != std::string::npos) {
+        GRAPH_THROW_WITH(invalid_argument, "Wrong graph name given; accepted characters: [a-zA-Z0-9_-]")
+    }
+
+    if (get_nature() == DIRECTED) {
+        dot += "di";
+    }
+    dot += "graph ";
+    if (!graph_name.empty()) {
+        dot += graph_name + " ";
+    }
+    dot += "{\n";
+
+    /// Displaying nodes' name
+    for (const_iterator it{cbegin()}; it != cend(); ++it) {
+        std::stringstream ss;
+        ss << it->first;
+        dot += tab + ss.str() + "\n";
+    }
+
+    if (get_nature() == DIRECTED) {
+        for_each(cbegin(), cend(), [this, &dot, tab](const value_type & element) {
+            const typename node::ListEdges &child{element.second->get_edges()};
+            for_each(child.cbegin(), child.cend(), [this, &dot, tab, &element](const typename node::edge & i) {
+                if (i.cost() != infinity) {
+                    std::stringstream ss;
+                    ss << tab << element.first << " -> " << i.target()->first << '\n';
+                    dot += ss.str();
+                }
+            });
+        });
+    } else {
+        std::set<std::pair<Key, Key >> list_edges;
+        for_each(cbegin(), cend(), [this, &dot, &list_edges](const value_type & element) {
+            const typename node::ListEdges &child{element.second->get_edges()};
+            for_each(child.cbegin(), child.cend(), [&dot, &list_edges, &element](const typename node::edge & i) {
+                const Key min{std::min(element.first, i.target()->first)};
+                const Key max{std::max(element.first, i.target()->first)};
+                list_edges.emplace(std::make_pair(min, max));
+            });
+        });
+
+        for_each(list_edges.cbegin(), list_edges.cend(), [&dot, tab](const std::pair<Key, Key> &p) {
+            std::stringstream ss;
+            ss << tab << p.first << " -- " << p.second << '\n';
+            dot += ss.str();
+        });
+    }
+    dot += '}';
+
+    return std::make_unique<std::string>(std::forward<std::string>(dot));
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::save_to_dot(const char* filename, const std::string &graph_name) const {
+    std::ofstream out(filename);
+    out << *generate_dot(graph_name) << std::endl;
+    out.close();
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::unique_ptr<nlohmann::json> graph<Key, T, Cost, Nat, Index>::generate_json() const {
+    nlohmann::json json;
+
+    using Set = typename node::ListEdges;
+
+    json["nature"] = get_nature();
+
+    size_type n{0};
+    for (const_iterator node{cbegin()}; node != cend(); ++node, ++n) {
+        json["nodes"][n]["key"]   = node->first;
+        json["nodes"][n]["value"] = node->second->get();
+    }
+
+    size_type p{0};
+    for (const_iterator node{cbegin()}; node != cend(); ++node) {
+        const Set &child{node->second->get_edges()};
+        for (typename Set::const_iterator edge{child.begin()}; edge != child.end(); ++edge, ++p) {
+            json["edges"][p]["from"] = node->first;
+            json["edges"][p]["to"]   = edge->target()->first;
+            json["edges"][p]["cost"] = edge->cost();
+        }
+    }
+    return std::make_unique<nlohmann::json>(std::forward<nlohmann::json>(json));
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::save_to_json(const char* filename) const {
+    std::ofstream out(filename);
+    out << std::setw(4) << *generate_json() << std::endl;
+    out.close();
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::parse_from_json(std::istream &is) {
+    nlohmann::json json;
+    is >> json;
+
+    if (static_cast<Nature>(json["nature"]) != get_nature()) {
+        std::string error_msg{"Bad graph nature (expected '"};
+        error_msg += (Nat == DIRECTED ? "graph')" : "digraph')");
+        GRAPH_THROW_WITH(invalid_argument, error_msg.c_str())
+    }
+
+    clear();
+    for (const nlohmann::json &node : json["nodes"]) {
+        key_type k = node["key"];
+        graphed_type x = node["value"];
+        add_node(k, x);
+    }
+    for (const nlohmann::json &edge : json["edges"]) {
+        key_type from = edge["from"];
+        key_type to = edge["to"];
+        cost_type c;
+        if (edge["cost"].is_null()) {
+            c = infinity;
+        } else {
+            c = edge["cost"];
+        }
+        add_edge(from, to, c);
+    }
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::DEBUG_load_from_json_rust(const char* path) {
+    nlohmann::json json;
+    std::ifstream is(path);
+    if (!is) {
+        std::cerr << "Unexistent file '" << path << "'!" << std::endl;
+        exit(1);
+    }
+    is >> json;
+
+    clear();
+    for (const nlohmann::json &node : json["nodes"]) {
+        add_node(node);
+    }
+
+    for (const nlohmann::json &edge : json["edges"]) {
+        const_iterator begin{std::next(cbegin(), edge[0])};
+        const_iterator end  {std::next(cbegin(), edge[1])};
+        add_edge(begin, end);
+    }
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::unique_ptr<std::string> graph<Key, T, Cost, Nat, Index>::generate_grp() const {
+    using std::max;
+    using std::ostringstream;
+    using std::setw;
+    using std::string;
+    using std::stringstream;
+
+    const auto tab{string(4, ' ')};
+
+    string data;
+
+    /// Displaying nature + graph types
+    if (get_nature() == DIRECTED) {
+        data += "di";
+    }
+
+    data += "graph<" + detail::type_name<Key>() + ", " +
+            detail::type_name<graphed_type>() + ", " +
+            detail::type_name<cost_type>() + "> {\n" +
+            tab + "nodes: {\n";
+
+    /// Displaying nodes:  "<name>"; "<value>",
+    size_type max_size{3};
+    for_each(cbegin(), cend(), [&max_size](const value_type & element) {
+        ostringstream out;
+        out << element.first;
+        const size_type size{static_cast<size_type>(out.tellp())};
+
+        max_size = max(max_size, size);
+    });
+
+    for (const_iterator it{cbegin()}; it != cend(); ++it) {
+        ostringstream out;
+        out << it->first << "\",";
+
+        stringstream ss;
+        ss << tab << tab
+           << '"' << std::left << setw(static_cast<int>(max_size + 3)) << out.str()
+           << '"' << it->second->get() << '"';
+        data += ss.str();
+
+        if (it != --cend()) {
+            data += ";";
+        }
+        data += "\n";
+    }
+    data += tab + "}";
+
+    /// Displaying edges:  "<node 1>"; "<node 2>"; "<cost>",
+    if (get_nbr_edges() == 0) {
+        data += "\n}";
+    } else {
+        data += ",\n" + tab + "edges: {\n";
+        size_type max_size_1{0}, max_size_2{0};
+
+        for_each(cbegin(), cend(), [&max_size_1, &max_size_2, this](const value_type & element) {
+            const typename node::ListEdges &child{element.second->get_edges()};
+            for_each(child.cbegin(), child.cend(), [ &, this](const typename node::edge & i) {
+                ostringstream out_1, out_2;
+                out_1 << element.first;
+                out_2 << i.target()->first;
+
+                const size_type size_1{static_cast<size_type>(out_1.tellp())};
+                const size_type size_2{static_cast<size_type>(out_2.tellp())};
+
+                max_size_1 = max(max_size_1, size_1);
+                max_size_2 = max(max_size_2, size_2);
+            });
+        });
+
+        size_type p{0};
+        /// Both directions of an UNDIRECTED edge are written
+        const size_type nbr_lines{directed_tag::value ? get_nbr_edges() : 2 * get_nbr_edges()};
+        for_each(cbegin(), cend(), [this, &data, &p, tab, max_size_1, max_size_2, nbr_lines](const value_type & element) {
+            const typename node::ListEdges &child{element.second->get_edges()};
+            for_each(child.cbegin(), child.cend(), [this, &data, &p, tab, &element, max_size_1, max_size_2, nbr_lines](const typename node::edge & i) {
+                ostringstream out_1, out_2;
+                out_1 << '"' << element.first     << "\",";
+                out_2 << '"' << i.target()->first << "\",";
+
+                stringstream ss;
+                ss << std::left << tab << tab
+                   << setw(static_cast<int>(max_size_1 + 4)) << out_1.str()
+                   << setw(static_cast<int>(max_size_2 + 4)) << out_2.str();
+                if (i.cost() == infinity) {
+                    ss << "infinity";
+                } else {
+                    ss << '"' << i.cost() << '"';
+                }
+
+                if (p < nbr_lines - 1) {
+                    ss << ';';
+                }
+                ss << '\n';
+                data += ss.str();
+                p++;
+            });
+        });
+        data += tab + "}\n}";
+    }
+
+    return std::make_unique<std::string>(std::forward<std::string>(data));
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::save_to_grp(const char* filename) const {
+    std::ofstream out(filename);
+    out << *generate_grp() << std::endl;
+    out.close();
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::parse_from_grp(std::istream &is) {
+    /// Nature
+    std::string line;
+    getline(is, line);
+    if (line.substr(0, 5) == "graph") {
+        if (get_nature() != UNDIRECTED) {
+            GRAPH_THROW_WITH(invalid_argument, "Bad graph nature (expected 'graph')")
+        }
+    } else if (line.substr(0, 7) == "digraph") {
+        if (get_nature() != DIRECTED) {
+            GRAPH_THROW_WITH(invalid_argument, "Bad graph nature (expected 'digraph')")
+        }
+    } else {
+        GRAPH_THROW_WITH(parse_error, is.tellg(), "Bad graph nature (expected '[di]graph')")
+    }
+
+    /// Nodes
+    getline(is, line);
+    if (line != "    nodes: {") {
+        GRAPH_THROW_WITH(parse_error, is.tellg(), "Bad format for nodes")
+    }
+
+    clear();
+    while (getline(is, line) && line.find('}') == std::string::npos) {
+        std::istringstream iss{line};
+        Key key;
+        T value;
+        detail::read_T(iss, key);
+        detail::read_T(iss, value);
+
+        add_node(key, value);
+    }
+
+    /// Edges
+    getline(is, line);
+    if (line == "}") {}
+    else if (line != "    edges: {") {
+        GRAPH_THROW_WITH(parse_error, is.tellg(), "Bad format for edges")
+    } else {
+        while (getline(is, line) && line.find('}') == std::string::npos) {
+            std::istringstream iss{line};
+            key_type from;
+            key_type to;
+            cost_type cost;
+            detail::read_T(iss, from);
+            detail::read_T(iss, to);
+            detail::read_cost(iss, cost);
+
+            add_edge(from, to, cost);
+        }
+
+        getline(is, line);
+        if (line != "}") {
+            GRAPH_THROW_WITH(parse_error, is.tellg(), "Bad format at the end of the graph")
+        }
+    }
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+template <class K, class D, class C, Nature N, class I>
+bool graph<Key, T, Cost, Nat, Index>::operator==(const graph<K, D, C, N, I> &other) const noexcept {
+    typedef typename graph<Key, T, Cost, Nat, Index>::const_iterator Iterator1;
+    typedef typename graph<K, D, C, N, I>::const_iterator Iterator2;
+
+    typedef typename graph<Key, T, Cost, Nat, Index>::node::edge Edge1;
+    typedef typename graph<K, D, C, N, I>  ::node::edge Edge2;
+
+    if (get_nature()        != other.get_nature()    ||
+            get_nbr_nodes() != other.get_nbr_nodes() ||
+            get_nbr_edges() != other.get_nbr_edges()) {
+        return false;
+    }
+
+    for (Iterator1 it1{cbegin()}; it1 != cend(); ++it1) {
+        /// Both graphs may not iterate in the same order: the nodes are matched by key
+        Iterator2 it2{other.find(it1->first)};
+        if (it2 == other.cend()) {
+            return false;
+        }
+
+        /// Test nodes value
+        if (!(it1->second->get()        == it2->second->get()) ||
+                !(it1->second->degree() == it2->second->degree())) {
+            return false;
+        }
+
+        /// Test out edges
+        const typename graph<Key, T, Cost, Nat, Index>::node::ListEdges &edges1{it1->second->get_edges()};
+        const typename graph<K, D, C, N, I>  ::node::ListEdges &edges2{it2->second->get_edges()};
+
+        std::map<Key, Edge1> child1;
+        std::map<Key, Edge2> child2;
+
+        std::transform(edges1.begin(), edges1.end(), std::inserter(child1, child1.end()), [](const Edge1 & e) {
+            return std::make_pair(e.target()->first, e);
+        });
+        std::transform(edges2.begin(), edges2.end(), std::inserter(child2, child2.end()), [](const Edge2 & e) {
+            return std::make_pair(e.target()->first, e);
+        });
+
+        typename std::map<Key, Edge1>::const_iterator edge1{child1.cbegin()};
+        typename std::map<Key, Edge2>::const_iterator edge2{child2.cbegin()};
+
+        for (; (edge1 != child1.cend() || edge2 != child2.cend()); ++edge1, ++edge2) {
+            Iterator1 target1{edge1->second.target()};
+            Iterator2 target2{edge2->second.target()};
+
+            if (!(target1->first == target2->first && edge1->second.cost() == edge2->second.cost())) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+template <class K, class D, class C, Nature N, class I>
+bool graph<Key, T, Cost, Nat, Index>::operator!=(const graph<K, D, C, N, I> &other) const noexcept {
+    return !(*this == other);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+graph<Key, T, Cost, Nat, Index>::node::node() : node(graphed_type()) {}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+graph<Key, T, Cost, Nat, Index>::node::node(const graphed_type &d) : basic_node<graphed_type, cost_type, iterator, const_iterator>(d) {}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+graph<Key, T, Cost, Nat, Index>::node::node(const graphed_type &d, const typename node::EdgesAllocator &alloc)
+    : basic_node<graphed_type, cost_type, iterator, const_iterator>(d, alloc) {}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+graph<Key, T, Cost, Nat, Index>::node::node(graphed_type &&d, const typename node::EdgesAllocator &alloc)
+    : basic_node<graphed_type, cost_type, iterator, const_iterator>(std::move(d), alloc) {}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::node &graph<Key, T, Cost, Nat, Index>::node::operator=(const graphed_type &d) {
+    this->set(d);
+    return *this;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::node::set_iterator_values(iterator this_, iterator end, const_iterator cend) {
+    this->container_from_this = this_;
+    this->end_container       = end;
+    this->cend_container      = cend;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+template <bool insertFront, class Goal>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::abstract_first_search(const_iterator start, Goal &is_goal) const {
+    if (start == cend()) {
+        GRAPH_THROW_WITH(invalid_argument, "Start point equals to graph::cend()")
+    }
+
+    using basic_node_type = typename node::basic_node;
+
+    /// Search state by dense index: the path is only rebuilt from the parents once the goal is reached
+    std::vector<bool> expanded(_indices_bound, false);
+    std::vector<std::pair<const basic_node_type*, cost_type>> parents(_indices_bound, std::make_pair(nullptr, cost_type()));
+    const basic_node_type* goal{nullptr};
+
+    if (insertFront) {
+        /// DFS: a node is expanded from the last edge pushed towards it, so the frontier keeps every pushed edge
+        struct pushed_edge {
+            const basic_node_type* target;
+            const basic_node_type* source;
+            cost_type              cost;
+        };
+        std::vector<pushed_edge> frontier;
+        frontier.push_back(pushed_edge{start->second.get(), nullptr, cost_type()});
+
+        while (!frontier.empty()) {
+            const pushed_edge e{frontier.back()};
+            frontier.pop_back();
+
+            const size_type i{index_of(e.target)};
+            if (expanded[i]) {
+                continue;
+            }
+            expanded[i] = true;
+            parents[i]  = std::make_pair(e.source, e.cost);
+
+            if (is_goal(e.target->container_from_this)) {
+                goal = e.target;
+                break;
+            }
+
+            for (const typename node::edge &out : e.target->_out_edges) {
+                if (!expanded[index_of(out._target)]) {
+                    frontier.push_back(pushed_edge{out._target, e.target, out.cost()});
+                }
+            }
+        }
+    } else {
+        /// BFS: a node is expanded from the first edge reaching it, so it is queued once, when discovered
+        std::vector<const basic_node_type*> frontier;
+        frontier.reserve(size());
+        frontier.push_back(start->second.get());
+        expanded[index_of(start->second.get())] = true;
+
+        for (size_type head{0}; head < frontier.size(); ++head) {
+            const basic_node_type* current{frontier[head]};
+            if (is_goal(current->container_from_this)) {
+                goal = current;
+                break;
+            }
+
+            for (const typename node::edge &out : current->_out_edges) {
+                const size_type i{index_of(out._target)};
+                if (!expanded[i]) {
+                    expanded[i] = true;
+                    parents[i]  = std::make_pair(current, out.cost());
+                    frontier.push_back(out._target);
+                }
+            }
+        }
+    }
+
+    search_path result;
+    for (const basic_node_type* current{goal}; current != nullptr; current = parents[index_of(current)].first) {
+        result.push_front(std::make_pair(const_iterator(current->container_from_this), parents[index_of(current)].second));
+    }
+
+    return result;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::bfs(key_type start, Key target) const {
+    return bfs(find(start), find(target));
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::bfs(key_type start, std::list<key_type> target_list) const {
+    std::list<const_iterator> l;
+    for (key_type k : target_list) {
+        l.emplace_back(find(k));
+    }
+    return bfs(find(start), l);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::bfs(key_type start, std::function<bool(key_type)> is_goal) const {
+    return bfs(find(start), [ &is_goal](const_iterator it) {
+        return is_goal(it->first);
+    });
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::bfs(const_iterator start, const_iterator target) const {
+    return bfs(start, [ &target](const_iterator node) -> bool { return node == target; });
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::bfs(const_iterator start, std::list<const_iterator> target_list) const {
+    return bfs(start, [ &target_list](const_iterator node) -> bool { return std::find(target_list.cbegin(), target_list.cend(), node) != target_list.cend(); });
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::bfs(const_iterator start, std::function<bool(const_iterator)> is_goal) const {
+    return abstract_first_search<false>(start, is_goal);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+template <class Goal>
+auto graph<Key, T, Cost, Nat, Index>::bfs(key_type start, Goal is_goal) const -> GRAPH_REQUIRES(search_path, GRAPH_SEARCH_GOAL(Goal, key_type)) {
+    return bfs(find(start), [ &is_goal](const_iterator it) {
+        return is_goal(it->first);
+    });
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+template <class Goal>
+auto graph<Key, T, Cost, Nat, Index>::bfs(const_iterator start, Goal is_goal) const -> GRAPH_REQUIRES(search_path, GRAPH_SEARCH_GOAL(Goal, const_iterator)) {
+    return abstract_first_search<false>(start, is_goal);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::dfs(key_type start, Key target) const {
+    return dfs(find(start), find(target));
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::dfs(key_type start, std::list<key_type> target_list) const {
+    std::list<const_iterator> l;
+    for (key_type k : target_list) {
+        l.emplace_back(find(k));
+    }
+    return dfs(find(start), l);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::dfs(key_type start, std::function<bool(key_type)> is_goal) const {
+    return dfs(find(start), [ &is_goal](const_iterator it) {
+        return is_goal(it->first);
+    });
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::dfs(const_iterator start, const_iterator target) const {
+    return dfs(start, [ &target](const_iterator node) -> bool { return node == target; });
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::dfs(const_iterator start, std::list<const_iterator> target_list) const {
+    return dfs(start, [ &target_list](const_iterator node) -> bool { return std::find(target_list.cbegin(), target_list.cend(), node) != target_list.cend(); });
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::dfs(const_iterator start, std::function<bool(const_iterator)> is_goal) const {
+    return abstract_first_search<true>(start, is_goal);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+template <class Goal>
+auto graph<Key, T, Cost, Nat, Index>::dfs(key_type start, Goal is_goal) const -> GRAPH_REQUIRES(search_path, GRAPH_SEARCH_GOAL(Goal, key_type)) {
+    return dfs(find(start), [ &is_goal](const_iterator it) {
+        return is_goal(it->first);
+    });
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+template <class Goal>
+auto graph<Key, T, Cost, Nat, Index>::dfs(const_iterator start, Goal is_goal) const -> GRAPH_REQUIRES(search_path, GRAPH_SEARCH_GOAL(Goal, const_iterator)) {
+    return abstract_first_search<true>(start, is_goal);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::dls(key_type start, Key target, size_type depth) const {
+    std::list<const_iterator> l;
+    l.emplace_back(find(target));
+    return dls(find(start), l, depth);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::dls(key_type start, std::list<key_type> target_list, size_type depth) const {
+    std::list<const_iterator> l;
+    for (key_type k : target_list) {
+        l.emplace_back(find(k));
+    }
+    return dls(find(start), l, depth);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::dls(key_type start, std::function<bool(key_type)> is_goal, size_type depth) const {
+    return dls(find(start), [ &is_goal](const_iterator it) {
+        return is_goal(it->first);
+    }, depth);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::dls(const_iterator start, const_iterator target, size_type depth) const {
+    std::list<const_iterator> l;
+    l.emplace_back(target);
+    return dls(start, l, depth);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::dls(const_iterator start, std::list<const_iterator> target_list, size_type depth) const {
+    return dls(start, [ &target_list](const_iterator node) -> bool { return std::find(target_list.cbegin(), target_list.cend(), node) != target_list.cend(); }, depth);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::dls(const_iterator start, std::function<bool(const_iterator)> is_goal, size_type depth) const {
+    if (start == cend()) {
+        GRAPH_THROW_WITH(invalid_argument, "Start point equals to graph::cend()")
+    }
+
+    std::list<const_iterator> expanded;
+    std::deque<search_path> frontier;
+
+    {
+        search_path p;
+        p.push_back({start, cost_type()});
+        frontier.push_front(std::move(p));
+    }
+
+    int l{0};
+    while (!frontier.empty() && l < depth) {
+        search_path p{frontier.front()};
+        frontier.pop_front();
+
+        if (std::find(expanded.cbegin(), expanded.cend(), p.back().first) == expanded.end()) {
+            const_iterator last{p.back().first};
+            expanded.push_back(last);
+
+            if (is_goal(last)) {
+                return p;
+            }
+
+            const typename node::ListEdges &legalActions{last->second->get_edges()};
+
+            for (typename node::ConstEdgesIterator it{legalActions.cbegin()}; it != legalActions.cend(); ++it) {
+                search_path newPath{p};
+                newPath.push_back({it->target(), it->cost()});
+                frontier.push_front(newPath);
+            }
+        }
+        ++l;
+    }
+
+    search_path empty = {};
+    return empty;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::iddfs(key_type start, Key target) const {
+    std::list<const_iterator> l;
+    l.emplace_back(find(target));
+    return iddfs(find(start), l);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::iddfs(key_type start, std::list<key_type> target_list) const {
+    std::list<const_iterator> l;
+    for (key_type k : target_list) {
+        l.emplace_back(find(k));
+    }
+    return iddfs(find(start), l);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::iddfs(key_type start, std::function<bool(key_type)> is_goal) const {
+    return iddfs(find(start), [ &is_goal](const_iterator it) {
+        return is_goal(it->first);
+    });
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::iddfs(const_iterator start, const_iterator target) const {
+    std::list<const_iterator> l;
+    l.emplace_back(target);
+    return iddfs(start, l);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::iddfs(const_iterator start, std::list<const_iterator> target_list) const {
+    return iddfs(start, [ &target_list](const_iterator node) -> bool { return std::find(target_list.cbegin(), target_list.cend(), node) != target_list.cend(); });
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::iddfs(const_iterator start, std::function<bool(const_iterator)> is_goal) const {
+    if (start == cend()) {
+        GRAPH_THROW_WITH(invalid_argument, "Start point equals to graph::cend()")
+    }
+
+    for (size_type i{0}; i < std::numeric_limits<size_type>::max(); ++i) {
+        const search_path found{dls(start, is_goal, i)};
+        if (!found.empty()) {
+            return found;
+        }
+    }
+    search_path empty = {};
+    return empty;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::ucs(key_type start, Key target) const {
+    return ucs(find(start), find(target));
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::ucs(key_type start, std::list<key_type> target_list) const {
+    std::list<const_iterator> l;
+    for (key_type k : target_list) {
+        l.emplace_back(find(k));
+    }
+    return ucs(find(start), l);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::ucs(key_type start, std::function<bool(key_type)> is_goal) const {
+    return ucs(find(start), [ &is_goal](const_iterator it) {
+        return is_goal(it->first);
+    });
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::ucs(const_iterator start, const_iterator target) const {
+    return ucs(start, [ &target](const_iterator node) -> bool { return node == target; });
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::ucs(const_iterator start, std::list<const_iterator> target_list) const {
+    return ucs(start, [ &target_list](const_iterator node) -> bool { return std::find(target_list.cbegin(), target_list.cend(), node) != target_list.cend(); });
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::ucs(const_iterator start, std::function<bool(const_iterator)> is_goal) const {
+    return ucs<std::function<bool(const_iterator)>>(start, std::move(is_goal));
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+template <class Goal>
+auto graph<Key, T, Cost, Nat, Index>::ucs(key_type start, Goal is_goal) const -> GRAPH_REQUIRES(search_path, GRAPH_SEARCH_GOAL(Goal, key_type)) {
+    return ucs(find(start), [ &is_goal](const_iterator it) {
+        return is_goal(it->first);
+    });
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+template <class Goal>
+auto graph<Key, T, Cost, Nat, Index>::ucs(const_iterator start, Goal is_goal) const -> GRAPH_REQUIRES(search_path, GRAPH_SEARCH_GOAL(Goal, const_iterator)) {
+    if (start == cend()) {
+        GRAPH_THROW_WITH(invalid_argument, "Start point equals to graph::cend()")
+    }
+
+    search_path result;
+    null_heuristic heuristic;
+    best_first_search(start, is_goal, heuristic, false, result);
+
+    return result;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::astar(key_type start, Key target, std::function<cost_type(const_iterator)> heuristic) const {
+    const_iterator it{this->find(target)};
+    return astar(find(start), [ &it](const_iterator node) -> bool { return it == node; }, heuristic);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::astar(key_type start, std::list<key_type> target_list, std::function<cost_type(const_iterator)> heuristic) const {
+    std::list<const_iterator> l;
+    for (key_type k : target_list) {
+        l.emplace_back(find(k));
+    }
+    return astar(find(start), l, heuristic);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::astar(key_type start, std::function<bool(key_type)> is_goal, std::function<cost_type(const_iterator)> heuristic) const {
+    return astar(find(start), [ &is_goal](const_iterator it) {
+        return is_goal(it->first);
+    }, heuristic);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::astar(const_iterator start, const_iterator target, std::function<cost_type(const_iterator)> heuristic) const {
+    return astar(start, [ &target](const_iterator node) -> bool { return target == node; }, heuristic);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::astar(const_iterator start, std::list<const_iterator> target_list, std::function<cost_type(const_iterator)> heuristic) const {
+    return astar(start, [ &target_list](const_iterator node) -> bool { return std::find(target_list.cbegin(), target_list.cend(), node) != target_list.cend(); }, heuristic);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::astar(const_iterator start, std::function<bool(const_iterator)> is_goal, std::function<cost_type(const_iterator)> heuristic) const {
+    return astar<std::function<bool(const_iterator)>, std::function<cost_type(const_iterator)>>(start, std::move(is_goal), std::move(heuristic));
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+template <class Heuristic>
+auto graph<Key, T, Cost, Nat, Index>::astar(key_type start, key_type target, Heuristic heuristic) const
+    -> GRAPH_REQUIRES(search_path, GRAPH_SEARCH_HEURISTIC(Heuristic, const_iterator, cost_type)) {
+    return astar(find(start), find(target), std::move(heuristic));
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+template <class Heuristic>
+auto graph<Key, T, Cost, Nat, Index>::astar(key_type start, std::list<key_type> target_list, Heuristic heuristic) const
+    -> GRAPH_REQUIRES(search_path, GRAPH_SEARCH_HEURISTIC(Heuristic, const_iterator, cost_type)) {
+    std::list<const_iterator> l;
+    for (key_type k : target_list) {
+        l.emplace_back(find(k));
+    }
+    return astar(find(start), l, std::move(heuristic));
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+template <class Goal, class Heuristic>
+auto graph<Key, T, Cost, Nat, Index>::astar(key_type start, Goal is_goal, Heuristic heuristic) const
+    -> GRAPH_REQUIRES(search_path, GRAPH_SEARCH_GOAL(Goal, key_type) && GRAPH_SEARCH_HEURISTIC(Heuristic, const_iterator, cost_type)) {
+    return astar(find(start), [ &is_goal](const_iterator it) {
+        return is_goal(it->first);
+    }, std::move(heuristic));
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+template <class Heuristic>
+auto graph<Key, T, Cost, Nat, Index>::astar(const_iterator start, const_iterator target, Heuristic heuristic) const
+    -> GRAPH_REQUIRES(search_path, GRAPH_SEARCH_HEURISTIC(Heuristic, const_iterator, cost_type)) {
+    return astar(start, [ &target](const_iterator node) -> bool { return node == target; }, std::move(heuristic));
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+template <class Heuristic>
+auto graph<Key, T, Cost, Nat, Index>::astar(const_iterator start, std::list<const_iterator> target_list, Heuristic heuristic) const
+    -> GRAPH_REQUIRES(search_path, GRAPH_SEARCH_HEURISTIC(Heuristic, const_iterator, cost_type)) {
+    return astar(start, [ &target_list](const_iterator node) -> bool { return std::find(target_list.cbegin(), target_list.cend(), node) != target_list.cend(); }, std::move(heuristic));
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+template <class Goal, class Heuristic>
+auto graph<Key, T, Cost, Nat, Index>::astar(const_iterator start, Goal is_goal, Heuristic heuristic) const
+    -> GRAPH_REQUIRES(search_path, GRAPH_SEARCH_GOAL(Goal, const_iterator) && GRAPH_SEARCH_HEURISTIC(Heuristic, const_iterator, cost_type)) {
+    if (start == cend()) {
+        GRAPH_THROW_WITH(invalid_argument, "Start point equals to graph::cend()")
+    }
+
+    search_path result;
+    /// A* cannot be computed with negative weights.
+    if (!best_first_search(start, is_goal, heuristic, true, result)) {
+        GRAPH_THROW(negative_edge)
+    }
+
+    return result;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+template <class Goal, class Heuristic>
+bool graph<Key, T, Cost, Nat, Index>::best_first_search(const_iterator start, Goal &is_goal, Heuristic &heuristic, bool reject_negative, search_path &result) const {
+    using basic_node_type = typename node::basic_node;
+
+    const cost_type nul_cost{cost_type()};
+
+    /// Search state by dense index; `nodes` is only set for the discovered nodes
+    std::vector<const basic_node_type*> nodes(_indices_bound, nullptr);
+    std::vector<cost_type> distances(_indices_bound, nul_cost);
+    std::vector<cost_type> heuristics(_indices_bound, nul_cost);
+    std::vector<bool> expanded(_indices_bound, false);
+    std::vector<std::pair<const basic_node_type*, cost_type>> parents(_indices_bound, std::make_pair(nullptr, nul_cost));
+    detail::indexed_heap<cost_type> frontier(_indices_bound);
+
+    {
+        const size_type i{index_of(start->second.get())};
+        nodes[i]      = start->second.get();
+        heuristics[i] = heuristic(start);
+        frontier.push(i, heuristics[i]);
+    }
+
+    const basic_node_type* goal{nullptr};
+    while (!frontier.empty()) {
+        const size_type i{frontier.pop()};
+        const basic_node_type* current{nodes[i]};
+        expanded[i] = true;
+
+        if (is_goal(current->container_from_this)) {
+            goal = current;
+            break;
+        }
+
+        for (const typename node::edge &out : current->_out_edges) {
+            const cost_type cost{out.cost()};
+            if (reject_negative && cost < nul_cost) {
+                return false;
+            }
+
+            const size_type j{index_of(out._target)};
+            if (expanded[j]) {
+                continue;
+            }
+
+            const cost_type alt{distances[i] + cost};
+            if (nodes[j] == nullptr) {
+                nodes[j]      = out._target;
+                heuristics[j] = heuristic(const_iterator(out._target->container_from_this));
+            } else if (!(alt < distances[j])) {
+                continue;
+            }
+            distances[j] = alt;
+            parents[j]   = std::make_pair(current, cost);
+            frontier.push(j, alt + heuristics[j]);
+        }
+    }
+
+    result.clear();
+    for (const basic_node_type* current{goal}; current != nullptr; current = parents[index_of(current)].first) {
+        result.push_front(std::make_pair(const_iterator(current->container_from_this), parents[index_of(current)].second));
+    }
+    return true;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::shortest_paths graph<Key, T, Cost, Nat, Index>::dijkstra(key_type start) const {
+    return dijkstra(find(start), [](const_iterator) {
+        return false;
+    });
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::shortest_paths graph<Key, T, Cost, Nat, Index>::dijkstra(key_type start, key_type target) const {
+    const_iterator it{this->find(target)};
+    return dijkstra(find(start), [ &it](const_iterator node) -> bool { return it == node; });
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::shortest_paths graph<Key, T, Cost, Nat, Index>::dijkstra(key_type start, std::list<key_type> target_list) const {
+    std::list<const_iterator> l;
+    for (key_type k : target_list) {
+        l.emplace_back(find(k));
+    }
+    return dijkstra(find(start), l);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::shortest_paths graph<Key, T, Cost, Nat, Index>::dijkstra(key_type start, std::function<bool(key_type)> is_goal) const {
+    return dijkstra(find(start), [ &is_goal](const_iterator it) {
+        return is_goal(it->first);
+    });
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::shortest_paths graph<Key, T, Cost, Nat, Index>::dijkstra(const_iterator start) const {
+    return dijkstra(start, [](const_iterator) {
+        return false;
+    });
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::shortest_paths graph<Key, T, Cost, Nat, Index>::dijkstra(const_iterator start, const_iterator target) const {
+    return dijkstra(start, [ &target](const_iterator node) -> bool { return target == node; });
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::shortest_paths graph<Key, T, Cost, Nat, Index>::dijkstra(const_iterator start, std::list<const_iterator> target_list) const {
+    return dijkstra(start, [ &target_list](const_iterator node) -> bool { return std::find(target_list.cbegin(), target_list.cend(), node) != target_list.cend(); });
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::shortest_paths graph<Key, T, Cost, Nat, Index>::dijkstra(const_iterator start, std::function<bool(const_iterator)> is_goal) const {
+    if (start == cend()) {
+        GRAPH_THROW_WITH(invalid_argument, "Start point equals to graph::cend()")
+    }
+
+    shortest_paths result(*this, start);
+    dijkstra(is_goal, result, integral_cost_tag());
+    return result;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::dijkstra(std::function<bool(const_iterator)> &is_goal, shortest_paths &result, std::true_type) const {
+    using radix_key = typename std::make_unsigned<cost_type>::type;
+
+    const cost_type nul_cost{cost_type()};
+
+    /// The distances are settled in increasing order: a radix heap replaces the comparisons between the costs.
+    /// A node is pushed again when its distance decreases, the outdated entries are skipped when popped.
+    std::vector<bool> settled(_indices_bound, false);
+    detail::radix_heap<radix_key, const typename node::basic_node*> Q;
+    Q.push(radix_key(), result._start->second.get());
+
+    while (!Q.empty()) {
+        const std::pair<radix_key, const typename node::basic_node*> top{Q.pop()};
+        const typename node::basic_node* u{top.second};
+        if (settled[index_of(u)]) {
+            continue;
+        }
+        settled[index_of(u)] = true;
+
+        if (is_goal(u->container_from_this)) {
+            break;
+        }
+
+        const cost_type dist_u{static_cast<cost_type>(top.first)};
+        for (const typename node::edge &e : u->_out_edges) {
+            const cost_type cost{e.cost()};
+            /// Dijkstra's algorithm cannot be computed with negative weights.
+            if (cost < nul_cost) {
+                GRAPH_THROW(negative_edge)
+            }
+
+            /// An edge of infinite cost leads nowhere, and a longer path would wrap below the last popped key
+            if (settled[index_of(e._target)] || !(cost < infinity - dist_u)) {
+                continue;
+            }
+
+            const cost_type alt{dist_u + cost};
+            typename shortest_paths::mapped_type &v{result.entry(e._target)};
+
+            if (alt < v.second) {
+                v.first  = u->container_from_this;
+                v.second = alt;
+                Q.push(static_cast<radix_key>(alt), e._target);
+            }
+        }
+    }
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::dijkstra(std::function<bool(const_iterator)> &is_goal, shortest_paths &result, std::false_type) const {
+    const cost_type nul_cost{cost_type()};
+
+    /// Each node is at most once in the queue, whose priorities are lowered in place: no outdated entry is ever popped
+    std::vector<bool> settled(_indices_bound, false);
+    detail::indexed_heap<cost_type> Q(_indices_bound);
+    Q.push(index_of(result._start->second.get()), nul_cost);
+
+    while (!Q.empty()) {
+        const size_type i{Q.top()};
+        const cost_type dist_u{Q.top_priority()};
+        Q.pop();
+        settled[i] = true;
+
+        const typename node::basic_node* u{result[result._positions[i]].first->second.get()};
+        if (is_goal(u->container_from_this)) {
+            break;
+        }
 
-    size_type n{0};
-    for (const_iterator node{cbegin()}; node != cend(); ++node, ++n) {
-        json["nodes"][n]["key"]   = node->first;
-        json["nodes"][n]["value"] = node->second->get();
+        for (const typename node::edge &e : u->_out_edges) {
+            const cost_type cost{e.cost()};
+            /// Dijkstra's algorithm cannot be computed with negative weights.
+            if (cost < nul_cost) {
+                GRAPH_THROW(negative_edge)
+            }
+
+            const size_type j{index_of(e._target)};
+            if (settled[j]) {
+                continue;
+            }
+
+            const cost_type alt{dist_u + cost};
+            typename shortest_paths::mapped_type &v{result.entry(e._target)};
+
+            if (alt < v.second) {
+                v.first  = u->container_from_this;
+                v.second = alt;
+                Q.push(j, alt);
+            }
+        }
     }
+}
 
-    size_type p{0};
-    for (const_iterator node{cbegin()}; node != cend(); ++node) {
-        Set child{node->second->get_edges()};
-        for (typename Set::const_iterator edge{child.begin()}; edge != child.end(); ++edge, ++p) {
-            json["edges"][p]["from"] = node->first;
-            json["edges"][p]["to"]   = edge->target()->first;
-            json["edges"][p]["cost"] = edge->cost();
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::shortest_paths graph<Key, T, Cost, Nat, Index>::bellman_ford(key_type start) const {
+    return bellman_ford(find(start));
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::shortest_paths graph<Key, T, Cost, Nat, Index>::bellman_ford(const_iterator start) const {
+    if (start == cend()) {
+        GRAPH_THROW_WITH(invalid_argument, "Start point equals to graph::cend()")
+    }
+
+    using basic_node_type = typename node::basic_node;
+
+    /// Initialization
+
+    shortest_paths result(*this, start);
+
+    /// Number of edges of the current path to each node, and active nodes waiting to relax their out-edges
+    std::vector<size_type> hops(_indices_bound, 0);
+    std::vector<bool> queued(_indices_bound, false);
+    std::deque<const basic_node_type*> active;
+    active.push_back(start->second.get());
+    queued[index_of(start->second.get())] = true;
+
+    /// Relax the out-edges of the nodes whose distance changed
+
+    while (!active.empty()) {
+        const basic_node_type* u{active.front()};
+        active.pop_front();
+        const size_type i{index_of(u)};
+        queued[i] = false;
+
+        const cost_type dist_u{result.entry(u).second};
+        for (const typename node::edge &e : u->_out_edges) {
+            const cost_type alt{dist_u + e.cost()};
+            typename shortest_paths::mapped_type &v{result.entry(e._target)};
+
+            if (alt < v.second) {
+                v.first  = u->container_from_this;
+                v.second = alt;
+
+                const size_type j{index_of(e._target)};
+                hops[j] = hops[i] + 1;
+                /// Check for negative-weight cycles: a shortest path has less than size() edges
+                if (hops[j] >= size()) {
+                    GRAPH_THROW(negative_weight_cycle)
+                }
+                if (!queued[j]) {
+                    queued[j] = true;
+                    active.push_back(e._target);
+                }
+            }
         }
     }
-    return std::make_unique<nlohmann::json>(std::forward<nlohmann::json>(json));
+
+    return result;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-void graph<Key, T, Cost, Nat>::save_to_json(const char* filename) const {
-    std::ofstream out(filename);
-    out << std::setw(4) << *generate_json() << std::endl;
-    out.close();
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::shortest_paths graph<Key, T, Cost, Nat, Index>::bellman_ford(key_type start, size_type nbr_threads) const {
+    return bellman_ford(find(start), nbr_threads);
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-void graph<Key, T, Cost, Nat>::parse_from_json(std::istream &is) {
-    nlohmann::json json;
-    is >> json;
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::shortest_paths graph<Key, T, Cost, Nat, Index>::bellman_ford(const_iterator start, size_type nbr_threads) const {
+    if (start == cend()) {
+        GRAPH_THROW_WITH(invalid_argument, "Start point equals to graph::cend()")
+    }
 
-    if (static_cast<Nature>(json["nature"]) != get_nature()) {
-        std::string error_msg{"Bad graph nature (expected '"};
-        error_msg += (Nat == DIRECTED ? "graph')" : "digraph')");
-        GRAPH_THROW_WITH(invalid_argument, error_msg.c_str())
+    /// Initialization
+
+    shortest_paths result(*this, start);
+    const size_type V{result.size()};
+
+    /// The sources and the costs of the in-edges of the node at the position v of result are in [offsets[v], offsets[v + 1])
+    std::vector<size_type> offsets(V + 1, 0);
+    std::vector<size_type> sources;
+    std::vector<cost_type> costs;
+    sources.reserve(directed_tag::value ? get_nbr_edges() : 2 * get_nbr_edges());
+    costs.reserve(sources.capacity());
+    for (size_type v{0}; v < V; ++v) {
+        for (const typename node::in_edge &in : result[v].first->second->_in_edges) {
+            sources.push_back(result._positions[index_of(in._source)]);
+            costs.push_back(in._source->_out_edges[in._position].cost());
+        }
+        offsets[v + 1] = sources.size();
     }
 
-    clear();
-    for (const nlohmann::json &node : json["nodes"]) {
-        key_type k = node["key"];
-        graphed_type x = node["value"];
-        add_node(k, x);
+    std::vector<cost_type> distances(V, infinity);
+    distances[result._positions[index_of(start->second.get())]] = cost_type();
+    std::vector<cost_type> next(distances);
+    std::vector<size_type> previous(V, V);
+
+    /// A thread is worth at least this number of nodes to update per round
+    const size_type parallel_threshold{256};
+    detail::thread_pool pool(nbr_threads, V / parallel_threshold);
+    const size_type P{pool.size()};
+    std::vector<char> changed(P, false);
+
+    /// Each thread pulls the new distances of its own share of the nodes from the distances of the previous round
+    const std::function<void(size_type)> round_task = [&](size_type t) {
+        changed[t] = false;
+        for (size_type v{V * t / P}; v < V * (t + 1) / P; ++v) {
+            cost_type best{distances[v]};
+            for (size_type e{offsets[v]}; e != offsets[v + 1]; ++e) {
+                const cost_type dist_u{distances[sources[e]]};
+                if (dist_u != infinity && dist_u + costs[e] < best) {
+                    best        = dist_u + costs[e];
+                    previous[v] = sources[e];
+                    changed[t]  = true;
+                }
+            }
+            next[v] = best;
+        }
+    };
+
+    /// Relax edges in rounds
+
+    for (size_type round{1};; ++round) {
+        pool.run(round_task);
+        distances.swap(next);
+
+        if (std::find(changed.cbegin(), changed.cend(), true) == changed.cend()) {
+            break;
+        }
+        /// Check for negative-weight cycles: a shortest path has less than size() edges
+        if (round >= V) {
+            GRAPH_THROW(negative_weight_cycle)
+        }
     }
-    for (const nlohmann::json &edge : json["edges"]) {
-        key_type from = edge["from"];
-        key_type to = edge["to"];
-        cost_type c;
-        if (edge["cost"].is_null()) {
-            c = infinity;
-        } else {
-            c = edge["cost"];
+
+    for (size_type v{0}; v < V; ++v) {
+        if (previous[v] != V) {
+            result[v].second.first  = result[previous[v]].first;
+            result[v].second.second = distances[v];
         }
-        add_edge(from, to, c);
     }
+    return result;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-void graph<Key, T, Cost, Nat>::DEBUG_load_from_json_rust(const char* path) {
-    nlohmann::json json;
-    std::ifstream is(path);
-    if (!is) {
-        std::cerr << "Unexistent file '" << path << "'!" << std::endl;
-        exit(1);
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::shortest_paths graph<Key, T, Cost, Nat, Index>::delta_stepping(key_type start, cost_type delta, size_type nbr_threads) const {
+    return delta_stepping(find(start), delta, nbr_threads);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::shortest_paths graph<Key, T, Cost, Nat, Index>::delta_stepping(const_iterator start, cost_type delta, size_type nbr_threads) const {
+    if (start == cend()) {
+        GRAPH_THROW_WITH(invalid_argument, "Start point equals to graph::cend()")
     }
-    is >> json;
 
-    clear();
-    for (const nlohmann::json &node : json["nodes"]) {
-        add_node(node);
+    const cost_type nul_cost{cost_type()};
+    if (!(nul_cost < delta)) {
+        GRAPH_THROW_WITH(invalid_argument, "Non-positive bucket width")
     }
 
-    for (const nlohmann::json &edge : json["edges"]) {
-        const_iterator begin{std::next(cbegin(), edge[0])};
-        const_iterator end  {std::next(cbegin(), edge[1])};
-        add_edge(begin, end);
+    using basic_node_type = typename node::basic_node;
+
+    /// A relaxation sent by a thread to the owner of its target, the thread `index_of(target) % P`
+    struct request {
+        const basic_node_type* target;
+        const basic_node_type* source;
+        cost_type              distance;
+    };
+
+    /// Below this number of nodes to expand, a phase is run on the calling thread only, and the pool is not started
+    const size_type parallel_threshold{256};
+    detail::thread_pool pool(nbr_threads, size() / parallel_threshold);
+    const size_type P{pool.size()};
+
+    std::vector<cost_type> distances(_indices_bound, infinity);
+    std::vector<const basic_node_type*> parents(_indices_bound, nullptr);
+    /// `buckets[i]` holds the nodes whose tentative distance was lowered into `[i * delta, (i + 1) * delta)`; outdated entries are skipped
+    /// The buckets are sparse: a large ratio between the distances and @p delta leaves most of them empty
+    std::map<size_type, std::vector<const basic_node_type*>> buckets;
+    std::vector<std::vector<request>> requests(P * P);
+    std::vector<std::vector<const basic_node_type*>> lowered(P);
+    std::vector<char> negative(P, false);
+
+    const auto bucket_of = [delta](cost_type distance) -> size_type {
+        return static_cast<size_type>(distance / delta);
+    };
+
+    /// Relax the light or the heavy edges of the nodes of @p frontier, and file the lowered nodes in their buckets
+    const auto relax = [&](const std::vector<const basic_node_type*> &frontier, bool light) {
+        const size_type nbr_tasks{frontier.size() < parallel_threshold ? 1 : P};
+
+        const std::function<void(size_type)> send = [&](size_type t) {
+            if (t >= nbr_tasks) {
+                return;
+            }
+            for (size_type k{frontier.size() * t / nbr_tasks}; k < frontier.size() * (t + 1) / nbr_tasks; ++k) {
+                const basic_node_type* u{frontier[k]};
+                const cost_type dist_u{distances[index_of(u)]};
+                for (const typename node::edge &e : u->_out_edges) {
+                    const cost_type cost{e.cost()};
+                    if (cost < nul_cost) {
+                        negative[t] = true;
+                    } else if (light == !(delta < cost) && cost < infinity - dist_u) { /// an infinite cost leads nowhere
+                        requests[t * P + index_of(e._target) % P].push_back(request{e._target, u, dist_u + cost});
+                    }
+                }
+            }
+        };
+
+        const std::function<void(size_type)> apply = [&](size_type t) {
+            for (size_type from{0}; from < P; ++from) {
+                for (const request &r : requests[from * P + t]) {
+                    const size_type j{index_of(r.target)};
+                    if (r.distance < distances[j]) {
+                        distances[j] = r.distance;
+                        parents[j]   = r.source;
+                        lowered[t].push_back(r.target);
+                    }
+                }
+                requests[from * P + t].clear();
+            }
+        };
+
+        if (nbr_tasks == 1) {
+            send(0);
+            for (size_type t{0}; t < P; ++t) {
+                apply(t);
+            }
+        } else {
+            pool.run(send);
+            pool.run(apply);
+        }
+
+        for (std::vector<const basic_node_type*> &nodes : lowered) {
+            for (const basic_node_type* v : nodes) {
+                buckets[bucket_of(distances[index_of(v)])].push_back(v);
+            }
+            nodes.clear();
+        }
+    };
+
+    /// Delta-stepping
+
+    distances[index_of(start->second.get())] = nul_cost;
+    buckets[0].push_back(start->second.get());
+
+    /// Round in which each node was last expanded, to expand it once per round
+    std::vector<size_type> expanded(_indices_bound, std::numeric_limits<size_type>::max());
+    size_type round{0};
+
+    std::vector<const basic_node_type*> current, frontier, settled;
+    while (!buckets.empty()) {
+        const size_type i{buckets.cbegin()->first};
+        settled.clear();
+
+        for (typename std::map<size_type, std::vector<const basic_node_type*>>::iterator it{buckets.find(i)}; it != buckets.end(); it = buckets.find(i)) {
+            current.swap(it->second);
+            buckets.erase(it);
+
+            frontier.clear();
+            for (const basic_node_type* u : current) {
+                const size_type k{index_of(u)};
+                if (expanded[k] != round && bucket_of(distances[k]) == i) {
+                    expanded[k] = round;
+                    frontier.push_back(u);
+                }
+            }
+            current.clear();
+            ++round;
+
+            settled.insert(settled.end(), frontier.cbegin(), frontier.cend());
+            relax(frontier, true);
+        }
+
+        frontier.clear();
+        for (const basic_node_type* u : settled) {
+            if (expanded[index_of(u)] != round) {
+                expanded[index_of(u)] = round;
+                frontier.push_back(u);
+            }
+        }
+        ++round;
+        relax(frontier, false);
+
+        /// Delta-stepping cannot be computed with negative weights.
+        if (std::find(negative.cbegin(), negative.cend(), true) != negative.cend()) {
+            GRAPH_THROW(negative_edge)
+        }
+    }
+
+    shortest_paths result(*this, start);
+    for (typename shortest_paths::value_type &e : result) {
+        const size_type k{index_of(e.first->second.get())};
+        if (parents[k] != nullptr) {
+            e.second.first  = parents[k]->container_from_this;
+            e.second.second = distances[k];
+        }
     }
+    return result;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-std::unique_ptr<std::string> graph<Key, T, Cost, Nat>::generate_grp() const {
-    using std::max;
-    using std::ostringstream;
-    using std::setw;
-    using std::string;
-    using std::stringstream;
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::distance_matrix graph<Key, T, Cost, Nat, Index>::all_pairs_shortest_paths(bool keep_paths, size_type nbr_threads) const {
+    const size_type n{size()};
+    std::vector<size_type> positions;
+    distance_matrix result(*this, keep_paths, positions);
 
-    const auto tab{string(4, ' ')};
+    /// Initialization: the cheapest edge between each pair of nodes, and the empty path from each node to itself
 
-    string data;
+    for (const_iterator it{cbegin()}; it != cend(); ++it) {
+        const size_type from{positions[index_of(it->second.get())]};
+        for (const typename node::edge &e : it->second->_out_edges) {
+            const size_type position{from * n + positions[index_of(e._target)]};
+            if (e.cost() < result._distances[position]) {
+                result._distances[position] = e.cost();
+                if (keep_paths) {
+                    result._next[position] = positions[index_of(e._target)];
+                }
+            }
+        }
+    }
+    for (size_type i{0}; i < n; ++i) {
+        if (!(result._distances[i * (n + 1)] < cost_type())) {
+            result._distances[i * (n + 1)] = cost_type();
+            if (keep_paths) {
+                result._next[i * (n + 1)] = i;
+            }
+        }
+    }
 
-    /// Displaying nature + graph types
-    if (get_nature() == DIRECTED) {
-        data += "di";
+    /// Blocked Floyd-Warshall: three blocks of 64 x 64 distances stay in the L2 cache
+
+    cost_type* distances{result._distances.data()};
+    size_type* next{keep_paths ? result._next.data() : nullptr};
+    const size_type B{64};
+    const size_type nbr_blocks{(n + B - 1) / B};
+    size_type k_begin{0}, k_end{0}, kb{0};
+
+    /// A thread is worth at least one block of the matrix: a graph of a single block is run on the calling thread
+    detail::thread_pool pool(nbr_threads, nbr_blocks * nbr_blocks);
+    const size_type P{pool.size()};
+
+    /// The blocks of the row and of the column of the diagonal block only depend on it
+    const std::function<void(size_type)> cross_task = [&](size_type t) {
+        for (size_type b{t}; b < nbr_blocks; b += P) {
+            if (b != kb) {
+                relax_block(distances, next, n, k_begin, k_end, k_begin, k_end, b * B, std::min(n, (b + 1) * B));
+                relax_block(distances, next, n, k_begin, k_end, b * B, std::min(n, (b + 1) * B), k_begin, k_end);
+            }
+        }
+    };
+    /// The other blocks only depend on the blocks of their row and of their column
+    const std::function<void(size_type)> remaining_task = [&](size_type t) {
+        for (size_type b{t}; b < nbr_blocks * nbr_blocks; b += P) {
+            const size_type bi{b / nbr_blocks}, bj{b % nbr_blocks};
+            if (bi != kb && bj != kb) {
+                relax_block(distances, next, n, k_begin, k_end, bi * B, std::min(n, (bi + 1) * B), bj * B, std::min(n, (bj + 1) * B));
+            }
+        }
+    };
+
+    for (kb = 0; kb < nbr_blocks; ++kb) {
+        k_begin = kb * B;
+        k_end   = std::min(n, k_begin + B);
+
+        relax_block(distances, next, n, k_begin, k_end, k_begin, k_end, k_begin, k_end);
+        pool.run(cross_task);
+        pool.run(remaining_task);
+
+        /// Check for negative-weight cycles: a node would be at a negative distance from itself
+        for (size_type i{0}; i < n; ++i) {
+            if (distances[i * (n + 1)] < cost_type()) {
+                GRAPH_THROW(negative_weight_cycle)
+            }
+        }
     }
 
-    data += "graph<" + detail::type_name<Key>() + ", " +
-            detail::type_name<graphed_type>() + ", " +
-            detail::type_name<cost_type>() + "> {\n" +
-            tab + "nodes: {\n";
+    return result;
+}
 
-    /// Displaying nodes:  "<name>"; "<value>",
-    size_type max_size{3};
-    for_each(cbegin(), cend(), [&max_size](const value_type & element) {
-        ostringstream out;
-        out << element.first;
-        const size_type size{static_cast<size_type>(out.tellp())};
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::relax_block(cost_type* distances, size_type* next, size_type n, size_type k_begin, size_type k_end,
+                                                   size_type i_begin, size_type i_end, size_type j_begin, size_type j_end) const {
+    /// Local copy, that the stores into the rows cannot alias
+    const cost_type inf{infinity};
 
-        max_size = max(max_size, size);
-    });
+    for (size_type k{k_begin}; k < k_end; ++k) {
+        const cost_type* row_k{distances + k * n};
+        for (size_type i{i_begin}; i < i_end; ++i) {
+            cost_type* row_i{distances + i * n};
+            const cost_type d_ik{row_i[k]};
+            if (d_ik == inf) {
+                continue;
+            }
 
-    for (const_iterator it{cbegin()}; it != cend(); ++it) {
-        ostringstream out;
-        out << it->first << "\",";
+            /// Branch-free inner loops over contiguous rows
+            /// The addend is selected before the sum: with integral costs, d_ik + inf would overflow
+            if (next == nullptr) {
+                for (size_type j{j_begin}; j < j_end; ++j) {
+                    const bool reachable{row_k[j] != inf};
+                    const cost_type alt{d_ik + (reachable ? row_k[j] : cost_type())};
+                    row_i[j] = reachable && alt < row_i[j] ? alt : row_i[j];
+                }
+            } else {
+                size_type* next_i{next + i * n};
+                const size_type hop{next_i[k]};
+                for (size_type j{j_begin}; j < j_end; ++j) {
+                    const bool reachable{row_k[j] != inf};
+                    const cost_type alt{d_ik + (reachable ? row_k[j] : cost_type())};
+                    const bool shorter{reachable && alt < row_i[j]};
+                    row_i[j]  = shorter ? alt : row_i[j];
+                    next_i[j] = shorter ? hop : next_i[j];
+                }
+            }
+        }
+    }
+}
 
-        stringstream ss;
-        ss << tab << tab
-           << '"' << std::left << setw(static_cast<int>(max_size + 3)) << out.str()
-           << '"' << it->second->get() << '"';
-        data += ss.str();
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::distance_matrix graph<Key, T, Cost, Nat, Index>::johnson(bool keep_paths, size_type nbr_threads) const {
+    const size_type n{size()};
+    std::vector<size_type> positions;
+    distance_matrix result(*this, keep_paths, positions);
 
-        if (it != --cend()) {
-            data += ";";
+    /// The out-edges of the node i are the positions [offsets[i], offsets[i + 1]) of targets and costs
+    std::vector<size_type> offsets(n + 1, 0);
+    std::vector<size_type> targets;
+    std::vector<cost_type> costs;
+    for (const_iterator it{cbegin()}; it != cend(); ++it) {
+        for (const typename node::edge &e : it->second->_out_edges) {
+            /// An edge of infinite cost leads nowhere: left out, it cannot overflow the reweighted costs
+            if (e.cost() != infinity) {
+                targets.push_back(positions[index_of(e._target)]);
+                costs.push_back(e.cost());
+            }
         }
-        data += "\n";
+        offsets[positions[index_of(it->second.get())] + 1] = targets.size();
     }
-    data += tab + "}";
 
-    /// Displaying edges:  "<node 1>"; "<node 2>"; "<cost>",
-    if (get_nbr_edges() == 0) {
-        data += "\n}";
-    } else {
-        data += ",\n" + tab + "edges: {\n";
-        size_type max_size_1{0}, max_size_2{0};
+    /// Potentials: Bellman-Ford from a virtual node linked to every node by an edge of null cost
 
-        for_each(cbegin(), cend(), [&max_size_1, &max_size_2, this](const value_type & element) {
-            std::list<typename node::edge> child{element.second->get_edges()};
-            for_each(child.cbegin(), child.cend(), [ &, this](const typename node::edge & i) {
-                ostringstream out_1, out_2;
-                out_1 << element.first;
-                out_2 << i.target()->first;
+    std::vector<cost_type> potentials(n, cost_type());
+    std::vector<size_type> hops(n, 0);
+    std::vector<bool> queued(n, true);
+    std::deque<size_type> active;
+    for (size_type i{0}; i < n; ++i) {
+        active.push_back(i);
+    }
+    while (!active.empty()) {
+        const size_type u{active.front()};
+        active.pop_front();
+        queued[u] = false;
+
+        for (size_type e{offsets[u]}; e != offsets[u + 1]; ++e) {
+            const size_type v{targets[e]};
+            if (potentials[u] + costs[e] < potentials[v]) {
+                potentials[v] = potentials[u] + costs[e];
+                hops[v]       = hops[u] + 1;
+                /// Check for negative-weight cycles: a shortest path has less than size() edges
+                if (hops[v] >= n) {
+                    GRAPH_THROW(negative_weight_cycle)
+                }
+                if (!queued[v]) {
+                    queued[v] = true;
+                    active.push_back(v);
+                }
+            }
+        }
+    }
 
-                const size_type size_1{static_cast<size_type>(out_1.tellp())};
-                const size_type size_2{static_cast<size_type>(out_2.tellp())};
+    /// Reweighting: non-negative costs, up to the rounding errors of floating-point costs
+    for (size_type u{0}; u < n; ++u) {
+        for (size_type e{offsets[u]}; e != offsets[u + 1]; ++e) {
+            costs[e] = std::max(cost_type(), costs[e] + potentials[u] - potentials[targets[e]]);
+        }
+    }
 
-                max_size_1 = max(max_size_1, size_1);
-                max_size_2 = max(max_size_2, size_2);
-            });
-        });
+    /// A Dijkstra's search from every source, in its own row of the matrix
 
-        size_type p{0};
-        for_each(cbegin(), cend(), [this, &data, &p, tab, max_size_1, max_size_2](const value_type & element) {
-            std::list<typename node::edge> child{element.second->get_edges()};
-            for_each(child.cbegin(), child.cend(), [this, &data, &p, tab, &element, max_size_1, max_size_2](const typename node::edge & i) {
-                ostringstream out_1, out_2;
-                out_1 << '"' << element.first     << "\",";
-                out_2 << '"' << i.target()->first << "\",";
+    /// A thread is worth at least this number of pops and relaxations
+    const size_type parallel_threshold{1 << 16};
+    detail::thread_pool pool(nbr_threads, n * (n + offsets[n]) / parallel_threshold);
+    const size_type P{pool.size()};
+    const cost_type inf{infinity};
 
-                stringstream ss;
-                ss << std::left << tab << tab
-                   << setw(static_cast<int>(max_size_1 + 4)) << out_1.str()
-                   << setw(static_cast<int>(max_size_2 + 4)) << out_2.str();
-                if (i.cost() == infinity) {
-                    ss << "infinity";
-                } else {
-                    ss << '"' << i.cost() << '"';
+    const std::function<void(size_type)> search_task = [&](size_type t) {
+        detail::indexed_heap<cost_type> heap(n);
+        for (size_type s{t}; s < n; s += P) {
+            cost_type* distances{result._distances.data() + s * n};
+            size_type* next{keep_paths ? result._next.data() + s * n : nullptr};
+
+            distances[s] = cost_type();
+            if (next != nullptr) {
+                next[s] = s;
+            }
+            heap.push(s, cost_type());
+            while (!heap.empty()) {
+                const cost_type dist_u{heap.top_priority()};
+                const size_type u{heap.pop()};
+
+                for (size_type e{offsets[u]}; e != offsets[u + 1]; ++e) {
+                    const size_type v{targets[e]};
+                    const cost_type alt{dist_u + costs[e]};
+                    if (alt < distances[v]) {
+                        distances[v] = alt;
+                        if (next != nullptr) {
+                            next[v] = u == s ? v : next[u];
+                        }
+                        heap.push(v, alt);
+                    }
                 }
+            }
 
-                if (p < (this->get_nature() == DIRECTED ?
-                         this->get_nbr_edges() : 2 * this->get_nbr_edges()) - 1) {
-                    ss << ';';
+            /// Back to the original costs
+            for (size_type v{0}; v < n; ++v) {
+                if (distances[v] != inf) {
+                    distances[v] = distances[v] - potentials[s] + potentials[v];
                 }
-                ss << '\n';
-                data += ss.str();
-                p++;
-            });
-        });
-        data += tab + "}\n}";
-    }
+            }
+        }
+    };
+    pool.run(search_task);
 
-    return std::make_unique<std::string>(std::forward<std::string>(data));
+    return result;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-void graph<Key, T, Cost, Nat>::save_to_grp(const char* filename) const {
-    std::ofstream out(filename);
-    out << *generate_grp() << std::endl;
-    out.close();
+template <class Key, class T, class Cost, Nature Nat, class Index>
+graph<Key, T, Cost, Nat, Index>::search_path::search_path(const search_path &p) : Container(p) {}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::cost_type graph<Key, T, Cost, Nat, Index>::search_path::total_cost() const {
+    cost_type total{};
+    for (const_iterator it{cbegin()}; it != cend(); ++it) {
+        total += it->second;
+    }
+    return total;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-void graph<Key, T, Cost, Nat>::parse_from_grp(std::istream &is) {
-    /// Nature
-    std::string line;
-    getline(is, line);
-    if (line.substr(0, 5) == "graph") {
-        if (get_nature() != UNDIRECTED) {
-            GRAPH_THROW_WITH(invalid_argument, "Bad graph nature (expected 'graph')")
-        }
-    } else if (line.substr(0, 7) == "digraph") {
-        if (get_nature() != DIRECTED) {
-            GRAPH_THROW_WITH(invalid_argument, "Bad graph nature (expected 'digraph')")
+template <class Key, class T, class Cost, Nature Nat, class Index>
+bool graph<Key, T, Cost, Nat, Index>::search_path::contain(const graph::const_iterator &i) const {
+    for (const_iterator it{cbegin()}; it != cend(); ++it) {
+        if (it->first == i) {
+            return true;
         }
-    } else {
-        GRAPH_THROW_WITH(parse_error, is.tellg(), "Bad graph nature (expected '[di]graph')")
     }
+    return false;
+}
 
-    /// Nodes
-    getline(is, line);
-    if (line != "    nodes: {") {
-        GRAPH_THROW_WITH(parse_error, is.tellg(), "Bad format for nodes")
+template <class Key, class T, class Cost, Nature Nat, class Index>
+graph<Key, T, Cost, Nat, Index>::shortest_paths::shortest_paths(const graph &g, graph::const_iterator start)
+    : _graph(&g), _start(start), _positions(g._indices_bound, 0) {
+    this->reserve(g.size());
+    for (graph::const_iterator it{g.cbegin()}; it != g.cend(); ++it) {
+        _positions[graph::index_of(it->second.get())] = this->size();
+        this->emplace_back(it, std::make_pair(g.cend(), g.infinity));
     }
 
-    clear();
-    while (getline(is, line) && line.find('}') == std::string::npos) {
-        std::istringstream iss{line};
-        Key key;
-        T value;
-        detail::read_T(iss, key);
-        detail::read_T(iss, value);
+    mapped_type &s{entry(start->second.get())};
+    s.first  = start;
+    s.second = cost_type();
+}
 
-        add_node(key, value);
-    }
+template <class Key, class T, class Cost, Nature Nat, class Index>
+graph<Key, T, Cost, Nat, Index>::shortest_paths::shortest_paths(const shortest_paths &p) : Container(p), _graph(p._graph), _start(p._start), _positions(p._positions) {}
 
-    /// Edges
-    getline(is, line);
-    if (line == "}") {}
-    else if (line != "    edges: {") {
-        GRAPH_THROW_WITH(parse_error, is.tellg(), "Bad format for edges")
-    } else {
-        while (getline(is, line) && line.find('}') == std::string::npos) {
-            std::istringstream iss{line};
-            key_type from;
-            key_type to;
-            cost_type cost;
-            detail::read_T(iss, from);
-            detail::read_T(iss, to);
-            detail::read_cost(iss, cost);
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::shortest_paths::mapped_type &graph<Key, T, Cost, Nat, Index>::shortest_paths::entry(const typename node::basic_node* n) {
+    return (*this)[_positions[graph::index_of(n)]].second;
+}
 
-            add_edge(from, to, cost);
-        }
+template <class Key, class T, class Cost, Nature Nat, class Index>
+const typename graph<Key, T, Cost, Nat, Index>::shortest_paths::mapped_type &graph<Key, T, Cost, Nat, Index>::shortest_paths::entry(const typename node::basic_node* n) const {
+    return (*this)[_positions[graph::index_of(n)]].second;
+}
 
-        getline(is, line);
-        if (line != "}") {
-            GRAPH_THROW_WITH(parse_error, is.tellg(), "Bad format at the end of the graph")
-        }
+template <class Key, class T, class Cost, Nature Nat, class Index>
+const typename graph<Key, T, Cost, Nat, Index>::shortest_paths::mapped_type *graph<Key, T, Cost, Nat, Index>::shortest_paths::find_entry(graph::const_iterator it) const {
+    /// Nodes added since the search are past the end; a reused dense index points to the entry of another node
+    if (it == _graph->cend()) {
+        return nullptr;
     }
+    const size_type index{graph::index_of(it->second.get())};
+    if (index >= _positions.size() || (*this)[_positions[index]].first != it) {
+        return nullptr;
+    }
+    return &(*this)[_positions[index]].second;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-template <class K, class D, class C, Nature N>
-bool graph<Key, T, Cost, Nat>::operator==(const graph<K, D, C, N> &other) const noexcept {
-    typedef typename graph<Key, T, Cost, Nat>::const_iterator Iterator1;
-    typedef typename graph<K, D, C, N>::const_iterator Iterator2;
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::const_iterator graph<Key, T, Cost, Nat, Index>::shortest_paths::get_previous(graph::const_iterator current) const {
+    const mapped_type* e{find_entry(current)};
+    return e == nullptr ? _graph->cend() : e->first;
+}
 
-    typedef typename graph<Key, T, Cost, Nat>::node::edge Edge1;
-    typedef typename graph<K, D, C, N>  ::node::edge Edge2;
+template <class Key, class T, class Cost, Nature Nat, class Index>
+Cost graph<Key, T, Cost, Nat, Index>::shortest_paths::get_distance(graph::key_type target) const {
+    const graph::const_iterator it{_graph->find(target)};
+    return it == _graph->cend() ? _graph->infinity : get_distance(it);
+}
 
-    if (get_nature()        != other.get_nature()    ||
-            get_nbr_nodes() != other.get_nbr_nodes() ||
-            get_nbr_edges() != other.get_nbr_edges()) {
-        return false;
+template <class Key, class T, class Cost, Nature Nat, class Index>
+Cost graph<Key, T, Cost, Nat, Index>::shortest_paths::get_distance(graph::const_iterator target) const {
+    const mapped_type* e{find_entry(target)};
+    return e == nullptr ? _graph->infinity : e->second;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::shortest_paths::get_path(graph::key_type target) const {
+    const graph::const_iterator it{_graph->find(target)};
+    return it == _graph->cend() ? graph::search_path() : get_path(it);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::shortest_paths::get_path(graph::const_iterator target) const {
+    graph::search_path result;
+    if (target == _graph->cend() || get_distance(target) == _graph->infinity) {
+        return result;
     }
 
-    Iterator1 it1{cbegin()};
-    Iterator2 it2{other.cbegin()};
+    for (graph::const_iterator current{target}; current != _start;) {
+        const mapped_type &e{entry(current->second.get())};
+        result.emplace_front(current, e.second - entry(e.first->second.get()).second);
+        current = e.first;
+    }
 
-    for (; (it1 != cend() || it2 != other.cend()); ++it1, ++it2) {
-        /// Test nodes value
-        if (!(it1->first                == it2->first)         ||
-                !(it1->second->get()    == it2->second->get()) ||
-                !(it1->second->degree() == it2->second->degree())) {
-            return false;
-        }
+    if (target != _start) {
+        result.emplace_front(_start, cost_type());
+    }
 
-        /// Test out edges
-        std::list<Edge1> edges1{it1->second->get_edges()};
-        std::list<Edge2> edges2{it2->second->get_edges()};
+    return result;
+}
 
-        std::map<Key, Edge1> child1;
-        std::map<Key, Edge2> child2;
+template <class Key, class T, class Cost, Nature Nat, class Index>
+Cost graph<Key, T, Cost, Nat, Index>::null_heuristic::operator()(const const_iterator &) const {
+    return cost_type();
+}
 
-        std::transform(edges1.begin(), edges1.end(), std::inserter(child1, child1.end()), [](const Edge1 & e) {
-            return std::make_pair(e.target()->first, e);
-        });
-        std::transform(edges2.begin(), edges2.end(), std::inserter(child2, child2.end()), [](const Edge2 & e) {
-            return std::make_pair(e.target()->first, e);
-        });
+template <class Key, class T, class Cost, Nature Nat, class Index>
+bool graph<Key, T, Cost, Nat, Index>::iterator_comparator::operator()(const const_iterator &lhs, const const_iterator &rhs) const {
+    return lhs->first < rhs->first;
+}
 
-        typename std::map<Key, Edge1>::const_iterator edge1{child1.cbegin()};
-        typename std::map<Key, Edge2>::const_iterator edge2{child2.cbegin()};
+template <class Key, class T, class Cost, Nature Nat, class Index>
+graph<Key, T, Cost, Nat, Index>::distance_matrix::distance_matrix(const graph &g, bool keep_paths, std::vector<size_type> &positions) {
+    const size_type n{g.size()};
 
-        for (; (edge1 != child1.cend() || edge2 != child2.cend()); ++edge1, ++edge2) {
-            Iterator1 target1{edge1->second.target()};
-            Iterator2 target2{edge2->second.target()};
+    positions.assign(g._indices_bound, n);
+    _keys.reserve(n);
+    for (const_iterator it{g.cbegin()}; it != g.cend(); ++it) {
+        positions[index_of(it->second.get())] = _keys.size();
+        _keys.push_back(it->first);
+    }
 
-            if (!(target1->first == target2->first && edge1->second.cost() == edge2->second.cost())) {
-                return false;
-            }
-        }
+    _distances.assign(n * n, g.infinity);
+    if (keep_paths) {
+        _next.assign(n * n, n);
     }
 
-    return true;
+    _sorted = detail::sorted_permutation(_keys);
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-template <class K, class D, class C, Nature N>
-bool graph<Key, T, Cost, Nat>::operator!=(const graph<K, D, C, N> &other) const noexcept {
-    return !(*this == other);
+template <class Key, class T, class Cost, Nature Nat, class Index>
+bool graph<Key, T, Cost, Nat, Index>::distance_matrix::empty() const noexcept {
+    return _keys.empty();
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-graph<Key, T, Cost, Nat>::node::node() : node(graphed_type()) {}
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::distance_matrix::size() const noexcept {
+    return _keys.size();
+}
 
-template <class Key, class T, class Cost, Nature Nat>
-graph<Key, T, Cost, Nat>::node::node(const graphed_type &d) {
-    this->_data = d;
+template <class Key, class T, class Cost, Nature Nat, class Index>
+bool graph<Key, T, Cost, Nat, Index>::distance_matrix::has_paths() const noexcept {
+    return !_next.empty() || _keys.empty();
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::node &graph<Key, T, Cost, Nat>::node::operator=(const graphed_type &d) {
-    this->set(d);
-    return *this;
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::distance_matrix::find(const key_type &k) const {
+    return detail::find_index(_keys, _sorted, k);
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-void graph<Key, T, Cost, Nat>::node::set_iterator_values(iterator this_, iterator end, const_iterator cend) {
-    this->container_from_this = this_;
-    this->end_container       = end;
-    this->cend_container      = cend;
+template <class Key, class T, class Cost, Nature Nat, class Index>
+const Key &graph<Key, T, Cost, Nat, Index>::distance_matrix::get_key(size_type i) const {
+    return _keys[i];
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-template <bool insertFront>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::abstract_first_search(const_iterator start, std::function<bool(const_iterator)> is_goal) const {
-    if (start == cend()) {
-        GRAPH_THROW_WITH(invalid_argument, "Start point equals to graph::cend()")
+template <class Key, class T, class Cost, Nature Nat, class Index>
+Cost graph<Key, T, Cost, Nat, Index>::distance_matrix::get_distance(size_type from, size_type to) const {
+    if (from >= size() || to >= size()) {
+        return std::numeric_limits<cost_type>::has_infinity ? std::numeric_limits<cost_type>::infinity() : std::numeric_limits<cost_type>::max();
     }
+    return _distances[from * size() + to];
+}
 
-    std::list<const_iterator> expanded;
-    std::deque<search_path> frontier;
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::distance_matrix::get_next(size_type from, size_type to) const {
+    if (!has_paths()) {
+        GRAPH_THROW_WITH(invalid_argument, "Paths not kept by all_pairs_shortest_paths")
+    }
+    if (from >= size() || to >= size()) {
+        return size();
+    }
+    return _next[from * size() + to];
+}
 
-    {
-        search_path p;
-        p.push_back({start, cost_type()});
-        frontier.push_front(std::move(p));
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::vector<std::size_t> graph<Key, T, Cost, Nat, Index>::distance_matrix::get_path(size_type from, size_type to) const {
+    std::vector<size_type> path;
+    size_type current{from};
+    if (get_next(from, to) == size()) {
+        return path;
     }
 
-    while (!frontier.empty()) {
-        search_path p{frontier.front()};
-        frontier.pop_front();
+    path.push_back(current);
+    while (current != to) {
+        current = _next[current * size() + to];
+        path.push_back(current);
+    }
+    return path;
+}
 
-        if (std::find(expanded.cbegin(), expanded.cend(), p.back().first) == expanded.end()) {
-            const_iterator last{p.back().first};
-            expanded.push_back(last);
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::frozen_graph graph<Key, T, Cost, Nat, Index>::freeze() const {
+    frozen_graph result;
 
-            if (is_goal(last)) {
-                return p;
-            }
+    /// Dense indices, in the order of the keys
+    std::vector<size_type> indices(_indices_bound, size());
+    result._keys.reserve(size());
+    result._values.reserve(size());
+    for (const_iterator it{cbegin()}; it != cend(); ++it) {
+        indices[index_of(it->second.get())] = result._keys.size();
+        result._keys.push_back(it->first);
+        result._values.push_back(it->second->get());
+    }
 
-            std::vector<typename node::edge> legalActions{get_nature() == DIRECTED ? get_out_edges(last) : get_edges(last)};
+    /// Compressed-sparse-row adjacency, each row sorted by target
+    result._offsets.reserve(size() + 1);
+    result._offsets.push_back(0);
+    std::vector<std::pair<size_type, cost_type>> row;
+    for (const_iterator it{cbegin()}; it != cend(); ++it) {
+        row.clear();
+        for (const typename node::edge &e : it->second->_out_edges) {
+            row.emplace_back(indices[index_of(e._target)], e.cost());
+        }
+        std::sort(row.begin(), row.end(), [](const std::pair<size_type, cost_type> &lhs, const std::pair<size_type, cost_type> &rhs) {
+            return lhs.first < rhs.first;
+        });
 
-            for (typename std::vector<typename node::edge>::const_iterator it{legalActions.cbegin()}; it != legalActions.cend(); ++it) {
-                search_path newPath{p};
-                newPath.push_back({it->target(), it->cost()});
-                if (insertFront) {
-                    frontier.push_front(newPath);
-                } else {
-                    frontier.push_back(newPath);
-                }
-            }
+        for (const std::pair<size_type, cost_type> &p : row) {
+            result._targets.push_back(p.first);
+            result._costs.push_back(p.second);
         }
+        result._offsets.push_back(result._targets.size());
     }
+    result._num_edges = _num_edges;
 
-    search_path empty = {};
-    return empty;
+    result._sorted = detail::sorted_permutation(result._keys);
+
+    return result;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::bfs(key_type start, Key target) const {
-    std::list<const_iterator> l;
-    l.emplace_back(find(target));
-    return bfs(find(start), l);
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::publish() {
+    std::shared_ptr<frozen_graph> result{std::make_shared<frozen_graph>(freeze())};
+    result->_version = ++_version;
+    _published.store(std::move(result));
+    return _version;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::bfs(key_type start, std::list<key_type> target_list) const {
-    std::list<const_iterator> l;
-    for (key_type k : target_list) {
-        l.emplace_back(find(k));
-    }
-    return bfs(find(start), l);
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::snapshot_type graph<Key, T, Cost, Nat, Index>::snapshot() const {
+    snapshot_type result{_published.load()};
+    return result ? result : std::make_shared<const frozen_graph>();
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::bfs(key_type start, std::function<bool(key_type)> is_goal) const {
-    return bfs(find(start), [ &is_goal](const_iterator it) {
-        return is_goal(it->first);
-    });
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::get_version() const noexcept {
+    return _version;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::bfs(const_iterator start, const_iterator target) const {
-    std::list<const_iterator> l;
-    l.emplace_back(target);
-    return bfs(start, l);
+template <class Key, class T, class Cost, Nature Nat, class Index>
+bool graph<Key, T, Cost, Nat, Index>::frozen_graph::empty() const noexcept {
+    return _keys.empty();
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::bfs(const_iterator start, std::list<const_iterator> target_list) const {
-    return bfs(start, [ &target_list](const_iterator node) -> bool { return std::find(target_list.cbegin(), target_list.cend(), node) != target_list.cend(); });
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::frozen_graph::size() const noexcept {
+    return _keys.size();
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::bfs(const_iterator start, std::function<bool(const_iterator)> is_goal) const {
-    return abstract_first_search<false>(start, is_goal);
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::frozen_graph::get_nbr_nodes() const noexcept {
+    return _keys.size();
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::dfs(key_type start, Key target) const {
-    std::list<const_iterator> l;
-    l.emplace_back(find(target));
-    return dfs(find(start), l);
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::frozen_graph::get_nbr_edges() const noexcept {
+    return _num_edges;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::dfs(key_type start, std::list<key_type> target_list) const {
-    std::list<const_iterator> l;
-    for (key_type k : target_list) {
-        l.emplace_back(find(k));
-    }
-    return dfs(find(start), l);
+template <class Key, class T, class Cost, Nature Nat, class Index>
+Nature graph<Key, T, Cost, Nat, Index>::frozen_graph::get_nature() const noexcept {
+    return Nat;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::dfs(key_type start, std::function<bool(key_type)> is_goal) const {
-    return dfs(find(start), [ &is_goal](const_iterator it) {
-        return is_goal(it->first);
-    });
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::frozen_graph::get_version() const noexcept {
+    return _version;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::dfs(const_iterator start, const_iterator target) const {
-    std::list<const_iterator> l;
-    l.emplace_back(target);
-    return dfs(start, l);
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::frozen_graph::find(const key_type &k) const {
+    return detail::find_index(_keys, _sorted, k);
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::dfs(const_iterator start, std::list<const_iterator> target_list) const {
-    return dfs(start, [ &target_list](const_iterator node) -> bool { return std::find(target_list.cbegin(), target_list.cend(), node) != target_list.cend(); });
+template <class Key, class T, class Cost, Nature Nat, class Index>
+const Key &graph<Key, T, Cost, Nat, Index>::frozen_graph::get_key(size_type i) const {
+    return _keys[i];
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::dfs(const_iterator start, std::function<bool(const_iterator)> is_goal) const {
-    return abstract_first_search<true>(start, is_goal);
+template <class Key, class T, class Cost, Nature Nat, class Index>
+const T &graph<Key, T, Cost, Nat, Index>::frozen_graph::get(size_type i) const {
+    return _values[i];
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::dls(key_type start, Key target, size_type depth) const {
-    std::list<const_iterator> l;
-    l.emplace_back(find(target));
-    return dls(find(start), l, depth);
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::frozen_graph::degree(size_type i) const {
+    return _offsets[i + 1] - _offsets[i];
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::dls(key_type start, std::list<key_type> target_list, size_type depth) const {
-    std::list<const_iterator> l;
-    for (key_type k : target_list) {
-        l.emplace_back(find(k));
-    }
-    return dls(find(start), l, depth);
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::frozen_graph::edges_begin(size_type i) const {
+    return _offsets[i];
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::dls(key_type start, std::function<bool(key_type)> is_goal, size_type depth) const {
-    return dls(find(start), [ &is_goal](const_iterator it) {
-        return is_goal(it->first);
-    }, depth);
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::frozen_graph::edges_end(size_type i) const {
+    return _offsets[i + 1];
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::dls(const_iterator start, const_iterator target, size_type depth) const {
-    std::list<const_iterator> l;
-    l.emplace_back(target);
-    return dls(start, l, depth);
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::frozen_graph::target(size_type e) const {
+    return _targets[e];
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::dls(const_iterator start, std::list<const_iterator> target_list, size_type depth) const {
-    return dls(start, [ &target_list](const_iterator node) -> bool { return std::find(target_list.cbegin(), target_list.cend(), node) != target_list.cend(); }, depth);
+template <class Key, class T, class Cost, Nature Nat, class Index>
+const Cost &graph<Key, T, Cost, Nat, Index>::frozen_graph::cost(size_type e) const {
+    return _costs[e];
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::dls(const_iterator start, std::function<bool(const_iterator)> is_goal, size_type depth) const {
-    if (start == cend()) {
-        GRAPH_THROW_WITH(invalid_argument, "Start point equals to graph::cend()")
+template <class Key, class T, class Cost, Nature Nat, class Index>
+bool graph<Key, T, Cost, Nat, Index>::frozen_graph::existing_edge(size_type from, size_type to) const {
+    if (from >= size() || to >= size()) {
+        return false;
     }
+    return std::binary_search(_targets.cbegin() + _offsets[from], _targets.cbegin() + _offsets[from + 1], to);
+}
 
-    std::list<const_iterator> expanded;
-    std::deque<search_path> frontier;
+template <class Key, class T, class Cost, Nature Nat, class Index>
+Cost graph<Key, T, Cost, Nat, Index>::frozen_graph::get_cost(size_type from, size_type to) const {
+    const cost_type infinity{std::numeric_limits<cost_type>::has_infinity ? std::numeric_limits<cost_type>::infinity() : std::numeric_limits<cost_type>::max()};
+    if (from >= size() || to >= size()) {
+        return infinity;
+    }
 
-    {
-        search_path p;
-        p.push_back({start, cost_type()});
-        frontier.push_front(std::move(p));
+    typename std::vector<size_type>::const_iterator first{_targets.cbegin() + _offsets[from]};
+    typename std::vector<size_type>::const_iterator last {_targets.cbegin() + _offsets[from + 1]};
+    typename std::vector<size_type>::const_iterator it{std::lower_bound(first, last, to)};
+    if (it == last || *it != to) {
+        return infinity;
+    }
+    return _costs[static_cast<size_type>(it - _targets.cbegin())];
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::frozen_graph::search_path graph<Key, T, Cost, Nat, Index>::frozen_graph::bfs(size_type start, size_type target) const {
+    if (start >= size()) {
+        GRAPH_THROW_WITH(invalid_argument, "Start point out of the frozen graph")
+    }
+
+    std::vector<size_type> previous(size(), size());
+    std::vector<size_type> queue;
+    queue.reserve(size());
+    queue.push_back(start);
+    previous[start] = start;
+
+    for (size_type head{0}; head < queue.size() && previous[target < size() ? target : start] == size(); ++head) {
+        const size_type u{queue[head]};
+        for (size_type e{_offsets[u]}; e != _offsets[u + 1]; ++e) {
+            const size_type v{_targets[e]};
+            if (previous[v] == size()) {
+                previous[v] = u;
+                queue.push_back(v);
+            }
+        }
+    }
+
+    search_path result;
+    if (target >= size() || previous[target] == size()) {
+        return result;
+    }
+
+    std::vector<size_type> nodes;
+    for (size_type current{target}; current != start; current = previous[current]) {
+        nodes.push_back(current);
+    }
+    result.emplace_back(start, cost_type());
+    for (typename std::vector<size_type>::const_reverse_iterator it{nodes.crbegin()}; it != nodes.crend(); ++it) {
+        result.emplace_back(*it, get_cost(previous[*it], *it));
+    }
+    return result;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::frozen_graph::search_path graph<Key, T, Cost, Nat, Index>::frozen_graph::astar(size_type start, size_type target, std::function<cost_type(size_type)> heuristic) const {
+    if (start >= size()) {
+        GRAPH_THROW_WITH(invalid_argument, "Start point out of the frozen graph")
+    }
+
+    const cost_type nul_cost{cost_type()};
+    const cost_type infinity{std::numeric_limits<cost_type>::has_infinity ? std::numeric_limits<cost_type>::infinity() : std::numeric_limits<cost_type>::max()};
+
+    std::vector<cost_type> distances(size(), infinity);
+    std::vector<size_type> previous (size(), size());
+    std::vector<bool>      expanded (size(), false);
+    /// The heuristic is evaluated once per node, when discovered, and the frontier lowers the priorities in place
+    std::vector<cost_type> heuristics(size(), nul_cost);
+    detail::indexed_heap<cost_type> frontier(size());
+
+    distances[start] = nul_cost;
+    heuristics[start] = heuristic(start);
+    frontier.push(start, heuristics[start]);
+
+    while (!frontier.empty()) {
+        const size_type u{frontier.pop()};
+        expanded[u] = true;
+
+        if (u == target) {
+            std::vector<size_type> nodes;
+            for (size_type current{target}; current != start; current = previous[current]) {
+                nodes.push_back(current);
+            }
+
+            search_path result;
+            result.emplace_back(start, nul_cost);
+            for (typename std::vector<size_type>::const_reverse_iterator it{nodes.crbegin()}; it != nodes.crend(); ++it) {
+                result.emplace_back(*it, distances[*it] - distances[previous[*it]]);
+            }
+            return result;
+        }
+
+        for (size_type e{_offsets[u]}; e != _offsets[u + 1]; ++e) {
+            /// A* cannot be computed with negative weights.
+            if (_costs[e] < nul_cost) {
+                GRAPH_THROW(negative_edge)
+            }
+
+            const size_type v{_targets[e]};
+            const cost_type alt{distances[u] + _costs[e]};
+            if (!expanded[v] && alt < distances[v]) {
+                if (distances[v] == infinity) {
+                    heuristics[v] = heuristic(v);
+                }
+                distances[v] = alt;
+                previous[v] = u;
+                frontier.push(v, alt + heuristics[v]);
+            }
+        }
+    }
+
+    return search_path();
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::frozen_graph::shortest_paths graph<Key, T, Cost, Nat, Index>::frozen_graph::dijkstra(size_type start) const {
+    if (start >= size()) {
+        GRAPH_THROW_WITH(invalid_argument, "Start point out of the frozen graph")
     }
 
-    int l{0};
-    while (!frontier.empty() && l < depth) {
-        search_path p{frontier.front()};
-        frontier.pop_front();
+    using Entry = std::pair<cost_type, size_type>;
+
+    const cost_type nul_cost{cost_type()};
+
+    shortest_paths result(start, size());
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> Q;
 
-        if (std::find(expanded.cbegin(), expanded.cend(), p.back().first) == expanded.end()) {
-            const_iterator last{p.back().first};
-            expanded.push_back(last);
+    result._distances[start] = nul_cost;
+    result._previous[start] = start;
+    Q.emplace(nul_cost, start);
 
-            if (is_goal(last)) {
-                return p;
-            }
+    while (!Q.empty()) {
+        const cost_type dist_u{Q.top().first};
+        const size_type u{Q.top().second};
+        Q.pop();
 
-            std::vector<typename node::edge> legalActions{get_nature() == DIRECTED ? get_out_edges(last) : get_edges(last)};
+        if (result._distances[u] < dist_u) {
+            continue;
+        }
 
-            for (typename std::vector<typename node::edge>::const_iterator it{legalActions.cbegin()}; it != legalActions.cend(); ++it) {
-                search_path newPath{p};
-                newPath.push_back({it->target(), it->cost()});
-                frontier.push_front(newPath);
+        for (size_type e{_offsets[u]}; e != _offsets[u + 1]; ++e) {
+            /// Dijkstra's algorithm cannot be computed with negative weights.
+            if (_costs[e] < nul_cost) {
+                GRAPH_THROW(negative_edge)
+            }
+
+            const size_type v{_targets[e]};
+            const cost_type alt{dist_u + _costs[e]};
+            if (alt < result._distances[v]) {
+                result._distances[v] = alt;
+                result._previous[v] = u;
+                Q.emplace(alt, v);
             }
         }
-        ++l;
     }
 
-    search_path empty = {};
-    return empty;
+    return result;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::iddfs(key_type start, Key target) const {
-    std::list<const_iterator> l;
-    l.emplace_back(find(target));
-    return iddfs(find(start), l);
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::cost_type graph<Key, T, Cost, Nat, Index>::frozen_graph::search_path::total_cost() const {
+    cost_type total{};
+    for (const_iterator it{cbegin()}; it != cend(); ++it) {
+        total += it->second;
+    }
+    return total;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::iddfs(key_type start, std::list<key_type> target_list) const {
-    std::list<const_iterator> l;
-    for (key_type k : target_list) {
-        l.emplace_back(find(k));
+template <class Key, class T, class Cost, Nature Nat, class Index>
+bool graph<Key, T, Cost, Nat, Index>::frozen_graph::search_path::contain(size_type i) const {
+    for (const_iterator it{cbegin()}; it != cend(); ++it) {
+        if (it->first == i) {
+            return true;
+        }
     }
-    return iddfs(find(start), l);
+    return false;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::iddfs(key_type start, std::function<bool(key_type)> is_goal) const {
-    return iddfs(find(start), [ &is_goal](const_iterator it) {
-        return is_goal(it->first);
-    });
-}
+template <class Key, class T, class Cost, Nature Nat, class Index>
+graph<Key, T, Cost, Nat, Index>::frozen_graph::shortest_paths::shortest_paths(size_type start, size_type nbr_nodes)
+    : _start(start),
+      _distances(nbr_nodes, std::numeric_limits<cost_type>::has_infinity ? std::numeric_limits<cost_type>::infinity() : std::numeric_limits<cost_type>::max()),
+      _previous(nbr_nodes, nbr_nodes) {}
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::iddfs(const_iterator start, const_iterator target) const {
-    std::list<const_iterator> l;
-    l.emplace_back(target);
-    return iddfs(start, l);
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::frozen_graph::shortest_paths::get_previous(size_type current) const {
+    return _previous[current];
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::iddfs(const_iterator start, std::list<const_iterator> target_list) const {
-    return iddfs(start, [ &target_list](const_iterator node) -> bool { return std::find(target_list.cbegin(), target_list.cend(), node) != target_list.cend(); });
+template <class Key, class T, class Cost, Nature Nat, class Index>
+Cost graph<Key, T, Cost, Nat, Index>::frozen_graph::shortest_paths::get_distance(size_type current) const {
+    return _distances[current];
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::iddfs(const_iterator start, std::function<bool(const_iterator)> is_goal) const {
-    if (start == cend()) {
-        GRAPH_THROW_WITH(invalid_argument, "Start point equals to graph::cend()")
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::frozen_graph::search_path graph<Key, T, Cost, Nat, Index>::frozen_graph::shortest_paths::get_path(size_type target) const {
+    search_path result;
+    if (target >= size() || _previous[target] == size()) {
+        return result;
     }
 
-    for (size_type i{0}; i < std::numeric_limits<size_type>::max(); ++i) {
-        const search_path found{dls(start, is_goal, i)};
-        if (!found.empty()) {
-            return found;
-        }
+    std::vector<size_type> nodes;
+    for (size_type current{target}; current != _start; current = _previous[current]) {
+        nodes.push_back(current);
     }
-    search_path empty = {};
-    return empty;
+    result.emplace_back(_start, cost_type());
+    for (typename std::vector<size_type>::const_reverse_iterator it{nodes.crbegin()}; it != nodes.crend(); ++it) {
+        result.emplace_back(*it, _distances[*it] - _distances[_previous[*it]]);
+    }
+    return result;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::ucs(key_type start, Key target) const {
-    std::list<const_iterator> l;
-    l.emplace_back(find(target));
-    return ucs(find(start), l);
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::frozen_graph::shortest_paths::size() const noexcept {
+    return _previous.size();
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::ucs(key_type start, std::list<key_type> target_list) const {
-    std::list<const_iterator> l;
-    for (key_type k : target_list) {
-        l.emplace_back(find(k));
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::adjacency_matrix graph<Key, T, Cost, Nat, Index>::to_matrix() const {
+    adjacency_matrix result;
+
+    std::vector<size_type> indices(_indices_bound, size());
+    result._keys.reserve(size());
+    result._values.reserve(size());
+    for (const_iterator it{cbegin()}; it != cend(); ++it) {
+        indices[index_of(it->second.get())] = result._keys.size();
+        result._keys.push_back(it->first);
+        result._values.push_back(it->second->get());
     }
-    return ucs(find(start), l);
-}
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::ucs(key_type start, std::function<bool(key_type)> is_goal) const {
-    return ucs(find(start), [ &is_goal](const_iterator it) {
-        return is_goal(it->first);
-    });
-}
+    result._costs.assign(size() * size(), infinity);
+    result._existing.assign(size() * size(), false);
+    for (const_iterator it{cbegin()}; it != cend(); ++it) {
+        const size_type from{indices[index_of(it->second.get())]};
+        for (const typename node::edge &e : it->second->_out_edges) {
+            const size_type position{from * size() + indices[index_of(e._target)]};
+            result._costs[position]    = e.cost();
+            result._existing[position] = true;
+        }
+    }
+    result._num_edges = _num_edges;
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::ucs(const_iterator start, const_iterator target) const {
-    std::list<const_iterator> l;
-    l.emplace_back(target);
-    return ucs(start, l);
+    result._sorted = detail::sorted_permutation(result._keys);
+
+    return result;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::ucs(const_iterator start, std::list<const_iterator> target_list) const {
-    return ucs(start, [ &target_list](const_iterator node) -> bool { return std::find(target_list.cbegin(), target_list.cend(), node) != target_list.cend(); });
+template <class Key, class T, class Cost, Nature Nat, class Index>
+bool graph<Key, T, Cost, Nat, Index>::adjacency_matrix::empty() const noexcept {
+    return _keys.empty();
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::ucs(const_iterator start, std::function<bool(const_iterator)> is_goal) const {
-    if (start == cend()) {
-        GRAPH_THROW_WITH(invalid_argument, "Start point equals to graph::cend()")
-    }
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::adjacency_matrix::size() const noexcept {
+    return _keys.size();
+}
 
-    std::list<const_iterator> expanded;
-    std::priority_queue<search_path, std::vector<search_path>, path_comparator> frontier((path_comparator([](const_iterator) {
-        return cost_type();
-    })));
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::adjacency_matrix::get_nbr_nodes() const noexcept {
+    return _keys.size();
+}
 
-    {
-        search_path p;
-        p.push_back({start, cost_type()});
-        frontier.push(std::move(p));
-    }
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::adjacency_matrix::get_nbr_edges() const noexcept {
+    return _num_edges;
+}
 
-    while (!frontier.empty()) {
-        search_path p{frontier.top()};
-        frontier.pop();
+template <class Key, class T, class Cost, Nature Nat, class Index>
+Nature graph<Key, T, Cost, Nat, Index>::adjacency_matrix::get_nature() const noexcept {
+    return Nat;
+}
 
-        if (std::find(expanded.cbegin(), expanded.cend(), p.back().first) == expanded.end()) {
-            const_iterator last{p.back().first};
-            expanded.push_back(last);
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::adjacency_matrix::find(const key_type &k) const {
+    return detail::find_index(_keys, _sorted, k);
+}
 
-            if (is_goal(last)) {
-                return p;
-            }
+template <class Key, class T, class Cost, Nature Nat, class Index>
+const Key &graph<Key, T, Cost, Nat, Index>::adjacency_matrix::get_key(size_type i) const {
+    return _keys[i];
+}
 
-            std::vector<typename node::edge> legalActions{get_nature() == DIRECTED ? get_out_edges(last) : get_edges(last)};
+template <class Key, class T, class Cost, Nature Nat, class Index>
+const T &graph<Key, T, Cost, Nat, Index>::adjacency_matrix::get(size_type i) const {
+    return _values[i];
+}
 
-            for (typename std::vector<typename node::edge>::const_iterator it{legalActions.cbegin()}; it != legalActions.cend(); ++it) {
-                search_path newPath{p};
-                newPath.push_back({it->target(), it->cost()});
-                frontier.push(newPath);
-            }
-        }
+template <class Key, class T, class Cost, Nature Nat, class Index>
+bool graph<Key, T, Cost, Nat, Index>::adjacency_matrix::existing_edge(size_type from, size_type to) const {
+    if (from >= size() || to >= size()) {
+        return false;
     }
+    return _existing[from * size() + to];
+}
 
-    search_path empty = {};
-    return empty;
+template <class Key, class T, class Cost, Nature Nat, class Index>
+Cost graph<Key, T, Cost, Nat, Index>::adjacency_matrix::get_cost(size_type from, size_type to) const {
+    if (!existing_edge(from, to)) {
+        return std::numeric_limits<cost_type>::has_infinity ? std::numeric_limits<cost_type>::infinity() : std::numeric_limits<cost_type>::max();
+    }
+    return _costs[from * size() + to];
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::astar(key_type start, Key target, std::function<cost_type(const_iterator)> heuristic) const {
-    const_iterator it{this->find(target)};
-    return astar(find(start), [ &it](const_iterator node) -> bool { return it == node; }, heuristic);
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::adjacency_matrix::mirror_edge(size_type, size_type, std::true_type) {}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::adjacency_matrix::mirror_edge(size_type from, size_type to, std::false_type) {
+    _costs   [to * size() + from] = _costs   [from * size() + to];
+    _existing[to * size() + from] = _existing[from * size() + to];
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::astar(key_type start, std::list<key_type> target_list, std::function<cost_type(const_iterator)> heuristic) const {
-    std::list<const_iterator> l;
-    for (key_type k : target_list) {
-        l.emplace_back(find(k));
+template <class Key, class T, class Cost, Nature Nat, class Index>
+bool graph<Key, T, Cost, Nat, Index>::adjacency_matrix::add_edge(size_type from, size_type to, cost_type cost) {
+    if (from >= size() || to >= size()) {
+        GRAPH_THROW_WITH(invalid_argument, "Node out of the adjacency matrix")
     }
-    return astar(find(start), l, heuristic);
-}
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::astar(key_type start, std::function<bool(key_type)> is_goal, std::function<cost_type(const_iterator)> heuristic) const {
-    return astar(find(start), [ &is_goal](const_iterator it) {
-        return is_goal(it->first);
-    }, heuristic);
+    const bool result{!_existing[from * size() + to]};
+    _costs   [from * size() + to] = cost;
+    _existing[from * size() + to] = true;
+    mirror_edge(from, to, directed_tag());
+
+    if (result) {
+        ++_num_edges;
+    }
+    return result;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::astar(const_iterator start, const_iterator target, std::function<cost_type(const_iterator)> heuristic) const {
-    return astar(start, [ &target](const_iterator node) -> bool { return target == node; }, heuristic);
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::adjacency_matrix::del_edge(size_type from, size_type to) {
+    if (!existing_edge(from, to)) {
+        return 0;
+    }
+
+    _existing[from * size() + to] = false;
+    mirror_edge(from, to, directed_tag());
+    --_num_edges;
+    return 1;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::astar(const_iterator start, std::list<const_iterator> target_list, std::function<cost_type(const_iterator)> heuristic) const {
-    return astar(start, [ &target_list](const_iterator node) -> bool { return std::find(target_list.cbegin(), target_list.cend(), node) != target_list.cend(); }, heuristic);
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::adjacency_matrix::clear_edges() {
+    std::fill(_existing.begin(), _existing.end(), false);
+    _num_edges = 0;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::astar(const_iterator start, std::function<bool(const_iterator)> is_goal, std::function<cost_type(const_iterator)> heuristic) const {
-    if (start == cend()) {
-        GRAPH_THROW_WITH(invalid_argument, "Start point equals to graph::cend()")
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::adjacency_matrix::make_complete(cost_type cost) {
+    std::fill(_costs.begin(), _costs.end(), cost);
+    std::fill(_existing.begin(), _existing.end(), true);
+    for (size_type i{0}; i < size(); ++i) {
+        _existing[i * size() + i] = false;
     }
+    _num_edges = directed_tag::value ? size() * (size() - 1) : size() * (size() - 1) / 2;
+}
 
-    const cost_type nul_cost{cost_type()};
+template <class Key, class T, class Cost, Nature Nat, class Index>
+graph<Key, T, Cost, Nat, Index> graph<Key, T, Cost, Nat, Index>::adjacency_matrix::to_graph() const {
+    graph result;
 
-    std::list<const_iterator> expanded;
-    std::priority_queue<search_path, std::vector<search_path>, path_comparator> frontier((path_comparator(heuristic)));
+    std::vector<node*> nodes;
+    nodes.reserve(size());
+    for (size_type i{0}; i < size(); ++i) {
+        iterator it{result.emplace(_keys[i], _values[i]).first};
+        nodes.push_back(it->second.get());
+    }
 
-    {
-        search_path p;
-        p.push_back({start, nul_cost});
-        frontier.push(std::move(p));
+    /// Row by row, each row reserved once: the edges are known to be distinct
+    for (size_type from{0}; from < size(); ++from) {
+        size_type degree{0};
+        for (size_type to{0}; to < size(); ++to) {
+            degree += _existing[from * size() + to] ? 1 : 0;
+        }
+        nodes[from]->reserve_edges(degree, directed_tag::value ? 0 : degree);
+    }
+    for (size_type from{0}; from < size(); ++from) {
+        for (size_type to{directed_tag::value ? 0 : from}; to < size(); ++to) {
+            if (_existing[from * size() + to]) {
+                typename node::EdgesIterator e{nodes[from]->push_edge(nodes[to], _costs[from * size() + to])};
+                result.push_opposite_edge(nodes[from], nodes[to], *e, directed_tag());
+            }
+        }
     }
+    result._num_edges = _num_edges;
 
-    while (!frontier.empty()) {
-        search_path p{frontier.top()};
-        frontier.pop();
+    return result;
+}
 
-        if (std::find(expanded.cbegin(), expanded.cend(), p.back().first) == expanded.end()) {
-            const_iterator last{p.back().first};
-            expanded.push_back(last);
+template <class Key, class Cost, class Index>
+implicit_graph<Key, Cost, Index>::implicit_graph(neighbours_function neighbours, size_type max_expansions)
+    : _neighbours(std::move(neighbours)), _max_expansions(max_expansions) {
+    if (!_neighbours) {
+        GRAPH_THROW_WITH(invalid_argument, "Empty neighbour function")
+    }
+}
 
-            if (is_goal(last)) {
-                return p;
-            }
+template <class Key, class Cost, class Index>
+std::size_t implicit_graph<Key, Cost, Index>::get_max_expansions() const noexcept {
+    return _max_expansions;
+}
 
-            std::vector<typename node::edge> legalActions{get_nature() == DIRECTED ? get_out_edges(last) : get_edges(last)};
+template <class Key, class Cost, class Index>
+void implicit_graph<Key, Cost, Index>::set_max_expansions(size_type max_expansions) noexcept {
+    _max_expansions = max_expansions;
+}
 
-            for (typename std::vector<typename node::edge>::const_iterator it{legalActions.cbegin()}; it != legalActions.cend(); ++it) {
-                /// Dijkstra's algorithm cannot be computed with negative weights.
-                if (it->cost() < nul_cost) {
-                    GRAPH_THROW(negative_edge)
-                }
+template <class Key, class Cost, class Index>
+typename implicit_graph<Key, Cost, Index>::neighbours_type implicit_graph<Key, Cost, Index>::get_neighbours(const key_type &key) const {
+    neighbours_type result;
+    _neighbours(key, result);
+    return result;
+}
 
-                search_path newPath{p};
-                newPath.push_back({it->target(), it->cost()});
-                frontier.push(newPath);
-            }
-        }
-    }
+template <class Key, class Cost, class Index>
+typename implicit_graph<Key, Cost, Index>::search_path implicit_graph<Key, Cost, Index>::bfs(const key_type &start, const key_type &target) const {
+    return first_search(start, [&target](const key_type &k) {
+        return k == target;
+    });
+}
 
-    search_path empty = {};
-    return empty;
+template <class Key, class Cost, class Index>
+typename implicit_graph<Key, Cost, Index>::search_path implicit_graph<Key, Cost, Index>::bfs(const key_type &start, std::function<bool(key_type)> is_goal) const {
+    return first_search(start, is_goal);
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::shortest_paths graph<Key, T, Cost, Nat>::dijkstra(key_type start) const {
-    return dijkstra(find(start), [](const_iterator) {
-        return false;
+template <class Key, class Cost, class Index>
+typename implicit_graph<Key, Cost, Index>::search_path implicit_graph<Key, Cost, Index>::ucs(const key_type &start, const key_type &target) const {
+    return ucs(start, [&target](const key_type &k) {
+        return k == target;
     });
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::shortest_paths graph<Key, T, Cost, Nat>::dijkstra(key_type start, key_type target) const {
-    const_iterator it{this->find(target)};
-    return dijkstra(find(start), [ &it](const_iterator node) -> bool { return it == node; });
+template <class Key, class Cost, class Index>
+typename implicit_graph<Key, Cost, Index>::search_path implicit_graph<Key, Cost, Index>::ucs(const key_type &start, std::function<bool(key_type)> is_goal) const {
+    size_type goal;
+    const explored e{best_first_search(start, is_goal, std::function<cost_type(key_type)>(), goal)};
+    return e.get_path(goal);
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::shortest_paths graph<Key, T, Cost, Nat>::dijkstra(key_type start, std::list<key_type> target_list) const {
-    std::list<const_iterator> l;
-    for (key_type k : target_list) {
-        l.emplace_back(find(k));
-    }
-    return dijkstra(find(start), l);
+template <class Key, class Cost, class Index>
+typename implicit_graph<Key, Cost, Index>::search_path implicit_graph<Key, Cost, Index>::astar(const key_type &start, const key_type &target, std::function<cost_type(key_type)> heuristic) const {
+    return astar(start, [&target](const key_type &k) {
+        return k == target;
+    }, heuristic);
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::shortest_paths graph<Key, T, Cost, Nat>::dijkstra(key_type start, std::function<bool(key_type)> is_goal) const {
-    return dijkstra(find(start), [ &is_goal](const_iterator it) {
-        return is_goal(it->first);
-    });
+template <class Key, class Cost, class Index>
+typename implicit_graph<Key, Cost, Index>::search_path implicit_graph<Key, Cost, Index>::astar(const key_type &start, std::function<bool(key_type)> is_goal, std::function<cost_type(key_type)> heuristic) const {
+    size_type goal;
+    const explored e{best_first_search(start, is_goal, heuristic, goal)};
+    return e.get_path(goal);
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::shortest_paths graph<Key, T, Cost, Nat>::dijkstra(const_iterator start) const {
-    return dijkstra(start, [](const_iterator) {
+template <class Key, class Cost, class Index>
+typename implicit_graph<Key, Cost, Index>::shortest_paths implicit_graph<Key, Cost, Index>::dijkstra(const key_type &start) const {
+    return dijkstra(start, [](const key_type &) {
         return false;
     });
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::shortest_paths graph<Key, T, Cost, Nat>::dijkstra(const_iterator start, const_iterator target) const {
-    return dijkstra(start, [ &target](const_iterator node) -> bool { return target == node; });
+template <class Key, class Cost, class Index>
+typename implicit_graph<Key, Cost, Index>::shortest_paths implicit_graph<Key, Cost, Index>::dijkstra(const key_type &start, std::function<bool(key_type)> is_goal) const {
+    size_type goal;
+    return shortest_paths(best_first_search(start, is_goal, std::function<cost_type(key_type)>(), goal));
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::shortest_paths graph<Key, T, Cost, Nat>::dijkstra(const_iterator start, std::list<const_iterator> target_list) const {
-    return dijkstra(start, [ &target_list](const_iterator node) -> bool { return std::find(target_list.cbegin(), target_list.cend(), node) != target_list.cend(); });
-}
+template <class Key, class Cost, class Index>
+typename implicit_graph<Key, Cost, Index>::search_path implicit_graph<Key, Cost, Index>::first_search(const key_type &start, std::function<bool(key_type)> is_goal) const {
+    explored e;
+    e.discover(start, cost_type(), 0);
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::shortest_paths graph<Key, T, Cost, Nat>::dijkstra(const_iterator start, std::function<bool(const_iterator)> is_goal) const {
-    if (start == cend()) {
-        GRAPH_THROW_WITH(invalid_argument, "Start point equals to graph::cend()")
-    }
+    neighbours_type neighbours;
+    /// The indices are given in the order of discovery: the queue of a BFS is the range [head, keys.size())
+    for (size_type head{0}; head < e.keys.size() && head < _max_expansions; ++head) {
+        if (is_goal(e.keys[head])) {
+            return e.get_path(head);
+        }
 
-    struct pair_iterator_comparator {
-        bool operator()(const std::pair<const_iterator, cost_type> &lhs, const std::pair<const_iterator, cost_type> &rhs) const {
-            return lhs.second < rhs.second;
+        neighbours.clear();
+        _neighbours(e.keys[head], neighbours);
+        for (const std::pair<key_type, cost_type> &n : neighbours) {
+            e.discover(n.first, e.distances[head] + n.second, head);
         }
-    };
+    }
 
-    /// Initialization
+    return search_path();
+}
 
+template <class Key, class Cost, class Index>
+typename implicit_graph<Key, Cost, Index>::explored implicit_graph<Key, Cost, Index>::best_first_search(const key_type &start, std::function<bool(key_type)> is_goal,
+                                                                                                       std::function<cost_type(key_type)> heuristic, size_type &goal) const {
     const cost_type nul_cost{cost_type()};
-    std::priority_queue<std::pair<const_iterator, cost_type>, std::vector<std::pair<const_iterator, cost_type >>, pair_iterator_comparator> Q;
-
-    shortest_paths result(start);
-    for (const_iterator it{cbegin()}; it != cend(); ++it) {
-        result.emplace(it, std::make_pair(cend(), infinity));
-    }
-    Q.emplace(start, nul_cost);
 
-    typename shortest_paths::iterator S{result.find(start)};
-    S->second.first = start;
-    S->second.second = nul_cost;
+    explored e;
+    /// Heuristic of every discovered node, evaluated once; the frontier lowers the priorities in place
+    std::vector<cost_type> heuristics;
+    detail::indexed_heap<cost_type> frontier;
 
-    /// Dijkstra's algorithm
+    e.discover(start, nul_cost, 0);
+    heuristics.push_back(heuristic ? heuristic(start) : nul_cost);
+    frontier.push(0, heuristics[0]);
 
-    while (!Q.empty()) {
-        const_iterator u{Q.top().first};
-        Q.pop();
+    neighbours_type neighbours;
+    for (size_type nbr_expansions{0}; !frontier.empty() && nbr_expansions < _max_expansions; ++nbr_expansions) {
+        const size_type u{frontier.pop()};
+        e.expanded[u] = true;
 
-        if (is_goal(u)) {
-            break;
+        if (is_goal(e.keys[u])) {
+            goal = u;
+            return e;
         }
 
-        std::vector<typename node::edge> adj{get_out_edges(u)};
-        for (typename std::vector<typename node::edge>::const_iterator edge{adj.cbegin()}; edge != adj.cend(); ++edge) {
-            const_iterator v{edge->target()};
-
-            cost_type cost{u->second->get_cost(v)};
-            /// Dijkstra's algorithm cannot be computed with negative weights.
-            if (cost < nul_cost) {
+        neighbours.clear();
+        _neighbours(e.keys[u], neighbours);
+        for (const std::pair<key_type, cost_type> &n : neighbours) {
+            /// Best-first searches cannot be computed with negative weights.
+            if (n.second < nul_cost) {
                 GRAPH_THROW(negative_edge)
             }
 
-            cost_type dist_u{result[u].second};
-            cost_type dist_v{result[v].second};
-
-            cost_type alt{dist_u + cost};
-
-            if (alt < dist_v) {
-                result[v].first = u;
-                result[v].second = alt;
-                Q.emplace(v, alt);
+            const cost_type alt{e.distances[u] + n.second};
+            const std::pair<size_type, bool> v{e.discover(n.first, alt, u)};
+            if (v.second) {
+                heuristics.push_back(heuristic ? heuristic(n.first) : nul_cost);
+            } else if (e.expanded[v.first] || !(alt < e.distances[v.first])) {
+                continue;
             }
+            e.distances[v.first] = alt;
+            e.previous [v.first] = u;
+            frontier.push(v.first, alt + heuristics[v.first]);
         }
     }
 
-    return result;
-}
-
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::shortest_paths graph<Key, T, Cost, Nat>::bellman_ford(key_type start) const {
-    return bellman_ford(find(start));
+    goal = e.keys.size();
+    return e;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::shortest_paths graph<Key, T, Cost, Nat>::bellman_ford(const_iterator start) const {
-    if (start == cend()) {
-        GRAPH_THROW_WITH(invalid_argument, "Start point equals to graph::cend()")
+template <class Key, class Cost, class Index>
+std::pair<std::size_t, bool> implicit_graph<Key, Cost, Index>::explored::discover(const key_type &key, cost_type distance, size_type from) {
+    const std::pair<typename Index::template map<key_type, size_type>::iterator, bool> it{ids.emplace(key, keys.size())};
+    if (it.second) {
+        keys.push_back(key);
+        distances.push_back(distance);
+        previous.push_back(from);
+        expanded.push_back(false);
     }
+    return std::make_pair(it.first->second, it.second);
+}
 
-    /// Initialization
+template <class Key, class Cost, class Index>
+std::size_t implicit_graph<Key, Cost, Index>::explored::find(const key_type &key) const {
+    const typename Index::template map<key_type, size_type>::const_iterator it{ids.find(key)};
+    return it == ids.cend() ? keys.size() : it->second;
+}
 
-    shortest_paths result(start);
-    for (const_iterator it{cbegin()}; it != cend(); ++it) {
-        result.emplace(it, std::make_pair(cend(), infinity));
+template <class Key, class Cost, class Index>
+typename implicit_graph<Key, Cost, Index>::search_path implicit_graph<Key, Cost, Index>::explored::get_path(size_type target) const {
+    search_path result;
+    if (target >= keys.size()) {
+        return result;
     }
 
-    typename shortest_paths::iterator S{result.find(start)};
-    S->second.first = start;
-    S->second.second = cost_type();
-
-    /// Relax edges repeatedly
-
-    bool finished{false};
-    for (size_type i{0}; i < get_nbr_edges() - 1 && !finished; ++i) {
-        finished = true;
-
-        for (const_iterator u{cbegin()}; u != cend(); ++u) {
-            std::vector<typename node::edge> adj{get_out_edges(u)};
-            for (typename std::vector<typename node::edge>::const_iterator edge{adj.cbegin()}; edge != adj.cend(); ++edge) {
-                const_iterator v{edge->target()};
-
-                cost_type cost{u->second->get_cost(v)};
-                cost_type dist_u{result[u].second};
-                cost_type dist_v{result[v].second};
-
-                cost_type alt{dist_u + cost};
-
-                if (alt < dist_v) {
-                    result[v].first = u;
-                    result[v].second = alt;
-                    finished = false;
-                }
-            }
-        }
+    std::vector<size_type> nodes;
+    for (size_type current{target}; current != 0; current = previous[current]) {
+        nodes.push_back(current);
     }
-
-    /// Check for negative-weigh cycles
-
-    for (const_iterator u{cbegin()}; u != cend(); ++u) {
-        std::vector<typename node::edge> adj{get_out_edges(u)};
-        for (typename std::vector<typename node::edge>::const_iterator edge{adj.cbegin()}; edge != adj.cend(); ++edge) {
-            const_iterator v{edge->target()};
-            if (result[u].second + u->second->get_cost(v) < result[v].second) {
-                GRAPH_THROW(negative_weight_cycle)
-            }
-        }
+    result.emplace_back(keys.front(), cost_type());
+    for (typename std::vector<size_type>::const_reverse_iterator it{nodes.crbegin()}; it != nodes.crend(); ++it) {
+        result.emplace_back(keys[*it], distances[*it] - distances[previous[*it]]);
     }
-
     return result;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-graph<Key, T, Cost, Nat>::search_path::search_path(const search_path &p) : Container(p) {}
-
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::cost_type graph<Key, T, Cost, Nat>::search_path::total_cost() const {
+template <class Key, class Cost, class Index>
+Cost implicit_graph<Key, Cost, Index>::search_path::total_cost() const {
     cost_type total{};
     for (const_iterator it{cbegin()}; it != cend(); ++it) {
         total += it->second;
@@ -3999,71 +7614,43 @@ typename graph<Key, T, Cost, Nat>::cost_type graph<Key, T, Cost, Nat>::search_pa
     return total;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-bool graph<Key, T, Cost, Nat>::search_path::contain(const graph::const_iterator &i) const {
+template <class Key, class Cost, class Index>
+bool implicit_graph<Key, Cost, Index>::search_path::contain(const key_type &key) const {
     for (const_iterator it{cbegin()}; it != cend(); ++it) {
-        if (it->first == i) {
+        if (it->first == key) {
             return true;
         }
     }
     return false;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-graph<Key, T, Cost, Nat>::shortest_paths::shortest_paths(graph::const_iterator start) : _start(start) {}
-
-template <class Key, class T, class Cost, Nature Nat>
-graph<Key, T, Cost, Nat>::shortest_paths::shortest_paths(const shortest_paths &p) : Container(p), _start(p._start) {}
-
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::const_iterator graph<Key, T, Cost, Nat>::shortest_paths::get_previous(graph::const_iterator current) const {
-    return this->find(current)->second.first;
-}
+template <class Key, class Cost, class Index>
+implicit_graph<Key, Cost, Index>::shortest_paths::shortest_paths(explored &&e) : _explored(std::move(e)) {}
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::shortest_paths::get_path(graph::key_type target) const {
-    for (const_iterator it{cbegin()}; it != cend(); ++it) {
-        if (it->first->first == target) {
-            return get_path(it->first);
-        }
-    }
-    return graph::search_path();
+template <class Key, class Cost, class Index>
+bool implicit_graph<Key, Cost, Index>::shortest_paths::contain(const key_type &key) const {
+    const size_type i{_explored.find(key)};
+    return i < _explored.keys.size() && _explored.expanded[i];
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::shortest_paths::get_path(graph::const_iterator target) const {
-    graph::shortest_paths::const_iterator current{this->find(target)};
-    if (current == cend() || current->second.second == (std::numeric_limits<cost_type>::has_infinity ? std::numeric_limits<cost_type>::infinity() : std::numeric_limits<cost_type>::max())) {
-        return search_path();
-    }
-
-    graph::search_path result;
-    graph::shortest_paths::const_iterator previous{this->find(current->second.first)};
-
-    while (previous != cend() && current->first != _start) {
-        result.emplace_front(current->first, current->second.second - previous->second.second);
-        current = previous;
-        previous = this->find(current->second.first);
+template <class Key, class Cost, class Index>
+Cost implicit_graph<Key, Cost, Index>::shortest_paths::get_distance(const key_type &key) const {
+    const size_type i{_explored.find(key)};
+    if (i < _explored.keys.size() && _explored.expanded[i]) {
+        return _explored.distances[i];
     }
-
-    if (target != _start) {
-        result.emplace_front(_start, cost_type());
-    }
-
-    return result;
+    return std::numeric_limits<cost_type>::has_infinity ? std::numeric_limits<cost_type>::infinity() : std::numeric_limits<cost_type>::max();
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-graph<Key, T, Cost, Nat>::path_comparator::path_comparator(std::function<cost_type(const_iterator)> heuristic) : _heuristic(heuristic) {}
-
-template <class Key, class T, class Cost, Nature Nat>
-bool graph<Key, T, Cost, Nat>::path_comparator::operator() (const search_path &p1, const search_path &p2) const {
-    return (p2.total_cost() + _heuristic(p2.back().first)) < (p1.total_cost() + _heuristic(p1.back().first));
+template <class Key, class Cost, class Index>
+typename implicit_graph<Key, Cost, Index>::search_path implicit_graph<Key, Cost, Index>::shortest_paths::get_path(const key_type &target) const {
+    const size_type i{_explored.find(target)};
+    return _explored.get_path(i < _explored.keys.size() && _explored.expanded[i] ? i : _explored.keys.size());
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-bool graph<Key, T, Cost, Nat>::iterator_comparator::operator()(const const_iterator &lhs, const const_iterator &rhs) const {
-    return lhs->first < rhs->first;
+template <class Key, class Cost, class Index>
+std::size_t implicit_graph<Key, Cost, Index>::shortest_paths::size() const noexcept {
+    return _explored.keys.size();
 }
 
 #endif
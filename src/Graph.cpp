@@ -5,63 +5,63 @@
 #include <memory>
 #include <set>
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::iterator graph<Key, T, Cost, Nat>::begin() noexcept {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::iterator graph<Key, T, Cost, Nat, Index>::begin() noexcept {
     return _nodes.begin();
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::iterator graph<Key, T, Cost, Nat>::end() noexcept {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::iterator graph<Key, T, Cost, Nat, Index>::end() noexcept {
     return _nodes.end();
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::const_iterator graph<Key, T, Cost, Nat>::begin() const noexcept {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::const_iterator graph<Key, T, Cost, Nat, Index>::begin() const noexcept {
     return _nodes.begin();
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::const_iterator graph<Key, T, Cost, Nat>::cbegin() const noexcept {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::const_iterator graph<Key, T, Cost, Nat, Index>::cbegin() const noexcept {
     return _nodes.cbegin();
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::const_iterator graph<Key, T, Cost, Nat>::end() const noexcept {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::const_iterator graph<Key, T, Cost, Nat, Index>::end() const noexcept {
     return _nodes.end();
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::const_iterator graph<Key, T, Cost, Nat>::cend() const noexcept {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::const_iterator graph<Key, T, Cost, Nat, Index>::cend() const noexcept {
     return _nodes.cend();
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::reverse_iterator graph<Key, T, Cost, Nat>::rbegin() noexcept {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::reverse_iterator graph<Key, T, Cost, Nat, Index>::rbegin() noexcept {
     return _nodes.rbegin();
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::reverse_iterator graph<Key, T, Cost, Nat>::rend() noexcept {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::reverse_iterator graph<Key, T, Cost, Nat, Index>::rend() noexcept {
     return _nodes.rend();
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::const_reverse_iterator graph<Key, T, Cost, Nat>::rbegin() const noexcept {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::const_reverse_iterator graph<Key, T, Cost, Nat, Index>::rbegin() const noexcept {
     return _nodes.rbegin();
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::const_reverse_iterator graph<Key, T, Cost, Nat>::crbegin() const noexcept {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::const_reverse_iterator graph<Key, T, Cost, Nat, Index>::crbegin() const noexcept {
     return _nodes.crbegin();
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::const_reverse_iterator graph<Key, T, Cost, Nat>::rend() const noexcept {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::const_reverse_iterator graph<Key, T, Cost, Nat, Index>::rend() const noexcept {
     return _nodes.rend();
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::const_reverse_iterator graph<Key, T, Cost, Nat>::crend() const noexcept {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::const_reverse_iterator graph<Key, T, Cost, Nat, Index>::crend() const noexcept {
     return _nodes.crend();
 }
 
@@ -70,102 +70,212 @@ typename graph<Key, T, Cost, Nat>::const_reverse_iterator graph<Key, T, Cost, Na
 //////////////////////////////////////////////////
 
 /// Constructors
-template <class Key, class T, class Cost, Nature Nat>
-graph<Key, T, Cost, Nat>::graph() {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+graph<Key, T, Cost, Nat, Index>::graph() {
     _nodes.clear();
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-graph<Key, T, Cost, Nat>::graph(std::istream &is) {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+graph<Key, T, Cost, Nat, Index>::graph(const allocator_type &alloc)
+    : _nodes(alloc)
+    , _shared_costs(alloc)
+    , _free_costs(alloc)
+    , _free_indices(alloc) {}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+graph<Key, T, Cost, Nat, Index>::graph(std::istream &is) {
     is >> *this;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-graph<Key, T, Cost, Nat>::graph(const graph &other) {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+graph<Key, T, Cost, Nat, Index>::graph(const graph &other) {
     *this = other;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-graph<Key, T, Cost, Nat>::graph(graph &&other) noexcept
+template <class Key, class T, class Cost, Nature Nat, class Index>
+graph<Key, T, Cost, Nat, Index>::graph(graph &&other) noexcept
     : _nodes(std::move(other._nodes))
-    , _num_edges(other._num_edges) {
-    other._num_edges = 0;
-}
-
-template <class Key, class T, class Cost, Nature Nat>
-graph<Key, T, Cost, Nat> &graph<Key, T, Cost, Nat>::operator=(const graph &other) {
-    clear();
-
-    for (const_iterator it{other.cbegin()}; it != other.cend(); ++it) {
-        add_node(it->first, it->second->get());
+    , _num_edges(other._num_edges)
+    , _shared_costs(std::move(other._shared_costs))
+    , _free_costs(std::move(other._free_costs))
+    , _indices_bound(other._indices_bound)
+    , _free_indices(std::move(other._free_indices))
+    , _published(other._published)
+    , _version(other._version) {
+    other._num_edges     = 0;
+    other._indices_bound = 0;
+    other._free_indices.clear();
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+graph<Key, T, Cost, Nat, Index> &graph<Key, T, Cost, Nat, Index>::operator=(const graph &other) {
+    if (this == &other) {
+        return *this;
     }
+    clear();
 
+    //! Structural copy in O(V + E): the nodes are appended in the iteration order of the other graph, and each
+    //! edge is pushed to its remapped target, with no lookup of the keys
+    using basic_node_type = typename node::basic_node;
+    std::vector<size_type> positions(other._indices_bound, other.size());
+    std::vector<basic_node_type*> copies;
+    copies.reserve(other.size());
+    detail::reserve(_nodes, other.size());
     for (const_iterator it{other.cbegin()}; it != other.cend(); ++it) {
-        std::list<typename node::edge> list = it->second->get_edges();
-        for (typename node::edge e : list) {
-            graph::const_iterator i{e.target()};
-            add_edge(it->first, i->first, e.cost());
+        iterator copy{_nodes.insert(_nodes.cend(), value_type(it->first, new_node(it->second->get())))};
+        attach_node(copy);
+        copy->second->reserve_edges(it->second->_out_edges.size(), it->second->_in_edges.size());
+        positions[index_of(it->second.get())] = copies.size();
+        copies.push_back(copy->second.get());
+    }
+
+    size_type i{0};
+    for (const_iterator it{other.cbegin()}; it != other.cend(); ++it, ++i) {
+        for (const typename node::edge &e : it->second->_out_edges) {
+            const size_type j{positions[index_of(e._target)]};
+            typename node::EdgesIterator pushed{copies[i]->push_edge(copies[j], e.cost())};
+
+            //! UNDIRECTED: the opposite edge was already copied with its target; it shares its slot
+            if (e._shared_cost != nullptr) {
+                pushed->_shared_cost = j < i ? copies[j]->_out_edges[copies[j]->find_edge(copies[i])]._shared_cost : acquire_shared_cost(e.cost());
+            }
         }
     }
+    _num_edges = other._num_edges;
+
+    //! The snapshots are immutable: the copy shares them
+    _published = other._published;
+    _version   = other._version;
 
     return *this;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-graph<Key, T, Cost, Nat> &graph<Key, T, Cost, Nat>::operator=(graph&& other) noexcept {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+graph<Key, T, Cost, Nat, Index> &graph<Key, T, Cost, Nat, Index>::operator=(graph&& other) noexcept(std::allocator_traits<allocator_type>::is_always_equal::value) {
     // Handle self-assignment
-    if (this != &other) {
+    if (this != &other && get_allocator() != other.get_allocator()) {
+        //! The elements would be moved one by one to the other resource, invalidating the iterators kept by the nodes
+        *this = other;
+        other.clear();
+    } else if (this != &other) {
         //swap(other);
         // Move the resources directly for better performance
         _nodes = std::move(other._nodes);
         _num_edges = other._num_edges;
+        _shared_costs = std::move(other._shared_costs);
+        _free_costs = std::move(other._free_costs);
+        _indices_bound = other._indices_bound;
+        _free_indices = std::move(other._free_indices);
+        _published = other._published;
+        _version = other._version;
 
         // Reset the moved-from object to a valid state
         other._num_edges = 0;
+        other._indices_bound = 0;
+        other._free_indices.clear();
     }
     return *this;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-graph<Key, T, Cost, Nat>::~graph() = default;
+template <class Key, class T, class Cost, Nature Nat, class Index>
+graph<Key, T, Cost, Nat, Index>::~graph() = default;
 
 /// Capacity
 
-template <class Key, class T, class Cost, Nature Nat>
-bool graph<Key, T, Cost, Nat>::empty() const noexcept {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+bool graph<Key, T, Cost, Nat, Index>::empty() const noexcept {
     return _nodes.empty();
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-std::size_t graph<Key, T, Cost, Nat>::size() const noexcept {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::size() const noexcept {
     return _nodes.size();
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-std::size_t graph<Key, T, Cost, Nat>::max_size() const noexcept {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::max_size() const noexcept {
     return _nodes.max_size();
 }
 
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::reserve_nodes(size_type n) {
+    detail::reserve(_nodes, n);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::reserve_edges(const_iterator position, size_type degree) {
+    if (position != cend()) {
+        position->second->reserve_edges(degree, directed_tag::value ? position->second->_in_edges.size() : degree);
+    }
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::reserve_edges(const key_type &k, size_type degree) {
+    reserve_edges(emplace(k).first, degree);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::shrink_to_fit() {
+    detail::shrink_to_fit(_nodes);
+    for (const_iterator it{cbegin()}; it != cend(); ++it) {
+        it->second->shrink_to_fit();
+    }
+
+    //! The released cost slots are given back by moving the live ones into a new pool
+    if (!_free_costs.empty()) {
+        std::deque<Cost, detail::allocator<Cost>> shared_costs(get_allocator());
+        for (const_iterator it{cbegin()}; it != cend(); ++it) {
+            typename node::basic_node* const u{it->second.get()};
+            for (typename node::edge &e : u->_out_edges) {
+                //! Each pair of directions is visited once, from its lowest node
+                if (e._shared_cost != nullptr && !std::less<typename node::basic_node*>()(e._target, u)) {
+                    shared_costs.push_back(*e._shared_cost);
+                    if (e._target != u) {
+                        e._target->_out_edges[e._target->find_edge(u)]._shared_cost = &shared_costs.back();
+                    }
+                    e._shared_cost = &shared_costs.back();
+                }
+            }
+        }
+        _shared_costs = std::move(shared_costs);
+        std::vector<Cost*, detail::allocator<Cost*>>(get_allocator()).swap(_free_costs);
+    }
+
+    //! The dense indices are renumbered, so that the arrays of the search algorithms fit the number of nodes
+    if (!_free_indices.empty()) {
+        _indices_bound = 0;
+        for (const_iterator it{cbegin()}; it != cend(); ++it) {
+            it->second->_index = _indices_bound++;
+        }
+        std::vector<std::size_t, detail::allocator<std::size_t>>(get_allocator()).swap(_free_indices);
+    }
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::allocator_type graph<Key, T, Cost, Nat, Index>::get_allocator() const noexcept {
+    return _nodes.get_allocator();
+}
+
 /// Element access
-template <class Key, class T, class Cost, Nature Nat>
-T &graph<Key, T, Cost, Nat>::operator[](const key_type &k) {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+T &graph<Key, T, Cost, Nat, Index>::operator[](const key_type &k) {
     return add_node(k).first->second->get();
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-T &graph<Key, T, Cost, Nat>::operator[](key_type &&k) {
-    return add_node(k).first->second->get();
+template <class Key, class T, class Cost, Nature Nat, class Index>
+T &graph<Key, T, Cost, Nat, Index>::operator[](key_type &&k) {
+    return try_emplace(std::move(k)).first->second->get();
 }
 
 #if defined(GRAPH_HAS_CPP_17)
-template <class Key, class T, class Cost, Nature Nat>
-std::optional<T> graph<Key, T, Cost, Nat>::operator[](key_type &&k) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::optional<T> graph<Key, T, Cost, Nat, Index>::operator[](key_type &&k) const {
     const_iterator it{this->find(k)};
     return it == cend() ? std::nullopt : std::optional<T>(it->second->get());
 }
 #else
-template <class Key, class T, class Cost, Nature Nat>
-T graph<Key, T, Cost, Nat>::operator[](key_type &&k) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+T graph<Key, T, Cost, Nat, Index>::operator[](key_type &&k) const {
     const_iterator it{this->find(k)};
     if (it == cend()) {
         GRAPH_THROW_WITH(invalid_argument, "Unexistant node")
@@ -175,8 +285,8 @@ T graph<Key, T, Cost, Nat>::operator[](key_type &&k) const {
 }
 #endif
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::cost_type &graph<Key, T, Cost, Nat>::operator()(iterator it1, iterator it2) {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::cost_type &graph<Key, T, Cost, Nat, Index>::operator()(iterator it1, iterator it2) {
     if (!existing_edge(it1, it2)) {
         add_edge(it1, it2, infinity);
     }
@@ -184,8 +294,8 @@ typename graph<Key, T, Cost, Nat>::cost_type &graph<Key, T, Cost, Nat>::operator
     return it1->second->get_cost(it2);
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::cost_type &graph<Key, T, Cost, Nat>::operator()(const key_type &k1, const key_type &k2) {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::cost_type &graph<Key, T, Cost, Nat, Index>::operator()(const key_type &k1, const key_type &k2) {
     iterator it1{add_node(k1).first};
     iterator it2{add_node(k2).first};
 
@@ -193,18 +303,18 @@ typename graph<Key, T, Cost, Nat>::cost_type &graph<Key, T, Cost, Nat>::operator
 }
 
 #if defined(GRAPH_HAS_CPP_17)
-template <class Key, class T, class Cost, Nature Nat>
-std::optional<typename graph<Key, T, Cost, Nat>::cost_type> graph<Key, T, Cost, Nat>::operator()(const_iterator it1, const_iterator it2) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::optional<typename graph<Key, T, Cost, Nat, Index>::cost_type> graph<Key, T, Cost, Nat, Index>::operator()(const_iterator it1, const_iterator it2) const {
     return existing_edge(it1, it2) ? std::optional<cost_type>(it1->second->get_cost(it2)) : std::nullopt;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-std::optional<typename graph<Key, T, Cost, Nat>::cost_type> graph<Key, T, Cost, Nat>::operator()(const key_type &k1, const key_type &k2) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::optional<typename graph<Key, T, Cost, Nat, Index>::cost_type> graph<Key, T, Cost, Nat, Index>::operator()(const key_type &k1, const key_type &k2) const {
     return operator()(this->find(k1), this->find(k2));
 }
 #else
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::cost_type graph<Key, T, Cost, Nat>::operator()(const_iterator it1, const_iterator it2) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::cost_type graph<Key, T, Cost, Nat, Index>::operator()(const_iterator it1, const_iterator it2) const {
     if (!existing_edge(it1, it2)) {
         GRAPH_THROW_WITH(invalid_argument, "Unexistant edge")
     }
@@ -212,77 +322,128 @@ typename graph<Key, T, Cost, Nat>::cost_type graph<Key, T, Cost, Nat>::operator(
     return it1->second->get_cost(it2);
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::cost_type graph<Key, T, Cost, Nat>::operator()(const key_type &k1, const key_type &k2) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::cost_type graph<Key, T, Cost, Nat, Index>::operator()(const key_type &k1, const key_type &k2) const {
     return operator()(this->find(k1), this->find(k2));
 }
 #endif
 
-template <class Key, class T, class Cost, Nature Nat>
-std::pair<typename graph<Key, T, Cost, Nat>::iterator, bool> graph<Key, T, Cost, Nat>::insert(const graph<Key, T, cost_type, Nat>::value_type &val) {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::pair<typename graph<Key, T, Cost, Nat, Index>::iterator, bool> graph<Key, T, Cost, Nat, Index>::insert(const graph<Key, T, cost_type, Nat, Index>::value_type &val) {
     std::pair<iterator, bool> p{_nodes.insert(val)};
-    p.first->second->set_iterator_values(p.first, end(), cend());
+    if (p.second) {
+        attach_node(p.first);
+    }
     return p;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::iterator graph<Key, T, Cost, Nat>::insert(const_iterator position, const value_type &val) {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::iterator graph<Key, T, Cost, Nat, Index>::insert(const_iterator position, const value_type &val) {
+    const size_type old_size{size()};
     iterator it{_nodes.insert(position, val)};
-    it->second->set_iterator_values(it, end(), cend());
+    if (size() != old_size) {
+        attach_node(it);
+    }
+    return it;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::iterator graph<Key, T, Cost, Nat, Index>::insert(const_iterator position, const key_type &k, graphed_type &x) {
+    return insert(position, std::make_pair(k, new_node(x)));
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::iterator graph<Key, T, Cost, Nat, Index>::insert(const_iterator position, const key_type &k, const node &n) {
+    iterator it{_nodes.find(k)};
+    if (it != end()) {
+        return it;
+    }
+
+    it = _nodes.insert(position, std::make_pair(k, new_node(n.get())));
+    attach_node(it);
+    copy_edges(it, n);
     return it;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::iterator graph<Key, T, Cost, Nat>::insert(const_iterator position, const key_type &k, graphed_type &x) {
-    return insert(position, std::make_pair(k, std::make_shared<node>(x)));
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::pair<typename graph<Key, T, Cost, Nat, Index>::iterator, bool> graph<Key, T, Cost, Nat, Index>::emplace(const key_type &k) {
+    return try_emplace(k);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::pair<typename graph<Key, T, Cost, Nat, Index>::iterator, bool> graph<Key, T, Cost, Nat, Index>::emplace(const key_type &k, const graphed_type &x) {
+    return try_emplace(k, x);
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::iterator graph<Key, T, Cost, Nat>::insert(const_iterator position, const key_type &k, const node &n) {
-    return insert(position, std::make_pair(k, std::make_shared<node>(n)));
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::pair<typename graph<Key, T, Cost, Nat, Index>::iterator, bool> graph<Key, T, Cost, Nat, Index>::emplace(const key_type &k, const node &n) {
+    std::pair<iterator, bool> p{try_emplace(k, n.get())};
+    if (p.second) {
+        copy_edges(p.first, n);
+    }
+    return p;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-std::pair<typename graph<Key, T, Cost, Nat>::iterator, bool> graph<Key, T, Cost, Nat>::emplace(const key_type &k) {
-    return emplace(k, node());
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::pair<typename graph<Key, T, Cost, Nat, Index>::iterator, bool> graph<Key, T, Cost, Nat, Index>::emplace(key_type &&k, graphed_type &&x) {
+    return try_emplace(std::move(k), std::move(x));
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-std::pair<typename graph<Key, T, Cost, Nat>::iterator, bool> graph<Key, T, Cost, Nat>::emplace(const key_type &k, const graphed_type &x) {
-    return emplace(k, node(x));
+template <class Key, class T, class Cost, Nature Nat, class Index>
+template <class... Args>
+std::pair<typename graph<Key, T, Cost, Nat, Index>::iterator, bool> graph<Key, T, Cost, Nat, Index>::try_emplace(const key_type &k, Args &&... args) {
+    //! Looked up first: an existing node costs no allocation
+    iterator it{_nodes.find(k)};
+    if (it != end()) {
+        return std::make_pair(it, false);
+    }
+
+    graphed_type data(std::forward<Args>(args)...);
+    std::pair<iterator, bool> p{_nodes.emplace(k, new_node(std::move(data)))};
+    attach_node(p.first);
+    return p;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-std::pair<typename graph<Key, T, Cost, Nat>::iterator, bool> graph<Key, T, Cost, Nat>::emplace(const key_type &k, const node &n) {
-    std::pair<iterator, bool> p{_nodes.emplace(k, std::make_shared<node>(n))};
-    p.first->second->set_iterator_values(p.first, end(), cend());
+template <class Key, class T, class Cost, Nature Nat, class Index>
+template <class... Args>
+std::pair<typename graph<Key, T, Cost, Nat, Index>::iterator, bool> graph<Key, T, Cost, Nat, Index>::try_emplace(key_type &&k, Args &&... args) {
+    iterator it{_nodes.find(k)};
+    if (it != end()) {
+        return std::make_pair(it, false);
+    }
+
+    graphed_type data(std::forward<Args>(args)...);
+    std::pair<iterator, bool> p{_nodes.emplace(std::move(k), new_node(std::move(data)))};
+    attach_node(p.first);
     return p;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-std::pair<typename graph<Key, T, Cost, Nat>::iterator, bool> graph<Key, T, Cost, Nat>::add_node(const key_type &k) {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::pair<typename graph<Key, T, Cost, Nat, Index>::iterator, bool> graph<Key, T, Cost, Nat, Index>::add_node(const key_type &k) {
     return emplace(k);
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-std::pair<typename graph<Key, T, Cost, Nat>::iterator, bool> graph<Key, T, Cost, Nat>::add_node(const key_type &k, const graphed_type &x) {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::pair<typename graph<Key, T, Cost, Nat, Index>::iterator, bool> graph<Key, T, Cost, Nat, Index>::add_node(const key_type &k, const graphed_type &x) {
     return emplace(k, x);
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-std::pair<typename graph<Key, T, Cost, Nat>::iterator, bool> graph<Key, T, Cost, Nat>::add_node(const key_type &k, const node &n) {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::pair<typename graph<Key, T, Cost, Nat, Index>::iterator, bool> graph<Key, T, Cost, Nat, Index>::add_node(const key_type &k, const node &n) {
     return emplace(k, n);
 }
 
-/// Modifiers
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::pair<typename graph<Key, T, Cost, Nat, Index>::iterator, bool> graph<Key, T, Cost, Nat, Index>::add_node(key_type &&k, graphed_type &&x) {
+    return try_emplace(std::move(k), std::move(x));
+}
 
-template <class Key, class T, class Cost, Nature Nat>
-bool graph<Key, T, Cost, Nat>::add_edge(const_iterator it1, const_iterator it2, cost_type cost) {
-    std::pair<typename std::list<typename node::edge>::const_iterator, bool> new_edge{it1->second->add_edge(it2, cost)};
+/// Modifiers
 
-    if (get_nature() == UNDIRECTED) {
-        it2->second->set_edge(it1, new_edge.first->_cost);
-    }
+template <class Key, class T, class Cost, Nature Nat, class Index>
+bool graph<Key, T, Cost, Nat, Index>::add_edge(const_iterator it1, const_iterator it2, cost_type cost) {
+    std::pair<typename node::EdgesIterator, bool> new_edge{it1->second->add_edge(it2, cost)};
+    add_opposite_edge(it1, it2, *new_edge.first, directed_tag());
 
     if (new_edge.second) {
         _num_edges++;
@@ -291,182 +452,564 @@ bool graph<Key, T, Cost, Nat>::add_edge(const_iterator it1, const_iterator it2,
     return true;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-bool graph<Key, T, Cost, Nat>::add_edge(const key_type &k1, const key_type &k2, cost_type cost) {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+bool graph<Key, T, Cost, Nat, Index>::add_edge(const key_type &k1, const key_type &k2, cost_type cost) {
     return add_edge(emplace(k1).first, emplace(k2).first, cost);
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-void graph<Key, T, Cost, Nat>::make_complete(cost_type cost) {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::make_complete(cost_type cost) {
     clear_edges();
 
-    if (cost != infinity) {
-        for (iterator it1{begin()}; it1 != end(); ++it1) {
-            for (iterator it2{begin()}; it2 != end(); ++it2) {
+    if (cost != infinity && !empty()) {
+        //! No edge is left: every edge is new, and is appended to reserved storage without any search
+        for (const_iterator it{cbegin()}; it != cend(); ++it) {
+            it->second->reserve_edges(size() - 1, size() - 1);
+        }
+
+        //! Row after row, so each node writes its out-edges contiguously; its index is then built once
+        for (const_iterator it1{cbegin()}; it1 != cend(); ++it1) {
+            for (const_iterator it2{cbegin()}; it2 != cend(); ++it2) {
                 if (it1 != it2) {
-                    add_edge(it1, it2, cost);
+                    it1->second->append_edge(it2->second.get(), cost);
+                }
+            }
+            it1->second->rebuild_edges_index();
+        }
+        if (!directed_tag::value) {
+            //! No cost is shared yet: the slots of every pair are appended in one step
+            _shared_costs.resize(size() * (size() - 1) / 2, cost);
+            typename std::deque<Cost, detail::allocator<Cost>>::iterator slot{_shared_costs.begin()};
+
+            //! The i-th row lists every other node in order: the opposite of (i, j) with i < j is the i-th edge of j
+            size_type i{0};
+            for (const_iterator it1{cbegin()}; it1 != cend(); ++it1, ++i) {
+                typename node::ListEdges &row{it1->second->_out_edges};
+                for (size_type j{i}; j < row.size(); ++j, ++slot) {
+                    typename node::edge &opposite{row[j]._target->_out_edges[i]};
+                    row[j]._shared_cost = opposite._shared_cost = &*slot;
+                }
+            }
+        }
+        _num_edges = directed_tag::value ? size() * (size() - 1) : size() * (size() - 1) / 2;
+    }
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+template <class InputIterator>
+void graph<Key, T, Cost, Nat, Index>::assign_edges(InputIterator first, InputIterator last) {
+    clear();
+
+    //! Nodes: the graph is empty, so the dense index of a node is its rank of insertion. The keys are looked up in
+    //! the index of the graph itself, which only requires what the index does: `operator<` or `std::hash`
+    std::vector<node*> nodes;
+    const auto node_index = [this, &nodes](const key_type &k) -> size_type {
+        iterator it{_nodes.find(k)};
+        if (it == _nodes.end()) {
+            it = _nodes.insert(_nodes.cend(), std::make_pair(k, new_node(graphed_type())));
+            attach_node(it);
+            nodes.push_back(it->second.get());
+        }
+        return index_of(it->second.get());
+    };
+
+    std::vector<cost_type> costs;
+    std::vector<size_type> from, to;
+    for (; first != last; ++first) {
+        from.push_back(node_index(std::get<0>(*first)));
+        to.push_back(node_index(std::get<1>(*first)));
+        costs.push_back(static_cast<cost_type>(std::get<2>(*first)));
+        if (!directed_tag::value && to.back() < from.back()) {
+            std::swap(from.back(), to.back());
+        }
+    }
+    const size_type nbr_edges{costs.size()};
+
+    //! Counting sort by source, stable so that the last duplicate of an edge comes last in its row
+    std::vector<size_type> offsets(nodes.size() + 1, 0);
+    for (size_type i{0}; i < nbr_edges; ++i) {
+        ++offsets[from[i] + 1];
+    }
+    for (size_type u{0}; u < nodes.size(); ++u) {
+        offsets[u + 1] += offsets[u];
+    }
+    std::vector<size_type> order(nbr_edges);
+    {
+        std::vector<size_type> cursor(offsets.cbegin(), offsets.cend() - 1);
+        for (size_type i{0}; i < nbr_edges; ++i) {
+            order[cursor[from[i]]++] = i;
+        }
+    }
+
+    //! Row by row, only the last occurrence of each target is kept
+    std::vector<size_type> latest(nodes.size());
+    std::vector<size_type> kept;
+    kept.reserve(nbr_edges);
+    std::vector<size_type> out_degree(nodes.size(), 0), in_degree(nodes.size(), 0);
+    for (size_type u{0}; u < nodes.size(); ++u) {
+        for (size_type k{offsets[u]}; k < offsets[u + 1]; ++k) {
+            latest[to[order[k]]] = k;
+        }
+        for (size_type k{offsets[u]}; k < offsets[u + 1]; ++k) {
+            const size_type v{to[order[k]]};
+            if (latest[v] == k) {
+                kept.push_back(order[k]);
+                ++out_degree[u];
+                ++in_degree[v];
+                if (!directed_tag::value && u != v) {
+                    ++out_degree[v];
+                    ++in_degree[u];
                 }
             }
         }
     }
+
+    //! Adjacency: the edges are known to be distinct, so they are appended without any search
+    for (size_type u{0}; u < nodes.size(); ++u) {
+        nodes[u]->_out_edges.reserve(out_degree[u]);
+        nodes[u]->_in_edges.reserve(in_degree[u]);
+    }
+    for (size_type i : kept) {
+        push_opposite_edge(nodes[from[i]], nodes[to[i]], *nodes[from[i]]->push_edge(nodes[to[i]], costs[i]), directed_tag());
+    }
+    _num_edges = kept.size();
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::iterator graph<Key, T, Cost, Nat>::erase(const_iterator position) {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::iterator graph<Key, T, Cost, Nat, Index>::erase(const_iterator position) {
     clear_edges(position);
+    release_node(position);
 
     return _nodes.erase(position);
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::iterator graph<Key, T, Cost, Nat>::erase(const_iterator first, const_iterator last) {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::iterator graph<Key, T, Cost, Nat, Index>::erase(const_iterator first, const_iterator last) {
+    std::vector<const_iterator> victims;
     for (const_iterator it{first}; it != last && it != cend(); ++it) {
-        clear_edges(it);
+        victims.push_back(it);
+    }
+    detach_nodes(victims);
+    for (const_iterator it : victims) {
+        release_node(it);
     }
 
     return _nodes.erase(first, last);
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-std::size_t graph<Key, T, Cost, Nat>::erase(const key_type &k) {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::erase(const key_type &k) {
     const_iterator it{this->find(k)};
     if (it == cend()) {
         return 0;
     }
 
     clear_edges(it);
+    release_node(it);
     return _nodes.erase(k);
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::iterator graph<Key, T, Cost, Nat>::del_node(const_iterator position) {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::iterator graph<Key, T, Cost, Nat, Index>::del_node(const_iterator position) {
     return erase(position);
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::iterator graph<Key, T, Cost, Nat>::del_nodes(const_iterator first, const_iterator last) {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::iterator graph<Key, T, Cost, Nat, Index>::del_nodes(const_iterator first, const_iterator last) {
     return erase(first, last);
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-std::size_t graph<Key, T, Cost, Nat>::del_node(const key_type &k) {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::del_node(const key_type &k) {
     return erase(k);
 }
-template <class Key, class T, class Cost, Nature Nat>
-void graph<Key, T, Cost, Nat>::clear() noexcept {
-    _nodes.clear();
-    _num_edges = 0;
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+template <class Range>
+std::size_t graph<Key, T, Cost, Nat, Index>::del_nodes(const Range &keys) {
+    std::vector<const_iterator> victims;
+    std::unordered_set<const typename node::basic_node*> marked;
+    for (const auto &k : keys) {
+        const_iterator it{find(k)};
+        if (it != cend() && marked.insert(it->second.get()).second) {
+            victims.push_back(it);
+        }
+    }
+
+    detach_nodes(victims);
+    for (const_iterator it : victims) {
+        release_node(it);
+        _nodes.erase(it);
+    }
+    return victims.size();
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-std::size_t graph<Key, T, Cost, Nat>::del_edge(const_iterator it1, const_iterator it2) {
-    size_type result{0};
-    if (it1 != end() && it2 != end()) {
-        result = static_cast<size_type>(it1->second->del_edge(it2));
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::del_nodes(std::initializer_list<key_type> keys) {
+    return del_nodes<std::initializer_list<key_type>>(keys);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::del_nodes_if(std::function<bool(const_iterator)> predicate) {
+    std::vector<const_iterator> victims;
+    for (const_iterator it{cbegin()}; it != cend(); ++it) {
+        if (predicate(it)) {
+            victims.push_back(it);
+        }
+    }
+
+    detach_nodes(victims);
+    for (const_iterator it : victims) {
+        release_node(it);
+        _nodes.erase(it);
+    }
+    return victims.size();
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::detach_nodes(const std::vector<const_iterator> &victims) {
+    using basic_node = typename node::basic_node;
+
+    std::unordered_set<const basic_node*> marked;
+    marked.reserve(victims.size());
+    for (const_iterator it : victims) {
+        marked.insert(it->second.get());
+    }
+
+    for (const_iterator it : victims) {
+        basic_node* const victim{it->second.get()};
+
+        //! Edges from the other nodes: the sources lose them. Swap-and-pop only moves links already visited
+        typename node::ListInEdges &in_edges{victim->_in_edges};
+        for (size_type k{in_edges.size()}; k-- > 0;) {
+            if (k < in_edges.size() && marked.count(in_edges[k]._source) == 0) {
+                in_edges[k]._source->erase_edge(in_edges[k]._position);
+                --_num_edges;
+            }
+        }
+
+        //! Edges to the other nodes: the targets lose their reverse link
+        for (const typename node::edge &e : victim->_out_edges) {
+            const bool to_victim{marked.count(e._target) != 0};
+            if (!to_victim) {
+                e._target->erase_in_edge(e._in_position);
+            }
 
-        if (get_nature() == UNDIRECTED) {
-            it2->second->del_edge(it1);
+            if (directed_tag::value) {
+                --_num_edges;
+            } else if (!to_victim || !std::less<const basic_node*>()(e._target, victim)) {
+                //! UNDIRECTED: the opposite direction from a survivor was counted above, and a pair of victims is handled from its lowest node
+                if (e._shared_cost != nullptr) {
+                    release_shared_cost(e._shared_cost);
+                }
+                if (to_victim) {
+                    --_num_edges;
+                }
+            }
         }
+    }
+}
 
-        _num_edges -= result;
+template <class Key, class T, class Cost, Nature Nat, class Index>
+template <class Range>
+std::size_t graph<Key, T, Cost, Nat, Index>::del_edges(const Range &edges) {
+    size_type result{0};
+    for (const auto &e : edges) {
+        result += del_edge(find(std::get<0>(e)), find(std::get<1>(e)));
     }
     return result;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-std::size_t graph<Key, T, Cost, Nat>::del_edge(const key_type &k1, const key_type &k2) {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::del_edges(std::initializer_list<std::pair<key_type, key_type>> edges) {
+    return del_edges<std::initializer_list<std::pair<key_type, key_type>>>(edges);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::clear() noexcept {
+    _nodes.clear();
+    _num_edges = 0;
+    _shared_costs.clear();
+    _free_costs.clear();
+    _indices_bound = 0;
+    _free_indices.clear();
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::del_edge(const_iterator it1, const_iterator it2) {
+    if (it1 == end() || it2 == end()) {
+        return 0;
+    }
+    return del_edge(it1, it2, directed_tag());
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::del_edge(const key_type &k1, const key_type &k2) {
     return del_edge(this->find(k1), this->find(k2));
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-void graph<Key, T, Cost, Nat>::clear_edges() {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::clear_edges() {
+    //! Every edge goes: no need to keep the reverse links in sync one by one
     for (const_iterator it{cbegin()}; it != cend(); ++it) {
-        clear_edges(it);
+        it->second->_out_edges.clear();
+        it->second->_edges_index.clear();
+        it->second->_in_edges.clear();
     }
     _num_edges = 0;
+    _shared_costs.clear();
+    _free_costs.clear();
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-std::size_t graph<Key, T, Cost, Nat>::clear_edges(const_iterator it) {
-    size_type result{0};
-    if (it != cend()) {
-        for (const_iterator it1{cbegin()}; it1 != cend(); ++it1) {
-            del_edge(it1, it);
-        }
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::clear_edges(const_iterator it) {
+    if (it == cend()) {
+        return 0;
+    }
+    return clear_edges(it, directed_tag());
+}
 
-        if (get_nature() == DIRECTED) {
-            result += it->second->clear_edges();
-        }
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::clear_edges(const key_type &k) {
+    return clear_edges(find(k));
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::swap(graph &other) noexcept {
+    //! Precondition: equal allocators, so that each node stays released by the resource it came from
+    _nodes.swap(other._nodes);
+    std::swap(_num_edges, other._num_edges);
+    _shared_costs.swap(other._shared_costs);
+    _free_costs.swap(other._free_costs);
+    std::swap(_indices_bound, other._indices_bound);
+    _free_indices.swap(other._free_indices);
+    _published.swap(other._published);
+    std::swap(_version, other._version);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::PtrNode graph<Key, T, Cost, Nat, Index>::new_node(const graphed_type &x) const {
+    return std::allocate_shared<node>(detail::allocator<node>(get_allocator()), x, typename node::EdgesAllocator(get_allocator()));
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::PtrNode graph<Key, T, Cost, Nat, Index>::new_node(graphed_type &&x) const {
+    return std::allocate_shared<node>(detail::allocator<node>(get_allocator()), std::move(x), typename node::EdgesAllocator(get_allocator()));
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::copy_edges(iterator position, const node &n) {
+    //! Undirected edges to @p n itself append to its out-edges: only the ones present at the call are copied
+    const size_type nbr_edges{n._out_edges.size()};
+    for (size_type i{0}; i < nbr_edges; ++i) {
+        const typename node::edge &e{n._out_edges[i]};
+        const cost_type cost{e.cost()};
+        add_edge(position, emplace(e.target()->first).first, cost);
+    }
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+Cost* graph<Key, T, Cost, Nat, Index>::acquire_shared_cost(cost_type cost) {
+    if (!_free_costs.empty()) {
+        Cost* slot{_free_costs.back()};
+        _free_costs.pop_back();
+        *slot = cost;
+        return slot;
+    }
+
+    _shared_costs.push_back(cost);
+    return &_shared_costs.back();
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::release_shared_cost(Cost* slot) {
+    _free_costs.push_back(slot);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::attach_node(iterator position) {
+    position->second->set_iterator_values(position, end(), cend());
+    if (!_free_indices.empty()) {
+        position->second->_index = _free_indices.back();
+        _free_indices.pop_back();
+    } else {
+        position->second->_index = _indices_bound++;
+    }
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::release_node(const_iterator position) {
+    _free_indices.push_back(position->second->_index);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::index_of(const typename node::basic_node* n) {
+    //! every node of a graph is a graph::node
+    return static_cast<const node*>(n)->_index;
+}
+
+/// Dispatch on the nature
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::add_opposite_edge(const_iterator, const_iterator, typename node::edge &, std::true_type) {}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::add_opposite_edge(const_iterator from, const_iterator to, typename node::edge &e, std::false_type) {
+    if (e._shared_cost == nullptr) {
+        e._shared_cost = acquire_shared_cost(e._cost);
+    }
+    to->second->set_edge(from, e._shared_cost);
+}
 
-        _num_edges -= result;
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::push_opposite_edge(node*, node*, typename node::edge &, std::true_type) {}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::push_opposite_edge(node* from, node* to, typename node::edge &e, std::false_type) {
+    e._shared_cost = acquire_shared_cost(e._cost);
+    if (from != to) {
+        to->push_edge(from, e._cost)->_shared_cost = e._shared_cost;
     }
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::del_edge(const_iterator it1, const_iterator it2, std::true_type) {
+    const size_type result{static_cast<size_type>(it1->second->del_edge(it2))};
+    _num_edges -= result;
     return result;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-std::size_t graph<Key, T, Cost, Nat>::clear_edges(const key_type &k) {
-    return clear_edges(find(k));
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::del_edge(const_iterator it1, const_iterator it2, std::false_type) {
+    const size_type position{it1->second->find_edge(it2->second.get())};
+    if (position == it1->second->_out_edges.size()) {
+        return 0;
+    }
+
+    Cost* shared_cost{it1->second->_out_edges[position]._shared_cost};
+    it1->second->erase_edge(position);
+    it2->second->del_edge(it1);
+    if (shared_cost != nullptr) {
+        release_shared_cost(shared_cost);
+    }
+
+    --_num_edges;
+    return 1;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-void graph<Key, T, Cost, Nat>::swap(graph &other) noexcept {
-    std::swap(_nodes,     other._nodes);
-    std::swap(_num_edges, other._num_edges);
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::clear_edges(const_iterator it, std::true_type) {
+    //! The reverse links give the sources directly, instead of visiting every node of the graph
+    typename node::ListInEdges &in_edges{it->second->_in_edges};
+    size_type result{in_edges.size()};
+    while (!in_edges.empty()) {
+        in_edges.back()._source->erase_edge(in_edges.back()._position);
+    }
+
+    result += it->second->clear_edges();
+    _num_edges -= result;
+    return result;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::clear_edges(const_iterator it, std::false_type) {
+    //! Both directions of an edge are linked: the reverse links give every neighbour
+    const typename node::ListInEdges &in_edges{it->second->_in_edges};
+    size_type result{0};
+    while (!in_edges.empty()) {
+        result += del_edge(in_edges.back()._source->container_from_this, it, std::false_type());
+    }
+    return result;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+bool graph<Key, T, Cost, Nat, Index>::existing_edge(const_iterator it1, const_iterator it2, std::true_type) const {
+    return it1->second->existing_adjacent_node(it2);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+bool graph<Key, T, Cost, Nat, Index>::existing_edge(const_iterator it1, const_iterator it2, std::false_type) const {
+    return it1->second->existing_adjacent_node(it2) && it2->second->existing_adjacent_node(it1);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::Degree graph<Key, T, Cost, Nat, Index>::degree(const_iterator position, std::true_type) const {
+    return Degree(position->second->degree().first, position->second->degree().second);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::Degree graph<Key, T, Cost, Nat, Index>::degree(const_iterator position, std::false_type) const {
+    return Degree(position->second->degree().first, 0);
 }
 
 /// specialisation of std::swap
 namespace std {
-    template <class Key, class T, class Cost, Nature Nat>
-    void swap(graph<Key, T, Cost, Nat> &g1, graph<Key, T, Cost, Nat> &g2) noexcept {
+    template <class Key, class T, class Cost, Nature Nat, class Index>
+    void swap(graph<Key, T, Cost, Nat, Index> &g1, graph<Key, T, Cost, Nat, Index> &g2) noexcept {
         g1.swap(g2);
     }
 }
 
 /// Operations
 
-template <class Key, class T, class Cost, Nature Nat>
-std::size_t graph<Key, T, Cost, Nat>::count(const key_type &k) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::count(const key_type &k) const {
+    return _nodes.count(k);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::iterator graph<Key, T, Cost, Nat, Index>::find(const key_type &k) {
+    return _nodes.find(k);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::const_iterator graph<Key, T, Cost, Nat, Index>::find(const key_type &k) const {
+    return _nodes.find(k);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+template <class K, class>
+std::size_t graph<Key, T, Cost, Nat, Index>::count(const K &k) const {
     return _nodes.count(k);
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::iterator graph<Key, T, Cost, Nat>::find(const key_type &k) {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+template <class K, class>
+typename graph<Key, T, Cost, Nat, Index>::iterator graph<Key, T, Cost, Nat, Index>::find(const K &k) {
     return _nodes.find(k);
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::const_iterator graph<Key, T, Cost, Nat>::find(const key_type &k) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+template <class K, class>
+typename graph<Key, T, Cost, Nat, Index>::const_iterator graph<Key, T, Cost, Nat, Index>::find(const K &k) const {
     return _nodes.find(k);
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-bool graph<Key, T, Cost, Nat>::existing_node(const_iterator it) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+bool graph<Key, T, Cost, Nat, Index>::existing_node(const_iterator it) const {
     return it != cend();
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-bool graph<Key, T, Cost, Nat>::existing_node(const key_type &k) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+bool graph<Key, T, Cost, Nat, Index>::existing_node(const key_type &k) const {
     return existing_node(find(k));
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-bool graph<Key, T, Cost, Nat>::existing_edge(const_iterator it1, const_iterator it2) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+bool graph<Key, T, Cost, Nat, Index>::existing_edge(const_iterator it1, const_iterator it2) const {
     if (it1 != cend() && it2 != cend()) {
-        if (get_nature() == DIRECTED) {
-            return it1->second->existing_adjacent_node(it2);
-        }
-        return it1->second->existing_adjacent_node(it2) && it2->second->existing_adjacent_node(it1);
+        return existing_edge(it1, it2, directed_tag());
     }
 
     return false;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-bool graph<Key, T, Cost, Nat>::existing_edge(const key_type &k1, const key_type &k2) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+bool graph<Key, T, Cost, Nat, Index>::existing_edge(const key_type &k1, const key_type &k2) const {
     return existing_edge(this->find(k1), this->find(k2));
 }
-template <class Key, class T, class Cost, Nature Nat>
-bool graph<Key, T, Cost, Nat>::has_path_connecting(const_iterator from, const_iterator to) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+bool graph<Key, T, Cost, Nat, Index>::has_path_connecting(const_iterator from, const_iterator to) const {
     if (from == cend() || to == cend()) {
         GRAPH_THROW(unexpected_nullptr)
     }
@@ -476,23 +1019,23 @@ bool graph<Key, T, Cost, Nat>::has_path_connecting(const_iterator from, const_it
     return !dfs(from, to).empty();
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-bool graph<Key, T, Cost, Nat>::has_path_connecting(const key_type &from, const key_type &to) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+bool graph<Key, T, Cost, Nat, Index>::has_path_connecting(const key_type &from, const key_type &to) const {
     return has_path_connecting(this->find(from), this->find(to));
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-std::size_t graph<Key, T, Cost, Nat>::get_nbr_nodes() const noexcept {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::get_nbr_nodes() const noexcept {
     return _nodes.size();
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-std::size_t graph<Key, T, Cost, Nat>::get_nbr_edges() const noexcept {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::get_nbr_edges() const noexcept {
     return _num_edges;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-Nature graph<Key, T, Cost, Nat>::get_nature() const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+Nature graph<Key, T, Cost, Nat, Index>::get_nature() const {
     return Nat;
 }
 
@@ -524,21 +1067,18 @@ Nature graph<Key, T, Cost, Nat>::get_nature() const {
 ///    }
 ///}
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::Degree graph<Key, T, Cost, Nat>::degree(const_iterator position) const {
-    if (get_nature() == DIRECTED) {
-        return position == cend() ? Degree::min() : Degree(position->second->degree().first, position->second->degree().second);
-    }
-    return position == cend() ? Degree::min() : Degree(position->second->degree().first, 0);
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::Degree graph<Key, T, Cost, Nat, Index>::degree(const_iterator position) const {
+    return position == cend() ? Degree::min() : degree(position, directed_tag());
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::Degree graph<Key, T, Cost, Nat>::degree(const key_type &k) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::Degree graph<Key, T, Cost, Nat, Index>::degree(const key_type &k) const {
     return degree(find(k));
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-std::pair<typename graph<Key, T, Cost, Nat>::const_iterator, typename graph<Key, T, Cost, Nat>::Degree> graph<Key, T, Cost, Nat>::degree_max() const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::pair<typename graph<Key, T, Cost, Nat, Index>::const_iterator, typename graph<Key, T, Cost, Nat, Index>::Degree> graph<Key, T, Cost, Nat, Index>::degree_max() const {
     if (empty()) {
         return std::make_pair(cend(), Degree::min());
     }
@@ -557,8 +1097,8 @@ std::pair<typename graph<Key, T, Cost, Nat>::const_iterator, typename graph<Key,
     return std::make_pair(cit, max);
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-std::pair<typename graph<Key, T, Cost, Nat>::const_iterator, typename graph<Key, T, Cost, Nat>::Degree> graph<Key, T, Cost, Nat>::degree_min() const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::pair<typename graph<Key, T, Cost, Nat, Index>::const_iterator, typename graph<Key, T, Cost, Nat, Index>::Degree> graph<Key, T, Cost, Nat, Index>::degree_min() const {
     if (empty()) {
         return std::make_pair(cend(), Degree::min());
     }
@@ -577,8 +1117,8 @@ std::pair<typename graph<Key, T, Cost, Nat>::const_iterator, typename graph<Key,
     return std::make_pair(cit, min);
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-std::map<Key, typename graph<Key, T, Cost, Nat>::Degree> graph<Key, T, Cost, Nat>::degrees() const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::map<Key, typename graph<Key, T, Cost, Nat, Index>::Degree> graph<Key, T, Cost, Nat, Index>::degrees() const {
     std::map<key_type, Degree> result;
 
     for (const_iterator it{cbegin()}; it != cend(); ++it) {
@@ -588,57 +1128,54 @@ std::map<Key, typename graph<Key, T, Cost, Nat>::Degree> graph<Key, T, Cost, Nat
     return result;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
+template <class Key, class T, class Cost, Nature Nat, class Index>
 template <class> /// enable_if_t<DIRECTED>
-std::vector<typename graph<Key, T, Cost, Nat>::node::edge> graph<Key, T, Cost, Nat>::get_in_edges(const_iterator to) const {
+std::vector<typename graph<Key, T, Cost, Nat, Index>::node::edge> graph<Key, T, Cost, Nat, Index>::get_in_edges(const_iterator to) const {
     std::vector<typename node::edge> result;
+    result.reserve(to->second->_in_edges.size());
 
-    for (const_iterator it{cbegin()}; it != cend(); ++it) {
-        if (it != to) {
-            for (typename node::edge e : it->second->_out_edges) {
-                if (e.target() == to) {
-                    result.push_back(e);
-                }
-            }
+    for (const typename node::in_edge &link : to->second->_in_edges) {
+        if (link._source != to->second.get()) {
+            result.push_back(link._source->_out_edges[link._position]);
         }
     }
 
     return result;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
+template <class Key, class T, class Cost, Nature Nat, class Index>
 template <class> /// enable_if_t<DIRECTED>
-std::vector<typename graph<Key, T, Cost, Nat>::node::edge> graph<Key, T, Cost, Nat>::get_in_edges(const key_type &to) const {
+std::vector<typename graph<Key, T, Cost, Nat, Index>::node::edge> graph<Key, T, Cost, Nat, Index>::get_in_edges(const key_type &to) const {
     return get_in_edges(find(to));
 }
 
-template <class Key, class T, class Cost, Nature Nat>
+template <class Key, class T, class Cost, Nature Nat, class Index>
 template <class> /// enable_if_t<DIRECTED>
-std::vector<typename graph<Key, T, Cost, Nat>::node::edge> graph<Key, T, Cost, Nat>::get_out_edges(const_iterator from) const {
+std::vector<typename graph<Key, T, Cost, Nat, Index>::node::edge> graph<Key, T, Cost, Nat, Index>::get_out_edges(const_iterator from) const {
     return std::vector<typename node::edge>(from->second->_out_edges.begin(), from->second->_out_edges.end());
 }
 
-template <class Key, class T, class Cost, Nature Nat>
+template <class Key, class T, class Cost, Nature Nat, class Index>
 template <class> /// enable_if_t<DIRECTED>
-std::vector<typename graph<Key, T, Cost, Nat>::node::edge> graph<Key, T, Cost, Nat>::get_out_edges(const key_type &from) const {
+std::vector<typename graph<Key, T, Cost, Nat, Index>::node::edge> graph<Key, T, Cost, Nat, Index>::get_out_edges(const key_type &from) const {
     return get_out_edges(find(from));
 }
 
-template <class Key, class T, class Cost, Nature Nat>
+template <class Key, class T, class Cost, Nature Nat, class Index>
 template <class> /// enable_if_t<UNDIRECTED>
-std::vector<typename graph<Key, T, Cost, Nat>::node::edge> graph<Key, T, Cost, Nat>::get_edges(const_iterator i) const {
+std::vector<typename graph<Key, T, Cost, Nat, Index>::node::edge> graph<Key, T, Cost, Nat, Index>::get_edges(const_iterator i) const {
     return std::vector<typename node::edge>(i->second->_out_edges.begin(), i->second->_out_edges.end());
 }
 
-template <class Key, class T, class Cost, Nature Nat>
+template <class Key, class T, class Cost, Nature Nat, class Index>
 template <class> /// enable_if_t<UNDIRECTED>
-std::vector<typename graph<Key, T, Cost, Nat>::node::edge> graph<Key, T, Cost, Nat>::get_edges(const key_type &i) const {
+std::vector<typename graph<Key, T, Cost, Nat, Index>::node::edge> graph<Key, T, Cost, Nat, Index>::get_edges(const key_type &i) const {
     return get_edges(find(i));
 }
 
-template <class Key, class T, class Cost, Nature Nat>
+template <class Key, class T, class Cost, Nature Nat, class Index>
 template <class> /// enable_if_t<DIRECTED>
-bool graph<Key, T, Cost, Nat>::is_cyclic() const {
+bool graph<Key, T, Cost, Nat, Index>::is_cyclic() const {
     for (const_iterator it{cbegin()}; it != cend(); ++it) {
         std::list<const_iterator> initPath;
         if (is_cyclic_rec(it, initPath)) {
@@ -648,10 +1185,10 @@ bool graph<Key, T, Cost, Nat>::is_cyclic() const {
     return false;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-bool graph<Key, T, Cost, Nat>::is_cyclic_rec(const_iterator current, std::list<const_iterator> path) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+bool graph<Key, T, Cost, Nat, Index>::is_cyclic_rec(const_iterator current, std::list<const_iterator> path) const {
     for (const_iterator it : path) {
-        if (it == current && (get_nature() == DIRECTED || path.back() != current)) {
+        if (it == current && (directed_tag::value || path.back() != current)) {
             return true;
         }
     }
@@ -660,14 +1197,9 @@ bool graph<Key, T, Cost, Nat>::is_cyclic_rec(const_iterator current, std::list<c
     }*/
 
     path.push_back(current);
-    std::vector<typename node::edge> adjacent;
-    if (get_nature() == DIRECTED) {
-        adjacent = get_out_edges(current);
-    } else { /// get_nature() == UNDIRECTED
-        adjacent = get_edges(current);
-    }
+    const typename node::ListEdges &adjacent{current->second->get_edges()};
 
-    for (typename std::vector<typename node::edge>::const_iterator it{adjacent.cbegin()}; it != adjacent.cend(); ++it) {
+    for (typename node::ConstEdgesIterator it{adjacent.cbegin()}; it != adjacent.cend(); ++it) {
         if (is_cyclic_rec(it->target(), path)) {
             return true;
         }
@@ -680,39 +1212,39 @@ bool graph<Key, T, Cost, Nat>::is_cyclic_rec(const_iterator current, std::list<c
 
 
 /*
-template <class Key, class T, class Cost, Nature Nat>
-bool graph<Key, T, Cost, Nat>::is_isomorphic() const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+bool graph<Key, T, Cost, Nat, Index>::is_isomorphic() const {
     // TODO
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-std::vector<typename graph<Key, T, Cost, Nat>::const_iterator> graph<Key, T, Cost, Nat>::toposort() const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::vector<typename graph<Key, T, Cost, Nat, Index>::const_iterator> graph<Key, T, Cost, Nat, Index>::toposort() const {
     // TODO
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-std::set<std::vector<typename graph<Key, T, Cost, Nat>::const_iterator>, typename graph<Key, T, Cost, Nat>::iterator_comparator> graph<Key, T, Cost, Nat>::kosaraju_scc() const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::set<std::vector<typename graph<Key, T, Cost, Nat, Index>::const_iterator>, typename graph<Key, T, Cost, Nat, Index>::iterator_comparator> graph<Key, T, Cost, Nat, Index>::kosaraju_scc() const {
     // TODO
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-std::set<std::vector<typename graph<Key, T, Cost, Nat>::const_iterator>, typename graph<Key, T, Cost, Nat>::iterator_comparator> graph<Key, T, Cost, Nat>::tarjan_scc() const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::set<std::vector<typename graph<Key, T, Cost, Nat, Index>::const_iterator>, typename graph<Key, T, Cost, Nat, Index>::iterator_comparator> graph<Key, T, Cost, Nat, Index>::tarjan_scc() const {
     // TODO
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-std::size_t graph<Key, T, Cost, Nat>::connected_components() const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::connected_components() const {
     // TODO
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-graph<Key, T, Cost, Nat> &graph<Key, T, Cost, Nat>::condensate(bool make_acyclic) {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+graph<Key, T, Cost, Nat, Index> &graph<Key, T, Cost, Nat, Index>::condensate(bool make_acyclic) {
     // TODO
 }
 */
 
-//template <class Key, class T, class Cost, Nature Nat>
-//std::vector<typename graph<Key, T, Cost, Nat>::const_iterator> graph<Key, T, Cost, Nat>::maximum_clique() const {
+//template <class Key, class T, class Cost, Nature Nat, class Index>
+//std::vector<typename graph<Key, T, Cost, Nat, Index>::const_iterator> graph<Key, T, Cost, Nat, Index>::maximum_clique() const {
 // TODO: fix the bug
 /// queue of all unvisited nodes which can be part of a bigger clique
 /*
@@ -752,8 +1284,8 @@ while (!Q.empty() && result.size() <= max_size) {
     std::vector<const_iterator> current_clique({N});
 
     // TODO: loop until neighbors of N { for each neighbor of N inside of Q { . . . }; };
-    std::vector<typename node::edge> adj{get_out_edges(N)};
-    for (typename std::vector<typename node::edge>::const_iterator edge{adj.cbegin()}; edge != adj.cend(); ++edge) {
+    const typename node::ListEdges &adj{N->second->get_edges()};
+    for (typename node::ConstEdgesIterator edge{adj.cbegin()}; edge != adj.cend(); ++edge) {
         // DEBUG
         std::cout << "Values inside current_clique: ";
         for (const_iterator I : current_clique) {
@@ -825,14 +1357,14 @@ return result;
 */
 //}
 
-template <class Key, class T, class Cost, Nature Nat>
-std::ostream &operator<<(std::ostream &os, const graph<Key, T, Cost, Nat> &g) {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::ostream &operator<<(std::ostream &os, const graph<Key, T, Cost, Nat, Index> &g) {
     return os << *g.generate_grp() << std::endl;
     //return os << std::setw(4) << *g.generate_json() << std::endl;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-std::istream &operator>>(std::istream &is, graph<Key, T, Cost, Nat> &g) {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::istream &operator>>(std::istream &is, graph<Key, T, Cost, Nat, Index> &g) {
     GRAPH_TRY {
         g.parse_from_grp(is);
     } GRAPH_CATCH (...) {
@@ -847,8 +1379,8 @@ std::istream &operator>>(std::istream &is, graph<Key, T, Cost, Nat> &g) {
     return is;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-void graph<Key, T, Cost, Nat>::load(const char* filename) {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::load(const char* filename) {
     const char* dot = strrchr(filename, '.');
     std::string extension;
     if (dot != nullptr && dot != filename) {
@@ -874,8 +1406,8 @@ void graph<Key, T, Cost, Nat>::load(const char* filename) {
     in.close();
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-std::unique_ptr<std::string> graph<Key, T, Cost, Nat>::generate_dot(const std::string &graph_name) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::unique_ptr<std::string> graph<Key, T, Cost, Nat, Index>::generate_dot(const std::string &graph_name) const {
     std::string dot;
 
     const std::string tab{"    "};
@@ -903,7 +1435,7 @@ std::unique_ptr<std::string> graph<Key, T, Cost, Nat>::generate_dot(const std::s
 
     if (get_nature() == DIRECTED) {
         for_each(cbegin(), cend(), [this, &dot, tab](const value_type & element) {
-            std::list<typename node::edge> child{element.second->get_edges()};
+            const typename node::ListEdges &child{element.second->get_edges()};
             for_each(child.cbegin(), child.cend(), [this, &dot, tab, &element](const typename node::edge & i) {
                 if (i.cost() != infinity) {
                     std::stringstream ss;
@@ -915,7 +1447,7 @@ std::unique_ptr<std::string> graph<Key, T, Cost, Nat>::generate_dot(const std::s
     } else { /// get_nature() == UNDIRECTED
         std::set<std::pair<Key, Key >> list_edges;
         for_each(cbegin(), cend(), [this, &dot, &list_edges](const value_type & element) {
-            std::list<typename node::edge> child{element.second->get_edges()};
+            const typename node::ListEdges &child{element.second->get_edges()};
             for_each(child.cbegin(), child.cend(), [&dot, &list_edges, &element](const typename node::edge & i) {
                 const Key min{std::min(element.first, i.target()->first)};
                 const Key max{std::max(element.first, i.target()->first)};
@@ -934,18 +1466,18 @@ std::unique_ptr<std::string> graph<Key, T, Cost, Nat>::generate_dot(const std::s
     return std::make_unique<std::string>(std::forward<std::string>(dot));
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-void graph<Key, T, Cost, Nat>::save_to_dot(const char* filename, const std::string &graph_name) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::save_to_dot(const char* filename, const std::string &graph_name) const {
     std::ofstream out(filename);
     out << *generate_dot(graph_name) << std::endl;
     out.close();
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-std::unique_ptr<nlohmann::json> graph<Key, T, Cost, Nat>::generate_json() const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::unique_ptr<nlohmann::json> graph<Key, T, Cost, Nat, Index>::generate_json() const {
     nlohmann::json json;
 
-    using Set = std::list<typename node::edge>;
+    using Set = typename node::ListEdges;
 
     /// Displaying nature
     json["nature"] = get_nature();
@@ -960,7 +1492,7 @@ std::unique_ptr<nlohmann::json> graph<Key, T, Cost, Nat>::generate_json() const
     /// Displaying adjacences
     size_type p{0};
     for (const_iterator node{cbegin()}; node != cend(); ++node) {
-        Set child{node->second->get_edges()};
+        const Set &child{node->second->get_edges()};
         for (typename Set::const_iterator edge{child.begin()}; edge != child.end(); ++edge, ++p) {
             json["edges"][p]["from"] = node->first;
             json["edges"][p]["to"]   = edge->target()->first;
@@ -970,15 +1502,15 @@ std::unique_ptr<nlohmann::json> graph<Key, T, Cost, Nat>::generate_json() const
     return std::make_unique<nlohmann::json>(std::forward<nlohmann::json>(json));
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-void graph<Key, T, Cost, Nat>::save_to_json(const char* filename) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::save_to_json(const char* filename) const {
     std::ofstream out(filename);
     out << std::setw(4) << *generate_json() << std::endl;
     out.close();
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-void graph<Key, T, Cost, Nat>::parse_from_json(std::istream &is) {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::parse_from_json(std::istream &is) {
     nlohmann::json json;
     is >> json;
 
@@ -1007,8 +1539,8 @@ void graph<Key, T, Cost, Nat>::parse_from_json(std::istream &is) {
     }
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-void graph<Key, T, Cost, Nat>::DEBUG_load_from_json_rust(const char* path) {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::DEBUG_load_from_json_rust(const char* path) {
     nlohmann::json json;
     std::ifstream is(path);
     if (!is) {
@@ -1029,8 +1561,8 @@ void graph<Key, T, Cost, Nat>::DEBUG_load_from_json_rust(const char* path) {
     }
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-std::unique_ptr<std::string> graph<Key, T, Cost, Nat>::generate_grp() const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::unique_ptr<std::string> graph<Key, T, Cost, Nat, Index>::generate_grp() const {
     using std::max;
     using std::ostringstream;
     using std::setw;
@@ -1086,7 +1618,7 @@ std::unique_ptr<std::string> graph<Key, T, Cost, Nat>::generate_grp() const {
         size_type max_size_1{0}, max_size_2{0};
 
         for_each(cbegin(), cend(), [&max_size_1, &max_size_2, this](const value_type & element) {
-            std::list<typename node::edge> child{element.second->get_edges()};
+            const typename node::ListEdges &child{element.second->get_edges()};
             for_each(child.cbegin(), child.cend(), [ &, this](const typename node::edge & i) {
                 ostringstream out_1, out_2;
                 out_1 << element.first;
@@ -1101,9 +1633,11 @@ std::unique_ptr<std::string> graph<Key, T, Cost, Nat>::generate_grp() const {
         });
 
         size_type p{0};
-        for_each(cbegin(), cend(), [this, &data, &p, tab, max_size_1, max_size_2](const value_type & element) {
-            std::list<typename node::edge> child{element.second->get_edges()};
-            for_each(child.cbegin(), child.cend(), [this, &data, &p, tab, &element, max_size_1, max_size_2](const typename node::edge & i) {
+        //! Both directions of an UNDIRECTED edge are written
+        const size_type nbr_lines{directed_tag::value ? get_nbr_edges() : 2 * get_nbr_edges()};
+        for_each(cbegin(), cend(), [this, &data, &p, tab, max_size_1, max_size_2, nbr_lines](const value_type & element) {
+            const typename node::ListEdges &child{element.second->get_edges()};
+            for_each(child.cbegin(), child.cend(), [this, &data, &p, tab, &element, max_size_1, max_size_2, nbr_lines](const typename node::edge & i) {
                 ostringstream out_1, out_2;
                 out_1 << '"' << element.first     << "\",";
                 out_2 << '"' << i.target()->first << "\",";
@@ -1118,8 +1652,7 @@ std::unique_ptr<std::string> graph<Key, T, Cost, Nat>::generate_grp() const {
                     ss << '"' << i.cost() << '"';
                 }
 
-                if (p < (this->get_nature() == DIRECTED ?
-                         this->get_nbr_edges() : 2 * this->get_nbr_edges()) - 1) {
+                if (p < nbr_lines - 1) {
                     ss << ';';
                 }
                 ss << '\n';
@@ -1133,15 +1666,15 @@ std::unique_ptr<std::string> graph<Key, T, Cost, Nat>::generate_grp() const {
     return std::make_unique<std::string>(std::forward<std::string>(data));
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-void graph<Key, T, Cost, Nat>::save_to_grp(const char* filename) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::save_to_grp(const char* filename) const {
     std::ofstream out(filename);
     out << *generate_grp() << std::endl;
     out.close();
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-void graph<Key, T, Cost, Nat>::parse_from_grp(std::istream &is) {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::parse_from_grp(std::istream &is) {
     //! Nature
     std::string line;
     getline(is, line);
@@ -1199,14 +1732,14 @@ void graph<Key, T, Cost, Nat>::parse_from_grp(std::istream &is) {
     }
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-template <class K, class D, class C, Nature N>
-bool graph<Key, T, Cost, Nat>::operator==(const graph<K, D, C, N> &other) const noexcept {
-    typedef typename graph<Key, T, Cost, Nat>::const_iterator Iterator1;
-    typedef typename graph<K, D, C, N>::const_iterator Iterator2;
+template <class Key, class T, class Cost, Nature Nat, class Index>
+template <class K, class D, class C, Nature N, class I>
+bool graph<Key, T, Cost, Nat, Index>::operator==(const graph<K, D, C, N, I> &other) const noexcept {
+    typedef typename graph<Key, T, Cost, Nat, Index>::const_iterator Iterator1;
+    typedef typename graph<K, D, C, N, I>::const_iterator Iterator2;
 
-    typedef typename graph<Key, T, Cost, Nat>::node::edge Edge1;
-    typedef typename graph<K, D, C, N>  ::node::edge Edge2;
+    typedef typename graph<Key, T, Cost, Nat, Index>::node::edge Edge1;
+    typedef typename graph<K, D, C, N, I>  ::node::edge Edge2;
 
     if (get_nature()        != other.get_nature()    ||
             get_nbr_nodes() != other.get_nbr_nodes() ||
@@ -1214,20 +1747,22 @@ bool graph<Key, T, Cost, Nat>::operator==(const graph<K, D, C, N> &other) const
         return false;
     }
 
-    Iterator1 it1{cbegin()};
-    Iterator2 it2{other.cbegin()};
+    for (Iterator1 it1{cbegin()}; it1 != cend(); ++it1) {
+        //! Both graphs may not iterate in the same order: the nodes are matched by key
+        Iterator2 it2{other.find(it1->first)};
+        if (it2 == other.cend()) {
+            return false;
+        }
 
-    for (; (it1 != cend() || it2 != other.cend()); ++it1, ++it2) {
         //! Test nodes value
-        if (!(it1->first                == it2->first)         ||
-                !(it1->second->get()    == it2->second->get()) ||
+        if (!(it1->second->get()        == it2->second->get()) ||
                 !(it1->second->degree() == it2->second->degree())) {
             return false;
         }
 
         //! Test out edges
-        std::list<Edge1> edges1{it1->second->get_edges()};
-        std::list<Edge2> edges2{it2->second->get_edges()};
+        const typename graph<Key, T, Cost, Nat, Index>::node::ListEdges &edges1{it1->second->get_edges()};
+        const typename graph<K, D, C, N, I>  ::node::ListEdges &edges2{it2->second->get_edges()};
 
         /// Transform an unordered list into a map to browse edges in the same order
         std::map<Key, Edge1> child1;
@@ -1256,9 +1791,9 @@ bool graph<Key, T, Cost, Nat>::operator==(const graph<K, D, C, N> &other) const
     return true;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-template <class K, class D, class C, Nature N>
-bool graph<Key, T, Cost, Nat>::operator!=(const graph<K, D, C, N> &other) const noexcept {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+template <class K, class D, class C, Nature N, class I>
+bool graph<Key, T, Cost, Nat, Index>::operator!=(const graph<K, D, C, N, I> &other) const noexcept {
     return !(*this == other);
 }
 
@@ -1266,22 +1801,28 @@ bool graph<Key, T, Cost, Nat>::operator!=(const graph<K, D, C, N> &other) const
 ///// IMPLEMENTATION OF NODES /////
 ///////////////////////////////////
 
-template <class Key, class T, class Cost, Nature Nat>
-graph<Key, T, Cost, Nat>::node::node() : node(graphed_type()) {}
+template <class Key, class T, class Cost, Nature Nat, class Index>
+graph<Key, T, Cost, Nat, Index>::node::node() : node(graphed_type()) {}
 
-template <class Key, class T, class Cost, Nature Nat>
-graph<Key, T, Cost, Nat>::node::node(const graphed_type &d) {
-    this->_data = d;
-}
+template <class Key, class T, class Cost, Nature Nat, class Index>
+graph<Key, T, Cost, Nat, Index>::node::node(const graphed_type &d) : basic_node<graphed_type, cost_type, iterator, const_iterator>(d) {}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+graph<Key, T, Cost, Nat, Index>::node::node(const graphed_type &d, const typename node::EdgesAllocator &alloc)
+    : basic_node<graphed_type, cost_type, iterator, const_iterator>(d, alloc) {}
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::node &graph<Key, T, Cost, Nat>::node::operator=(const graphed_type &d) {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+graph<Key, T, Cost, Nat, Index>::node::node(graphed_type &&d, const typename node::EdgesAllocator &alloc)
+    : basic_node<graphed_type, cost_type, iterator, const_iterator>(std::move(d), alloc) {}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::node &graph<Key, T, Cost, Nat, Index>::node::operator=(const graphed_type &d) {
     this->set(d);
     return *this;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-void graph<Key, T, Cost, Nat>::node::set_iterator_values(iterator this_, iterator end, const_iterator cend) {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::node::set_iterator_values(iterator this_, iterator end, const_iterator cend) {
     this->container_from_this = this_;
     this->end_container       = end;
     this->cend_container      = cend;
@@ -1294,63 +1835,93 @@ void graph<Key, T, Cost, Nat>::node::set_iterator_values(iterator this_, iterato
 ////////////////////////////////////////
 ///// First Searches (BFS and DFS) /////
 ////////////////////////////////////////
-template <class Key, class T, class Cost, Nature Nat>
-template <bool insertFront>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::abstract_first_search(const_iterator start, std::function<bool(const_iterator)> is_goal) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+template <bool insertFront, class Goal>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::abstract_first_search(const_iterator start, Goal &is_goal) const {
     if (start == cend()) {
         GRAPH_THROW_WITH(invalid_argument, "Start point equals to graph::cend()")
     }
 
-    std::list<const_iterator> expanded;
-    std::deque<search_path> frontier;
+    using basic_node_type = typename node::basic_node;
 
-    {
-        search_path p;
-        p.push_back({start, cost_type()});
-        frontier.push_front(std::move(p));
-    }
+    //! Search state by dense index: the path is only rebuilt from the parents once the goal is reached
+    std::vector<bool> expanded(_indices_bound, false);
+    std::vector<std::pair<const basic_node_type*, cost_type>> parents(_indices_bound, std::make_pair(nullptr, cost_type()));
+    const basic_node_type* goal{nullptr};
 
-    while (!frontier.empty()) {
-        search_path p{frontier.front()};
-        frontier.pop_front();
+    if (insertFront) {
+        //! DFS: a node is expanded from the last edge pushed towards it, so the frontier keeps every pushed edge
+        struct pushed_edge {
+            const basic_node_type* target;
+            const basic_node_type* source;
+            cost_type              cost;
+        };
+        std::vector<pushed_edge> frontier;
+        frontier.push_back(pushed_edge{start->second.get(), nullptr, cost_type()});
 
-        /// expanded does not contain path's last state
-        if (std::find(expanded.cbegin(), expanded.cend(), p.back().first) == expanded.end()) {
-            const_iterator last{p.back().first};
-            expanded.push_back(last);
+        while (!frontier.empty()) {
+            const pushed_edge e{frontier.back()};
+            frontier.pop_back();
 
-            if (is_goal(last)) {
-                return p;
+            const size_type i{index_of(e.target)};
+            if (expanded[i]) {
+                continue;
             }
+            expanded[i] = true;
+            parents[i]  = std::make_pair(e.source, e.cost);
 
-            std::vector<typename node::edge> legalActions{get_nature() == DIRECTED ? get_out_edges(last) : get_edges(last)};
+            if (is_goal(e.target->container_from_this)) {
+                goal = e.target;
+                break;
+            }
 
-            for (typename std::vector<typename node::edge>::const_iterator it{legalActions.cbegin()}; it != legalActions.cend(); ++it) {
-                search_path newPath{p};
-                newPath.push_back({it->target(), it->cost()});
-                if (insertFront) {
-                    frontier.push_front(newPath);
-                } else {
-                    frontier.push_back(newPath);
+            for (const typename node::edge &out : e.target->_out_edges) {
+                if (!expanded[index_of(out._target)]) {
+                    frontier.push_back(pushed_edge{out._target, e.target, out.cost()});
+                }
+            }
+        }
+    } else {
+        //! BFS: a node is expanded from the first edge reaching it, so it is queued once, when discovered
+        std::vector<const basic_node_type*> frontier;
+        frontier.reserve(size());
+        frontier.push_back(start->second.get());
+        expanded[index_of(start->second.get())] = true;
+
+        for (size_type head{0}; head < frontier.size(); ++head) {
+            const basic_node_type* current{frontier[head]};
+            if (is_goal(current->container_from_this)) {
+                goal = current;
+                break;
+            }
+
+            for (const typename node::edge &out : current->_out_edges) {
+                const size_type i{index_of(out._target)};
+                if (!expanded[i]) {
+                    expanded[i] = true;
+                    parents[i]  = std::make_pair(current, out.cost());
+                    frontier.push_back(out._target);
                 }
             }
         }
     }
 
-    /// Could not find a solution
-    search_path empty = {};
-    return empty;
+    search_path result;
+    for (const basic_node_type* current{goal}; current != nullptr; current = parents[index_of(current)].first) {
+        result.push_front(std::make_pair(const_iterator(current->container_from_this), parents[index_of(current)].second));
+    }
+
+    /// An empty path if the goal could not be found
+    return result;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::bfs(key_type start, Key target) const {
-    std::list<const_iterator> l;
-    l.emplace_back(find(target));
-    return bfs(find(start), l);
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::bfs(key_type start, Key target) const {
+    return bfs(find(start), find(target));
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::bfs(key_type start, std::list<key_type> target_list) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::bfs(key_type start, std::list<key_type> target_list) const {
     std::list<const_iterator> l;
     for (key_type k : target_list) {
         l.emplace_back(find(k));
@@ -1358,39 +1929,49 @@ typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::bfs(key
     return bfs(find(start), l);
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::bfs(key_type start, std::function<bool(key_type)> is_goal) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::bfs(key_type start, std::function<bool(key_type)> is_goal) const {
     return bfs(find(start), [ &is_goal](const_iterator it) {
         return is_goal(it->first);
     });
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::bfs(const_iterator start, const_iterator target) const {
-    std::list<const_iterator> l;
-    l.emplace_back(target);
-    return bfs(start, l);
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::bfs(const_iterator start, const_iterator target) const {
+    return bfs(start, [ &target](const_iterator node) -> bool { return node == target; });
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::bfs(const_iterator start, std::list<const_iterator> target_list) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::bfs(const_iterator start, std::list<const_iterator> target_list) const {
     return bfs(start, [ &target_list](const_iterator node) -> bool { return std::find(target_list.cbegin(), target_list.cend(), node) != target_list.cend(); });
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::bfs(const_iterator start, std::function<bool(const_iterator)> is_goal) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::bfs(const_iterator start, std::function<bool(const_iterator)> is_goal) const {
     return abstract_first_search<false>(start, is_goal);
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::dfs(key_type start, Key target) const {
-    std::list<const_iterator> l;
-    l.emplace_back(find(target));
-    return dfs(find(start), l);
+template <class Key, class T, class Cost, Nature Nat, class Index>
+template <class Goal>
+auto graph<Key, T, Cost, Nat, Index>::bfs(key_type start, Goal is_goal) const -> GRAPH_REQUIRES(search_path, GRAPH_SEARCH_GOAL(Goal, key_type)) {
+    return bfs(find(start), [ &is_goal](const_iterator it) {
+        return is_goal(it->first);
+    });
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::dfs(key_type start, std::list<key_type> target_list) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+template <class Goal>
+auto graph<Key, T, Cost, Nat, Index>::bfs(const_iterator start, Goal is_goal) const -> GRAPH_REQUIRES(search_path, GRAPH_SEARCH_GOAL(Goal, const_iterator)) {
+    return abstract_first_search<false>(start, is_goal);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::dfs(key_type start, Key target) const {
+    return dfs(find(start), find(target));
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::dfs(key_type start, std::list<key_type> target_list) const {
     std::list<const_iterator> l;
     for (key_type k : target_list) {
         l.emplace_back(find(k));
@@ -1398,27 +1979,39 @@ typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::dfs(key
     return dfs(find(start), l);
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::dfs(key_type start, std::function<bool(key_type)> is_goal) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::dfs(key_type start, std::function<bool(key_type)> is_goal) const {
     return dfs(find(start), [ &is_goal](const_iterator it) {
         return is_goal(it->first);
     });
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::dfs(const_iterator start, const_iterator target) const {
-    std::list<const_iterator> l;
-    l.emplace_back(target);
-    return dfs(start, l);
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::dfs(const_iterator start, const_iterator target) const {
+    return dfs(start, [ &target](const_iterator node) -> bool { return node == target; });
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::dfs(const_iterator start, std::list<const_iterator> target_list) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::dfs(const_iterator start, std::list<const_iterator> target_list) const {
     return dfs(start, [ &target_list](const_iterator node) -> bool { return std::find(target_list.cbegin(), target_list.cend(), node) != target_list.cend(); });
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::dfs(const_iterator start, std::function<bool(const_iterator)> is_goal) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::dfs(const_iterator start, std::function<bool(const_iterator)> is_goal) const {
+    return abstract_first_search<true>(start, is_goal);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+template <class Goal>
+auto graph<Key, T, Cost, Nat, Index>::dfs(key_type start, Goal is_goal) const -> GRAPH_REQUIRES(search_path, GRAPH_SEARCH_GOAL(Goal, key_type)) {
+    return dfs(find(start), [ &is_goal](const_iterator it) {
+        return is_goal(it->first);
+    });
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+template <class Goal>
+auto graph<Key, T, Cost, Nat, Index>::dfs(const_iterator start, Goal is_goal) const -> GRAPH_REQUIRES(search_path, GRAPH_SEARCH_GOAL(Goal, const_iterator)) {
     return abstract_first_search<true>(start, is_goal);
 }
 
@@ -1426,15 +2019,15 @@ typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::dfs(con
 ///// Depth-Limited Search /////
 ////////////////////////////////
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::dls(key_type start, Key target, size_type depth) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::dls(key_type start, Key target, size_type depth) const {
     std::list<const_iterator> l;
     l.emplace_back(find(target));
     return dls(find(start), l, depth);
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::dls(key_type start, std::list<key_type> target_list, size_type depth) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::dls(key_type start, std::list<key_type> target_list, size_type depth) const {
     std::list<const_iterator> l;
     for (key_type k : target_list) {
         l.emplace_back(find(k));
@@ -1442,27 +2035,27 @@ typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::dls(key
     return dls(find(start), l, depth);
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::dls(key_type start, std::function<bool(key_type)> is_goal, size_type depth) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::dls(key_type start, std::function<bool(key_type)> is_goal, size_type depth) const {
     return dls(find(start), [ &is_goal](const_iterator it) {
         return is_goal(it->first);
     }, depth);
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::dls(const_iterator start, const_iterator target, size_type depth) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::dls(const_iterator start, const_iterator target, size_type depth) const {
     std::list<const_iterator> l;
     l.emplace_back(target);
     return dls(start, l, depth);
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::dls(const_iterator start, std::list<const_iterator> target_list, size_type depth) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::dls(const_iterator start, std::list<const_iterator> target_list, size_type depth) const {
     return dls(start, [ &target_list](const_iterator node) -> bool { return std::find(target_list.cbegin(), target_list.cend(), node) != target_list.cend(); }, depth);
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::dls(const_iterator start, std::function<bool(const_iterator)> is_goal, size_type depth) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::dls(const_iterator start, std::function<bool(const_iterator)> is_goal, size_type depth) const {
     if (start == cend()) {
         GRAPH_THROW_WITH(invalid_argument, "Start point equals to graph::cend()")
     }
@@ -1490,9 +2083,9 @@ typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::dls(con
                 return p;
             }
 
-            std::vector<typename node::edge> legalActions{get_nature() == DIRECTED ? get_out_edges(last) : get_edges(last)};
+            const typename node::ListEdges &legalActions{last->second->get_edges()};
 
-            for (typename std::vector<typename node::edge>::const_iterator it{legalActions.cbegin()}; it != legalActions.cend(); ++it) {
+            for (typename node::ConstEdgesIterator it{legalActions.cbegin()}; it != legalActions.cend(); ++it) {
                 search_path newPath{p};
                 newPath.push_back({it->target(), it->cost()});
                 frontier.push_front(newPath);
@@ -1510,15 +2103,15 @@ typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::dls(con
 ///// Iterative-Deepening Depth-First Search /////
 //////////////////////////////////////////////////
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::iddfs(key_type start, Key target) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::iddfs(key_type start, Key target) const {
     std::list<const_iterator> l;
     l.emplace_back(find(target));
     return iddfs(find(start), l);
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::iddfs(key_type start, std::list<key_type> target_list) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::iddfs(key_type start, std::list<key_type> target_list) const {
     std::list<const_iterator> l;
     for (key_type k : target_list) {
         l.emplace_back(find(k));
@@ -1526,27 +2119,27 @@ typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::iddfs(k
     return iddfs(find(start), l);
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::iddfs(key_type start, std::function<bool(key_type)> is_goal) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::iddfs(key_type start, std::function<bool(key_type)> is_goal) const {
     return iddfs(find(start), [ &is_goal](const_iterator it) {
         return is_goal(it->first);
     });
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::iddfs(const_iterator start, const_iterator target) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::iddfs(const_iterator start, const_iterator target) const {
     std::list<const_iterator> l;
     l.emplace_back(target);
     return iddfs(start, l);
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::iddfs(const_iterator start, std::list<const_iterator> target_list) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::iddfs(const_iterator start, std::list<const_iterator> target_list) const {
     return iddfs(start, [ &target_list](const_iterator node) -> bool { return std::find(target_list.cbegin(), target_list.cend(), node) != target_list.cend(); });
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::iddfs(const_iterator start, std::function<bool(const_iterator)> is_goal) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::iddfs(const_iterator start, std::function<bool(const_iterator)> is_goal) const {
     if (start == cend()) {
         GRAPH_THROW_WITH(invalid_argument, "Start point equals to graph::cend()")
     }
@@ -1565,15 +2158,13 @@ typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::iddfs(c
 ///// Uniform Cost Search /////
 ///////////////////////////////
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::ucs(key_type start, Key target) const {
-    std::list<const_iterator> l;
-    l.emplace_back(find(target));
-    return ucs(find(start), l);
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::ucs(key_type start, Key target) const {
+    return ucs(find(start), find(target));
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::ucs(key_type start, std::list<key_type> target_list) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::ucs(key_type start, std::list<key_type> target_list) const {
     std::list<const_iterator> l;
     for (key_type k : target_list) {
         l.emplace_back(find(k));
@@ -1581,82 +2172,63 @@ typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::ucs(key
     return ucs(find(start), l);
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::ucs(key_type start, std::function<bool(key_type)> is_goal) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::ucs(key_type start, std::function<bool(key_type)> is_goal) const {
     return ucs(find(start), [ &is_goal](const_iterator it) {
         return is_goal(it->first);
     });
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::ucs(const_iterator start, const_iterator target) const {
-    std::list<const_iterator> l;
-    l.emplace_back(target);
-    return ucs(start, l);
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::ucs(const_iterator start, const_iterator target) const {
+    return ucs(start, [ &target](const_iterator node) -> bool { return node == target; });
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::ucs(const_iterator start, std::list<const_iterator> target_list) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::ucs(const_iterator start, std::list<const_iterator> target_list) const {
     return ucs(start, [ &target_list](const_iterator node) -> bool { return std::find(target_list.cbegin(), target_list.cend(), node) != target_list.cend(); });
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::ucs(const_iterator start, std::function<bool(const_iterator)> is_goal) const {
-    if (start == cend()) {
-        GRAPH_THROW_WITH(invalid_argument, "Start point equals to graph::cend()")
-    }
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::ucs(const_iterator start, std::function<bool(const_iterator)> is_goal) const {
+    return ucs<std::function<bool(const_iterator)>>(start, std::move(is_goal));
+}
 
-    std::list<const_iterator> expanded;
-    std::priority_queue<search_path, std::vector<search_path>, path_comparator> frontier((path_comparator([](const_iterator) {
-        return cost_type();
-    })));
+template <class Key, class T, class Cost, Nature Nat, class Index>
+template <class Goal>
+auto graph<Key, T, Cost, Nat, Index>::ucs(key_type start, Goal is_goal) const -> GRAPH_REQUIRES(search_path, GRAPH_SEARCH_GOAL(Goal, key_type)) {
+    return ucs(find(start), [ &is_goal](const_iterator it) {
+        return is_goal(it->first);
+    });
+}
 
-    {
-        search_path p;
-        p.push_back({start, cost_type()});
-        frontier.push(std::move(p));
+template <class Key, class T, class Cost, Nature Nat, class Index>
+template <class Goal>
+auto graph<Key, T, Cost, Nat, Index>::ucs(const_iterator start, Goal is_goal) const -> GRAPH_REQUIRES(search_path, GRAPH_SEARCH_GOAL(Goal, const_iterator)) {
+    if (start == cend()) {
+        GRAPH_THROW_WITH(invalid_argument, "Start point equals to graph::cend()")
     }
 
-    while (!frontier.empty()) {
-        search_path p{frontier.top()};
-        frontier.pop();
-
-        /// expanded does not contain path's last state
-        if (std::find(expanded.cbegin(), expanded.cend(), p.back().first) == expanded.end()) {
-            const_iterator last{p.back().first};
-            expanded.push_back(last);
-
-            if (is_goal(last)) {
-                return p;
-            }
-
-            std::vector<typename node::edge> legalActions{get_nature() == DIRECTED ? get_out_edges(last) : get_edges(last)};
-
-            for (typename std::vector<typename node::edge>::const_iterator it{legalActions.cbegin()}; it != legalActions.cend(); ++it) {
-                search_path newPath{p};
-                newPath.push_back({it->target(), it->cost()});
-                frontier.push(newPath);
-            }
-        }
-    }
+    search_path result;
+    null_heuristic heuristic;
+    best_first_search(start, is_goal, heuristic, false, result);
 
-    /// Could not find a solution
-    search_path empty = {};
-    return empty;
+    /// An empty path if the goal could not be found
+    return result;
 }
 
 /////////////////////
 ///// A* Search /////
 /////////////////////
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::astar(key_type start, Key target, std::function<cost_type(const_iterator)> heuristic) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::astar(key_type start, Key target, std::function<cost_type(const_iterator)> heuristic) const {
     const_iterator it{this->find(target)};
     return astar(find(start), [ &it](const_iterator node) -> bool { return it == node; }, heuristic);
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::astar(key_type start, std::list<key_type> target_list, std::function<cost_type(const_iterator)> heuristic) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::astar(key_type start, std::list<key_type> target_list, std::function<cost_type(const_iterator)> heuristic) const {
     std::list<const_iterator> l;
     for (key_type k : target_list) {
         l.emplace_back(find(k));
@@ -1664,89 +2236,167 @@ typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::astar(k
     return astar(find(start), l, heuristic);
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::astar(key_type start, std::function<bool(key_type)> is_goal, std::function<cost_type(const_iterator)> heuristic) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::astar(key_type start, std::function<bool(key_type)> is_goal, std::function<cost_type(const_iterator)> heuristic) const {
     return astar(find(start), [ &is_goal](const_iterator it) {
         return is_goal(it->first);
     }, heuristic);
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::astar(const_iterator start, const_iterator target, std::function<cost_type(const_iterator)> heuristic) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::astar(const_iterator start, const_iterator target, std::function<cost_type(const_iterator)> heuristic) const {
     return astar(start, [ &target](const_iterator node) -> bool { return target == node; }, heuristic);
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::astar(const_iterator start, std::list<const_iterator> target_list, std::function<cost_type(const_iterator)> heuristic) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::astar(const_iterator start, std::list<const_iterator> target_list, std::function<cost_type(const_iterator)> heuristic) const {
     return astar(start, [ &target_list](const_iterator node) -> bool { return std::find(target_list.cbegin(), target_list.cend(), node) != target_list.cend(); }, heuristic);
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::astar(const_iterator start, std::function<bool(const_iterator)> is_goal, std::function<cost_type(const_iterator)> heuristic) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::astar(const_iterator start, std::function<bool(const_iterator)> is_goal, std::function<cost_type(const_iterator)> heuristic) const {
+    return astar<std::function<bool(const_iterator)>, std::function<cost_type(const_iterator)>>(start, std::move(is_goal), std::move(heuristic));
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+template <class Heuristic>
+auto graph<Key, T, Cost, Nat, Index>::astar(key_type start, key_type target, Heuristic heuristic) const
+    -> GRAPH_REQUIRES(search_path, GRAPH_SEARCH_HEURISTIC(Heuristic, const_iterator, cost_type)) {
+    return astar(find(start), find(target), std::move(heuristic));
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+template <class Heuristic>
+auto graph<Key, T, Cost, Nat, Index>::astar(key_type start, std::list<key_type> target_list, Heuristic heuristic) const
+    -> GRAPH_REQUIRES(search_path, GRAPH_SEARCH_HEURISTIC(Heuristic, const_iterator, cost_type)) {
+    std::list<const_iterator> l;
+    for (key_type k : target_list) {
+        l.emplace_back(find(k));
+    }
+    return astar(find(start), l, std::move(heuristic));
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+template <class Goal, class Heuristic>
+auto graph<Key, T, Cost, Nat, Index>::astar(key_type start, Goal is_goal, Heuristic heuristic) const
+    -> GRAPH_REQUIRES(search_path, GRAPH_SEARCH_GOAL(Goal, key_type) && GRAPH_SEARCH_HEURISTIC(Heuristic, const_iterator, cost_type)) {
+    return astar(find(start), [ &is_goal](const_iterator it) {
+        return is_goal(it->first);
+    }, std::move(heuristic));
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+template <class Heuristic>
+auto graph<Key, T, Cost, Nat, Index>::astar(const_iterator start, const_iterator target, Heuristic heuristic) const
+    -> GRAPH_REQUIRES(search_path, GRAPH_SEARCH_HEURISTIC(Heuristic, const_iterator, cost_type)) {
+    return astar(start, [ &target](const_iterator node) -> bool { return node == target; }, std::move(heuristic));
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+template <class Heuristic>
+auto graph<Key, T, Cost, Nat, Index>::astar(const_iterator start, std::list<const_iterator> target_list, Heuristic heuristic) const
+    -> GRAPH_REQUIRES(search_path, GRAPH_SEARCH_HEURISTIC(Heuristic, const_iterator, cost_type)) {
+    return astar(start, [ &target_list](const_iterator node) -> bool { return std::find(target_list.cbegin(), target_list.cend(), node) != target_list.cend(); }, std::move(heuristic));
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+template <class Goal, class Heuristic>
+auto graph<Key, T, Cost, Nat, Index>::astar(const_iterator start, Goal is_goal, Heuristic heuristic) const
+    -> GRAPH_REQUIRES(search_path, GRAPH_SEARCH_GOAL(Goal, const_iterator) && GRAPH_SEARCH_HEURISTIC(Heuristic, const_iterator, cost_type)) {
     if (start == cend()) {
         GRAPH_THROW_WITH(invalid_argument, "Start point equals to graph::cend()")
     }
 
+    search_path result;
+    //! A* cannot be computed with negative weights.
+    if (!best_first_search(start, is_goal, heuristic, true, result)) {
+        GRAPH_THROW(negative_edge)
+    }
+
+    /// An empty path if the goal could not be found
+    return result;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+template <class Goal, class Heuristic>
+bool graph<Key, T, Cost, Nat, Index>::best_first_search(const_iterator start, Goal &is_goal, Heuristic &heuristic, bool reject_negative, search_path &result) const {
+    using basic_node_type = typename node::basic_node;
+
     const cost_type nul_cost{cost_type()};
 
-    std::list<const_iterator> expanded;
-    std::priority_queue<search_path, std::vector<search_path>, path_comparator> frontier((path_comparator(heuristic)));
+    //! Search state by dense index; `nodes` is only set for the discovered nodes
+    std::vector<const basic_node_type*> nodes(_indices_bound, nullptr);
+    std::vector<cost_type> distances(_indices_bound, nul_cost);
+    std::vector<cost_type> heuristics(_indices_bound, nul_cost);
+    std::vector<bool> expanded(_indices_bound, false);
+    std::vector<std::pair<const basic_node_type*, cost_type>> parents(_indices_bound, std::make_pair(nullptr, nul_cost));
+    detail::indexed_heap<cost_type> frontier(_indices_bound);
 
     {
-        search_path p;
-        p.push_back({start, nul_cost});
-        frontier.push(std::move(p));
+        const size_type i{index_of(start->second.get())};
+        nodes[i]      = start->second.get();
+        heuristics[i] = heuristic(start);
+        frontier.push(i, heuristics[i]);
     }
 
+    const basic_node_type* goal{nullptr};
     while (!frontier.empty()) {
-        search_path p{frontier.top()};
-        frontier.pop();
+        const size_type i{frontier.pop()};
+        const basic_node_type* current{nodes[i]};
+        expanded[i] = true;
 
-        /// expanded does not contain path's last state
-        if (std::find(expanded.cbegin(), expanded.cend(), p.back().first) == expanded.end()) {
-            const_iterator last{p.back().first};
-            expanded.push_back(last);
+        if (is_goal(current->container_from_this)) {
+            goal = current;
+            break;
+        }
 
-            if (is_goal(last)) {
-                return p;
+        for (const typename node::edge &out : current->_out_edges) {
+            const cost_type cost{out.cost()};
+            if (reject_negative && cost < nul_cost) {
+                return false;
             }
 
-            std::vector<typename node::edge> legalActions{get_nature() == DIRECTED ? get_out_edges(last) : get_edges(last)};
-
-            for (typename std::vector<typename node::edge>::const_iterator it{legalActions.cbegin()}; it != legalActions.cend(); ++it) {
-                //! Dijkstra's algorithm cannot be computed with negative weights.
-                if (it->cost() < nul_cost) {
-                    GRAPH_THROW(negative_edge)
-                }
+            const size_type j{index_of(out._target)};
+            if (expanded[j]) {
+                continue;
+            }
 
-                search_path newPath{p};
-                newPath.push_back({it->target(), it->cost()});
-                frontier.push(newPath);
+            const cost_type alt{distances[i] + cost};
+            if (nodes[j] == nullptr) {
+                nodes[j]      = out._target;
+                heuristics[j] = heuristic(const_iterator(out._target->container_from_this));
+            } else if (!(alt < distances[j])) {
+                continue;
             }
+            distances[j] = alt;
+            parents[j]   = std::make_pair(current, cost);
+            frontier.push(j, alt + heuristics[j]);
         }
     }
 
-    /// Could not find a solution
-    search_path empty = {};
-    return empty;
+    result.clear();
+    for (const basic_node_type* current{goal}; current != nullptr; current = parents[index_of(current)].first) {
+        result.push_front(std::make_pair(const_iterator(current->container_from_this), parents[index_of(current)].second));
+    }
+    return true;
 }
 
 ////
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::shortest_paths graph<Key, T, Cost, Nat>::dijkstra(key_type start) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::shortest_paths graph<Key, T, Cost, Nat, Index>::dijkstra(key_type start) const {
     return dijkstra(find(start), [](const_iterator) {
         return false;
     });
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::shortest_paths graph<Key, T, Cost, Nat>::dijkstra(key_type start, key_type target) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::shortest_paths graph<Key, T, Cost, Nat, Index>::dijkstra(key_type start, key_type target) const {
     const_iterator it{this->find(target)};
     return dijkstra(find(start), [ &it](const_iterator node) -> bool { return it == node; });
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::shortest_paths graph<Key, T, Cost, Nat>::dijkstra(key_type start, std::list<key_type> target_list) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::shortest_paths graph<Key, T, Cost, Nat, Index>::dijkstra(key_type start, std::list<key_type> target_list) const {
     std::list<const_iterator> l;
     for (key_type k : target_list) {
         l.emplace_back(find(k));
@@ -1754,250 +2404,1658 @@ typename graph<Key, T, Cost, Nat>::shortest_paths graph<Key, T, Cost, Nat>::dijk
     return dijkstra(find(start), l);
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::shortest_paths graph<Key, T, Cost, Nat>::dijkstra(key_type start, std::function<bool(key_type)> is_goal) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::shortest_paths graph<Key, T, Cost, Nat, Index>::dijkstra(key_type start, std::function<bool(key_type)> is_goal) const {
     return dijkstra(find(start), [ &is_goal](const_iterator it) {
         return is_goal(it->first);
     });
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::shortest_paths graph<Key, T, Cost, Nat>::dijkstra(const_iterator start) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::shortest_paths graph<Key, T, Cost, Nat, Index>::dijkstra(const_iterator start) const {
     return dijkstra(start, [](const_iterator) {
         return false;
     });
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::shortest_paths graph<Key, T, Cost, Nat>::dijkstra(const_iterator start, const_iterator target) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::shortest_paths graph<Key, T, Cost, Nat, Index>::dijkstra(const_iterator start, const_iterator target) const {
     return dijkstra(start, [ &target](const_iterator node) -> bool { return target == node; });
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::shortest_paths graph<Key, T, Cost, Nat>::dijkstra(const_iterator start, std::list<const_iterator> target_list) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::shortest_paths graph<Key, T, Cost, Nat, Index>::dijkstra(const_iterator start, std::list<const_iterator> target_list) const {
     return dijkstra(start, [ &target_list](const_iterator node) -> bool { return std::find(target_list.cbegin(), target_list.cend(), node) != target_list.cend(); });
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::shortest_paths graph<Key, T, Cost, Nat>::dijkstra(const_iterator start, std::function<bool(const_iterator)> is_goal) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::shortest_paths graph<Key, T, Cost, Nat, Index>::dijkstra(const_iterator start, std::function<bool(const_iterator)> is_goal) const {
     if (start == cend()) {
         GRAPH_THROW_WITH(invalid_argument, "Start point equals to graph::cend()")
     }
 
-    struct pair_iterator_comparator {
-        bool operator()(const std::pair<const_iterator, cost_type> &lhs, const std::pair<const_iterator, cost_type> &rhs) const {
-            return lhs.second < rhs.second;
-        }
-    };
+    shortest_paths result(*this, start);
+    dijkstra(is_goal, result, integral_cost_tag());
+    return result;
+}
 
-    //! Initialization
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::dijkstra(std::function<bool(const_iterator)> &is_goal, shortest_paths &result, std::true_type) const {
+    using radix_key = typename std::make_unsigned<cost_type>::type;
 
     const cost_type nul_cost{cost_type()};
-    std::priority_queue<std::pair<const_iterator, cost_type>, std::vector<std::pair<const_iterator, cost_type >>, pair_iterator_comparator> Q;
 
-    shortest_paths result(start);
-    for (const_iterator it{cbegin()}; it != cend(); ++it) {
-        result.emplace(it, std::make_pair(cend(), infinity));
+    //! The distances are settled in increasing order: a radix heap replaces the comparisons between the costs.
+    //! A node is pushed again when its distance decreases, the outdated entries are skipped when popped.
+    std::vector<bool> settled(_indices_bound, false);
+    detail::radix_heap<radix_key, const typename node::basic_node*> Q;
+    Q.push(radix_key(), result._start->second.get());
+
+    while (!Q.empty()) {
+        const std::pair<radix_key, const typename node::basic_node*> top{Q.pop()};
+        const typename node::basic_node* u{top.second};
+        if (settled[index_of(u)]) {
+            continue;
+        }
+        settled[index_of(u)] = true;
+
+        if (is_goal(u->container_from_this)) {
+            break;
+        }
+
+        const cost_type dist_u{static_cast<cost_type>(top.first)};
+        for (const typename node::edge &e : u->_out_edges) {
+            const cost_type cost{e.cost()};
+            //! Dijkstra's algorithm cannot be computed with negative weights.
+            if (cost < nul_cost) {
+                GRAPH_THROW(negative_edge)
+            }
+
+            //! An edge of infinite cost leads nowhere, and a longer path would wrap below the last popped key
+            if (settled[index_of(e._target)] || !(cost < infinity - dist_u)) {
+                continue;
+            }
+
+            const cost_type alt{dist_u + cost};
+            typename shortest_paths::mapped_type &v{result.entry(e._target)};
+
+            /// Existing shortest path to v through u with a cost of alt
+            if (alt < v.second) {
+                v.first  = u->container_from_this;
+                v.second = alt;
+                Q.push(static_cast<radix_key>(alt), e._target);
+            }
+        }
     }
-    Q.emplace(start, nul_cost);
-    /// d(start, start) == nul_cost;
-    typename shortest_paths::iterator S{result.find(start)};
-    S->second.first = start;
-    S->second.second = nul_cost;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::dijkstra(std::function<bool(const_iterator)> &is_goal, shortest_paths &result, std::false_type) const {
+    const cost_type nul_cost{cost_type()};
 
-    //! Dijkstra's algorithm
+    //! Each node is at most once in the queue, whose priorities are lowered in place: no outdated entry is ever popped
+    std::vector<bool> settled(_indices_bound, false);
+    detail::indexed_heap<cost_type> Q(_indices_bound);
+    Q.push(index_of(result._start->second.get()), nul_cost);
 
     while (!Q.empty()) {
-        const_iterator u{Q.top().first};
+        const size_type i{Q.top()};
+        const cost_type dist_u{Q.top_priority()};
         Q.pop();
+        settled[i] = true;
 
-        if (is_goal(u)) {
+        const typename node::basic_node* u{result[result._positions[i]].first->second.get()};
+        if (is_goal(u->container_from_this)) {
             break;
         }
 
-        std::vector<typename node::edge> adj{get_out_edges(u)};
-        for (typename std::vector<typename node::edge>::const_iterator edge{adj.cbegin()}; edge != adj.cend(); ++edge) {
-            const_iterator v{edge->target()};
-
-            cost_type cost{u->second->get_cost(v)};
+        for (const typename node::edge &e : u->_out_edges) {
+            const cost_type cost{e.cost()};
             //! Dijkstra's algorithm cannot be computed with negative weights.
             if (cost < nul_cost) {
                 GRAPH_THROW(negative_edge)
             }
 
-            cost_type dist_u{result[u].second};
-            cost_type dist_v{result[v].second};
+            const size_type j{index_of(e._target)};
+            if (settled[j]) {
+                continue;
+            }
 
-            cost_type alt{dist_u + cost};
+            const cost_type alt{dist_u + cost};
+            typename shortest_paths::mapped_type &v{result.entry(e._target)};
 
             /// Existing shortest path to v through u with a cost of alt
-            if (alt < dist_v) {
-                result[v].first = u;
-                result[v].second = alt;
-                Q.emplace(v, alt);
+            if (alt < v.second) {
+                v.first  = u->container_from_this;
+                v.second = alt;
+                Q.push(j, alt);
             }
         }
     }
-
-    return result;
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::shortest_paths graph<Key, T, Cost, Nat>::bellman_ford(key_type start) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::shortest_paths graph<Key, T, Cost, Nat, Index>::bellman_ford(key_type start) const {
     return bellman_ford(find(start));
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::shortest_paths graph<Key, T, Cost, Nat>::bellman_ford(const_iterator start) const {
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::shortest_paths graph<Key, T, Cost, Nat, Index>::bellman_ford(const_iterator start) const {
     if (start == cend()) {
         GRAPH_THROW_WITH(invalid_argument, "Start point equals to graph::cend()")
     }
 
+    using basic_node_type = typename node::basic_node;
+
     //! Initialization
 
-    shortest_paths result(start);
-    for (const_iterator it{cbegin()}; it != cend(); ++it) {
-        result.emplace(it, std::make_pair(cend(), infinity));
+    shortest_paths result(*this, start);
+
+    //! Number of edges of the current path to each node, and active nodes waiting to relax their out-edges
+    std::vector<size_type> hops(_indices_bound, 0);
+    std::vector<bool> queued(_indices_bound, false);
+    std::deque<const basic_node_type*> active;
+    active.push_back(start->second.get());
+    queued[index_of(start->second.get())] = true;
+
+    //! Relax the out-edges of the nodes whose distance changed
+
+    while (!active.empty()) {
+        const basic_node_type* u{active.front()};
+        active.pop_front();
+        const size_type i{index_of(u)};
+        queued[i] = false;
+
+        const cost_type dist_u{result.entry(u).second};
+        for (const typename node::edge &e : u->_out_edges) {
+            const cost_type alt{dist_u + e.cost()};
+            typename shortest_paths::mapped_type &v{result.entry(e._target)};
+
+            if (alt < v.second) {
+                v.first  = u->container_from_this;
+                v.second = alt;
+
+                const size_type j{index_of(e._target)};
+                hops[j] = hops[i] + 1;
+                //! Check for negative-weight cycles: a shortest path has less than size() edges
+                if (hops[j] >= size()) {
+                    GRAPH_THROW(negative_weight_cycle)
+                }
+                if (!queued[j]) {
+                    queued[j] = true;
+                    active.push_back(e._target);
+                }
+            }
+        }
     }
-    /// d(start, start) == nul_cost;
-    typename shortest_paths::iterator S{result.find(start)};
-    S->second.first = start;
-    S->second.second = cost_type();
 
-    //! Relax edges repeatedly
-
-    bool finished{false};
-    for (size_type i{0}; i < get_nbr_edges() - 1 && !finished; ++i) {
-        finished = true;
+    return result;
+}
 
-        for (const_iterator u{cbegin()}; u != cend(); ++u) {
-            std::vector<typename node::edge> adj{get_out_edges(u)};
-            for (typename std::vector<typename node::edge>::const_iterator edge{adj.cbegin()}; edge != adj.cend(); ++edge) {
-                const_iterator v{edge->target()};
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::shortest_paths graph<Key, T, Cost, Nat, Index>::bellman_ford(key_type start, size_type nbr_threads) const {
+    return bellman_ford(find(start), nbr_threads);
+}
 
-                cost_type cost{u->second->get_cost(v)};
-                cost_type dist_u{result[u].second};
-                cost_type dist_v{result[v].second};
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::shortest_paths graph<Key, T, Cost, Nat, Index>::bellman_ford(const_iterator start, size_type nbr_threads) const {
+    if (start == cend()) {
+        GRAPH_THROW_WITH(invalid_argument, "Start point equals to graph::cend()")
+    }
 
-                cost_type alt{dist_u + cost};
+    //! Initialization
 
-                if (alt < dist_v) {
-                    result[v].first = u;
-                    result[v].second = alt;
-                    finished = false;
+    shortest_paths result(*this, start);
+    const size_type V{result.size()};
+
+    //! The sources and the costs of the in-edges of the node at the position v of result are in [offsets[v], offsets[v + 1])
+    std::vector<size_type> offsets(V + 1, 0);
+    std::vector<size_type> sources;
+    std::vector<cost_type> costs;
+    sources.reserve(directed_tag::value ? get_nbr_edges() : 2 * get_nbr_edges());
+    costs.reserve(sources.capacity());
+    for (size_type v{0}; v < V; ++v) {
+        for (const typename node::in_edge &in : result[v].first->second->_in_edges) {
+            sources.push_back(result._positions[index_of(in._source)]);
+            costs.push_back(in._source->_out_edges[in._position].cost());
+        }
+        offsets[v + 1] = sources.size();
+    }
+
+    std::vector<cost_type> distances(V, infinity);
+    distances[result._positions[index_of(start->second.get())]] = cost_type();
+    std::vector<cost_type> next(distances);
+    std::vector<size_type> previous(V, V);
+
+    //! A thread is worth at least this number of nodes to update per round
+    const size_type parallel_threshold{256};
+    detail::thread_pool pool(nbr_threads, V / parallel_threshold);
+    const size_type P{pool.size()};
+    std::vector<char> changed(P, false);
+
+    //! Each thread pulls the new distances of its own share of the nodes from the distances of the previous round
+    const std::function<void(size_type)> round_task = [&](size_type t) {
+        changed[t] = false;
+        for (size_type v{V * t / P}; v < V * (t + 1) / P; ++v) {
+            cost_type best{distances[v]};
+            for (size_type e{offsets[v]}; e != offsets[v + 1]; ++e) {
+                const cost_type dist_u{distances[sources[e]]};
+                if (dist_u != infinity && dist_u + costs[e] < best) {
+                    best        = dist_u + costs[e];
+                    previous[v] = sources[e];
+                    changed[t]  = true;
                 }
             }
+            next[v] = best;
         }
-    }
+    };
 
-    //! Check for negative-weigh cycles
+    //! Relax edges in rounds
 
-    for (const_iterator u{cbegin()}; u != cend(); ++u) {
-        std::vector<typename node::edge> adj{get_out_edges(u)};
-        for (typename std::vector<typename node::edge>::const_iterator edge{adj.cbegin()}; edge != adj.cend(); ++edge) {
-            const_iterator v{edge->target()};
-            if (result[u].second + u->second->get_cost(v) < result[v].second) {
-                GRAPH_THROW(negative_weight_cycle)
-            }
+    for (size_type round{1};; ++round) {
+        pool.run(round_task);
+        distances.swap(next);
+
+        if (std::find(changed.cbegin(), changed.cend(), true) == changed.cend()) {
+            break;
+        }
+        //! Check for negative-weight cycles: a shortest path has less than size() edges
+        if (round >= V) {
+            GRAPH_THROW(negative_weight_cycle)
         }
     }
 
+    for (size_type v{0}; v < V; ++v) {
+        if (previous[v] != V) {
+            result[v].second.first  = result[previous[v]].first;
+            result[v].second.second = distances[v];
+        }
+    }
     return result;
 }
 
-/////////////////////////////
-///// search_path class /////
-/////////////////////////////
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::shortest_paths graph<Key, T, Cost, Nat, Index>::delta_stepping(key_type start, cost_type delta, size_type nbr_threads) const {
+    return delta_stepping(find(start), delta, nbr_threads);
+}
 
-template <class Key, class T, class Cost, Nature Nat>
-graph<Key, T, Cost, Nat>::search_path::search_path(const search_path &p) : Container(p) {}
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::shortest_paths graph<Key, T, Cost, Nat, Index>::delta_stepping(const_iterator start, cost_type delta, size_type nbr_threads) const {
+    if (start == cend()) {
+        GRAPH_THROW_WITH(invalid_argument, "Start point equals to graph::cend()")
+    }
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::cost_type graph<Key, T, Cost, Nat>::search_path::total_cost() const {
-    cost_type total{};
-    for (const_iterator it{cbegin()}; it != cend(); ++it) {
-        total += it->second;
+    const cost_type nul_cost{cost_type()};
+    if (!(nul_cost < delta)) {
+        GRAPH_THROW_WITH(invalid_argument, "Non-positive bucket width")
     }
-    return total;
-}
 
-template <class Key, class T, class Cost, Nature Nat>
-bool graph<Key, T, Cost, Nat>::search_path::contain(const graph::const_iterator &i) const {
-    for (const_iterator it{cbegin()}; it != cend(); ++it) {
-        if (it->first == i) {
-            return true;
+    using basic_node_type = typename node::basic_node;
+
+    //! A relaxation sent by a thread to the owner of its target, the thread `index_of(target) % P`
+    struct request {
+        const basic_node_type* target;
+        const basic_node_type* source;
+        cost_type              distance;
+    };
+
+    //! Below this number of nodes to expand, a phase is run on the calling thread only, and the pool is not started
+    const size_type parallel_threshold{256};
+    detail::thread_pool pool(nbr_threads, size() / parallel_threshold);
+    const size_type P{pool.size()};
+
+    std::vector<cost_type> distances(_indices_bound, infinity);
+    std::vector<const basic_node_type*> parents(_indices_bound, nullptr);
+    //! `buckets[i]` holds the nodes whose tentative distance was lowered into `[i * delta, (i + 1) * delta)`; outdated entries are skipped
+    //! The buckets are sparse: a large ratio between the distances and @p delta leaves most of them empty
+    std::map<size_type, std::vector<const basic_node_type*>> buckets;
+    std::vector<std::vector<request>> requests(P * P);
+    std::vector<std::vector<const basic_node_type*>> lowered(P);
+    std::vector<char> negative(P, false);
+
+    const auto bucket_of = [delta](cost_type distance) -> size_type {
+        return static_cast<size_type>(distance / delta);
+    };
+
+    //! Relax the light or the heavy edges of the nodes of @p frontier, and file the lowered nodes in their buckets
+    const auto relax = [&](const std::vector<const basic_node_type*> &frontier, bool light) {
+        const size_type nbr_tasks{frontier.size() < parallel_threshold ? 1 : P};
+
+        /// each thread sends the relaxations of its share of the frontier to the owners of their targets
+        const std::function<void(size_type)> send = [&](size_type t) {
+            if (t >= nbr_tasks) {
+                return;
+            }
+            for (size_type k{frontier.size() * t / nbr_tasks}; k < frontier.size() * (t + 1) / nbr_tasks; ++k) {
+                const basic_node_type* u{frontier[k]};
+                const cost_type dist_u{distances[index_of(u)]};
+                for (const typename node::edge &e : u->_out_edges) {
+                    const cost_type cost{e.cost()};
+                    if (cost < nul_cost) {
+                        negative[t] = true;
+                    } else if (light == !(delta < cost) && cost < infinity - dist_u) { //! an infinite cost leads nowhere
+                        requests[t * P + index_of(e._target) % P].push_back(request{e._target, u, dist_u + cost});
+                    }
+                }
+            }
+        };
+        /// each thread applies the relaxations of the nodes it owns
+        const std::function<void(size_type)> apply = [&](size_type t) {
+            for (size_type from{0}; from < P; ++from) {
+                for (const request &r : requests[from * P + t]) {
+                    const size_type j{index_of(r.target)};
+                    if (r.distance < distances[j]) {
+                        distances[j] = r.distance;
+                        parents[j]   = r.source;
+                        lowered[t].push_back(r.target);
+                    }
+                }
+                requests[from * P + t].clear();
+            }
+        };
+
+        if (nbr_tasks == 1) {
+            send(0);
+            for (size_type t{0}; t < P; ++t) {
+                apply(t);
+            }
+        } else {
+            pool.run(send);
+            pool.run(apply);
         }
-    }
-    return false;
-}
 
-////////////////////////////////
-///// shortest_paths class /////
-////////////////////////////////
+        for (std::vector<const basic_node_type*> &nodes : lowered) {
+            for (const basic_node_type* v : nodes) {
+                buckets[bucket_of(distances[index_of(v)])].push_back(v);
+            }
+            nodes.clear();
+        }
+    };
 
-template <class Key, class T, class Cost, Nature Nat>
-graph<Key, T, Cost, Nat>::shortest_paths::shortest_paths(graph::const_iterator start) : _start(start) {}
+    //! Delta-stepping
 
-template <class Key, class T, class Cost, Nature Nat>
-graph<Key, T, Cost, Nat>::shortest_paths::shortest_paths(const shortest_paths &p) : Container(p), _start(p._start) {}
+    distances[index_of(start->second.get())] = nul_cost;
+    buckets[0].push_back(start->second.get());
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::const_iterator graph<Key, T, Cost, Nat>::shortest_paths::get_previous(graph::const_iterator current) const {
-    return this->find(current)->second.first;
-}
+    //! Round in which each node was last expanded, to expand it once per round
+    std::vector<size_type> expanded(_indices_bound, std::numeric_limits<size_type>::max());
+    size_type round{0};
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::shortest_paths::get_path(graph::key_type target) const {
-    for (const_iterator it{cbegin()}; it != cend(); ++it) {
-        if (it->first->first == target) {
-            return get_path(it->first);
+    std::vector<const basic_node_type*> current, frontier, settled;
+    while (!buckets.empty()) {
+        const size_type i{buckets.cbegin()->first};
+        settled.clear();
+
+        /// the light edges may lower nodes back into the bucket `i`, which is then expanded again
+        for (typename std::map<size_type, std::vector<const basic_node_type*>>::iterator it{buckets.find(i)}; it != buckets.end(); it = buckets.find(i)) {
+            current.swap(it->second);
+            buckets.erase(it);
+
+            frontier.clear();
+            for (const basic_node_type* u : current) {
+                const size_type k{index_of(u)};
+                if (expanded[k] != round && bucket_of(distances[k]) == i) {
+                    expanded[k] = round;
+                    frontier.push_back(u);
+                }
+            }
+            current.clear();
+            ++round;
+
+            settled.insert(settled.end(), frontier.cbegin(), frontier.cend());
+            relax(frontier, true);
+        }
+
+        /// the heavy edges lead to later buckets: they are relaxed once, from the nodes settled in this bucket
+        frontier.clear();
+        for (const basic_node_type* u : settled) {
+            if (expanded[index_of(u)] != round) {
+                expanded[index_of(u)] = round;
+                frontier.push_back(u);
+            }
+        }
+        ++round;
+        relax(frontier, false);
+
+        //! Delta-stepping cannot be computed with negative weights.
+        if (std::find(negative.cbegin(), negative.cend(), true) != negative.cend()) {
+            GRAPH_THROW(negative_edge)
         }
     }
-    return graph::search_path();
-}
 
-template <class Key, class T, class Cost, Nature Nat>
-typename graph<Key, T, Cost, Nat>::search_path graph<Key, T, Cost, Nat>::shortest_paths::get_path(graph::const_iterator target) const {
-    graph::shortest_paths::const_iterator current{this->find(target)};
-    if (current == cend() || current->second.second == (std::numeric_limits<cost_type>::has_infinity ? std::numeric_limits<cost_type>::infinity() : std::numeric_limits<cost_type>::max())) {
-        return search_path();
+    shortest_paths result(*this, start);
+    for (typename shortest_paths::value_type &e : result) {
+        const size_type k{index_of(e.first->second.get())};
+        if (parents[k] != nullptr) {
+            e.second.first  = parents[k]->container_from_this;
+            e.second.second = distances[k];
+        }
     }
+    return result;
+}
 
-    graph::search_path result;
-    graph::shortest_paths::const_iterator previous{this->find(current->second.first)};
+//////////////////////////
+///// Floyd-Warshall /////
+//////////////////////////
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::distance_matrix graph<Key, T, Cost, Nat, Index>::all_pairs_shortest_paths(bool keep_paths, size_type nbr_threads) const {
+    const size_type n{size()};
+    std::vector<size_type> positions;
+    distance_matrix result(*this, keep_paths, positions);
+
+    //! Initialization: the cheapest edge between each pair of nodes, and the empty path from each node to itself
 
-    while (previous != cend() && current->first != _start) {
-        result.emplace_front(current->first, current->second.second - previous->second.second);
-        current = previous;
-        previous = this->find(current->second.first);
+    for (const_iterator it{cbegin()}; it != cend(); ++it) {
+        const size_type from{positions[index_of(it->second.get())]};
+        for (const typename node::edge &e : it->second->_out_edges) {
+            const size_type position{from * n + positions[index_of(e._target)]};
+            if (e.cost() < result._distances[position]) {
+                result._distances[position] = e.cost();
+                if (keep_paths) {
+                    result._next[position] = positions[index_of(e._target)];
+                }
+            }
+        }
+    }
+    for (size_type i{0}; i < n; ++i) {
+        if (!(result._distances[i * (n + 1)] < cost_type())) {
+            result._distances[i * (n + 1)] = cost_type();
+            if (keep_paths) {
+                result._next[i * (n + 1)] = i;
+            }
+        }
     }
 
-    if (target != _start) {
-        result.emplace_front(_start, cost_type());
+    //! Blocked Floyd-Warshall: three blocks of 64 x 64 distances stay in the L2 cache
+
+    cost_type* distances{result._distances.data()};
+    size_type* next{keep_paths ? result._next.data() : nullptr};
+    const size_type B{64};
+    const size_type nbr_blocks{(n + B - 1) / B};
+    size_type k_begin{0}, k_end{0}, kb{0};
+
+    //! A thread is worth at least one block of the matrix: a graph of a single block is run on the calling thread
+    detail::thread_pool pool(nbr_threads, nbr_blocks * nbr_blocks);
+    const size_type P{pool.size()};
+
+    //! The blocks of the row and of the column of the diagonal block only depend on it
+    const std::function<void(size_type)> cross_task = [&](size_type t) {
+        for (size_type b{t}; b < nbr_blocks; b += P) {
+            if (b != kb) {
+                relax_block(distances, next, n, k_begin, k_end, k_begin, k_end, b * B, std::min(n, (b + 1) * B));
+                relax_block(distances, next, n, k_begin, k_end, b * B, std::min(n, (b + 1) * B), k_begin, k_end);
+            }
+        }
+    };
+    //! The other blocks only depend on the blocks of their row and of their column
+    const std::function<void(size_type)> remaining_task = [&](size_type t) {
+        for (size_type b{t}; b < nbr_blocks * nbr_blocks; b += P) {
+            const size_type bi{b / nbr_blocks}, bj{b % nbr_blocks};
+            if (bi != kb && bj != kb) {
+                relax_block(distances, next, n, k_begin, k_end, bi * B, std::min(n, (bi + 1) * B), bj * B, std::min(n, (bj + 1) * B));
+            }
+        }
+    };
+
+    for (kb = 0; kb < nbr_blocks; ++kb) {
+        k_begin = kb * B;
+        k_end   = std::min(n, k_begin + B);
+
+        relax_block(distances, next, n, k_begin, k_end, k_begin, k_end, k_begin, k_end);
+        pool.run(cross_task);
+        pool.run(remaining_task);
+
+        //! Check for negative-weight cycles: a node would be at a negative distance from itself
+        for (size_type i{0}; i < n; ++i) {
+            if (distances[i * (n + 1)] < cost_type()) {
+                GRAPH_THROW(negative_weight_cycle)
+            }
+        }
     }
 
     return result;
 }
 
-///template <class Key, class T, class Cost, Nature Nat>
-///std::ostream &graph<Key, T, Cost, Nat>::operator<<(std::ostream &os, const typename graph::search_path &sp) {
-///    Cost count{};
-///    for (const std::pair<typename graph<Key, T, Cost, Nat>::const_iterator, Cost> &p : sp) {
-///       count += p.second;
-///        os << "-> " << p.first->first << " (" << count << ") ";
-///    }
-///    return os;
-///}
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::relax_block(cost_type* distances, size_type* next, size_type n, size_type k_begin, size_type k_end,
+                                                   size_type i_begin, size_type i_end, size_type j_begin, size_type j_end) const {
+    //! Local copy, that the stores into the rows cannot alias
+    const cost_type inf{infinity};
 
-template <class Key, class T, class Cost, Nature Nat>
-graph<Key, T, Cost, Nat>::path_comparator::path_comparator(std::function<cost_type(const_iterator)> heuristic) : _heuristic(heuristic) {}
+    for (size_type k{k_begin}; k < k_end; ++k) {
+        const cost_type* row_k{distances + k * n};
+        for (size_type i{i_begin}; i < i_end; ++i) {
+            cost_type* row_i{distances + i * n};
+            const cost_type d_ik{row_i[k]};
+            if (d_ik == inf) {
+                continue;
+            }
 
-template <class Key, class T, class Cost, Nature Nat>
-bool graph<Key, T, Cost, Nat>::path_comparator::operator() (const search_path &p1, const search_path &p2) const {
-    return (p2.total_cost() + _heuristic(p2.back().first)) < (p1.total_cost() + _heuristic(p1.back().first));
+            //! Branch-free inner loops over contiguous rows
+            //! The addend is selected before the sum: with integral costs, d_ik + inf would overflow
+            if (next == nullptr) {
+                for (size_type j{j_begin}; j < j_end; ++j) {
+                    const bool reachable{row_k[j] != inf};
+                    const cost_type alt{d_ik + (reachable ? row_k[j] : cost_type())};
+                    row_i[j] = reachable && alt < row_i[j] ? alt : row_i[j];
+                }
+            } else {
+                size_type* next_i{next + i * n};
+                const size_type hop{next_i[k]};
+                for (size_type j{j_begin}; j < j_end; ++j) {
+                    const bool reachable{row_k[j] != inf};
+                    const cost_type alt{d_ik + (reachable ? row_k[j] : cost_type())};
+                    const bool shorter{reachable && alt < row_i[j]};
+                    row_i[j]  = shorter ? alt : row_i[j];
+                    next_i[j] = shorter ? hop : next_i[j];
+                }
+            }
+        }
+    }
 }
 
-template <class Key, class T, class Cost, Nature Nat>
-bool graph<Key, T, Cost, Nat>::iterator_comparator::operator()(const const_iterator &lhs, const const_iterator &rhs) const {
-    return lhs->first < rhs->first;
+///////////////////////////////
+///// Johnson's Algorithm /////
+///////////////////////////////
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::distance_matrix graph<Key, T, Cost, Nat, Index>::johnson(bool keep_paths, size_type nbr_threads) const {
+    const size_type n{size()};
+    std::vector<size_type> positions;
+    distance_matrix result(*this, keep_paths, positions);
+
+    //! The out-edges of the node i are the positions [offsets[i], offsets[i + 1]) of targets and costs
+    std::vector<size_type> offsets(n + 1, 0);
+    std::vector<size_type> targets;
+    std::vector<cost_type> costs;
+    for (const_iterator it{cbegin()}; it != cend(); ++it) {
+        for (const typename node::edge &e : it->second->_out_edges) {
+            //! An edge of infinite cost leads nowhere: left out, it cannot overflow the reweighted costs
+            if (e.cost() != infinity) {
+                targets.push_back(positions[index_of(e._target)]);
+                costs.push_back(e.cost());
+            }
+        }
+        offsets[positions[index_of(it->second.get())] + 1] = targets.size();
+    }
+
+    //! Potentials: Bellman-Ford from a virtual node linked to every node by an edge of null cost
+
+    std::vector<cost_type> potentials(n, cost_type());
+    std::vector<size_type> hops(n, 0);
+    std::vector<bool> queued(n, true);
+    std::deque<size_type> active;
+    for (size_type i{0}; i < n; ++i) {
+        active.push_back(i);
+    }
+    while (!active.empty()) {
+        const size_type u{active.front()};
+        active.pop_front();
+        queued[u] = false;
+
+        for (size_type e{offsets[u]}; e != offsets[u + 1]; ++e) {
+            const size_type v{targets[e]};
+            if (potentials[u] + costs[e] < potentials[v]) {
+                potentials[v] = potentials[u] + costs[e];
+                hops[v]       = hops[u] + 1;
+                //! Check for negative-weight cycles: a shortest path has less than size() edges
+                if (hops[v] >= n) {
+                    GRAPH_THROW(negative_weight_cycle)
+                }
+                if (!queued[v]) {
+                    queued[v] = true;
+                    active.push_back(v);
+                }
+            }
+        }
+    }
+
+    //! Reweighting: non-negative costs, up to the rounding errors of floating-point costs
+    for (size_type u{0}; u < n; ++u) {
+        for (size_type e{offsets[u]}; e != offsets[u + 1]; ++e) {
+            costs[e] = std::max(cost_type(), costs[e] + potentials[u] - potentials[targets[e]]);
+        }
+    }
+
+    //! A Dijkstra's search from every source, in its own row of the matrix
+
+    //! A thread is worth at least this number of pops and relaxations
+    const size_type parallel_threshold{1 << 16};
+    detail::thread_pool pool(nbr_threads, n * (n + offsets[n]) / parallel_threshold);
+    const size_type P{pool.size()};
+    const cost_type inf{infinity};
+
+    const std::function<void(size_type)> search_task = [&](size_type t) {
+        detail::indexed_heap<cost_type> heap(n);
+        for (size_type s{t}; s < n; s += P) {
+            cost_type* distances{result._distances.data() + s * n};
+            size_type* next{keep_paths ? result._next.data() + s * n : nullptr};
+
+            distances[s] = cost_type();
+            if (next != nullptr) {
+                next[s] = s;
+            }
+            heap.push(s, cost_type());
+            while (!heap.empty()) {
+                const cost_type dist_u{heap.top_priority()};
+                const size_type u{heap.pop()};
+
+                for (size_type e{offsets[u]}; e != offsets[u + 1]; ++e) {
+                    const size_type v{targets[e]};
+                    const cost_type alt{dist_u + costs[e]};
+                    if (alt < distances[v]) {
+                        distances[v] = alt;
+                        if (next != nullptr) {
+                            next[v] = u == s ? v : next[u];
+                        }
+                        heap.push(v, alt);
+                    }
+                }
+            }
+
+            //! Back to the original costs
+            for (size_type v{0}; v < n; ++v) {
+                if (distances[v] != inf) {
+                    distances[v] = distances[v] - potentials[s] + potentials[v];
+                }
+            }
+        }
+    };
+    pool.run(search_task);
+
+    return result;
+}
+
+/////////////////////////////
+///// search_path class /////
+/////////////////////////////
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+graph<Key, T, Cost, Nat, Index>::search_path::search_path(const search_path &p) : Container(p) {}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::cost_type graph<Key, T, Cost, Nat, Index>::search_path::total_cost() const {
+    cost_type total{};
+    for (const_iterator it{cbegin()}; it != cend(); ++it) {
+        total += it->second;
+    }
+    return total;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+bool graph<Key, T, Cost, Nat, Index>::search_path::contain(const graph::const_iterator &i) const {
+    for (const_iterator it{cbegin()}; it != cend(); ++it) {
+        if (it->first == i) {
+            return true;
+        }
+    }
+    return false;
+}
+
+////////////////////////////////
+///// shortest_paths class /////
+////////////////////////////////
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+graph<Key, T, Cost, Nat, Index>::shortest_paths::shortest_paths(const graph &g, graph::const_iterator start)
+    : _graph(&g), _start(start), _positions(g._indices_bound, 0) {
+    this->reserve(g.size());
+    for (graph::const_iterator it{g.cbegin()}; it != g.cend(); ++it) {
+        _positions[graph::index_of(it->second.get())] = this->size();
+        this->emplace_back(it, std::make_pair(g.cend(), g.infinity));
+    }
+
+    /// d(start, start) == nul_cost;
+    mapped_type &s{entry(start->second.get())};
+    s.first  = start;
+    s.second = cost_type();
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+graph<Key, T, Cost, Nat, Index>::shortest_paths::shortest_paths(const shortest_paths &p) : Container(p), _graph(p._graph), _start(p._start), _positions(p._positions) {}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::shortest_paths::mapped_type &graph<Key, T, Cost, Nat, Index>::shortest_paths::entry(const typename node::basic_node* n) {
+    return (*this)[_positions[graph::index_of(n)]].second;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+const typename graph<Key, T, Cost, Nat, Index>::shortest_paths::mapped_type &graph<Key, T, Cost, Nat, Index>::shortest_paths::entry(const typename node::basic_node* n) const {
+    return (*this)[_positions[graph::index_of(n)]].second;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+const typename graph<Key, T, Cost, Nat, Index>::shortest_paths::mapped_type *graph<Key, T, Cost, Nat, Index>::shortest_paths::find_entry(graph::const_iterator it) const {
+    //! Nodes added since the search are past the end; a reused dense index points to the entry of another node
+    if (it == _graph->cend()) {
+        return nullptr;
+    }
+    const size_type index{graph::index_of(it->second.get())};
+    if (index >= _positions.size() || (*this)[_positions[index]].first != it) {
+        return nullptr;
+    }
+    return &(*this)[_positions[index]].second;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::const_iterator graph<Key, T, Cost, Nat, Index>::shortest_paths::get_previous(graph::const_iterator current) const {
+    const mapped_type* e{find_entry(current)};
+    return e == nullptr ? _graph->cend() : e->first;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+Cost graph<Key, T, Cost, Nat, Index>::shortest_paths::get_distance(graph::key_type target) const {
+    const graph::const_iterator it{_graph->find(target)};
+    return it == _graph->cend() ? _graph->infinity : get_distance(it);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+Cost graph<Key, T, Cost, Nat, Index>::shortest_paths::get_distance(graph::const_iterator target) const {
+    const mapped_type* e{find_entry(target)};
+    return e == nullptr ? _graph->infinity : e->second;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::shortest_paths::get_path(graph::key_type target) const {
+    const graph::const_iterator it{_graph->find(target)};
+    return it == _graph->cend() ? graph::search_path() : get_path(it);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::search_path graph<Key, T, Cost, Nat, Index>::shortest_paths::get_path(graph::const_iterator target) const {
+    graph::search_path result;
+    if (target == _graph->cend() || get_distance(target) == _graph->infinity) {
+        return result;
+    }
+
+    for (graph::const_iterator current{target}; current != _start;) {
+        const mapped_type &e{entry(current->second.get())};
+        result.emplace_front(current, e.second - entry(e.first->second.get()).second);
+        current = e.first;
+    }
+
+    if (target != _start) {
+        result.emplace_front(_start, cost_type());
+    }
+
+    return result;
+}
+
+///template <class Key, class T, class Cost, Nature Nat, class Index>
+///std::ostream &graph<Key, T, Cost, Nat, Index>::operator<<(std::ostream &os, const typename graph::search_path &sp) {
+///    Cost count{};
+///    for (const std::pair<typename graph<Key, T, Cost, Nat, Index>::const_iterator, Cost> &p : sp) {
+///       count += p.second;
+///        os << "-> " << p.first->first << " (" << count << ") ";
+///    }
+///    return os;
+///}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+Cost graph<Key, T, Cost, Nat, Index>::null_heuristic::operator()(const const_iterator &) const {
+    return cost_type();
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+bool graph<Key, T, Cost, Nat, Index>::iterator_comparator::operator()(const const_iterator &lhs, const const_iterator &rhs) const {
+    return lhs->first < rhs->first;
+}
+
+/////////////////////////////////
+///// distance_matrix class /////
+/////////////////////////////////
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+graph<Key, T, Cost, Nat, Index>::distance_matrix::distance_matrix(const graph &g, bool keep_paths, std::vector<size_type> &positions) {
+    const size_type n{g.size()};
+
+    positions.assign(g._indices_bound, n);
+    _keys.reserve(n);
+    for (const_iterator it{g.cbegin()}; it != g.cend(); ++it) {
+        positions[index_of(it->second.get())] = _keys.size();
+        _keys.push_back(it->first);
+    }
+
+    _distances.assign(n * n, g.infinity);
+    if (keep_paths) {
+        _next.assign(n * n, n);
+    }
+
+    _sorted = detail::sorted_permutation(_keys);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+bool graph<Key, T, Cost, Nat, Index>::distance_matrix::empty() const noexcept {
+    return _keys.empty();
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::distance_matrix::size() const noexcept {
+    return _keys.size();
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+bool graph<Key, T, Cost, Nat, Index>::distance_matrix::has_paths() const noexcept {
+    return !_next.empty() || _keys.empty();
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::distance_matrix::find(const key_type &k) const {
+    return detail::find_index(_keys, _sorted, k);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+const Key &graph<Key, T, Cost, Nat, Index>::distance_matrix::get_key(size_type i) const {
+    return _keys[i];
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+Cost graph<Key, T, Cost, Nat, Index>::distance_matrix::get_distance(size_type from, size_type to) const {
+    if (from >= size() || to >= size()) {
+        return std::numeric_limits<cost_type>::has_infinity ? std::numeric_limits<cost_type>::infinity() : std::numeric_limits<cost_type>::max();
+    }
+    return _distances[from * size() + to];
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::distance_matrix::get_next(size_type from, size_type to) const {
+    if (!has_paths()) {
+        GRAPH_THROW_WITH(invalid_argument, "Paths not kept by all_pairs_shortest_paths")
+    }
+    if (from >= size() || to >= size()) {
+        return size();
+    }
+    return _next[from * size() + to];
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::vector<std::size_t> graph<Key, T, Cost, Nat, Index>::distance_matrix::get_path(size_type from, size_type to) const {
+    std::vector<size_type> path;
+    size_type current{from};
+    if (get_next(from, to) == size()) {
+        return path;
+    }
+
+    path.push_back(current);
+    while (current != to) {
+        current = _next[current * size() + to];
+        path.push_back(current);
+    }
+    return path;
+}
+
+///////////////////////////////////////////
+///// IMPLEMENTATION OF FROZEN GRAPHS /////
+///////////////////////////////////////////
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::frozen_graph graph<Key, T, Cost, Nat, Index>::freeze() const {
+    frozen_graph result;
+
+    //! Dense indices, in the order of the keys
+    std::vector<size_type> indices(_indices_bound, size());
+    result._keys.reserve(size());
+    result._values.reserve(size());
+    for (const_iterator it{cbegin()}; it != cend(); ++it) {
+        indices[index_of(it->second.get())] = result._keys.size();
+        result._keys.push_back(it->first);
+        result._values.push_back(it->second->get());
+    }
+
+    //! Compressed-sparse-row adjacency, each row sorted by target
+    result._offsets.reserve(size() + 1);
+    result._offsets.push_back(0);
+    std::vector<std::pair<size_type, cost_type>> row;
+    for (const_iterator it{cbegin()}; it != cend(); ++it) {
+        row.clear();
+        for (const typename node::edge &e : it->second->_out_edges) {
+            row.emplace_back(indices[index_of(e._target)], e.cost());
+        }
+        std::sort(row.begin(), row.end(), [](const std::pair<size_type, cost_type> &lhs, const std::pair<size_type, cost_type> &rhs) {
+            return lhs.first < rhs.first;
+        });
+
+        for (const std::pair<size_type, cost_type> &p : row) {
+            result._targets.push_back(p.first);
+            result._costs.push_back(p.second);
+        }
+        result._offsets.push_back(result._targets.size());
+    }
+    result._num_edges = _num_edges;
+
+    result._sorted = detail::sorted_permutation(result._keys);
+
+    return result;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::publish() {
+    std::shared_ptr<frozen_graph> result{std::make_shared<frozen_graph>(freeze())};
+    result->_version = ++_version;
+    _published.store(std::move(result));
+    return _version;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::snapshot_type graph<Key, T, Cost, Nat, Index>::snapshot() const {
+    snapshot_type result{_published.load()};
+    return result ? result : std::make_shared<const frozen_graph>();
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::get_version() const noexcept {
+    return _version;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+bool graph<Key, T, Cost, Nat, Index>::frozen_graph::empty() const noexcept {
+    return _keys.empty();
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::frozen_graph::size() const noexcept {
+    return _keys.size();
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::frozen_graph::get_nbr_nodes() const noexcept {
+    return _keys.size();
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::frozen_graph::get_nbr_edges() const noexcept {
+    return _num_edges;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+Nature graph<Key, T, Cost, Nat, Index>::frozen_graph::get_nature() const noexcept {
+    return Nat;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::frozen_graph::get_version() const noexcept {
+    return _version;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::frozen_graph::find(const key_type &k) const {
+    return detail::find_index(_keys, _sorted, k);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+const Key &graph<Key, T, Cost, Nat, Index>::frozen_graph::get_key(size_type i) const {
+    return _keys[i];
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+const T &graph<Key, T, Cost, Nat, Index>::frozen_graph::get(size_type i) const {
+    return _values[i];
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::frozen_graph::degree(size_type i) const {
+    return _offsets[i + 1] - _offsets[i];
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::frozen_graph::edges_begin(size_type i) const {
+    return _offsets[i];
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::frozen_graph::edges_end(size_type i) const {
+    return _offsets[i + 1];
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::frozen_graph::target(size_type e) const {
+    return _targets[e];
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+const Cost &graph<Key, T, Cost, Nat, Index>::frozen_graph::cost(size_type e) const {
+    return _costs[e];
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+bool graph<Key, T, Cost, Nat, Index>::frozen_graph::existing_edge(size_type from, size_type to) const {
+    if (from >= size() || to >= size()) {
+        return false;
+    }
+    return std::binary_search(_targets.cbegin() + _offsets[from], _targets.cbegin() + _offsets[from + 1], to);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+Cost graph<Key, T, Cost, Nat, Index>::frozen_graph::get_cost(size_type from, size_type to) const {
+    const cost_type infinity{std::numeric_limits<cost_type>::has_infinity ? std::numeric_limits<cost_type>::infinity() : std::numeric_limits<cost_type>::max()};
+    if (from >= size() || to >= size()) {
+        return infinity;
+    }
+
+    typename std::vector<size_type>::const_iterator first{_targets.cbegin() + _offsets[from]};
+    typename std::vector<size_type>::const_iterator last {_targets.cbegin() + _offsets[from + 1]};
+    typename std::vector<size_type>::const_iterator it{std::lower_bound(first, last, to)};
+    if (it == last || *it != to) {
+        return infinity;
+    }
+    return _costs[static_cast<size_type>(it - _targets.cbegin())];
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::frozen_graph::search_path graph<Key, T, Cost, Nat, Index>::frozen_graph::bfs(size_type start, size_type target) const {
+    if (start >= size()) {
+        GRAPH_THROW_WITH(invalid_argument, "Start point out of the frozen graph")
+    }
+
+    std::vector<size_type> previous(size(), size());
+    std::vector<size_type> queue;
+    queue.reserve(size());
+    queue.push_back(start);
+    previous[start] = start;
+
+    for (size_type head{0}; head < queue.size() && previous[target < size() ? target : start] == size(); ++head) {
+        const size_type u{queue[head]};
+        for (size_type e{_offsets[u]}; e != _offsets[u + 1]; ++e) {
+            const size_type v{_targets[e]};
+            if (previous[v] == size()) {
+                previous[v] = u;
+                queue.push_back(v);
+            }
+        }
+    }
+
+    search_path result;
+    if (target >= size() || previous[target] == size()) {
+        return result;
+    }
+
+    std::vector<size_type> nodes;
+    for (size_type current{target}; current != start; current = previous[current]) {
+        nodes.push_back(current);
+    }
+    result.emplace_back(start, cost_type());
+    for (typename std::vector<size_type>::const_reverse_iterator it{nodes.crbegin()}; it != nodes.crend(); ++it) {
+        result.emplace_back(*it, get_cost(previous[*it], *it));
+    }
+    return result;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::frozen_graph::search_path graph<Key, T, Cost, Nat, Index>::frozen_graph::astar(size_type start, size_type target, std::function<cost_type(size_type)> heuristic) const {
+    if (start >= size()) {
+        GRAPH_THROW_WITH(invalid_argument, "Start point out of the frozen graph")
+    }
+
+    const cost_type nul_cost{cost_type()};
+    const cost_type infinity{std::numeric_limits<cost_type>::has_infinity ? std::numeric_limits<cost_type>::infinity() : std::numeric_limits<cost_type>::max()};
+
+    std::vector<cost_type> distances(size(), infinity);
+    std::vector<size_type> previous (size(), size());
+    std::vector<bool>      expanded (size(), false);
+    //! The heuristic is evaluated once per node, when discovered, and the frontier lowers the priorities in place
+    std::vector<cost_type> heuristics(size(), nul_cost);
+    detail::indexed_heap<cost_type> frontier(size());
+
+    distances[start] = nul_cost;
+    heuristics[start] = heuristic(start);
+    frontier.push(start, heuristics[start]);
+
+    while (!frontier.empty()) {
+        const size_type u{frontier.pop()};
+        expanded[u] = true;
+
+        if (u == target) {
+            std::vector<size_type> nodes;
+            for (size_type current{target}; current != start; current = previous[current]) {
+                nodes.push_back(current);
+            }
+
+            search_path result;
+            result.emplace_back(start, nul_cost);
+            for (typename std::vector<size_type>::const_reverse_iterator it{nodes.crbegin()}; it != nodes.crend(); ++it) {
+                result.emplace_back(*it, distances[*it] - distances[previous[*it]]);
+            }
+            return result;
+        }
+
+        for (size_type e{_offsets[u]}; e != _offsets[u + 1]; ++e) {
+            //! A* cannot be computed with negative weights.
+            if (_costs[e] < nul_cost) {
+                GRAPH_THROW(negative_edge)
+            }
+
+            const size_type v{_targets[e]};
+            const cost_type alt{distances[u] + _costs[e]};
+            if (!expanded[v] && alt < distances[v]) {
+                if (distances[v] == infinity) {
+                    heuristics[v] = heuristic(v);
+                }
+                distances[v] = alt;
+                previous[v] = u;
+                frontier.push(v, alt + heuristics[v]);
+            }
+        }
+    }
+
+    /// Could not find a solution
+    return search_path();
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::frozen_graph::shortest_paths graph<Key, T, Cost, Nat, Index>::frozen_graph::dijkstra(size_type start) const {
+    if (start >= size()) {
+        GRAPH_THROW_WITH(invalid_argument, "Start point out of the frozen graph")
+    }
+
+    using Entry = std::pair<cost_type, size_type>;
+
+    const cost_type nul_cost{cost_type()};
+
+    shortest_paths result(start, size());
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> Q;
+
+    result._distances[start] = nul_cost;
+    result._previous[start] = start;
+    Q.emplace(nul_cost, start);
+
+    while (!Q.empty()) {
+        const cost_type dist_u{Q.top().first};
+        const size_type u{Q.top().second};
+        Q.pop();
+
+        /// outdated entry: u was already reached with a shorter distance
+        if (result._distances[u] < dist_u) {
+            continue;
+        }
+
+        for (size_type e{_offsets[u]}; e != _offsets[u + 1]; ++e) {
+            //! Dijkstra's algorithm cannot be computed with negative weights.
+            if (_costs[e] < nul_cost) {
+                GRAPH_THROW(negative_edge)
+            }
+
+            const size_type v{_targets[e]};
+            const cost_type alt{dist_u + _costs[e]};
+            if (alt < result._distances[v]) {
+                result._distances[v] = alt;
+                result._previous[v] = u;
+                Q.emplace(alt, v);
+            }
+        }
+    }
+
+    return result;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::cost_type graph<Key, T, Cost, Nat, Index>::frozen_graph::search_path::total_cost() const {
+    cost_type total{};
+    for (const_iterator it{cbegin()}; it != cend(); ++it) {
+        total += it->second;
+    }
+    return total;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+bool graph<Key, T, Cost, Nat, Index>::frozen_graph::search_path::contain(size_type i) const {
+    for (const_iterator it{cbegin()}; it != cend(); ++it) {
+        if (it->first == i) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+graph<Key, T, Cost, Nat, Index>::frozen_graph::shortest_paths::shortest_paths(size_type start, size_type nbr_nodes)
+    : _start(start),
+      _distances(nbr_nodes, std::numeric_limits<cost_type>::has_infinity ? std::numeric_limits<cost_type>::infinity() : std::numeric_limits<cost_type>::max()),
+      _previous(nbr_nodes, nbr_nodes) {}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::frozen_graph::shortest_paths::get_previous(size_type current) const {
+    return _previous[current];
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+Cost graph<Key, T, Cost, Nat, Index>::frozen_graph::shortest_paths::get_distance(size_type current) const {
+    return _distances[current];
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::frozen_graph::search_path graph<Key, T, Cost, Nat, Index>::frozen_graph::shortest_paths::get_path(size_type target) const {
+    search_path result;
+    if (target >= size() || _previous[target] == size()) {
+        return result;
+    }
+
+    std::vector<size_type> nodes;
+    for (size_type current{target}; current != _start; current = _previous[current]) {
+        nodes.push_back(current);
+    }
+    result.emplace_back(_start, cost_type());
+    for (typename std::vector<size_type>::const_reverse_iterator it{nodes.crbegin()}; it != nodes.crend(); ++it) {
+        result.emplace_back(*it, _distances[*it] - _distances[_previous[*it]]);
+    }
+    return result;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::frozen_graph::shortest_paths::size() const noexcept {
+    return _previous.size();
+}
+
+/////////////////////////////////////////////
+///// IMPLEMENTATION OF ADJACENCY MATRIX /////
+/////////////////////////////////////////////
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+typename graph<Key, T, Cost, Nat, Index>::adjacency_matrix graph<Key, T, Cost, Nat, Index>::to_matrix() const {
+    adjacency_matrix result;
+
+    std::vector<size_type> indices(_indices_bound, size());
+    result._keys.reserve(size());
+    result._values.reserve(size());
+    for (const_iterator it{cbegin()}; it != cend(); ++it) {
+        indices[index_of(it->second.get())] = result._keys.size();
+        result._keys.push_back(it->first);
+        result._values.push_back(it->second->get());
+    }
+
+    result._costs.assign(size() * size(), infinity);
+    result._existing.assign(size() * size(), false);
+    for (const_iterator it{cbegin()}; it != cend(); ++it) {
+        const size_type from{indices[index_of(it->second.get())]};
+        for (const typename node::edge &e : it->second->_out_edges) {
+            const size_type position{from * size() + indices[index_of(e._target)]};
+            result._costs[position]    = e.cost();
+            result._existing[position] = true;
+        }
+    }
+    result._num_edges = _num_edges;
+
+    result._sorted = detail::sorted_permutation(result._keys);
+
+    return result;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+bool graph<Key, T, Cost, Nat, Index>::adjacency_matrix::empty() const noexcept {
+    return _keys.empty();
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::adjacency_matrix::size() const noexcept {
+    return _keys.size();
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::adjacency_matrix::get_nbr_nodes() const noexcept {
+    return _keys.size();
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::adjacency_matrix::get_nbr_edges() const noexcept {
+    return _num_edges;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+Nature graph<Key, T, Cost, Nat, Index>::adjacency_matrix::get_nature() const noexcept {
+    return Nat;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::adjacency_matrix::find(const key_type &k) const {
+    return detail::find_index(_keys, _sorted, k);
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+const Key &graph<Key, T, Cost, Nat, Index>::adjacency_matrix::get_key(size_type i) const {
+    return _keys[i];
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+const T &graph<Key, T, Cost, Nat, Index>::adjacency_matrix::get(size_type i) const {
+    return _values[i];
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+bool graph<Key, T, Cost, Nat, Index>::adjacency_matrix::existing_edge(size_type from, size_type to) const {
+    if (from >= size() || to >= size()) {
+        return false;
+    }
+    return _existing[from * size() + to];
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+Cost graph<Key, T, Cost, Nat, Index>::adjacency_matrix::get_cost(size_type from, size_type to) const {
+    if (!existing_edge(from, to)) {
+        return std::numeric_limits<cost_type>::has_infinity ? std::numeric_limits<cost_type>::infinity() : std::numeric_limits<cost_type>::max();
+    }
+    return _costs[from * size() + to];
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::adjacency_matrix::mirror_edge(size_type, size_type, std::true_type) {}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::adjacency_matrix::mirror_edge(size_type from, size_type to, std::false_type) {
+    _costs   [to * size() + from] = _costs   [from * size() + to];
+    _existing[to * size() + from] = _existing[from * size() + to];
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+bool graph<Key, T, Cost, Nat, Index>::adjacency_matrix::add_edge(size_type from, size_type to, cost_type cost) {
+    if (from >= size() || to >= size()) {
+        GRAPH_THROW_WITH(invalid_argument, "Node out of the adjacency matrix")
+    }
+
+    const bool result{!_existing[from * size() + to]};
+    _costs   [from * size() + to] = cost;
+    _existing[from * size() + to] = true;
+    mirror_edge(from, to, directed_tag());
+
+    if (result) {
+        ++_num_edges;
+    }
+    return result;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+std::size_t graph<Key, T, Cost, Nat, Index>::adjacency_matrix::del_edge(size_type from, size_type to) {
+    if (!existing_edge(from, to)) {
+        return 0;
+    }
+
+    _existing[from * size() + to] = false;
+    mirror_edge(from, to, directed_tag());
+    --_num_edges;
+    return 1;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::adjacency_matrix::clear_edges() {
+    std::fill(_existing.begin(), _existing.end(), false);
+    _num_edges = 0;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+void graph<Key, T, Cost, Nat, Index>::adjacency_matrix::make_complete(cost_type cost) {
+    std::fill(_costs.begin(), _costs.end(), cost);
+    std::fill(_existing.begin(), _existing.end(), true);
+    for (size_type i{0}; i < size(); ++i) {
+        _existing[i * size() + i] = false;
+    }
+    _num_edges = directed_tag::value ? size() * (size() - 1) : size() * (size() - 1) / 2;
+}
+
+template <class Key, class T, class Cost, Nature Nat, class Index>
+graph<Key, T, Cost, Nat, Index> graph<Key, T, Cost, Nat, Index>::adjacency_matrix::to_graph() const {
+    graph result;
+
+    std::vector<node*> nodes;
+    nodes.reserve(size());
+    for (size_type i{0}; i < size(); ++i) {
+        iterator it{result.emplace(_keys[i], _values[i]).first};
+        nodes.push_back(it->second.get());
+    }
+
+    //! Row by row, each row reserved once: the edges are known to be distinct
+    for (size_type from{0}; from < size(); ++from) {
+        size_type degree{0};
+        for (size_type to{0}; to < size(); ++to) {
+            degree += _existing[from * size() + to] ? 1 : 0;
+        }
+        nodes[from]->reserve_edges(degree, directed_tag::value ? 0 : degree);
+    }
+    for (size_type from{0}; from < size(); ++from) {
+        for (size_type to{directed_tag::value ? 0 : from}; to < size(); ++to) {
+            if (_existing[from * size() + to]) {
+                typename node::EdgesIterator e{nodes[from]->push_edge(nodes[to], _costs[from * size() + to])};
+                result.push_opposite_edge(nodes[from], nodes[to], *e, directed_tag());
+            }
+        }
+    }
+    result._num_edges = _num_edges;
+
+    return result;
+}
+
+/////////////////////////////////////////////
+///// IMPLEMENTATION OF IMPLICIT GRAPHS /////
+/////////////////////////////////////////////
+
+template <class Key, class Cost, class Index>
+implicit_graph<Key, Cost, Index>::implicit_graph(neighbours_function neighbours, size_type max_expansions)
+    : _neighbours(std::move(neighbours)), _max_expansions(max_expansions) {
+    if (!_neighbours) {
+        GRAPH_THROW_WITH(invalid_argument, "Empty neighbour function")
+    }
+}
+
+template <class Key, class Cost, class Index>
+std::size_t implicit_graph<Key, Cost, Index>::get_max_expansions() const noexcept {
+    return _max_expansions;
+}
+
+template <class Key, class Cost, class Index>
+void implicit_graph<Key, Cost, Index>::set_max_expansions(size_type max_expansions) noexcept {
+    _max_expansions = max_expansions;
+}
+
+template <class Key, class Cost, class Index>
+typename implicit_graph<Key, Cost, Index>::neighbours_type implicit_graph<Key, Cost, Index>::get_neighbours(const key_type &key) const {
+    neighbours_type result;
+    _neighbours(key, result);
+    return result;
+}
+
+template <class Key, class Cost, class Index>
+typename implicit_graph<Key, Cost, Index>::search_path implicit_graph<Key, Cost, Index>::bfs(const key_type &start, const key_type &target) const {
+    return first_search(start, [&target](const key_type &k) {
+        return k == target;
+    });
+}
+
+template <class Key, class Cost, class Index>
+typename implicit_graph<Key, Cost, Index>::search_path implicit_graph<Key, Cost, Index>::bfs(const key_type &start, std::function<bool(key_type)> is_goal) const {
+    return first_search(start, is_goal);
+}
+
+template <class Key, class Cost, class Index>
+typename implicit_graph<Key, Cost, Index>::search_path implicit_graph<Key, Cost, Index>::ucs(const key_type &start, const key_type &target) const {
+    return ucs(start, [&target](const key_type &k) {
+        return k == target;
+    });
+}
+
+template <class Key, class Cost, class Index>
+typename implicit_graph<Key, Cost, Index>::search_path implicit_graph<Key, Cost, Index>::ucs(const key_type &start, std::function<bool(key_type)> is_goal) const {
+    size_type goal;
+    const explored e{best_first_search(start, is_goal, std::function<cost_type(key_type)>(), goal)};
+    return e.get_path(goal);
+}
+
+template <class Key, class Cost, class Index>
+typename implicit_graph<Key, Cost, Index>::search_path implicit_graph<Key, Cost, Index>::astar(const key_type &start, const key_type &target, std::function<cost_type(key_type)> heuristic) const {
+    return astar(start, [&target](const key_type &k) {
+        return k == target;
+    }, heuristic);
+}
+
+template <class Key, class Cost, class Index>
+typename implicit_graph<Key, Cost, Index>::search_path implicit_graph<Key, Cost, Index>::astar(const key_type &start, std::function<bool(key_type)> is_goal, std::function<cost_type(key_type)> heuristic) const {
+    size_type goal;
+    const explored e{best_first_search(start, is_goal, heuristic, goal)};
+    return e.get_path(goal);
+}
+
+template <class Key, class Cost, class Index>
+typename implicit_graph<Key, Cost, Index>::shortest_paths implicit_graph<Key, Cost, Index>::dijkstra(const key_type &start) const {
+    return dijkstra(start, [](const key_type &) {
+        return false;
+    });
+}
+
+template <class Key, class Cost, class Index>
+typename implicit_graph<Key, Cost, Index>::shortest_paths implicit_graph<Key, Cost, Index>::dijkstra(const key_type &start, std::function<bool(key_type)> is_goal) const {
+    size_type goal;
+    return shortest_paths(best_first_search(start, is_goal, std::function<cost_type(key_type)>(), goal));
+}
+
+template <class Key, class Cost, class Index>
+typename implicit_graph<Key, Cost, Index>::search_path implicit_graph<Key, Cost, Index>::first_search(const key_type &start, std::function<bool(key_type)> is_goal) const {
+    explored e;
+    e.discover(start, cost_type(), 0);
+
+    neighbours_type neighbours;
+    //! The indices are given in the order of discovery: the queue of a BFS is the range [head, keys.size())
+    for (size_type head{0}; head < e.keys.size() && head < _max_expansions; ++head) {
+        if (is_goal(e.keys[head])) {
+            return e.get_path(head);
+        }
+
+        neighbours.clear();
+        _neighbours(e.keys[head], neighbours);
+        for (const std::pair<key_type, cost_type> &n : neighbours) {
+            e.discover(n.first, e.distances[head] + n.second, head);
+        }
+    }
+
+    /// Could not find a solution
+    return search_path();
+}
+
+template <class Key, class Cost, class Index>
+typename implicit_graph<Key, Cost, Index>::explored implicit_graph<Key, Cost, Index>::best_first_search(const key_type &start, std::function<bool(key_type)> is_goal,
+                                                                                                       std::function<cost_type(key_type)> heuristic, size_type &goal) const {
+    const cost_type nul_cost{cost_type()};
+
+    explored e;
+    //! Heuristic of every discovered node, evaluated once; the frontier lowers the priorities in place
+    std::vector<cost_type> heuristics;
+    detail::indexed_heap<cost_type> frontier;
+
+    e.discover(start, nul_cost, 0);
+    heuristics.push_back(heuristic ? heuristic(start) : nul_cost);
+    frontier.push(0, heuristics[0]);
+
+    neighbours_type neighbours;
+    for (size_type nbr_expansions{0}; !frontier.empty() && nbr_expansions < _max_expansions; ++nbr_expansions) {
+        const size_type u{frontier.pop()};
+        e.expanded[u] = true;
+
+        if (is_goal(e.keys[u])) {
+            goal = u;
+            return e;
+        }
+
+        neighbours.clear();
+        _neighbours(e.keys[u], neighbours);
+        for (const std::pair<key_type, cost_type> &n : neighbours) {
+            //! Best-first searches cannot be computed with negative weights.
+            if (n.second < nul_cost) {
+                GRAPH_THROW(negative_edge)
+            }
+
+            const cost_type alt{e.distances[u] + n.second};
+            const std::pair<size_type, bool> v{e.discover(n.first, alt, u)};
+            if (v.second) {
+                heuristics.push_back(heuristic ? heuristic(n.first) : nul_cost);
+            } else if (e.expanded[v.first] || !(alt < e.distances[v.first])) {
+                continue;
+            }
+            e.distances[v.first] = alt;
+            e.previous [v.first] = u;
+            frontier.push(v.first, alt + heuristics[v.first]);
+        }
+    }
+
+    goal = e.keys.size();
+    return e;
+}
+
+template <class Key, class Cost, class Index>
+std::pair<std::size_t, bool> implicit_graph<Key, Cost, Index>::explored::discover(const key_type &key, cost_type distance, size_type from) {
+    const std::pair<typename Index::template map<key_type, size_type>::iterator, bool> it{ids.emplace(key, keys.size())};
+    if (it.second) {
+        keys.push_back(key);
+        distances.push_back(distance);
+        previous.push_back(from);
+        expanded.push_back(false);
+    }
+    return std::make_pair(it.first->second, it.second);
+}
+
+template <class Key, class Cost, class Index>
+std::size_t implicit_graph<Key, Cost, Index>::explored::find(const key_type &key) const {
+    const typename Index::template map<key_type, size_type>::const_iterator it{ids.find(key)};
+    return it == ids.cend() ? keys.size() : it->second;
+}
+
+template <class Key, class Cost, class Index>
+typename implicit_graph<Key, Cost, Index>::search_path implicit_graph<Key, Cost, Index>::explored::get_path(size_type target) const {
+    search_path result;
+    if (target >= keys.size()) {
+        return result;
+    }
+
+    std::vector<size_type> nodes;
+    for (size_type current{target}; current != 0; current = previous[current]) {
+        nodes.push_back(current);
+    }
+    result.emplace_back(keys.front(), cost_type());
+    for (typename std::vector<size_type>::const_reverse_iterator it{nodes.crbegin()}; it != nodes.crend(); ++it) {
+        result.emplace_back(keys[*it], distances[*it] - distances[previous[*it]]);
+    }
+    return result;
+}
+
+template <class Key, class Cost, class Index>
+Cost implicit_graph<Key, Cost, Index>::search_path::total_cost() const {
+    cost_type total{};
+    for (const_iterator it{cbegin()}; it != cend(); ++it) {
+        total += it->second;
+    }
+    return total;
+}
+
+template <class Key, class Cost, class Index>
+bool implicit_graph<Key, Cost, Index>::search_path::contain(const key_type &key) const {
+    for (const_iterator it{cbegin()}; it != cend(); ++it) {
+        if (it->first == key) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <class Key, class Cost, class Index>
+implicit_graph<Key, Cost, Index>::shortest_paths::shortest_paths(explored &&e) : _explored(std::move(e)) {}
+
+template <class Key, class Cost, class Index>
+bool implicit_graph<Key, Cost, Index>::shortest_paths::contain(const key_type &key) const {
+    const size_type i{_explored.find(key)};
+    return i < _explored.keys.size() && _explored.expanded[i];
+}
+
+template <class Key, class Cost, class Index>
+Cost implicit_graph<Key, Cost, Index>::shortest_paths::get_distance(const key_type &key) const {
+    const size_type i{_explored.find(key)};
+    if (i < _explored.keys.size() && _explored.expanded[i]) {
+        return _explored.distances[i];
+    }
+    return std::numeric_limits<cost_type>::has_infinity ? std::numeric_limits<cost_type>::infinity() : std::numeric_limits<cost_type>::max();
+}
+
+template <class Key, class Cost, class Index>
+typename implicit_graph<Key, Cost, Index>::search_path implicit_graph<Key, Cost, Index>::shortest_paths::get_path(const key_type &target) const {
+    const size_type i{_explored.find(target)};
+    return _explored.get_path(i < _explored.keys.size() && _explored.expanded[i] ? i : _explored.keys.size());
+}
+
+template <class Key, class Cost, class Index>
+std::size_t implicit_graph<Key, Cost, Index>::shortest_paths::size() const noexcept {
+    return _explored.keys.size();
 }
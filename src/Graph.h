@@ -5,11 +5,16 @@
 #ifndef ROOT_GRAPH_H
 #define ROOT_GRAPH_H
 
-#include <fstream>   /// setw, operator<<
-#include <iomanip>   /// setw
-#include <map>       /// map
-#include <queue>     /// queue
-#include <vector>    /// vector
+#include <algorithm>     /// binary_search, lower_bound, sort
+#include <deque>         /// deque
+#include <fstream>       /// setw, operator<<
+#include <iomanip>       /// setw
+#include <list>          /// list
+#include <map>           /// map
+#include <queue>         /// queue
+#include <unordered_map> /// unordered_map
+#include <unordered_set> /// unordered_set
+#include <vector>        /// vector
 
 #ifdef INCLUDE_JSON_FILE
     #include "../third-party/json/single_include/nlohmann/json.hpp"
@@ -66,6 +71,27 @@ concept GraphCost = std::copyable<T> && std::equality_comparable<T> && std::tota
     t * t;
     t / t;
 };
+
+/// @brief Concept for the goal predicates given to the search algorithms
+/// Requires that the callable can be called on a node of type Arg and returns a boolean
+template<typename F, typename Arg>
+concept SearchGoal = std::predicate<F&, Arg>;
+
+/// @brief Concept for the heuristics given to the informed search algorithms
+/// Requires that the callable can be called on a node of type Arg and returns an estimate convertible to Cost
+template<typename F, typename Arg, typename Cost>
+concept SearchHeuristic = std::invocable<F&, Arg> && std::convertible_to<std::invoke_result_t<F&, Arg>, Cost>;
+#endif
+
+/// Constraints of the search algorithms templated on their callables, used in a trailing return type: `-> GRAPH_REQUIRES(R, condition)`
+#if defined(GRAPH_HAS_CPP_20)
+    #define GRAPH_SEARCH_GOAL(F, Arg)            SearchGoal<F, Arg>
+    #define GRAPH_SEARCH_HEURISTIC(F, Arg, Cost) SearchHeuristic<F, Arg, Cost>
+    #define GRAPH_REQUIRES(R, ...)               R requires (__VA_ARGS__)
+#else
+    #define GRAPH_SEARCH_GOAL(F, Arg)            detail::is_callable_as<F, Arg, bool>::value
+    #define GRAPH_SEARCH_HEURISTIC(F, Arg, Cost) detail::is_callable_as<F, Arg, Cost>::value
+    #define GRAPH_REQUIRES(R, ...)               typename std::enable_if<(__VA_ARGS__), R>::type
 #endif
 
 /// exclude unsupported compilers
@@ -81,6 +107,44 @@ concept GraphCost = std::copyable<T> && std::equality_comparable<T> && std::tota
 
 #include "Node.h"
 
+/////////////////////////
+///// INDEX POLICIES ////
+/////////////////////////
+
+/**
+ * @brief Index policy storing the nodes in a `std::map`
+ *
+ * Lookups are O(log V) key comparisons and the nodes are iterated in the
+ * order of their keys. This is the default policy of @ref graph.
+ *
+ * @since version 1.2
+ */
+struct ordered_index {
+#if defined(GRAPH_HAS_CPP_14)
+    //! Transparent comparator: keys can be looked up from any type comparable with them
+    template <class Key, class Value>
+    using map = std::map<Key, Value, std::less<>, detail::allocator<std::pair<const Key, Value>>>;
+#else
+    template <class Key, class Value>
+    using map = std::map<Key, Value, std::less<Key>, detail::allocator<std::pair<const Key, Value>>>;
+#endif
+};
+
+/**
+ * @brief Index policy storing the nodes in an open-addressing hash map
+ *
+ * Lookups hash the key once and compare it with `==` on a hit only. The
+ * nodes are iterated in insertion order. `std::hash<Key>` must be defined,
+ * and keys must still be ordered for the dense representations, which sort them.
+ * Under C++17, `std::string` keys are also looked up from a `std::string_view`.
+ *
+ * @since version 1.2
+ */
+struct unordered_index {
+    template <class Key, class Value>
+    using map = detail::hash_map<Key, Value, detail::key_hash<Key>>;
+};
+
 ///////////////////////////
 ///// ADJACENCY GRAPH /////
 ///////////////////////////
@@ -101,27 +165,46 @@ concept GraphCost = std::copyable<T> && std::equality_comparable<T> && std::tota
  *           Aliased as member type Graph::graphed_type
  * @tparam Cost Type of the cost between nodes. Default is std::size_t
  * @tparam Nat Nature of the graph (DIRECTED or UNDIRECTED). Default is UNDIRECTED
+ * @tparam Index Container policy of the nodes: @ref ordered_index (default)
+ *               or @ref unordered_index for hashed lookups of the keys
  *
  * @since version 1.0.0
  */
-template <class Key, class T, class Cost = std::size_t, Nature Nat = UNDIRECTED>
+template <class Key, class T, class Cost = std::size_t, Nature Nat = UNDIRECTED, class Index = ordered_index>
 class graph {
   public:
     class node;
     using Degree = detail::basic_degree<Nat>;
     class search_path;
     class shortest_paths;
+    class frozen_graph;
+    class adjacency_matrix;
+    class distance_matrix;
 
   private:
     using PtrNode  = std::shared_ptr<node>;
-    using MapNodes = std::map<Key, PtrNode>;
+    using MapNodes = typename Index::template map<Key, PtrNode>;
 
     MapNodes _nodes;
     std::size_t _num_edges = 0;
 
+    //! Cost slots shared by both directions of UNDIRECTED edges; addresses are stable
+    std::deque<Cost, detail::allocator<Cost>>    _shared_costs;
+    std::vector<Cost*, detail::allocator<Cost*>> _free_costs;
+
+    //! Dense indices of the nodes, all below `_indices_bound`; the ones of erased nodes are reused first
+    std::size_t                                              _indices_bound = 0;
+    std::vector<std::size_t, detail::allocator<std::size_t>> _free_indices;
+
+    //! Snapshot handed to the readers, and number of publications
+    detail::shared_slot<frozen_graph> _published;
+    std::size_t                       _version = 0;
+
+    PtrNode new_node(const T &x) const;
+    PtrNode new_node(T &&x) const;
+
     const Cost infinity = std::numeric_limits<cost_type>::has_infinity ? std::numeric_limits<Cost>::infinity() :
                           std::numeric_limits<Cost>::max();
-    class path_comparator;
     struct iterator_comparator;
 
   public:
@@ -165,6 +248,8 @@ class graph {
     using cost_type    = Cost;
     /// A type to represent container sizes
     using size_type    = std::size_t;
+    /// The allocator of the nodes, the edges and the shared costs
+    using allocator_type = detail::allocator<value_type>;
 
     /// An iterator for a graph container
     using iterator               = typename MapNodes::iterator;
@@ -268,6 +353,22 @@ class graph {
      */
     explicit graph();
 
+    /**
+     * @brief Construct an empty graph allocating all its memory with @p alloc
+     *
+     * Since C++17 the allocator is a `std::pmr::polymorphic_allocator`: passing a
+     * `std::pmr::memory_resource*`, such as a `std::pmr::monotonic_buffer_resource`,
+     * builds the nodes, their out-edges and the shared costs on it. Releasing the
+     * elements into a monotonic arena costs nothing, so `clear()` and the destructor
+     * only run the destructors of the keys and values.
+     * A copy of the graph uses the default resource.
+     *
+     * @param alloc Allocator of the graph
+     *
+     * @since version 1.2
+     */
+    explicit graph(const allocator_type& alloc);
+
     /**
      * @brief Construct a graph from an input stream
      *
@@ -311,11 +412,12 @@ class graph {
      *
      * Assigns the contents of one graph to another by moving.
      * The moved-from graph is left in a valid but unspecified state.
+     * When the two allocators differ, the elements are copied into the resource of this graph, which may throw.
      *
      * @param other Graph to move from
      * @return Reference to this graph
      */
-    graph &operator=(graph&& other) noexcept;
+    graph &operator=(graph&& other) noexcept(std::allocator_traits<allocator_type>::is_always_equal::value);
 
     /**
      * @brief Virtual destructor
@@ -352,6 +454,53 @@ class graph {
      */
     [[nodiscard]] size_type max_size() const noexcept;
 
+    /**
+     * @brief Allocate room for nodes up front
+     *
+     * A hashed index is sized so that inserting up to @p n nodes does not rehash
+     * it; an ordered index allocates its nodes one by one and is left as is.
+     *
+     * @param n Number of nodes expected in the graph
+     */
+    void reserve_nodes(size_type n);
+
+    /**
+     * @brief Allocate room for the edges of a node up front
+     *
+     * Adding up to @p degree edges from the node then neither grows its edges
+     * nor rehashes their index. On UNDIRECTED graphs, the edges to the node are
+     * reserved as well.
+     *
+     * @param position Iterator to the node
+     * @param degree Number of edges expected from the node
+     */
+    void reserve_edges(const_iterator position, size_type degree);
+
+    /**
+     * @brief Allocate room for the edges of a node up front (key version)
+     *
+     * The node is created if it does not exist yet, as with @ref add_edge.
+     *
+     * @param key Key of the node
+     * @param degree Number of edges expected from the node
+     */
+    void reserve_edges(const key_type& key, size_type degree);
+
+    /**
+     * @brief Give back the memory left unused by deletions
+     *
+     * The node index, the edges of every node and the pool of shared costs are
+     * reallocated to fit their current size, and the dense indices of the nodes
+     * used by the search algorithms are renumbered. Iterators to the nodes remain valid.
+     */
+    void shrink_to_fit();
+
+    /**
+     * @brief Get the allocator of the graph
+     * @return Copy of the allocator given at construction
+     */
+    [[nodiscard]] allocator_type get_allocator() const noexcept;
+
     /// @}
 
     ///
@@ -520,6 +669,9 @@ class graph {
     /**
      * @brief Insert a node with specified key and node
      *
+     * The new node gets the data of @p node and, through add_edge, an edge to the node with the key of each of its targets.
+     * Nothing is allocated if @p key is already in the graph.
+     *
      * @param position Hint for where to insert the node
      * @param key Key for the new node
      * @param node Node to insert
@@ -551,7 +703,8 @@ class graph {
     /**
      * @brief Emplace a node with the specified key and node
      *
-     * Constructs a new node in-place with the given key and node.
+     * Constructs a new node in-place with the data of the given node and, through add_edge, an edge to the node with
+     * the key of each of its targets. Nothing is allocated if @p key is already in the graph.
      *
      * @param key Key for the new node
      * @param node Node to emplace
@@ -559,6 +712,40 @@ class graph {
      */
     std::pair<iterator, bool> emplace(const key_type &, const node &);
 
+    /**
+     * @brief Emplace a node by moving the specified key and data
+     *
+     * @param key Key for the new node (moved from only if it is inserted)
+     * @param data Data for the new node (moved from only if it is inserted)
+     * @return Pair containing iterator to the node and boolean indicating if insertion occurred
+     */
+    std::pair<iterator, bool> emplace(key_type &&, graphed_type &&);
+
+    /**
+     * @brief Insert a node whose data is constructed in place, if the key does not exist yet
+     *
+     * Nothing is allocated nor constructed when the key already exists: @p args are left untouched.
+     * Otherwise the data is constructed once from @p args and moved into the new node.
+     *
+     * @param key Key for the node
+     * @param args Arguments forwarded to the constructor of the data
+     * @return Pair containing iterator to the node and boolean indicating if insertion occurred
+     * @since version 1.2
+     */
+    template <class... Args>
+    std::pair<iterator, bool> try_emplace(const key_type &key, Args &&... args);
+
+    /**
+     * @brief Insert a node whose data is constructed in place, if the key does not exist yet (move version)
+     *
+     * @param key Key for the node, moved from only if it is inserted
+     * @param args Arguments forwarded to the constructor of the data
+     * @return Pair containing iterator to the node and boolean indicating if insertion occurred
+     * @since version 1.2
+     */
+    template <class... Args>
+    std::pair<iterator, bool> try_emplace(key_type &&key, Args &&... args);
+
     /**
      * @brief Add a node with the specified key
      *
@@ -583,7 +770,7 @@ class graph {
     /**
      * @brief Add a node with the specified key and node
      *
-     * If a node with the given key doesn't exist, creates a new node with the given node's data.
+     * If a node with the given key doesn't exist, creates a new node with the given node's data and edges, as emplace does.
      *
      * @param key Key for the node
      * @param node Node to copy data from
@@ -591,6 +778,15 @@ class graph {
      */
     std::pair<iterator, bool> add_node(const key_type &, const node &);
 
+    /**
+     * @brief Add a node by moving the specified key and data
+     *
+     * @param key Key for the node (moved from only if it is inserted)
+     * @param data Data for the node (moved from only if it is inserted)
+     * @return Pair containing iterator to the node and boolean indicating if insertion occurred
+     */
+    std::pair<iterator, bool> add_node(key_type &&, graphed_type &&);
+
     /**
      * @brief Add an edge between two nodes (iterator version)
      *
@@ -619,11 +815,29 @@ class graph {
      * @brief Make the graph complete with specified edge cost
      *
      * Adds edges between all pairs of nodes with the given cost.
+     * The previous edges are cleared first, so the new ones are appended to
+     * reserved storage without any search: O(V^2).
      *
      * @param cost Cost for all edges
      */
     void make_complete(cost_type cost);
 
+    /**
+     * @brief Replace the content of the graph with a list of edges
+     *
+     * Each element of [first, last) is a (from, to, cost) tuple read with `std::get`.
+     * The endpoints become nodes holding default values, in the order of their first
+     * appearance, and the last cost given to a duplicate edge wins, as with @ref add_edge.
+     * Each endpoint is looked up once in the node index, then the edges are sorted in bulk by source,
+     * so the adjacency is built without any per-edge search.
+     *
+     * @tparam InputIterator Iterator over (from, to, cost) tuples
+     * @param first Iterator to the first edge
+     * @param last Iterator to one past the last edge
+     */
+    template <class InputIterator>
+    void assign_edges(InputIterator first, InputIterator last);
+
     /// @}
 
     /// @name Deleters
@@ -692,6 +906,38 @@ class graph {
      */
     size_type del_node(const key_type& key);
 
+    /**
+     * @brief Delete a batch of nodes by key
+     *
+     * The nodes are marked first, then all their incident edges are removed in a
+     * single sweep over their adjacency: an edge between two deleted nodes is not
+     * unlinked on either side. Unknown and repeated keys are ignored.
+     *
+     * @tparam Range Container of keys, iterated with a range-based for loop
+     * @param keys Keys of the nodes to delete
+     * @return Number of nodes removed
+     */
+    template <class Range>
+    size_type del_nodes(const Range& keys);
+
+    /**
+     * @brief Delete a batch of nodes by key (initializer list version)
+     *
+     * @param keys Keys of the nodes to delete
+     * @return Number of nodes removed
+     */
+    size_type del_nodes(std::initializer_list<key_type> keys);
+
+    /**
+     * @brief Delete the nodes satisfying a predicate
+     *
+     * The whole graph is scanned once to mark the nodes, then they are removed as with @ref del_nodes.
+     *
+     * @param predicate Function called on every node, returning true for the nodes to delete
+     * @return Number of nodes removed
+     */
+    size_type del_nodes_if(std::function<bool(const_iterator)> predicate);
+
     /**
      * @brief Clear all nodes and edges from the graph
      */
@@ -719,6 +965,26 @@ class graph {
      */
     size_type del_edge(const key_type& from_key, const key_type& to_key);
 
+    /**
+     * @brief Delete a batch of edges by key
+     *
+     * Each element is a (from, to) pair read with `std::get`; unknown nodes and missing edges are ignored.
+     *
+     * @tparam Range Container of pairs of keys, iterated with a range-based for loop
+     * @param edges Endpoints of the edges to delete
+     * @return Number of edges removed
+     */
+    template <class Range>
+    size_type del_edges(const Range& edges);
+
+    /**
+     * @brief Delete a batch of edges by key (initializer list version)
+     *
+     * @param edges Endpoints of the edges to delete
+     * @return Number of edges removed
+     */
+    size_type del_edges(std::initializer_list<std::pair<key_type, key_type>> edges);
+
     /**
      * @brief Clear all edges from the graph
      */
@@ -754,8 +1020,10 @@ class graph {
      * @brief Swap the contents of two graphs
      *
      * Exchanges the contents of this graph with another graph.
+     * As with the standard containers, the allocators are not swapped.
      *
      * @param other Graph to swap with
+     * @pre `get_allocator() == other.get_allocator()`; use a move assignment to transfer a graph to another resource
      */
     void swap(graph& other) noexcept;
 
@@ -792,6 +1060,19 @@ class graph {
      */
     const_iterator find(const key_type &) const;
 
+    /// @brief Heterogeneous lookups, e.g. from a `std::string_view` on `std::string` keys
+    ///
+    /// Only available when the node index is transparent: @ref ordered_index under C++14, and @ref unordered_index
+    /// for `std::string` keys under C++17. The key is not converted to a `key_type` beforehand.
+    template <class K, class = typename std::enable_if<detail::is_transparent_map<MapNodes>::value && !std::is_same<K, Key>::value>::type>
+    size_type count(const K &) const;
+
+    template <class K, class = typename std::enable_if<detail::is_transparent_map<MapNodes>::value && !std::is_same<K, Key>::value>::type>
+    iterator find(const K &);
+
+    template <class K, class = typename std::enable_if<detail::is_transparent_map<MapNodes>::value && !std::is_same<K, Key>::value>::type>
+    const_iterator find(const K &) const;
+
     /// @}
 
     ///
@@ -1037,12 +1318,13 @@ class graph {
      * @tparam D Data type
      * @tparam C Cost type
      * @tparam N Nature type
+     * @tparam I Index policy
      * @param os Output stream
      * @param g Graph to output
      * @return Reference to the output stream
      */
-    template<class K, class D, class C, Nature N>
-    friend std::ostream & operator<<(std::ostream& os, const graph<K, D, C, N> &g);
+    template<class K, class D, class C, Nature N, class I>
+    friend std::ostream & operator<<(std::ostream& os, const graph<K, D, C, N, I> &g);
 
     /**
      * @brief Input stream operator
@@ -1053,12 +1335,13 @@ class graph {
      * @tparam D Data type
      * @tparam C Cost type
      * @tparam N Nature type
+     * @tparam I Index policy
      * @param is Input stream
      * @param g Graph to load into
      * @return Reference to the input stream
      */
-    template<class K, class D, class C, Nature N>
-    friend std::istream & operator>>(std::istream& is, graph<K, D, C, N> &g);
+    template<class K, class D, class C, Nature N, class I>
+    friend std::istream & operator>>(std::istream& is, graph<K, D, C, N, I> &g);
 
     /**
      * @brief Load a graph from a file
@@ -1148,11 +1431,12 @@ class graph {
      * @tparam D Data type of other graph
      * @tparam C Cost type of other graph
      * @tparam N Nature type of other graph
+     * @tparam I Index policy of other graph
      * @param other Graph to compare with
      * @return true if graphs are equal, false otherwise
      */
-    template<class K, class D, class C, Nature N>
-    bool operator==(const graph<K, D, C, N> &other) const noexcept;
+    template<class K, class D, class C, Nature N, class I>
+    bool operator==(const graph<K, D, C, N, I> &other) const noexcept;
 
     /**
      * @brief Inequality operator
@@ -1163,26 +1447,36 @@ class graph {
      * @tparam D Data type of other graph
      * @tparam C Cost type of other graph
      * @tparam N Nature type of other graph
+     * @tparam I Index policy of other graph
      * @param other Graph to compare with
      * @return true if graphs are not equal, false otherwise
      */
-    template<class K, class D, class C, Nature N>
-    bool operator!=(const graph<K, D, C, N> &other) const noexcept;
+    template<class K, class D, class C, Nature N, class I>
+    bool operator!=(const graph<K, D, C, N, I> &other) const noexcept;
 
     /// @}
 
     /// CRTP: https://en.wikipedia.org/wiki/Curiously_recurring_template_pattern
     class node : public basic_node<graphed_type, cost_type, iterator, const_iterator> {
       public:
+        using EdgesAllocator = typename basic_node<graphed_type, cost_type, iterator, const_iterator>::EdgesAllocator;
+
         explicit node();
 
         explicit node(const graphed_type &);
 
+        node(const graphed_type &, const EdgesAllocator &);
+
+        node(graphed_type &&, const EdgesAllocator &);
+
         node &operator=(const graphed_type &);
 
       private:
         friend class graph;
 
+        //! Dense index of the node in its graph, see @ref graph::attach_node
+        size_type _index = std::numeric_limits<size_type>::max();
+
         void set_iterator_values(iterator this_, iterator end, const_iterator cend);
     };
 
@@ -1203,6 +1497,10 @@ class graph {
     search_path bfs(const_iterator start, std::list<const_iterator>           target_list) const;
     search_path bfs(const_iterator start, std::function<bool(const_iterator)> is_goal)     const;
 
+    /// Overloads inlining the goal predicate @p is_goal, instead of calling it through a `std::function`
+    template <class Goal> auto bfs(key_type       start, Goal is_goal) const -> GRAPH_REQUIRES(search_path, GRAPH_SEARCH_GOAL(Goal, key_type));
+    template <class Goal> auto bfs(const_iterator start, Goal is_goal) const -> GRAPH_REQUIRES(search_path, GRAPH_SEARCH_GOAL(Goal, const_iterator));
+
     ///
     /// @brief Depth-First Search class
     /// @see https://en.wikipedia.org/wiki/Depth-First_Search
@@ -1216,6 +1514,10 @@ class graph {
     search_path dfs(const_iterator start, std::list<const_iterator>           target_list) const;
     search_path dfs(const_iterator start, std::function<bool(const_iterator)> is_goal)     const;
 
+    /// Overloads inlining the goal predicate @p is_goal, instead of calling it through a `std::function`
+    template <class Goal> auto dfs(key_type       start, Goal is_goal) const -> GRAPH_REQUIRES(search_path, GRAPH_SEARCH_GOAL(Goal, key_type));
+    template <class Goal> auto dfs(const_iterator start, Goal is_goal) const -> GRAPH_REQUIRES(search_path, GRAPH_SEARCH_GOAL(Goal, const_iterator));
+
     ///
     /// @brief Depth-Limited Search class
     /// @see https://en.wikipedia.org/wiki/Iterative_Deepening_Depth-First_Search
@@ -1258,6 +1560,10 @@ class graph {
     search_path ucs(const_iterator start, std::list<const_iterator>           target_list) const;
     search_path ucs(const_iterator start, std::function<bool(const_iterator)> is_goal)     const;
 
+    /// Overloads inlining the goal predicate @p is_goal, instead of calling it through a `std::function`
+    template <class Goal> auto ucs(key_type       start, Goal is_goal) const -> GRAPH_REQUIRES(search_path, GRAPH_SEARCH_GOAL(Goal, key_type));
+    template <class Goal> auto ucs(const_iterator start, Goal is_goal) const -> GRAPH_REQUIRES(search_path, GRAPH_SEARCH_GOAL(Goal, const_iterator));
+
     ///
     /// @brief A* shortest path algorithm
     ///
@@ -1277,6 +1583,23 @@ class graph {
     search_path astar(const_iterator start, std::list<const_iterator>           target_list, std::function<cost_type(const_iterator)> heuristic) const;
     search_path astar(const_iterator start, std::function<bool(const_iterator)> is_goal,     std::function<cost_type(const_iterator)> heuristic) const;
 
+    /// Overloads inlining the @p heuristic and the goal predicate @p is_goal, instead of calling them through a `std::function`
+    template <class Heuristic>
+    auto astar(key_type       start, key_type                  target,      Heuristic heuristic) const -> GRAPH_REQUIRES(search_path, GRAPH_SEARCH_HEURISTIC(Heuristic, const_iterator, cost_type));
+    template <class Heuristic>
+    auto astar(key_type       start, std::list<key_type>       target_list, Heuristic heuristic) const -> GRAPH_REQUIRES(search_path, GRAPH_SEARCH_HEURISTIC(Heuristic, const_iterator, cost_type));
+    template <class Goal, class Heuristic>
+    auto astar(key_type       start, Goal                      is_goal,     Heuristic heuristic) const
+        -> GRAPH_REQUIRES(search_path, GRAPH_SEARCH_GOAL(Goal, key_type) && GRAPH_SEARCH_HEURISTIC(Heuristic, const_iterator, cost_type));
+
+    template <class Heuristic>
+    auto astar(const_iterator start, const_iterator            target,      Heuristic heuristic) const -> GRAPH_REQUIRES(search_path, GRAPH_SEARCH_HEURISTIC(Heuristic, const_iterator, cost_type));
+    template <class Heuristic>
+    auto astar(const_iterator start, std::list<const_iterator> target_list, Heuristic heuristic) const -> GRAPH_REQUIRES(search_path, GRAPH_SEARCH_HEURISTIC(Heuristic, const_iterator, cost_type));
+    template <class Goal, class Heuristic>
+    auto astar(const_iterator start, Goal                      is_goal,     Heuristic heuristic) const
+        -> GRAPH_REQUIRES(search_path, GRAPH_SEARCH_GOAL(Goal, const_iterator) && GRAPH_SEARCH_HEURISTIC(Heuristic, const_iterator, cost_type));
+
     ///
     /// @brief Dijkstra Search
     ///
@@ -1303,24 +1626,158 @@ class graph {
     /// Computes shortest paths from node @param start to every reachable node.
     /// Negative edge costs are permitted, but the graph must not have a cycle of negative weights.
     ///
+    /// The nodes whose distance changed wait in a queue to relax their out-edges (Shortest Path Faster Algorithm),
+    /// so that the nodes left untouched by a round are not swept again. A path of `size()` edges can only be shorter
+    /// than the previous ones through a negative-weight cycle.
+    ///
     /// @see https://en.wikipedia.org/wiki/Bellman%E2%80%93Ford_algorithm
+    /// @see https://en.wikipedia.org/wiki/Shortest_path_faster_algorithm
     /// @since version 1.1
     ///
     shortest_paths bellman_ford(key_type       start) const;
     shortest_paths bellman_ford(const_iterator start) const;
 
+    ///
+    /// @brief Parallel Bellman-Ford Search
+    ///
+    /// Same result as @ref bellman_ford, computed in rounds on @p nbr_threads threads. The in-edges are first packed
+    /// into contiguous arrays; each round then computes the new distance of every node from the distances of the
+    /// previous round, each thread handling its own share of the nodes. After `k` rounds, the distances are the ones
+    /// of the shortest paths of at most `k` edges: a change at the round `size()` reveals a negative-weight cycle.
+    ///
+    /// @param nbr_threads the maximum number of threads, including the calling one; 0 for the number of cores. A small
+    ///        graph does not start more threads than it has work for
+    /// @since version 1.2
+    ///
+    shortest_paths bellman_ford(key_type       start, size_type nbr_threads) const;
+    shortest_paths bellman_ford(const_iterator start, size_type nbr_threads) const;
+
+    ///
+    /// @brief Parallel Delta-Stepping Search
+    ///
+    /// Computes the same distances as @ref dijkstra from @param start to every reachable node, on @p nbr_threads threads.
+    /// The tentative distances are grouped in buckets of width @p delta: all the nodes of the lowest bucket are relaxed
+    /// together, first through their light edges (cost up to @p delta) until the bucket stays empty, then through
+    /// their heavy edges. Each phase splits the nodes to expand between the threads, and each thread then applies the
+    /// relaxations of the nodes it owns, so no lock is taken on the distances.
+    ///
+    /// Edge costs must be non-negative. A @p delta close to the average edge cost is a good start: a smaller one
+    /// makes more phases, a larger one relaxes more edges several times.
+    /// Among equally short paths, the chosen predecessors may differ from the ones of @ref dijkstra.
+    ///
+    /// @param nbr_threads the maximum number of threads, including the calling one; 0 for the number of cores. A small
+    ///        graph does not start more threads than it has work for
+    /// @see https://en.wikipedia.org/wiki/Parallel_single-source_shortest_path_algorithm#Delta_stepping_algorithm
+    /// @since version 1.2
+    ///
+    shortest_paths delta_stepping(key_type       start, cost_type delta, size_type nbr_threads = 0) const;
+    shortest_paths delta_stepping(const_iterator start, cost_type delta, size_type nbr_threads = 0) const;
+
+    ///
+    /// @brief All-Pairs Shortest Paths (Floyd-Warshall)
+    ///
+    /// Computes the distance between every ordered pair of nodes in a dense @ref distance_matrix, in O(size()^3).
+    /// Negative edge costs are permitted, but the graph must not have a cycle of negative weights.
+    ///
+    /// The matrix is split in square blocks: for each block of intermediate nodes, its diagonal block is updated
+    /// first, then the blocks of its row and of its column, then all the others. The blocks of the two last steps
+    /// are independent and shared between @p nbr_threads threads, and the innermost loop runs over contiguous
+    /// rows that the compiler can vectorise.
+    ///
+    /// @param keep_paths whether to also keep the next-hop matrix, needed by @ref distance_matrix::get_path
+    /// @param nbr_threads the maximum number of threads, including the calling one; 0 for the number of cores. A small
+    ///        graph does not start more threads than it has work for
+    /// @see https://en.wikipedia.org/wiki/Floyd%E2%80%93Warshall_algorithm
+    /// @since version 1.2
+    ///
+    distance_matrix all_pairs_shortest_paths(bool keep_paths = false, size_type nbr_threads = 0) const;
+
+    ///
+    /// @brief All-Pairs Shortest Paths on sparse graphs (Johnson)
+    ///
+    /// Same result as @ref all_pairs_shortest_paths, in O(size() * (size() + get_nbr_edges()) * log(size())).
+    /// A single Bellman-Ford pass computes a potential `h` of every node, such that the reweighted edge costs
+    /// `cost(u, v) + h(u) - h(v)` are non-negative; then a Dijkstra's search runs from every node on these costs.
+    /// The searches are shared between @p nbr_threads threads, each one reusing its own heap, and write straight
+    /// into their row of the matrix.
+    ///
+    /// Negative edge costs are permitted, but the graph must not have a cycle of negative weights.
+    ///
+    /// @param keep_paths whether to also keep the next-hop matrix, needed by @ref distance_matrix::get_path
+    /// @param nbr_threads the maximum number of threads, including the calling one; 0 for the number of cores. A small
+    ///        graph does not start more threads than it has work for
+    /// @see https://en.wikipedia.org/wiki/Johnson%27s_algorithm
+    /// @since version 1.2
+    ///
+    distance_matrix johnson(bool keep_paths = false, size_type nbr_threads = 0) const;
+
+    ///
+    /// @brief Compact read-only snapshot of the graph
+    ///
+    /// Packs the nodes into dense indices, in iteration order, and the edges into compressed-sparse-row arrays,
+    /// so that the search algorithms of the returned @ref frozen_graph walk contiguous memory
+    /// instead of the node map and the adjacency lists.
+    /// The snapshot owns its data: later modifications of the graph are not reflected.
+    ///
+    /// @since version 1.2
+    ///
+    frozen_graph freeze() const;
+
+    ///
+    /// @brief Dense adjacency-matrix copy of the graph
+    ///
+    /// Packs the nodes into dense indices, in iteration order, and the edges into a cost matrix
+    /// with a bitset of the existing edges; see @ref adjacency_matrix.
+    /// The matrix owns its data: later modifications of the graph are not reflected.
+    ///
+    /// @since version 1.2
+    ///
+    adjacency_matrix to_matrix() const;
+
+    /// @name Snapshots
+    /// Concurrent reads while a single thread writes: the writer keeps mutating the graph and calls @ref publish
+    /// whenever its readers should see the changes, and the readers only ever query immutable snapshots.
+    /// @{
+
+    /// The type of a published snapshot, shared by the readers holding it
+    using snapshot_type = std::shared_ptr<const frozen_graph>;
+
+    /**
+     * @brief Freeze the current state of the graph and make it the current snapshot
+     *
+     * Writer side: must not run concurrently with another modification of the graph.
+     * The previous snapshot stays valid for the readers still holding it.
+     *
+     * @return the version of the new snapshot, one more than the previous one
+     * @since version 1.2
+     */
+    size_type publish();
+
+    /**
+     * @brief Last published snapshot
+     *
+     * Reader side: safe to call from any thread, even while the writer modifies the graph or publishes.
+     * The returned snapshot is then queried without any lock.
+     *
+     * @return the last published snapshot, or an empty one of version 0 if nothing was published yet
+     * @since version 1.2
+     */
+    snapshot_type snapshot() const;
+
+    /// @return the number of published snapshots; writer side
+    [[nodiscard]] size_type get_version() const noexcept;
+
+    /// @}
+
     class search_path final : std::deque<std::pair<graph::const_iterator, cost_type >> {
-        template <bool> friend search_path graph::abstract_first_search(graph::const_iterator, std::function<bool(const_iterator)>) const;
+        template <bool, class Goal> friend search_path graph::abstract_first_search(graph::const_iterator, Goal &) const;
 
         friend search_path graph::dls   (graph::const_iterator, std::function<bool(const_iterator)>, size_type)                                const;
         friend search_path graph::iddfs (graph::const_iterator, std::function<bool(const_iterator)>)                                           const;
-        friend search_path graph::ucs   (graph::const_iterator, std::function<bool(const_iterator)>)                                           const;
-        friend search_path graph::astar (graph::const_iterator, std::function<bool(const_iterator)>, std::function<cost_type(const_iterator)>) const;
+        template <class Goal, class Heuristic> friend bool graph::best_first_search(graph::const_iterator, Goal &, Heuristic &, bool, search_path &) const;
 
         friend class shortest_paths;
 
-        friend bool path_comparator::operator()(const search_path &, const search_path &) const;
-
         using Container = std::deque<std::pair<graph::const_iterator, cost_type >>;
 
       public:
@@ -1371,24 +1828,40 @@ class graph {
     ///
     /// @brief Return data of shortest paths from a single source node to all the other nodes
     ///
-    /// Data structure as a map<destination_node, pair<previous_node, distance>>
+    /// Data structure as a sequence of (destination_node, (previous_node, distance)), in the iteration order of the graph.
+    /// The entry of a given node is found in O(1) through its dense index.
     /// Used by Dijkstra and Bellman-Ford algorithms
     ///
     /// @since version 1.1
     ///
-    class shortest_paths final : std::map<graph::const_iterator, std::pair<graph::const_iterator, cost_type>, iterator_comparator> {
+    class shortest_paths final : std::vector<std::pair<graph::const_iterator, std::pair<graph::const_iterator, cost_type>>> {
+        const graph*          _graph;
         graph::const_iterator _start;
+        //! Position in the container of the node of each dense index
+        std::vector<size_type> _positions;
 
         friend shortest_paths graph::dijkstra    (graph::const_iterator, std::function<bool(const_iterator)>) const;
+        friend void           graph::dijkstra    (std::function<bool(const_iterator)> &, shortest_paths &, std::true_type)  const;
+        friend void           graph::dijkstra    (std::function<bool(const_iterator)> &, shortest_paths &, std::false_type) const;
         friend shortest_paths graph::bellman_ford(graph::const_iterator)                                      const;
+        friend shortest_paths graph::bellman_ford(graph::const_iterator, size_type)                           const;
+        friend shortest_paths graph::delta_stepping(graph::const_iterator, cost_type, size_type)              const;
+
+        using Container = std::vector<std::pair<graph::const_iterator, std::pair<graph::const_iterator, cost_type>>>;
+
+        /// Every node is unreached but @p start, at a distance of `cost_type()`
+        shortest_paths(const graph &g, graph::const_iterator start);
 
-        using Container = std::map<graph::const_iterator, std::pair<graph::const_iterator, cost_type>, iterator_comparator>;
+        //! @return the predecessor and the distance of the node @p n
+        typename Container::value_type::second_type       &entry(const typename node::basic_node* n);
+        const typename Container::value_type::second_type &entry(const typename node::basic_node* n) const;
 
-        explicit shortest_paths(graph::const_iterator start);
+        //! @return the predecessor and the distance of the node at @p it, or nullptr if it was not in the graph during the search
+        const typename Container::value_type::second_type *find_entry(graph::const_iterator it) const;
 
       public:
         using value_type             = typename Container::value_type;
-        using mapped_type            = typename Container::mapped_type;
+        using mapped_type            = typename value_type::second_type;
         using reference              = typename Container::reference;
         using const_reference        = typename Container::const_reference;
         using iterator               = typename Container::iterator;
@@ -1406,14 +1879,24 @@ class graph {
         using Container::crend;
 
         shortest_paths(const shortest_paths &);
+        shortest_paths(shortest_paths &&) noexcept = default;
         ~shortest_paths() = default;
 
+        shortest_paths &operator=(const shortest_paths &) = default;
+        shortest_paths &operator=(shortest_paths &&) noexcept = default;
+
         using Container::empty;
         using Container::size;
 
-        //! @return the father of current in the optimal path from _start to current
+        //! @return the father of current in the optimal path from _start to current, graph::cend() if current is unreached
+        //! or was added to the graph after the search
         graph::const_iterator get_previous(graph::const_iterator current) const;
 
+        //! @return the cost of the optimal path from _start to target, the infinity of cost_type if target is unreached
+        //! or was added to the graph after the search
+        cost_type get_distance(graph::key_type target) const;
+        cost_type get_distance(graph::const_iterator target) const;
+
         //! @return the re-build path from the start node to the target
         search_path get_path(graph::key_type target) const;
         search_path get_path(graph::const_iterator target) const;
@@ -1426,32 +1909,493 @@ class graph {
         }
     };
 
-  private:
-    //! Helper functions and classes
-    class path_comparator : public std::function<bool(search_path, search_path)> {
-        std::function<cost_type(const_iterator)> _heuristic;
+    ///
+    /// @brief Immutable compressed-sparse-row (CSR) representation of a graph
+    ///
+    /// Nodes are identified by dense indices in `[0, size())`, in the iteration order of the graph; `size()` is
+    /// used as the "no node" value, like `end()` for iterators.
+    /// The out-edges of the node `i` are the positions `[edges_begin(i), edges_end(i))` of the
+    /// `target()` and `cost()` arrays, sorted by target. Edges of an UNDIRECTED graph are stored in both directions.
+    ///
+    /// Built once by @ref graph::freeze, it answers any number of read-only queries.
+    ///
+    /// @since version 1.2
+    ///
+    class frozen_graph final {
+        friend frozen_graph graph::freeze() const;
+        friend size_type    graph::publish();
+
+        std::vector<key_type>     _keys;
+        std::vector<size_type>    _sorted;  /// indices ordered by key, empty when _keys already is
+        std::vector<graphed_type> _values;
+        std::vector<size_type>    _offsets; /// size() + 1 positions into _targets and _costs
+        std::vector<size_type>    _targets;
+        std::vector<cost_type>    _costs;
+        size_type                 _num_edges{0};
+        size_type                 _version{0};
+
+      public:
+        class search_path;
+        class shortest_paths;
+
+        frozen_graph() = default;
+
+        [[nodiscard]] bool      empty()         const noexcept;
+        [[nodiscard]] size_type size()          const noexcept;
+        [[nodiscard]] size_type get_nbr_nodes() const noexcept;
+        [[nodiscard]] size_type get_nbr_edges() const noexcept;
+        [[nodiscard]] Nature    get_nature()    const noexcept;
+
+        //! @return the version given by @ref graph::publish, or 0 for a snapshot made by @ref graph::freeze
+        [[nodiscard]] size_type get_version()   const noexcept;
+
+        //! @return the index of the node @param key, or `size()` if it does not exist
+        size_type find(const key_type &key) const;
+
+        const key_type     &get_key(size_type index) const;
+        const graphed_type &get    (size_type index) const;
+
+        //! @return the out-degree of the node @param index
+        size_type degree(size_type index) const;
+
+        //! @return the range of positions `[edges_begin(i), edges_end(i))` of the out-edges of the node @param index
+        size_type edges_begin(size_type index) const;
+        size_type edges_end  (size_type index) const;
+
+        size_type        target(size_type edge) const;
+        const cost_type &cost  (size_type edge) const;
+
+        bool existing_edge(size_type from, size_type to) const;
+
+        //! @return the cost of the edge between @param from and @param to, or infinity if it does not exist
+        cost_type get_cost(size_type from, size_type to) const;
+
+        search_path bfs  (size_type start, size_type target) const;
+        search_path astar(size_type start, size_type target, std::function<cost_type(size_type)> heuristic) const;
+
+        shortest_paths dijkstra(size_type start) const;
+
+        ///
+        /// @brief Path found by a search algorithm on a @ref frozen_graph
+        ///
+        /// Sequence of `(index, cost of the edge leading to index)`, starting with `(start, 0)`.
+        ///
+        class search_path final : std::vector<std::pair<size_type, cost_type>> {
+            using Container = std::vector<std::pair<size_type, cost_type>>;
+
+          public:
+            using value_type     = typename Container::value_type;
+            using const_iterator = typename Container::const_iterator;
+
+            using Container::begin;
+            using Container::cbegin;
+            using Container::end;
+            using Container::cend;
+            using Container::empty;
+            using Container::size;
+            using Container::front;
+            using Container::back;
+            using Container::operator[];
+            using Container::push_back;
+            using Container::emplace_back;
+
+            cost_type total_cost() const;
+
+            bool contain(size_type index) const;
+        };
+
+        ///
+        /// @brief Single-source shortest paths computed on a @ref frozen_graph
+        ///
+        /// Dense arrays of distances and predecessors, indexed by node.
+        ///
+        class shortest_paths final {
+            friend shortest_paths frozen_graph::dijkstra(size_type) const;
+
+            size_type              _start;
+            std::vector<cost_type> _distances;
+            std::vector<size_type> _previous;
+
+            shortest_paths(size_type start, size_type nbr_nodes);
+
+          public:
+            //! @return the father of @param current in the optimal path from the start, or `size()` if unreachable
+            size_type get_previous(size_type current) const;
+
+            //! @return the distance from the start to @param current, or infinity if unreachable
+            cost_type get_distance(size_type current) const;
+
+            //! @return the re-build path from the start node to the target
+            search_path get_path(size_type target) const;
+
+            [[nodiscard]] size_type size() const noexcept;
+        };
+    };
+
+    ///
+    /// @brief Dense adjacency-matrix representation of a graph
+    ///
+    /// Nodes are identified by dense indices in `[0, size())`, in the iteration order of the graph; `size()` is
+    /// used as the "no node" value, as for @ref frozen_graph.
+    /// The costs are stored in a row-major `size() x size()` matrix beside a bitset of the existing edges, so
+    /// that edges are looked up, added and removed in O(1) without any allocation. Both are kept symmetric
+    /// for UNDIRECTED graphs.
+    ///
+    /// Built by @ref graph::to_matrix, and converted back by @ref to_graph.
+    ///
+    /// @since version 1.2
+    ///
+    class adjacency_matrix final {
+        friend adjacency_matrix graph::to_matrix() const;
+
+        std::vector<key_type>     _keys;
+        std::vector<size_type>    _sorted;   /// indices ordered by key, empty when _keys already is
+        std::vector<graphed_type> _values;
+        std::vector<cost_type>    _costs;    /// size() * size() costs, row by row
+        std::vector<bool>         _existing; /// size() * size() bits, set for the existing edges
+        size_type                 _num_edges{0};
+
+        //! copy the cell (from, to) on (to, from) for UNDIRECTED graphs
+        void mirror_edge(size_type from, size_type to, std::true_type);
+        void mirror_edge(size_type from, size_type to, std::false_type);
+
+      public:
+        adjacency_matrix() = default;
+
+        [[nodiscard]] bool      empty()         const noexcept;
+        [[nodiscard]] size_type size()          const noexcept;
+        [[nodiscard]] size_type get_nbr_nodes() const noexcept;
+        [[nodiscard]] size_type get_nbr_edges() const noexcept;
+        [[nodiscard]] Nature    get_nature()    const noexcept;
+
+        //! @return the index of the node @param key, or `size()` if it does not exist
+        size_type find(const key_type &key) const;
+
+        const key_type     &get_key(size_type index) const;
+        const graphed_type &get    (size_type index) const;
+
+        bool existing_edge(size_type from, size_type to) const;
+
+        //! @return the cost of the edge between @param from and @param to, or infinity if it does not exist
+        cost_type get_cost(size_type from, size_type to) const;
+
+        //! add the edge between @param from and @param to, or update its cost
+        //! @return true if the edge is new
+        bool add_edge(size_type from, size_type to, cost_type cost);
+
+        //! @return the number of removed edges (0 or 1)
+        size_type del_edge(size_type from, size_type to);
+
+        void clear_edges();
+
+        //! add an edge of cost @param cost between every pair of distinct nodes, in O(size()^2) and without any allocation
+        void make_complete(cost_type cost);
+
+        //! @return a graph holding the nodes and the edges of the matrix
+        graph to_graph() const;
+    };
+
+    ///
+    /// @brief Distances between all the pairs of nodes of a graph
+    ///
+    /// Nodes are identified by dense indices in `[0, size())`, in the iteration order of the graph; `size()` is
+    /// used as the "no node" value, as for @ref adjacency_matrix.
+    /// The distances are stored in a row-major `size() x size()` matrix, optionally beside the matrix of the first
+    /// node after `from` on a shortest path from `from` to `to`, from which the paths are rebuilt.
+    ///
+    /// Built by @ref graph::all_pairs_shortest_paths.
+    ///
+    /// @since version 1.2
+    ///
+    class distance_matrix final {
+        friend distance_matrix graph::all_pairs_shortest_paths(bool, size_type) const;
+        friend distance_matrix graph::johnson                 (bool, size_type) const;
+
+        std::vector<key_type>  _keys;
+        std::vector<size_type> _sorted;    /// indices ordered by key, empty when _keys already is
+        std::vector<cost_type> _distances; /// size() * size() distances, row by row
+        std::vector<size_type> _next;      /// size() * size() next hops, row by row; empty when the paths are not kept
+
+        /// Every distance is infinite and every next hop is `size()`
+        /// @param[out] positions the index in the matrix of the node of each dense index of @p g
+        distance_matrix(const graph &g, bool keep_paths, std::vector<size_type> &positions);
 
       public:
-        explicit path_comparator(std::function<cost_type(const_iterator)> heuristic);
+        distance_matrix() = default;
 
-        bool operator() (const search_path &, const search_path &) const;
+        [[nodiscard]] bool      empty() const noexcept;
+        [[nodiscard]] size_type size()  const noexcept;
+
+        //! @return true if the next hops were kept, so that the paths can be rebuilt
+        [[nodiscard]] bool has_paths() const noexcept;
+
+        //! @return the index of the node @param key, or `size()` if it does not exist
+        size_type find(const key_type &key) const;
+
+        const key_type &get_key(size_type index) const;
+
+        //! @return the cost of the shortest path from @param from to @param to, or infinity if there is none
+        cost_type get_distance(size_type from, size_type to) const;
+
+        //! @return the node following @param from on a shortest path to @param to, or `size()` if there is none
+        size_type get_next(size_type from, size_type to) const;
+
+        //! @return the indices of the nodes of a shortest path from @param from to @param to, both included; empty if there is none
+        std::vector<size_type> get_path(size_type from, size_type to) const;
     };
 
+  private:
+    //! Helper functions and classes
     struct iterator_comparator : std::function<bool(const_iterator, const_iterator)> {
         bool operator()(const const_iterator &, const const_iterator &) const;
     };
 
     bool is_cyclic_rec(const_iterator current, std::list<const_iterator> path) const;
 
-    /// @tparam insertFront Specialization parameter between dfs (`true`) and bfs (`false`) using respectively a `std::stack` and a `std::queue`
-    template <bool insertFront> search_path abstract_first_search(const_iterator start, std::function<bool(const_iterator)> is_goal) const;
+    /// @brief Link the node newly inserted at @p position to it, and give it a free dense index
+    ///
+    /// The dense indices let the search algorithms keep their state in arrays of `_indices_bound` elements
+    /// instead of associative containers of iterators.
+    void attach_node(iterator position);
+    /// @brief Release the dense index of the node at @p position, about to be erased
+    void release_node(const_iterator position);
+    /// @return the dense index of the node @p n of this graph
+    static size_type index_of(const typename node::basic_node* n);
+
+    /// @brief Give the node at @p position an edge to the node with the key of each target of @p n, through add_edge
+    void copy_edges(iterator position, const node &n);
+
+    /// @brief Remove every edge incident to the distinct nodes @p victims in one sweep; the nodes themselves are left in place
+    void detach_nodes(const std::vector<const_iterator> &victims);
+
+    /// @brief Reuse a released slot, or append a new one, to hold the shared cost of an undirected edge
+    Cost* acquire_shared_cost(cost_type cost);
+    void  release_shared_cost(Cost* slot);
+
+    /// @name Dispatch on the nature
+    /// `directed_tag` is `std::true_type` for DIRECTED graphs, so each instantiation only contains its own code path
+    /// @{
+    using directed_tag = std::integral_constant<bool, detail::is_directed<Nat>::value>;
+    /// `integral_cost_tag` is `std::true_type` for integral costs, whose Dijkstra's algorithm runs on a radix heap
+    using integral_cost_tag = std::integral_constant<bool, std::is_integral<Cost>::value && !std::is_same<Cost, bool>::value>;
+
+    /// @brief Mirror the new edge @p e from @p from to @p to on the opposite direction, sharing its cost
+    void      add_opposite_edge(const_iterator from, const_iterator to, typename node::edge &e, std::true_type);
+    void      add_opposite_edge(const_iterator from, const_iterator to, typename node::edge &e, std::false_type);
+    /// @brief Same as add_opposite_edge for an edge @p e known to be new, appended without any search
+    void      push_opposite_edge(node* from, node* to, typename node::edge &e, std::true_type);
+    void      push_opposite_edge(node* from, node* to, typename node::edge &e, std::false_type);
+    size_type del_edge     (const_iterator from, const_iterator to, std::true_type);
+    size_type del_edge     (const_iterator from, const_iterator to, std::false_type);
+    size_type clear_edges  (const_iterator position, std::true_type);
+    size_type clear_edges  (const_iterator position, std::false_type);
+    bool      existing_edge(const_iterator from, const_iterator to, std::true_type)  const;
+    bool      existing_edge(const_iterator from, const_iterator to, std::false_type) const;
+    Degree    degree       (const_iterator position, std::true_type)  const;
+    Degree    degree       (const_iterator position, std::false_type) const;
+    /// @brief Settle the nodes of @p result by increasing distance from its start until a goal is settled
+    void      dijkstra     (std::function<bool(const_iterator)> &is_goal, shortest_paths &result, std::true_type)  const;
+    void      dijkstra     (std::function<bool(const_iterator)> &is_goal, shortest_paths &result, std::false_type) const;
+    /// @}
+
+    /// @tparam insertFront Specialization parameter between dfs (`true`) and bfs (`false`), whose frontier is respectively used as a stack and as a queue
+    template <bool insertFront, class Goal> search_path abstract_first_search(const_iterator start, Goal &is_goal) const;
+
+    /// @brief Shared engine of ucs (with a @ref null_heuristic) and astar
+    ///
+    /// The cost from @p start and the heuristic of every discovered node are kept in arrays by dense index, the
+    /// heuristic being evaluated once per node, and the frontier is an indexed heap whose priorities are lowered in place.
+    /// @param[out] result the path to the first expanded goal, empty if there is none
+    /// @return false if the search met an edge of negative cost while @p reject_negative is set
+    template <class Goal, class Heuristic>
+    bool best_first_search(const_iterator start, Goal &is_goal, Heuristic &heuristic, bool reject_negative, search_path &result) const;
+
+    /// @brief Floyd-Warshall step of the intermediate nodes `[k_begin, k_end)` on the block `[i_begin, i_end) x [j_begin, j_end)`
+    ///
+    /// @p distances and @p next are row-major matrices of @p n columns; @p next is `nullptr` when the paths are not kept
+    void relax_block(cost_type* distances, size_type* next, size_type n, size_type k_begin, size_type k_end,
+                     size_type i_begin, size_type i_end, size_type j_begin, size_type j_end) const;
+
+    /// @brief Heuristic of the uninformed searches
+    struct null_heuristic {
+        cost_type operator()(const const_iterator &) const;
+    };
 };
 
-template <class Key, class T, class Cost = std::size_t>
-using graph_directed   = graph<Key, T, Cost, DIRECTED>;
+template <class Key, class T, class Cost = std::size_t, class Index = ordered_index>
+using graph_directed   = graph<Key, T, Cost, DIRECTED, Index>;
+
+template <class Key, class T, class Cost = std::size_t, class Index = ordered_index>
+using graph_undirected = graph<Key, T, Cost, UNDIRECTED, Index>;
+
+template <class Key, class T, class Cost = std::size_t, Nature Nat = UNDIRECTED>
+using graph_unordered  = graph<Key, T, Cost, Nat, unordered_index>;
+
+//////////////////////////
+///// IMPLICIT GRAPH /////
+//////////////////////////
+
+/**
+ * @brief Search-only view of a graph whose edges are computed on demand
+ *
+ * Nothing is materialised up front: the out-edges of a node are asked to the
+ * neighbour function each time the node is expanded, and the state of a search
+ * (distance, predecessor) is only allocated for the nodes it discovers. This
+ * allows searching state spaces that are too large, or unbounded, to be stored
+ * in a @ref graph.
+ *
+ * Each discovered key gets a dense index in the order of discovery: the
+ * per-node state is kept in contiguous arrays and the key is only looked up
+ * once per relaxed edge.
+ *
+ * @tparam Key Type of the states. Must be ordered, or hashable with @ref unordered_index
+ * @tparam Cost Type of the cost between nodes. Default is std::size_t
+ * @tparam Index Container policy of the discovered keys: @ref ordered_index (default) or @ref unordered_index
+ *
+ * @since version 1.2
+ */
+template <class Key, class Cost = std::size_t, class Index = ordered_index>
+class implicit_graph final {
+  public:
+    class search_path;
+    class shortest_paths;
+
+    using key_type   = Key;
+    using cost_type  = Cost;
+    using size_type  = std::size_t;
+
+    /// The `(neighbour, cost of the edge leading to it)` pairs of a node
+    using neighbours_type     = std::vector<std::pair<key_type, cost_type>>;
+    /// Fills its second argument, given empty, with the out-edges of its first argument
+    using neighbours_function = std::function<void(const key_type&, neighbours_type&)>;
+
+    using invalid_argument = detail::invalid_argument;
+    using negative_edge    = detail::negative_edge;
+
+    /**
+     * @param neighbours function computing the out-edges of a node
+     * @param max_expansions number of nodes a search expands before giving up; bounds the memory of a search
+     *                       on an infinite state space
+     */
+    explicit implicit_graph(neighbours_function neighbours, size_type max_expansions = std::numeric_limits<size_type>::max());
+
+    [[nodiscard]] size_type get_max_expansions() const noexcept;
+    void set_max_expansions(size_type max_expansions) noexcept;
+
+    /// @return the out-edges of @param key, as given by the neighbour function
+    neighbours_type get_neighbours(const key_type &key) const;
+
+    /// @name Search algorithms
+    /// Same semantics as the algorithms of @ref graph; an empty path is returned when the goal is not
+    /// reached within `get_max_expansions()` expansions.
+    /// @{
 
-template <class Key, class T, class Cost = std::size_t>
-using graph_undirected = graph<Key, T, Cost, UNDIRECTED>;
+    search_path bfs  (const key_type &start, const key_type &target) const;
+    search_path bfs  (const key_type &start, std::function<bool(key_type)> is_goal) const;
+
+    search_path ucs  (const key_type &start, const key_type &target) const;
+    search_path ucs  (const key_type &start, std::function<bool(key_type)> is_goal) const;
+
+    search_path astar(const key_type &start, const key_type &target,          std::function<cost_type(key_type)> heuristic) const;
+    search_path astar(const key_type &start, std::function<bool(key_type)> is_goal, std::function<cost_type(key_type)> heuristic) const;
+
+    /// Only terminates on a finite reachable space, or with a bounded number of expansions
+    shortest_paths dijkstra(const key_type &start) const;
+    /// Stops as soon as the shortest path to a goal is known
+    shortest_paths dijkstra(const key_type &start, std::function<bool(key_type)> is_goal) const;
+
+    /// @}
+
+  private:
+    neighbours_function _neighbours;
+    size_type           _max_expansions;
+
+    ///
+    /// @brief State of a search, allocated lazily for each discovered key
+    ///
+    /// The index of a key is its rank of discovery; `keys.size()` is the "no node" value.
+    ///
+    struct explored {
+        typename Index::template map<key_type, size_type> ids;
+        std::vector<key_type>  keys;
+        std::vector<cost_type> distances; /// from the start
+        std::vector<size_type> previous;
+        std::vector<bool>      expanded;  /// the distance of an expanded node is final, for best-first searches
+
+        //! @return the index of @param key and whether it was discovered by this call
+        std::pair<size_type, bool> discover(const key_type &key, cost_type distance, size_type from);
+
+        //! @return the index of @param key, or `keys.size()` if it was not discovered
+        size_type find(const key_type &key) const;
+
+        //! @return the path from the start (index 0) to the node @param target
+        search_path get_path(size_type target) const;
+    };
+
+    /// @brief Breadth-first search of the first node validating @p is_goal
+    search_path first_search(const key_type &start, std::function<bool(key_type)> is_goal) const;
+
+    /// @brief Best-first search ordered by distance, plus @p heuristic when set
+    /// @param goal set to the index of the reached goal, or to `keys.size()` if none was reached
+    explored best_first_search(const key_type &start, std::function<bool(key_type)> is_goal,
+                               std::function<cost_type(key_type)> heuristic, size_type &goal) const;
+
+  public:
+    ///
+    /// @brief Path found by a search algorithm on an @ref implicit_graph
+    ///
+    /// Sequence of `(key, cost of the edge leading to key)`, starting with `(start, 0)`.
+    ///
+    class search_path final : std::vector<std::pair<key_type, cost_type>> {
+        using Container = std::vector<std::pair<key_type, cost_type>>;
+
+      public:
+        using value_type     = typename Container::value_type;
+        using const_iterator = typename Container::const_iterator;
+
+        using Container::begin;
+        using Container::cbegin;
+        using Container::end;
+        using Container::cend;
+        using Container::empty;
+        using Container::size;
+        using Container::front;
+        using Container::back;
+        using Container::operator[];
+        using Container::push_back;
+        using Container::emplace_back;
+
+        cost_type total_cost() const;
+
+        bool contain(const key_type &key) const;
+    };
+
+    ///
+    /// @brief Single-source shortest paths computed on an @ref implicit_graph
+    ///
+    /// Only holds the keys discovered by the search.
+    ///
+    class shortest_paths final {
+        friend shortest_paths implicit_graph::dijkstra(const key_type &, std::function<bool(key_type)>) const;
+
+        explored _explored;
+
+        explicit shortest_paths(explored &&e);
+
+      public:
+        //! @return whether the shortest path to @param key is known
+        bool contain(const key_type &key) const;
+
+        //! @return the distance from the start to @param key, or infinity if it is not known
+        cost_type get_distance(const key_type &key) const;
+
+        //! @return the re-build path from the start node to @param target, empty if it is not known
+        search_path get_path(const key_type &target) const;
+
+        //! @return the number of keys discovered by the search, including the ones left in its frontier
+        [[nodiscard]] size_type size() const noexcept;
+    };
+};
 
 #include "Graph.cpp"
 
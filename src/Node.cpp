@@ -7,15 +7,16 @@
 ///////////////////////////////////
 
 template <class Data, class Cost, class Container, class constContainer>
-basic_node<Data, Cost, Container, constContainer>::edge::edge(const std::weak_ptr<basic_node<Data, Cost, Container, constContainer >> &ptr, Cost c) : _target(ptr),
-    _cost(std::make_shared<Cost>(c)) {}
+basic_node<Data, Cost, Container, constContainer>::edge::edge(basic_node<Data, Cost, Container, constContainer>* ptr, Cost c) : _target(ptr),
+    _cost(c) {}
 
 template <class Data, class Cost, class Container, class constContainer>
-basic_node<Data, Cost, Container, constContainer>::edge::edge(const edge &e) : _target(e._target), _cost(e._cost) {}
+basic_node<Data, Cost, Container, constContainer>::edge::edge(const edge &e) : _target(e._target), _cost(e._cost), _shared_cost(e._shared_cost),
+    _in_position(e._in_position) {}
 
 template <class Data, class Cost, class Container, class constContainer>
-std::tuple<Cost, basic_node<Data, Cost, Container, constContainer >> basic_node<Data, Cost, Container, constContainer>::edge::tie() const {
-    return std::tie(*_cost, *_target.lock().get());
+std::tuple<const Cost&, const basic_node<Data, Cost, Container, constContainer>&> basic_node<Data, Cost, Container, constContainer>::edge::tie() const {
+    return std::tie(cost(), *_target);
 }
 
 template <class Data, class Cost, class Container, class constContainer>
@@ -30,12 +31,12 @@ bool basic_node<Data, Cost, Container, constContainer>::edge::operator==(const e
 
 template <class Data, class Cost, class Container, class constContainer>
 constContainer basic_node<Data, Cost, Container, constContainer>::edge::target() const {
-    return _target.lock()->container_from_this;
+    return _target->container_from_this;
 }
 
 template <class Data, class Cost, class Container, class constContainer>
 Cost & basic_node<Data, Cost, Container, constContainer>::edge::cost() const {
-    return *_cost;
+    return _shared_cost == nullptr ? _cost : *_shared_cost;
 }
 
 ///////////////////////////////////
@@ -43,30 +44,123 @@ Cost & basic_node<Data, Cost, Container, constContainer>::edge::cost() const {
 ///////////////////////////////////
 
 template <class Data, class Cost, class Container, class constContainer>
-std::tuple<Data, std::size_t, std::list<typename basic_node<Data, Cost, Container, constContainer>::edge >> basic_node<Data, Cost, Container, constContainer>::tie() const {
-    return std::tie(_data, _in_degree, _out_edges);
+std::tuple<Data, std::size_t, typename basic_node<Data, Cost, Container, constContainer>::ListEdges> basic_node<Data, Cost, Container, constContainer>::tie() const {
+    return std::tuple<Data, std::size_t, ListEdges>(_data, _in_edges.size(), _out_edges);
 }
 
 template <class Data, class Cost, class Container, class constContainer>
-std::list<typename basic_node<Data, Cost, Container, constContainer>::edge> basic_node<Data, Cost, Container, constContainer>::get_edges() const {
+const typename basic_node<Data, Cost, Container, constContainer>::ListEdges &basic_node<Data, Cost, Container, constContainer>::get_edges() const {
     return _out_edges;
 }
 
 template <class Data, class Cost, class Container, class constContainer>
-void basic_node<Data, Cost, Container, constContainer>::increment_in_degree(int n) {
-    _in_degree += n;
+constexpr std::size_t basic_node<Data, Cost, Container, constContainer>::edges_index_threshold;
+
+template <class Data, class Cost, class Container, class constContainer>
+std::size_t basic_node<Data, Cost, Container, constContainer>::find_edge(const basic_node *target) const {
+    if (!_edges_index.empty()) {
+        typename EdgesIndex::const_iterator it{_edges_index.find(target)};
+        return it == _edges_index.cend() ? _out_edges.size() : it->second;
+    }
+
+    //! Few edges: a linear scan over contiguous memory is cheaper than hashing
+    for (std::size_t i{0}; i < _out_edges.size(); ++i) {
+        if (_out_edges[i]._target == target) {
+            return i;
+        }
+    }
+    return _out_edges.size();
 }
 
 template <class Data, class Cost, class Container, class constContainer>
-void basic_node<Data, Cost, Container, constContainer>::decrement_in_degree(int n) {
-    _in_degree -= n;
+void basic_node<Data, Cost, Container, constContainer>::append_edge(basic_node* target, Cost cost) {
+    _out_edges.emplace_back(target, cost);
+    _out_edges.back()._in_position = target->_in_edges.size();
+    target->_in_edges.push_back(in_edge{this, _out_edges.size() - 1});
 }
 
 template <class Data, class Cost, class Container, class constContainer>
-bool basic_node<Data, Cost, Container, constContainer>::set_edge(constContainer other, std::shared_ptr<Cost> cost) {
-    std::pair<basic_node<Data, Cost, Container, constContainer>::EdgesIterator, bool> new_edge{add_edge(other, *cost)};
+typename basic_node<Data, Cost, Container, constContainer>::EdgesIterator basic_node<Data, Cost, Container, constContainer>::push_edge(basic_node* target, Cost cost) {
+    append_edge(target, cost);
+
+    if (!_edges_index.empty()) {
+        _edges_index.emplace(target, _out_edges.size() - 1);
+    } else if (_out_edges.size() >= edges_index_threshold) {
+        rebuild_edges_index();
+    }
 
-    new_edge.first->_cost = cost;
+    return --_out_edges.end();
+}
+
+template <class Data, class Cost, class Container, class constContainer>
+void basic_node<Data, Cost, Container, constContainer>::erase_edge(std::size_t position) {
+    const bool indexed{!_edges_index.empty()};
+    if (indexed) {
+        _edges_index.erase(_out_edges[position]._target);
+    }
+    _out_edges[position]._target->erase_in_edge(_out_edges[position]._in_position);
+
+    if (position + 1 != _out_edges.size()) {
+        _out_edges[position] = _out_edges.back();
+        _out_edges[position]._target->_in_edges[_out_edges[position]._in_position]._position = position;
+        if (indexed) {
+            _edges_index[_out_edges[position]._target] = position;
+        }
+    }
+    _out_edges.pop_back();
+
+    //! Hysteresis: the index is only dropped well below the threshold
+    if (indexed && _out_edges.size() < edges_index_threshold / 2) {
+        _edges_index.clear();
+    }
+}
+
+template <class Data, class Cost, class Container, class constContainer>
+void basic_node<Data, Cost, Container, constContainer>::rebuild_edges_index() {
+    _edges_index.clear();
+    if (_out_edges.size() >= edges_index_threshold) {
+        _edges_index.reserve(_out_edges.size());
+        for (std::size_t i{0}; i < _out_edges.size(); ++i) {
+            _edges_index.emplace(_out_edges[i]._target, i);
+        }
+    }
+}
+
+template <class Data, class Cost, class Container, class constContainer>
+void basic_node<Data, Cost, Container, constContainer>::reserve_edges(std::size_t out_degree, std::size_t in_degree) {
+    _out_edges.reserve(out_degree);
+    _in_edges.reserve(in_degree);
+    //! The buckets are kept while the index is empty, so building it at the threshold does not rehash
+    if (out_degree >= edges_index_threshold) {
+        _edges_index.reserve(out_degree);
+    }
+}
+
+template <class Data, class Cost, class Container, class constContainer>
+void basic_node<Data, Cost, Container, constContainer>::shrink_to_fit() {
+    _out_edges.shrink_to_fit();
+    _in_edges.shrink_to_fit();
+    if (_edges_index.empty()) {
+        EdgesIndex(_edges_index.get_allocator()).swap(_edges_index);
+    } else {
+        _edges_index.rehash(0);
+    }
+}
+
+template <class Data, class Cost, class Container, class constContainer>
+void basic_node<Data, Cost, Container, constContainer>::erase_in_edge(std::size_t position) {
+    if (position + 1 != _in_edges.size()) {
+        _in_edges[position] = _in_edges.back();
+        _in_edges[position]._source->_out_edges[_in_edges[position]._position]._in_position = position;
+    }
+    _in_edges.pop_back();
+}
+
+template <class Data, class Cost, class Container, class constContainer>
+bool basic_node<Data, Cost, Container, constContainer>::set_edge(constContainer other, Cost* shared_cost) {
+    std::pair<basic_node<Data, Cost, Container, constContainer>::EdgesIterator, bool> new_edge{add_edge(other, *shared_cost)};
+
+    new_edge.first->_shared_cost = shared_cost;
 
     return new_edge.second;
 }
@@ -79,6 +173,14 @@ basic_node<Data, Cost, Container, constContainer>::basic_node() : basic_node(Dat
 template <class Data, class Cost, class Container, class constContainer>
 basic_node<Data, Cost, Container, constContainer>::basic_node(const Data &d) : _data(d) {}
 
+template <class Data, class Cost, class Container, class constContainer>
+basic_node<Data, Cost, Container, constContainer>::basic_node(const Data &d, const EdgesAllocator &alloc) : _out_edges(alloc), _in_edges(alloc),
+    _edges_index(alloc), _data(d) {}
+
+template <class Data, class Cost, class Container, class constContainer>
+basic_node<Data, Cost, Container, constContainer>::basic_node(Data &&d, const EdgesAllocator &alloc) : _out_edges(alloc), _in_edges(alloc),
+    _edges_index(alloc), _data(std::move(d)) {}
+
 template <class Data, class Cost, class Container, class constContainer>
 basic_node<Data, Cost, Container, constContainer>::basic_node(const basic_node &n) {
     *this = n;
@@ -86,9 +188,12 @@ basic_node<Data, Cost, Container, constContainer>::basic_node(const basic_node &
 
 template <class Data, class Cost, class Container, class constContainer>
 basic_node<Data, Cost, Container, constContainer> &basic_node<Data, Cost, Container, constContainer>::operator=(const basic_node &n) {
-    _data               = n._data;
-    _out_edges          = n._out_edges;
-    _in_degree          = n._in_degree;
+    if (this == &n) {
+        return *this;
+    }
+
+    //! Only the data is copied: the edges belong to the graph, which links the copy itself
+    _data = n._data;
     container_from_this = n.container_from_this;
 
     return *this;
@@ -111,35 +216,33 @@ Data basic_node<Data, Cost, Container, constContainer>::get() const {
 
 template <class Data, class Cost, class Container, class constContainer>
 Cost & basic_node<Data, Cost, Container, constContainer>::get_cost(Container other) {
-    std::shared_ptr<basic_node<Data, Cost, Container, constContainer >> ptr(detail::get_value(other, end_container));
+    basic_node<Data, Cost, Container, constContainer>* ptr{detail::get_pointer(other, end_container)};
 
     if (ptr == nullptr) {
         GRAPH_THROW(unexpected_nullptr)
     }
 
-    for (EdgesIterator it{_out_edges.begin()}; it != _out_edges.end(); ++it)
-        if (it->_target.lock() == ptr) {
-            return it->cost();
-        }
+    const std::size_t position{find_edge(ptr)};
+    if (position != _out_edges.size()) {
+        return _out_edges[position].cost();
+    }
 
     //! Link doesn't exist
-    _out_edges.emplace_back(std::weak_ptr<basic_node<Data, Cost, Container, constContainer >> (detail::get_value(other, end_container)), infinity);
-    ptr->increment_in_degree();
-    return (--_out_edges.end())->cost();
+    return push_edge(ptr, infinity)->cost();
 }
 
 template <class Data, class Cost, class Container, class constContainer>
 Cost basic_node<Data, Cost, Container, constContainer>::get_cost(constContainer other) const {
-    std::shared_ptr<basic_node<Data, Cost, Container, constContainer >> ptr(detail::get_value(other, cend_container));
+    basic_node<Data, Cost, Container, constContainer>* ptr{detail::get_pointer(other, cend_container)};
 
     if (ptr == nullptr) {
         GRAPH_THROW(unexpected_nullptr)
     }
 
-    for (auto it = _out_edges.begin(); it != _out_edges.end(); ++it)
-        if (it->_target.lock() == ptr) {
-            return it->cost();
-        }
+    const std::size_t position{find_edge(ptr)};
+    if (position != _out_edges.size()) {
+        return _out_edges[position].cost();
+    }
 
     //! Link doesn't exist
     return infinity;
@@ -165,25 +268,13 @@ void basic_node<Data, Cost, Container, constContainer>::set(const T_data &d) {
 template <class Data, class Cost, class Container, class constContainer>
 template <class T_cost>
 void basic_node<Data, Cost, Container, constContainer>::set_cost(Container other, const T_cost &c) {
-    std::shared_ptr<basic_node<Data, Cost, Container, constContainer >> ptr(detail::get_value(other, end_container));
+    basic_node<Data, Cost, Container, constContainer>* ptr{detail::get_pointer(other, end_container)};
 
     if (ptr == nullptr) {
         GRAPH_THROW(unexpected_nullptr)
     }
 
-    Cost new_cost{static_cast<Cost>(c)};
-    bool existing_edge{false};
-
-    for (EdgesIterator it{_out_edges.begin()}; it != _out_edges.end(); ++it) {
-        if (it->_target.lock() == ptr) {
-            it->cost() = new_cost;
-            existing_edge = true;
-        }
-    }
-
-    if (!existing_edge) {
-        this->add_edge(other, new_cost);
-    }
+    this->add_edge(other, static_cast<Cost>(c));
 }
 
 ///template <class Data, class Cost, class Container, class constContainer>
@@ -216,29 +307,29 @@ bool basic_node<Data, Cost, Container, constContainer>::del_edge(constContainer
 
 template <class Data, class Cost, class Container, class constContainer>
 bool basic_node<Data, Cost, Container, constContainer>::del_edge_if(constContainer other, std::function<bool(const edge &)> predicate) {
-    for (EdgesIterator it{_out_edges.begin()}; it != _out_edges.end(); ) {
-        if (it->_target.lock() == detail::get_value(other, cend_container)) {
-            if (predicate(*it)) {
-                it = _out_edges.erase(it);
-                other->second->decrement_in_degree();
-                return true;
-            }
-            break;
-        }
-        ++it;
+    basic_node<Data, Cost, Container, constContainer>* ptr{detail::get_pointer(other, cend_container)};
+    if (ptr == nullptr) {
+        return false;
     }
 
-    return false;
+    const std::size_t position{find_edge(ptr)};
+    if (position == _out_edges.size() || !predicate(_out_edges[position])) {
+        return false;
+    }
+
+    erase_edge(position);
+    return true;
 }
 
 template <class Data, class Cost, class Container, class constContainer>
 std::size_t basic_node<Data, Cost, Container, constContainer>::clear_edges() {
     const std::size_t NUM{_out_edges.size()};
 
-    for (EdgesIterator it{_out_edges.begin()}; it != _out_edges.end(); ) {
-        it->_target.lock()->decrement_in_degree();
-        it = _out_edges.erase(it);
+    for (EdgesIterator it{_out_edges.begin()}; it != _out_edges.end(); ++it) {
+        it->_target->erase_in_edge(it->_in_position);
     }
+    _out_edges.clear();
+    _edges_index.clear();
 
     return NUM;
 }
@@ -247,25 +338,18 @@ std::size_t basic_node<Data, Cost, Container, constContainer>::clear_edges() {
 
 template <class Data, class Cost, class Container, class constContainer>
 std::pair<std::size_t, std::size_t> basic_node<Data, Cost, Container, constContainer>::degree() const {
-    return std::make_pair(_in_degree, _out_edges.size());
+    return std::make_pair(_in_edges.size(), _out_edges.size());
 }
 
 template <class Data, class Cost, class Container, class constContainer>
 bool basic_node<Data, Cost, Container, constContainer>::existing_adjacent_node(constContainer other) const {
-    std::shared_ptr<basic_node<Data, Cost, Container, constContainer >> ptr(detail::get_value(other, cend_container));
+    basic_node<Data, Cost, Container, constContainer>* ptr{detail::get_pointer(other, cend_container)};
 
     if (ptr == nullptr) {
         return false;
     }
 
-    for (auto it = _out_edges.begin(); it != _out_edges.end(); ++it) {
-        if (it->_target.lock() == ptr) {
-            return true;
-        }
-    }
-
-    //! Link doesn't exist
-    return false;
+    return find_edge(ptr) != _out_edges.size();
 }
 
 template <class Data, class Cost, class Container, class constContainer>
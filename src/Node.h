@@ -5,11 +5,12 @@
 #ifndef ROOT_NODE_H
 #define ROOT_NODE_H
 
-#include <iostream> /// cerr, cout
-#include <list>     /// list
-#include <memory>   /// make_shared, shared_ptr, weak_ptr
-#include <tuple>    /// tie, tuple
-#include <utility>  /// make_pair, move, pair, swap
+#include <iostream>      /// cerr, cout
+#include <memory>        /// make_shared, shared_ptr
+#include <tuple>         /// tie, tuple
+#include <unordered_map> /// unordered_map
+#include <utility>       /// make_pair, move, pair, swap
+#include <vector>        /// vector
 
 #include "detail.hpp"
 
@@ -31,28 +32,32 @@ class basic_node {
     /**
      * @brief Represents an edge in the graph
      *
-     * An edge connects two nodes and has an associated cost.
+     * An edge connects two nodes and has an associated cost. The cost is
+     * stored inline, except for undirected edges whose both directions
+     * share a single slot owned by the graph.
      */
     class edge {
         template <class T, class C, class c1, class c2> friend class basic_node;
-        template <class K, class T, class C, Nature N> friend class graph;
+        template <class K, class T, class C, Nature N, class I> friend class graph;
 
-        std::weak_ptr<basic_node<Data, Cost, Container, constContainer >> _target;
-        std::shared_ptr<Cost> _cost;
+        basic_node<Data, Cost, Container, constContainer>* _target; /// the graph removes in-edges before their node
+        mutable Cost _cost;
+        Cost* _shared_cost{nullptr}; /// slot shared with the opposite direction, if any
+        std::size_t _in_position{0}; /// position of the reverse link in _target->_in_edges
 
         /**
          * @brief Create a tuple representation of the edge for comparison
-         * @return Tuple containing cost and target node
+         * @return Tuple referring to the cost and the target node
          */
-        std::tuple<Cost, basic_node<Data, Cost, Container, constContainer >> tie() const;
+        std::tuple<const Cost&, const basic_node<Data, Cost, Container, constContainer>&> tie() const;
 
       public:
         /**
          * @brief Construct a new edge object
-         * @param ptr Shared pointer to the target node
+         * @param ptr Pointer to the target node
          * @param cost Cost of the edge
          */
-        explicit edge(const std::weak_ptr<basic_node<Data, Cost, Container, constContainer >> &ptr, Cost cost);
+        explicit edge(basic_node<Data, Cost, Container, constContainer>* ptr, Cost cost);
 
         /**
          * @brief Copy constructor
@@ -60,6 +65,13 @@ class basic_node {
          */
         edge(const edge& other);
 
+        /**
+         * @brief Copy assignment operator
+         * @param other Edge to copy
+         * @return Reference to this edge
+         */
+        edge &operator=(const edge& other) = default;
+
         /**
          * @brief Compare edges by cost
          * @param other Edge to compare with
@@ -87,29 +99,67 @@ class basic_node {
         Cost& cost() const;
     };
 
-    using ListEdges = std::list<edge>;
+    using ListEdges = std::vector<edge, detail::allocator<edge>>;
+    using EdgesAllocator = detail::allocator<edge>;
     using EdgesIterator = typename ListEdges::iterator;
     using ConstEdgesIterator = typename ListEdges::const_iterator;
 
   private:
-    template <class K, class T, class C, Nature N> friend class graph;
+    template <class K, class T, class C, Nature N, class I> friend class graph;
 
     ListEdges _out_edges;
 
-    const Cost infinity = std::numeric_limits<Cost>::has_infinity ? std::numeric_limits<Cost>::infinity() :
-                          std::numeric_limits<Cost>::max();
+    //! reverse link of an edge: its source and the position of the edge in the source out-edges
+    struct in_edge {
+        basic_node* _source;
+        std::size_t _position;
+    };
+
+    using ListInEdges = std::vector<in_edge, detail::allocator<in_edge>>;
 
-    std::size_t _in_degree{0};
+    //! edges whose target is this node, kept in sync with the out-edges of their sources
+    ListInEdges _in_edges;
 
-    void increment_in_degree(int n = 1);
-    void decrement_in_degree(int n = 1);
+    //! out-degree from which the position of each edge is hashed by target
+    static constexpr std::size_t edges_index_threshold = 16;
+
+    using EdgesIndex = std::unordered_map<const basic_node*, std::size_t, std::hash<const basic_node*>, std::equal_to<const basic_node*>,
+                                          detail::allocator<std::pair<const basic_node* const, std::size_t>>>;
+
+    //! position of each edge in _out_edges, keyed by target; empty while the node has few edges
+    EdgesIndex _edges_index;
+
+    const Cost infinity = std::numeric_limits<Cost>::has_infinity ? std::numeric_limits<Cost>::infinity() :
+                          std::numeric_limits<Cost>::max();
 
     //! used for UNDIRECTED graphs: same Cost in memory for both directions
-    bool set_edge(constContainer other, std::shared_ptr<Cost> cost);
+    bool set_edge(constContainer other, Cost* shared_cost);
 
     std::tuple<Data, std::size_t, ListEdges> tie() const;
 
-    ListEdges get_edges() const;
+    const ListEdges &get_edges() const;
+
+    //! position of the edge to target in _out_edges, or _out_edges.size() if there is none
+    std::size_t find_edge(const basic_node* target) const;
+
+    //! append an edge whose target is not adjacent yet
+    EdgesIterator push_edge(basic_node* target, Cost cost);
+
+    //! same as push_edge, but leaves _edges_index to be rebuilt once the edges are all appended
+    void append_edge(basic_node* target, Cost cost);
+
+    //! remove the edge at position, swapping the last edge into its place
+    void erase_edge(std::size_t position);
+
+    //! remove the reverse link at position, swapping the last reverse link into its place
+    void erase_in_edge(std::size_t position);
+
+    void rebuild_edges_index();
+
+    //! allocate room for @p out_degree edges from the node and @p in_degree edges to it
+    void reserve_edges(std::size_t out_degree, std::size_t in_degree);
+
+    void shrink_to_fit();
 
     template <class T, class C, class X, class Y>
     friend constexpr bool operator==(const basic_node<T, C, X, Y> &n1, const basic_node<T, C, X, Y> &n2) noexcept;
@@ -163,6 +213,20 @@ class basic_node {
      */
     explicit basic_node(const Data& data);
 
+    /**
+     * @brief Construct with data, allocating the edges with @p alloc
+     * @param data Data to store in the node
+     * @param alloc Allocator of the out-edges
+     */
+    basic_node(const Data& data, const EdgesAllocator& alloc);
+
+    /**
+     * @brief Construct by moving the data, allocating the edges with @p alloc
+     * @param data Data to move into the node
+     * @param alloc Allocator of the out-edges
+     */
+    basic_node(Data&& data, const EdgesAllocator& alloc);
+
     /**
      * @brief Move assignment operator (deleted)
      */
@@ -249,33 +313,28 @@ class basic_node {
      * @return Pair containing iterator to edge and boolean indicating if new edge was created
      */
     std::pair<EdgesIterator, bool> add_edge(constContainer other, Cost cost = Cost(1)) {
-        std::shared_ptr<basic_node<Data, Cost, Container, constContainer >> ptr{
-            detail::get_value(other, cend_container)
-        };
+        basic_node<Data, Cost, Container, constContainer>* ptr{detail::get_pointer(other, cend_container)};
 
         if (ptr == nullptr) {
             GRAPH_THROW(unexpected_nullptr)
         }
 
-        for (EdgesIterator it{_out_edges.begin()}; it != _out_edges.end(); ++it) {
-            if (it->_target.lock() == ptr) {
-                it->cost() = cost;
-                return std::make_pair(it, false);
-            }
+        const std::size_t position{find_edge(ptr)};
+        if (position != _out_edges.size()) {
+            EdgesIterator it{_out_edges.begin() + static_cast<std::ptrdiff_t>(position)};
+            it->cost() = cost;
+            return std::make_pair(it, false);
         }
 
         // Link doesn't exist
-        ptr->increment_in_degree();
-        _out_edges.emplace_back(
-            std::weak_ptr<basic_node<Data, Cost, Container, constContainer >> (ptr),
-            cost
-        );
-        std::pair<EdgesIterator, bool> result{std::make_pair(--_out_edges.end(), true)};
-        return result;
+        return std::make_pair(push_edge(ptr, cost), true);
     }
 
     /**
      * @brief Delete an edge to another node
+     *
+     * The last edge of the node takes the place of the deleted one.
+     *
      * @param other Const iterator to target node
      * @return true if edge was deleted, false otherwise
      */
@@ -7,6 +7,13 @@
 #include <memory>
 #include <string>
 #include <istream>
+#include <list>
+#include <tuple>
+#include <vector>
+#if defined(GRAPH_HAS_CPP_17)
+    #include <memory_resource>
+    #include <string_view>
+#endif
 
 //! allow to disable exceptions
 #if (defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)) && not defined(GRAPH_NOEXCEPTION)
@@ -24,8 +31,13 @@
     #define GRAPH_CATCH(exception) if (false)
 #endif
 
-#include <functional> /// function
-#include <limits>     /// numeric_limits
+#include <algorithm>          /// fill, max, sort, lower_bound
+#include <condition_variable> /// condition_variable
+#include <exception>          /// exception_ptr, current_exception, rethrow_exception
+#include <functional>         /// function
+#include <limits>             /// numeric_limits
+#include <mutex>              /// mutex, lock_guard
+#include <thread>             /// thread, hardware_concurrency
 #include <sstream>
 
 /// #define COUNT_ARGS(...) std::tuple_size<decltype(std::make_tuple(__VA_ARGS__))>::value
@@ -486,6 +498,18 @@ namespace detail {
     template <Nature> struct is_undirected             : std::false_type { };
     template <>       struct is_undirected<UNDIRECTED> : std::true_type  { };
 
+    ///
+    /// @brief Allocator of the nodes, the edges and the containers of a graph
+    ///
+    /// Since C++17 it is polymorphic, so that a whole graph can be built on
+    /// one `std::pmr::memory_resource` such as a monotonic arena.
+    ///
+#if defined(GRAPH_HAS_CPP_17)
+    template <class T> using allocator = std::pmr::polymorphic_allocator<T>;
+#else
+    template <class T> using allocator = std::allocator<T>;
+#endif
+
 #include <utility>
 
     //! distinguish value type between map::iterator and shared_ptr: @see https://stackoverflow.com/a/31409532
@@ -517,6 +541,109 @@ namespace detail {
         return (*v).second;
     }
 
+    /// @brief Whether the lookups of the associative container @p Map accept any key comparable to its own
+    template <typename Map, typename = void>
+    struct has_transparent_compare : std::false_type { };
+
+    template <typename Map>
+    struct has_transparent_compare<Map, void_t<typename Map::key_compare::is_transparent> > : std::true_type { };
+
+    template <typename Map, typename = void>
+    struct has_transparent_hash : std::false_type { };
+
+    template <typename Map>
+    struct has_transparent_hash<Map, void_t<typename Map::hasher::is_transparent> > : std::true_type { };
+
+    template <typename Map>
+    struct is_transparent_map : std::integral_constant<bool, has_transparent_compare<Map>::value || has_transparent_hash<Map>::value> { };
+
+    //! distinguish containers able to allocate room for their elements up front
+    template <typename T, typename = void>
+    struct has_reserve : std::false_type { };
+
+    template <typename T>
+    struct has_reserve<T, void_t<decltype(std::declval<T&>().reserve(std::size_t()))> > : std::true_type { };
+
+    template <class C>
+    void reserve(C &c, std::size_t n, std::true_type) { c.reserve(n); }
+    template <class C>
+    void reserve(C &, std::size_t, std::false_type) {}
+
+    /// reserve room for @p n elements when the container supports it, like `std::vector`; do nothing otherwise, like `std::map`
+    template <class C>
+    void reserve(C &c, std::size_t n) { reserve(c, n, has_reserve<C>()); }
+
+    template <typename T, typename = void>
+    struct has_shrink_to_fit : std::false_type { };
+
+    template <typename T>
+    struct has_shrink_to_fit<T, void_t<decltype(std::declval<T&>().shrink_to_fit())> > : std::true_type { };
+
+    template <class C>
+    void shrink_to_fit(C &c, std::true_type) { c.shrink_to_fit(); }
+    template <class C>
+    void shrink_to_fit(C &, std::false_type) {}
+
+    /// give back the unused memory when the container supports it
+    template <class C>
+    void shrink_to_fit(C &c) { shrink_to_fit(c, has_shrink_to_fit<C>()); }
+
+    /// @brief Whether a callable of type @p F can be called with an @p Arg, and its result converted to @p R
+    template <typename F, typename Arg, typename R, typename = void>
+    struct is_callable_as : std::false_type { };
+
+    template <typename F, typename Arg, typename R>
+    struct is_callable_as<F, Arg, R, void_t<decltype(std::declval<F&>()(std::declval<Arg>()))> >
+            : std::is_convertible<decltype(std::declval<F&>()(std::declval<Arg>())), R> { };
+
+    /// map iterator: raw pointer to the mapped object, without copying a smart pointer
+    template <class V, class = typename std::enable_if<is_map_iterator<V>::value>::type>
+    typename std::pointer_traits<typename std::iterator_traits<V>::value_type::second_type>::element_type*
+    get_pointer(const V &v, const V &end) {
+        if (v == end || (*v).second == nullptr) {
+            return nullptr;
+        }
+        return &*(*v).second;
+    }
+
+    /// @brief Dense positions of @p keys sorted by key, for the lookups of @ref find_index
+    /// @return an empty permutation when @p keys already is sorted, like the keys of an ordered index
+    template <class Key>
+    std::vector<std::size_t> sorted_permutation(const std::vector<Key> &keys) {
+        std::vector<std::size_t> sorted;
+        if (!std::is_sorted(keys.cbegin(), keys.cend())) {
+            sorted.resize(keys.size());
+            for (std::size_t i{0}; i < keys.size(); ++i) {
+                sorted[i] = i;
+            }
+            std::sort(sorted.begin(), sorted.end(), [&keys](std::size_t lhs, std::size_t rhs) {
+                return keys[lhs] < keys[rhs];
+            });
+        }
+        return sorted;
+    }
+
+    /// @brief Binary search of @p k in @p keys, through the permutation @p sorted unless it is empty
+    /// @return the position of @p k in @p keys, or `keys.size()` if it is absent
+    template <class Key>
+    std::size_t find_index(const std::vector<Key> &keys, const std::vector<std::size_t> &sorted, const Key &k) {
+        if (!sorted.empty()) {
+            typename std::vector<std::size_t>::const_iterator it{std::lower_bound(sorted.cbegin(), sorted.cend(), k, [&keys](std::size_t i, const Key & key) {
+                return keys[i] < key;
+            })};
+            if (it == sorted.cend() || k < keys[*it]) {
+                return keys.size();
+            }
+            return *it;
+        }
+
+        typename std::vector<Key>::const_iterator it{std::lower_bound(keys.cbegin(), keys.cend(), k)};
+        if (it == keys.cend() || k < *it) {
+            return keys.size();
+        }
+        return static_cast<std::size_t>(it - keys.cbegin());
+    }
+
 #include <cxxabi.h> /// demangled_name, abi::__cxa_demangle
 
     ///
@@ -591,6 +718,657 @@ namespace detail {
         }
         return is;
     }
+
+    ///
+    /// @brief Hash of the keys of @ref unordered_index
+    ///
+    /// `std::hash<Key>`, made transparent for `std::string` keys under C++17 so that they can be looked up
+    /// from a `std::string_view` or a C string without building a `std::string`.
+    ///
+    template <class Key>
+    struct key_hash : std::hash<Key> { };
+
+#if defined(GRAPH_HAS_CPP_17)
+    template <>
+    struct key_hash<std::string> {
+        using is_transparent = void;
+
+        std::size_t operator()(std::string_view s) const noexcept {
+            return std::hash<std::string_view>()(s);
+        }
+    };
+#endif
+
+    ///
+    /// @brief Associative container hashing its keys with open addressing
+    ///
+    /// The elements are kept in a `std::list`, in insertion order, so that
+    /// iterators are bidirectional and remain valid until their element is
+    /// erased, as with `std::map`. A linear-probing table of list iterators,
+    /// at most half full, maps each key to its element.
+    ///
+    /// @tparam Key type of the keys, hashed by @p Hash and compared with `==`
+    /// @tparam Value type of the mapped values
+    ///
+    /// @since version 1.2
+    ///
+    template <class Key, class Value, class Hash = std::hash<Key>>
+    class hash_map {
+      public:
+        using key_type               = Key;
+        using mapped_type            = Value;
+        using value_type             = std::pair<const Key, Value>;
+        using size_type              = std::size_t;
+        using hasher                 = Hash;
+        using iterator               = typename std::list<value_type, allocator<value_type>>::iterator;
+        using const_iterator         = typename std::list<value_type, allocator<value_type>>::const_iterator;
+        using reverse_iterator       = typename std::list<value_type, allocator<value_type>>::reverse_iterator;
+        using const_reverse_iterator = typename std::list<value_type, allocator<value_type>>::const_reverse_iterator;
+        using allocator_type         = allocator<value_type>;
+
+        hash_map() = default;
+        explicit hash_map(const allocator_type &alloc) : _elements(alloc), _slots(alloc) {}
+        hash_map(const hash_map &other) : _elements(other._elements), _hash(other._hash) {
+            rehash(_elements.size());
+        }
+        hash_map(hash_map &&) noexcept = default;
+        //! The assignments of the list would assign the `const Key` of the elements in place: they are rebuilt instead
+        hash_map &operator=(const hash_map &other) {
+            if (this != &other) {
+                _elements.clear();
+                for (const value_type &v : other._elements) {
+                    _elements.emplace_back(v);
+                }
+                _hash = other._hash;
+                rehash(_elements.size());
+            }
+            return *this;
+        }
+        hash_map &operator=(hash_map &&other) {
+            if (this != &other) {
+                _elements.clear();
+                _hash = std::move(other._hash);
+                if (_elements.get_allocator() == other._elements.get_allocator()) {
+                    //! The nodes change hands: the iterators of the table stay valid
+                    _elements.splice(_elements.end(), other._elements);
+                    _slots = std::move(other._slots);
+                    other._slots.clear();
+                } else {
+                    //! With different resources the elements are moved one by one: their iterators change
+                    for (value_type &v : other._elements) {
+                        _elements.emplace_back(std::move(v));
+                    }
+                    other.clear();
+                    rehash(_elements.size());
+                }
+            }
+            return *this;
+        }
+
+        iterator               begin()         noexcept { return _elements.begin();   }
+        const_iterator         begin()   const noexcept { return _elements.begin();   }
+        const_iterator         cbegin()  const noexcept { return _elements.cbegin();  }
+        iterator               end()           noexcept { return _elements.end();     }
+        const_iterator         end()     const noexcept { return _elements.end();     }
+        const_iterator         cend()    const noexcept { return _elements.cend();    }
+        reverse_iterator       rbegin()        noexcept { return _elements.rbegin();  }
+        const_reverse_iterator rbegin()  const noexcept { return _elements.rbegin();  }
+        const_reverse_iterator crbegin() const noexcept { return _elements.crbegin(); }
+        reverse_iterator       rend()          noexcept { return _elements.rend();    }
+        const_reverse_iterator rend()    const noexcept { return _elements.rend();    }
+        const_reverse_iterator crend()   const noexcept { return _elements.crend();   }
+
+        [[nodiscard]] bool empty()    const noexcept { return _elements.empty();    }
+        [[nodiscard]] size_type size()     const noexcept { return _elements.size();     }
+        [[nodiscard]] size_type max_size() const noexcept { return _elements.max_size(); }
+
+        allocator_type get_allocator() const noexcept { return _elements.get_allocator(); }
+
+        iterator find(const key_type &k) {
+            const size_type slot{find_slot(k)};
+            return slot == npos ? _elements.end() : _slots[slot].element;
+        }
+        const_iterator find(const key_type &k) const {
+            const size_type slot{find_slot(k)};
+            return slot == npos ? _elements.cend() : const_iterator(_slots[slot].element);
+        }
+        size_type count(const key_type &k) const {
+            return find_slot(k) == npos ? 0 : 1;
+        }
+
+        //! heterogeneous lookups, when the @ref hasher is transparent: @p k is hashed and compared as is
+        template <class K, class H = Hash, class = typename H::is_transparent>
+        iterator find(const K &k) {
+            const size_type slot{find_slot(k)};
+            return slot == npos ? _elements.end() : _slots[slot].element;
+        }
+        template <class K, class H = Hash, class = typename H::is_transparent>
+        const_iterator find(const K &k) const {
+            const size_type slot{find_slot(k)};
+            return slot == npos ? _elements.cend() : const_iterator(_slots[slot].element);
+        }
+        template <class K, class H = Hash, class = typename H::is_transparent>
+        size_type count(const K &k) const {
+            return find_slot(k) == npos ? 0 : 1;
+        }
+
+        template <class... Args>
+        std::pair<iterator, bool> emplace(const key_type &k, Args &&... args) {
+            return emplace_key(k, std::forward<Args>(args)...);
+        }
+        //! @p k is only moved from if it is inserted
+        template <class... Args>
+        std::pair<iterator, bool> emplace(key_type &&k, Args &&... args) {
+            return emplace_key(std::move(k), std::forward<Args>(args)...);
+        }
+        std::pair<iterator, bool> insert(const value_type &val) {
+            return emplace(val.first, val.second);
+        }
+        //! the position is only a hint, as for `std::map`: new elements are appended
+        iterator insert(const_iterator, const value_type &val) {
+            return insert(val).first;
+        }
+
+        iterator erase(const_iterator position) {
+            unplace(position);
+            return _elements.erase(position);
+        }
+        iterator erase(const_iterator first, const_iterator last) {
+            for (const_iterator it{first}; it != last; ++it) {
+                unplace(it);
+            }
+            return _elements.erase(first, last);
+        }
+        size_type erase(const key_type &k) {
+            const_iterator it{find(k)};
+            if (it == _elements.cend()) {
+                return 0;
+            }
+            erase(it);
+            return 1;
+        }
+
+        void clear() noexcept {
+            _elements.clear();
+            _slots.clear();
+        }
+
+        //! allocate the table for @p n elements without any further rehash
+        void reserve(size_type n) {
+            if (2 * n > _slots.size()) {
+                size_type capacity{16};
+                while (capacity < 2 * n) {
+                    capacity *= 2;
+                }
+                rehash(capacity / 2);
+            }
+        }
+
+        //! reallocate the table to fit the current number of elements
+        void shrink_to_fit() {
+            std::vector<slot, allocator<slot>>(_slots.get_allocator()).swap(_slots);
+            rehash(_elements.size());
+        }
+
+        void swap(hash_map &other) noexcept {
+            _elements.swap(other._elements);
+            _slots.swap(other._slots);
+            std::swap(_hash, other._hash);
+        }
+
+      private:
+        struct slot {
+            std::size_t hash{0}; /// 0 marks an empty slot
+            iterator    element;
+        };
+
+        static constexpr size_type npos = static_cast<size_type>(-1);
+
+        std::list<value_type, allocator<value_type>> _elements;
+        std::vector<slot, allocator<slot>>           _slots; /// size is zero or a power of two
+        hasher                _hash;
+
+        template <class K>
+        std::size_t hash(const K &k) const {
+            const std::size_t h{_hash(k)};
+            return h == 0 ? 1 : h;
+        }
+
+        template <class K>
+        size_type find_slot(const K &k) const {
+            return _slots.empty() ? npos : find_slot(k, hash(k));
+        }
+        template <class K>
+        size_type find_slot(const K &k, std::size_t h) const {
+            if (_slots.empty()) {
+                return npos;
+            }
+            const size_type mask{_slots.size() - 1};
+            for (size_type i{h & mask}; _slots[i].hash != 0; i = (i + 1) & mask) {
+                if (_slots[i].hash == h && _slots[i].element->first == k) {
+                    return i;
+                }
+            }
+            return npos;
+        }
+
+        template <class K, class... Args>
+        std::pair<iterator, bool> emplace_key(K &&k, Args &&... args) {
+            const std::size_t h{hash(k)};
+            const size_type slot{find_slot(k, h)};
+            if (slot != npos) {
+                return std::make_pair(_slots[slot].element, false);
+            }
+
+            reserve(_elements.size() + 1);
+            _elements.emplace_back(std::piecewise_construct, std::forward_as_tuple(std::forward<K>(k)), std::forward_as_tuple(std::forward<Args>(args)...));
+            place(h, --_elements.end());
+            return std::make_pair(--_elements.end(), true);
+        }
+
+        void place(std::size_t h, iterator element) {
+            const size_type mask{_slots.size() - 1};
+            size_type i{h & mask};
+            while (_slots[i].hash != 0) {
+                i = (i + 1) & mask;
+            }
+            _slots[i].hash    = h;
+            _slots[i].element = element;
+        }
+
+        //! backward-shift deletion: no tombstone is left in the table
+        void unplace(const_iterator element) {
+            const size_type mask{_slots.size() - 1};
+            size_type i{find_slot(element->first)};
+            for (size_type j{(i + 1) & mask}; _slots[j].hash != 0; j = (j + 1) & mask) {
+                const size_type home{_slots[j].hash & mask};
+                //! slot j may move back into i only if its home does not lie in (i, j]
+                if (((j - home) & mask) >= ((j - i) & mask)) {
+                    _slots[i] = _slots[j];
+                    i = j;
+                }
+            }
+            _slots[i].hash = 0;
+        }
+
+        void rehash(size_type n) {
+            size_type capacity{n == 0 ? size_type(0) : size_type(16)};
+            while (capacity < 2 * n) {
+                capacity *= 2;
+            }
+
+            _slots.assign(capacity, slot());
+            for (iterator it{_elements.begin()}; it != _elements.end(); ++it) {
+                place(hash(it->first), it);
+            }
+        }
+    };
+
+    template <class Key, class Value, class Hash>
+    constexpr typename hash_map<Key, Value, Hash>::size_type hash_map<Key, Value, Hash>::npos;
+
+    ///
+    /// @brief Min-heap of dense ids with decrease-key
+    ///
+    /// Each id is at most once in the heap, and its position is tracked so that its priority can be lowered in place
+    /// instead of pushing a duplicate entry. With an arity @p D of 4 the heap is shallower than a binary one and the
+    /// children of a node share a cache line.
+    ///
+    /// @tparam Priority totally ordered by `operator<`
+    /// @tparam D the number of children of each node of the heap
+    ///
+    template <class Priority, std::size_t D = 4>
+    class indexed_heap {
+        static_assert(D >= 2, "An indexed heap needs at least two children per node");
+
+      public:
+        using size_type = std::size_t;
+
+        static constexpr size_type npos = std::numeric_limits<size_type>::max();
+
+        /// @param n the expected bound of the ids; larger ids are still accepted
+        explicit indexed_heap(size_type n = 0) : _positions(n, npos) {}
+
+        bool      empty() const noexcept { return _heap.empty(); }
+        size_type size()  const noexcept { return _heap.size(); }
+
+        /// @return whether @p id is waiting in the heap
+        bool contains(size_type id) const noexcept { return id < _positions.size() && _positions[id] != npos; }
+
+        /// @return the id of smallest priority
+        size_type       top()          const { return _heap.front().id; }
+        const Priority &top_priority() const { return _heap.front().priority; }
+
+        /// @brief Insert @p id, or lower its priority if it is already waiting
+        /// @return false if @p id was already waiting with a priority lower than or equal to @p priority
+        bool push(size_type id, const Priority &priority) {
+            if (id >= _positions.size()) {
+                _positions.resize(id + 1, npos);
+            }
+
+            size_type position{_positions[id]};
+            if (position == npos) {
+                position = _heap.size();
+                _heap.push_back(entry{priority, id});
+            } else if (priority < _heap[position].priority) {
+                _heap[position].priority = priority;
+            } else {
+                return false;
+            }
+            sift_up(position);
+            return true;
+        }
+
+        /// @brief Remove the id of smallest priority
+        /// @return the removed id
+        size_type pop() {
+            const size_type id{_heap.front().id};
+            _positions[id] = npos;
+
+            if (_heap.size() > 1) {
+                _heap.front() = std::move(_heap.back());
+                _heap.pop_back();
+                sift_down(0);
+            } else {
+                _heap.pop_back();
+            }
+            return id;
+        }
+
+        void clear() noexcept {
+            for (const entry &e : _heap) {
+                _positions[e.id] = npos;
+            }
+            _heap.clear();
+        }
+
+      private:
+        struct entry {
+            Priority  priority;
+            size_type id;
+        };
+
+        std::vector<entry>     _heap;
+        std::vector<size_type> _positions;
+
+        void place(entry &&e, size_type position) {
+            _positions[e.id] = position;
+            _heap[position]  = std::move(e);
+        }
+
+        void sift_up(size_type position) {
+            entry e{std::move(_heap[position])};
+            while (position > 0) {
+                const size_type parent{(position - 1) / D};
+                if (!(e.priority < _heap[parent].priority)) {
+                    break;
+                }
+                place(std::move(_heap[parent]), position);
+                position = parent;
+            }
+            place(std::move(e), position);
+        }
+
+        void sift_down(size_type position) {
+            entry e{std::move(_heap[position])};
+            for (;;) {
+                const size_type first{position * D + 1};
+                if (first >= _heap.size()) {
+                    break;
+                }
+
+                size_type smallest{first};
+                const size_type last{first + D < _heap.size() ? first + D : _heap.size()};
+                for (size_type child{first + 1}; child < last; ++child) {
+                    if (_heap[child].priority < _heap[smallest].priority) {
+                        smallest = child;
+                    }
+                }
+                if (!(_heap[smallest].priority < e.priority)) {
+                    break;
+                }
+                place(std::move(_heap[smallest]), position);
+                position = smallest;
+            }
+            place(std::move(e), position);
+        }
+    };
+
+    template <class Priority, std::size_t D>
+    constexpr typename indexed_heap<Priority, D>::size_type indexed_heap<Priority, D>::npos;
+
+    ///
+    /// @brief Monotone priority queue of unsigned integral keys
+    ///
+    /// Every pushed key must be greater than or equal to the last popped one, as the distances settled by Dijkstra's
+    /// algorithm. The elements are spread in buckets by the highest bit that differs from the last popped key:
+    /// each element moves down at most once per bit, for an amortized O(log C) per operation where C is the largest
+    /// key, without any comparison between the elements.
+    ///
+    /// There is no decrease-key: an outdated element is simply pushed again with its lower key.
+    ///
+    template <class Key, class Value>
+    class radix_heap {
+        static_assert(std::is_unsigned<Key>::value, "A radix heap needs unsigned integral keys");
+
+      public:
+        using size_type  = std::size_t;
+        using value_type = std::pair<Key, Value>;
+
+        radix_heap() : _buckets(std::numeric_limits<Key>::digits + 1) {}
+
+        bool      empty() const noexcept { return _size == 0; }
+        size_type size()  const noexcept { return _size; }
+
+        /// @pre @p key is not lower than the last popped key
+        void push(Key key, const Value &value) {
+            _buckets[bucket(key)].emplace_back(key, value);
+            ++_size;
+        }
+
+        /// @brief Remove an element of smallest key
+        /// @return the removed element
+        value_type pop() {
+            if (_buckets[0].empty()) {
+                size_type i{1};
+                while (_buckets[i].empty()) {
+                    ++i;
+                }
+
+                /// the smallest key of the first non-empty bucket becomes the reference of the redistribution
+                _last = _buckets[i].front().first;
+                for (const value_type &e : _buckets[i]) {
+                    if (e.first < _last) {
+                        _last = e.first;
+                    }
+                }
+                for (value_type &e : _buckets[i]) {
+                    _buckets[bucket(e.first)].push_back(std::move(e));
+                }
+                _buckets[i].clear();
+            }
+
+            value_type e{std::move(_buckets[0].back())};
+            _buckets[0].pop_back();
+            --_size;
+            return e;
+        }
+
+      private:
+        std::vector<std::vector<value_type>> _buckets;
+        Key                                  _last = 0;
+        size_type                            _size = 0;
+
+        /// 0 for the keys equal to the last popped one, else the number of bits up to the highest differing one
+        size_type bucket(Key key) const noexcept {
+            unsigned long long diff{static_cast<unsigned long long>(key ^ _last)};
+#if defined(__GNUC__) || defined(__clang__)
+            return diff == 0 ? 0 : size_type(std::numeric_limits<unsigned long long>::digits - __builtin_clzll(diff));
+#else
+            size_type n{0};
+            for (; diff != 0; diff >>= 1) {
+                ++n;
+            }
+            return n;
+#endif
+        }
+    };
+
+    ///
+    /// @brief Shared pointer that can be replaced by one thread while others read it
+    ///
+    /// The lock is only held to copy the pointer: the pointed object is then used without any synchronisation,
+    /// and stays alive as long as a reader holds it.
+    ///
+    template <class T>
+    class shared_slot {
+      public:
+        shared_slot() = default;
+        shared_slot(const shared_slot &other) : _ptr(other.load()) {}
+        shared_slot &operator=(const shared_slot &other) {
+            store(other.load());
+            return *this;
+        }
+
+        std::shared_ptr<const T> load() const {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _ptr;
+        }
+        void store(std::shared_ptr<const T> ptr) {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _ptr.swap(ptr);
+            }
+            /// the previous object is released out of the lock
+        }
+        void swap(shared_slot &other) {
+            std::shared_ptr<const T> ptr{load()};
+            store(other.load());
+            other.store(std::move(ptr));
+        }
+
+      private:
+        mutable std::mutex       _mutex;
+        std::shared_ptr<const T> _ptr;
+    };
+
+    ///
+    /// @brief Fixed set of threads running the same task, one call per thread, in lockstep phases
+    ///
+    /// The calling thread takes part in every phase as the thread 0, so a pool of size 1 has no worker and runs inline.
+    /// The workers are started by the first phase and parked between the phases, which is much cheaper than starting
+    /// threads each time, and free when no phase is run.
+    ///
+    class thread_pool {
+      public:
+        using size_type = std::size_t;
+
+        /// @param nbr_threads the number of threads of a phase, including the calling one; 0 for the number of cores
+        /// @param nbr_shares the number of shares worth a thread in the work of a phase: there are not more threads
+        explicit thread_pool(size_type nbr_threads, size_type nbr_shares = std::numeric_limits<size_type>::max()) {
+            if (nbr_threads == 0) {
+                nbr_threads = std::thread::hardware_concurrency();
+            }
+            _errors.resize(std::max<size_type>(std::min(nbr_threads, nbr_shares), 1));
+        }
+
+        thread_pool(const thread_pool &) = delete;
+        thread_pool &operator=(const thread_pool &) = delete;
+
+        ~thread_pool() {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _stop = true;
+            }
+            _start.notify_all();
+            for (std::thread &t : _workers) {
+                t.join();
+            }
+        }
+
+        /// @return the number of threads of a phase
+        size_type size() const noexcept { return _errors.size(); }
+
+        /// @brief Call @p task with every thread id in `[0, size())`, each on its own thread, and wait for all the calls
+        /// @throw the exception thrown by the call of the lowest thread id, once every call has returned
+        void run(const std::function<void(size_type)> &task) {
+            for (size_type id{_workers.size() + 1}; id < size(); ++id) {
+                _workers.emplace_back(&thread_pool::work, this, id);
+            }
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _task    = &task;
+                _pending = _workers.size();
+                ++_generation;
+            }
+            _start.notify_all();
+
+            call(task, 0);
+
+            /// the workers refer to @p task until the end of their calls: always wait for them, even after a failure
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _done.wait(lock, [this] { return _pending == 0; });
+                _task = nullptr;
+            }
+
+            for (std::exception_ptr &error : _errors) {
+                if (error) {
+                    std::exception_ptr first{std::move(error)};
+                    std::fill(_errors.begin(), _errors.end(), nullptr);
+                    std::rethrow_exception(first);
+                }
+            }
+        }
+
+      private:
+        std::vector<std::thread> _workers;
+        std::mutex               _mutex;
+        std::condition_variable  _start;
+        std::condition_variable  _done;
+        /// exception thrown by the call of each thread id in the current phase, if any
+        std::vector<std::exception_ptr> _errors;
+
+        const std::function<void(size_type)>* _task = nullptr;
+        size_type                             _generation = 0;
+        size_type                             _pending = 0;
+        bool                                  _stop = false;
+
+        void work(size_type id) {
+            size_type seen{0};
+            for (;;) {
+                const std::function<void(size_type)>* task;
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    _start.wait(lock, [this, seen] { return _stop || _generation != seen; });
+                    if (_stop) {
+                        return;
+                    }
+                    seen = _generation;
+                    task = _task;
+                }
+
+                call(*task, id);
+
+                bool last;
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    last = --_pending == 0;
+                }
+                if (last) {
+                    _done.notify_one();
+                }
+            }
+        }
+
+        void call(const std::function<void(size_type)> &task, size_type id) {
+            GRAPH_TRY {
+                task(id);
+            } GRAPH_CATCH(...) {
+                _errors[id] = std::current_exception();
+            }
+        }
+    };
 } /// namespace detail
 
 #endif /// ROOT_DETAIL_H
@@ -0,0 +1,31 @@
+//
+// Memory resource shared by the allocator tests
+//
+
+#ifndef ROOT_TEST_COUNTING_RESOURCE_H
+#define ROOT_TEST_COUNTING_RESOURCE_H
+
+#if defined(GRAPH_HAS_CPP_17)
+    #include <memory_resource>
+
+    //! Counts the allocations and the bytes still allocated from the upstream resource
+    struct counting_resource : std::pmr::memory_resource {
+        std::size_t allocations{0};
+        std::size_t allocated{0};
+
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+            ++allocations;
+            allocated += bytes;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+        void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+            allocated -= bytes;
+            std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+        }
+        bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+            return this == &other;
+        }
+    };
+#endif
+
+#endif // ROOT_TEST_COUNTING_RESOURCE_H
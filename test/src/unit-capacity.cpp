@@ -10,6 +10,8 @@
     #include "Graph.h"
 #endif
 
+#include "counting-resource.hpp"
+
 TEST_CASE("capacity") {
     using namespace std;
 
@@ -48,4 +50,102 @@ TEST_CASE("capacity") {
 
         CHECK(g.max_size() >= g.size());
     }
+
+    SECTION("reserve_nodes()") {
+        graph<string, int> ordered;
+        ordered.reserve_nodes(100);
+        CHECK(ordered.empty());
+
+        graph_unordered<string, int, size_t, DIRECTED> g;
+        g.reserve_nodes(1000);
+        CHECK(g.empty());
+        for (int i{0}; i < 1000; ++i) {
+            g["node " + to_string(i)] = i;
+        }
+        CHECK(g.size() == 1000);
+        CHECK(g["node 500"] == 500);
+    }
+
+    SECTION("reserve_edges()") {
+        graph_directed<string, int, int> g;
+        g.reserve_edges("hub", 100);
+        CHECK(g.size() == 1);
+        CHECK(g.degree("hub") == make_pair<size_t, size_t>(0, 0));
+        g.reserve_edges(g.cend(), 100);
+        CHECK(g.size() == 1);
+
+        for (int i{0}; i < 100; ++i) {
+            g("hub", "node " + to_string(i)) = i;
+        }
+        CHECK(g.get_nbr_edges() == 100);
+        CHECK(g("hub", "node 42") == 42);
+        CHECK(g.existing_edge("hub", "node 99"));
+    }
+
+    SECTION("shrink_to_fit()") {
+        graph_undirected<string, int, int> g;
+        for (int i{0}; i < 100; ++i) {
+            g("hub", "node " + to_string(i)) = i;
+            g("node " + to_string(i), "node " + to_string((i + 1) % 100)) = 1000 + i;
+        }
+        for (int i{0}; i < 100; i += 2) {
+            g.del_edge("hub", "node " + to_string(i));
+        }
+        graph_undirected<string, int, int> expected{g};
+
+        g.shrink_to_fit();
+        CHECK(g == expected);
+        CHECK(g.get_nbr_edges() == 150);
+
+        //! the costs are still shared by both directions
+        g("node 1", "hub") = 7;
+        CHECK(g("hub", "node 1") == 7);
+        g("node 2", "node 3") = 8;
+        CHECK(g("node 3", "node 2") == 8);
+        g("hub", "node 2") = 9;
+        CHECK(g("node 2", "hub") == 9);
+        CHECK(g.get_nbr_edges() == 151);
+
+        graph_unordered<string, int, int, DIRECTED> h;
+        for (int i{0}; i < 1000; ++i) {
+            h("node " + to_string(i), "node " + to_string(i + 1)) = i;
+        }
+        for (int i{0}; i < 1000; i += 2) {
+            h.erase("node " + to_string(i));
+        }
+        CHECK(h.get_nbr_edges() == 1);
+        h.shrink_to_fit();
+        CHECK(h.size() == 501);
+        CHECK(h.find("node 501") != h.cend());
+        CHECK(h.find("node 502") == h.cend());
+        h("node 501", "node 503") = 501;
+        CHECK(h.existing_edge("node 501", "node 503"));
+    }
+
+#if defined(GRAPH_HAS_CPP_17)
+    SECTION("reserved allocations") {
+        //! The same ingestion, with and without reserving room for it
+        counting_resource unreserved_resource, resource;
+        graph_unordered<int, int, int, DIRECTED> unreserved(&unreserved_resource), g(&resource);
+        g.reserve_nodes(1000);
+        g.reserve_edges(0, 999);
+        unreserved.add_node(0);
+        for (int i{1}; i < 1000; ++i) {
+            unreserved.add_edge(0, i, i);
+            g.add_edge(0, i, i);
+        }
+        CHECK(g == unreserved);
+        CHECK(resource.allocations < unreserved_resource.allocations);
+
+        const size_t full{resource.allocated};
+        for (int i{1}; i < 1000; ++i) {
+            g.erase(i);
+        }
+        const size_t deleted{resource.allocated};
+        CHECK(deleted < full);
+        g.shrink_to_fit();
+        CHECK(resource.allocated < deleted);
+        CHECK(g.degree(0) == make_pair<size_t, size_t>(0, 0));
+    }
+#endif
 }
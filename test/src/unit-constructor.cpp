@@ -12,6 +12,8 @@
     #include "Graph.h"
 #endif
 
+#include "counting-resource.hpp"
+
 /**
  * TODO
  * initializations with personal objects (finish structs ; do class, ...)
@@ -39,6 +41,53 @@ struct std::numeric_limits<cost> {
     }
 };
 
+#if defined(GRAPH_HAS_CPP_17)
+//! Move assignments and swaps of graphs on the same resource or on different ones
+template <class Graph>
+void check_move_and_swap() {
+    counting_resource resource_1, resource_2;
+    Graph g1(&resource_1), g2(&resource_1), g3(&resource_2);
+    g1(1, 2) = 12;
+    g2(3, 4) = 34;
+    g2(4, 5) = 45;
+    g3(6, 7) = 67;
+    const Graph g2_copy{g2};
+
+    //! same resource: the nodes change hands
+    g1 = std::move(g2);
+    CHECK(g1 == g2_copy);
+    CHECK(g2.empty());
+    CHECK(g1.get_in_edges(5).size() == 1);
+    g1(5, 3) = 53;
+    CHECK(g1.get_nbr_edges() == 3);
+
+    //! different resources: the nodes are copied
+    g3 = std::move(g1);
+    CHECK(g1.empty());
+    CHECK(g3.get_allocator().resource() == &resource_2);
+    CHECK(g3.size() == 3);
+    CHECK(g3(4, 5) == 45);
+    CHECK(g3.existing_edge(5, 3));
+
+    Graph g4(&resource_2);
+    g4(8, 9) = 89;
+    std::swap(g3, g4);
+    CHECK(g3.size() == 2);
+    CHECK(g3(8, 9) == 89);
+    CHECK(g4(5, 3) == 53);
+    CHECK(g4.del_node(4));
+    CHECK(g4.get_nbr_edges() == 1);
+
+    Graph g5, g6;
+    g6(1, 2) = 12;
+    std::swap(g5, g6);
+    CHECK(g5(1, 2) == 12);
+    CHECK(g6.empty());
+    g6 = std::move(g5);
+    CHECK(g6.get_nbr_edges() == 1);
+}
+#endif
+
 TEST_CASE("constructors") {
     using namespace std;
 
@@ -388,6 +437,43 @@ TEST_CASE("constructors") {
             }
         }
 
+        SECTION("structural copy") {
+            Graph_undirected initial;
+            initial("hub", "hub") = 1;
+            for (int i{0}; i < 40; ++i) {
+                initial("hub", "node " + to_string(i)) = i;
+            }
+            initial("node 1", "node 2") = 12;
+            initial.del_edge("hub", "node 7");
+
+            Graph_undirected final;
+            final("old", "older") = 3;
+            final = initial;
+            CHECK(final == initial);
+            CHECK(final.get_nbr_edges() == 41);
+            CHECK(final.degree("hub") == initial.degree("hub"));
+            CHECK(final.get_in_edges("node 2").size() == 2);
+            CHECK_FALSE(final.existing_node("old"));
+
+            //! both directions of a copied edge share their cost, and nothing is shared with the original
+            final("node 2", "hub") = 200;
+            CHECK(final("hub", "node 2") == 200);
+            CHECK(initial("hub", "node 2") == 2);
+            final("hub", "hub") = 100;
+            CHECK(final("hub", "hub") == 100);
+            CHECK(initial("hub", "hub") == 1);
+
+            //! the copied high-degree node answers lookups and removals
+            CHECK(final.del_edge("node 30", "hub") == 1);
+            CHECK_FALSE(final.existing_edge("hub", "node 30"));
+            CHECK(final.erase("hub") == 1);
+            CHECK(final.get_nbr_edges() == 1);
+            CHECK(initial.get_nbr_edges() == 41);
+
+            final = final;
+            CHECK(final.size() == 40);
+        }
+
         SECTION("move assignment operator") {
             Graph initial;
             for (int i{0}; i < 100; ++i) {
@@ -407,4 +493,85 @@ TEST_CASE("constructors") {
             CHECK(initial["node 0"] == 0);
         }
     }
+
+#if defined(GRAPH_HAS_CPP_17)
+    SECTION("allocator constructor") {
+        using Graph_directed   = graph_directed  <string, int, int>;
+        using Graph_undirected = graph_undirected<string, int, int>;
+
+        SECTION("nodes, edges and shared costs") {
+            counting_resource resource;
+            {
+                Graph_undirected g(&resource);
+                CHECK(g.get_allocator().resource() == &resource);
+                for (int i{0}; i < 100; ++i) {
+                    g("node " + to_string(i), "node " + to_string((i + 1) % 100)) = i;
+                }
+                CHECK(g.get_nbr_edges() == 100);
+                CHECK(g("node 1", "node 0") == 0);
+                CHECK(resource.allocated > 0);
+
+                const size_t before_copy{resource.allocated};
+                Graph_undirected copy{g};
+                CHECK(copy == g);
+                CHECK(copy.get_allocator().resource() != &resource);
+                CHECK(resource.allocated == before_copy);
+
+                g.clear();
+                CHECK(resource.allocated < before_copy);
+                g("node 1", "node 2") = 12;
+            }
+            CHECK(resource.allocated == 0);
+        }
+
+        SECTION("monotonic arena") {
+            pmr::monotonic_buffer_resource arena;
+            Graph_directed g(&arena);
+            for (int i{1}; i < 1000; ++i) {
+                g("node " + to_string(i), "node " + to_string(i / 2)) = i;
+            }
+            CHECK(g.get_nbr_edges() == 999);
+            CHECK(g.dijkstra("node 999").get_path("node 0").total_cost() == 999 + 499 + 249 + 124 + 62 + 31 + 15 + 7 + 3 + 1);
+        }
+
+        SECTION("different resources") {
+            counting_resource resource_1, resource_2;
+            Graph_directed g1(&resource_1), g2(&resource_2);
+            g1("a", "b") = 1;
+            g2("c", "d") = 2;
+            g2("d", "e") = 3;
+            const Graph_directed g2_copy{g2};
+
+            //! the move assignment copies across the resources, so it may throw
+            CHECK_FALSE(is_nothrow_move_assignable<Graph_directed>::value);
+            CHECK(noexcept(g1.swap(g2)));
+
+            g1 = move(g2);
+            CHECK(g1 == g2_copy);
+            CHECK(g2.empty());
+            CHECK(g1.get_allocator().resource() == &resource_1);
+            CHECK(g1.get_in_edges("e").size() == 1);
+
+            g2 = move(g1);
+            CHECK(g2 == g2_copy);
+            CHECK(g1.empty());
+            CHECK(g2.get_allocator().resource() == &resource_2);
+            CHECK(g2.get_out_edges("c").begin()->target()->first == "d");
+
+            //! swapping needs equal resources
+            Graph_directed g3(&resource_2);
+            g3("f", "g") = 4;
+            g2.swap(g3);
+            CHECK(g2("f", "g") == 4);
+            CHECK(g3 == g2_copy);
+        }
+
+        SECTION("move assignment and swap of every index") {
+            check_move_and_swap<graph_directed  <int, int, int>>();
+            check_move_and_swap<graph_undirected<int, int, int>>();
+            check_move_and_swap<graph_unordered <int, int, int, DIRECTED>>();
+            check_move_and_swap<graph_unordered <int, int, int, UNDIRECTED>>();
+        }
+    }
+#endif
 }
@@ -46,6 +46,18 @@ TEST_CASE("detail") {
         delete ptr;
     }
 
+    SECTION("get_pointer(const V&, const V&)") {
+        map<string, shared_ptr<int>> m;
+        shared_ptr<int> ptr = make_shared<int>(1);
+        auto it = m.emplace("a", ptr).first;
+        m.emplace("b", nullptr);
+        CHECK(is_same<decltype(get_pointer(it, m.end())), int*>::value);
+        CHECK(get_pointer(it, m.end())      == ptr.get());
+        CHECK(get_pointer(m.find("b"), m.end()) == nullptr);
+        CHECK(get_pointer(m.end(), m.end()) == nullptr);
+        CHECK(ptr.use_count() == 2);
+    }
+
     SECTION("type_name<T>()") {
         CHECK(type_name<int>()                == "int");
         CHECK(type_name<float>()              == "float");
@@ -56,6 +68,119 @@ TEST_CASE("detail") {
         CHECK(type_name<std::size_t>()        == "unsigned long");
     }
 
+    SECTION("indexed_heap") {
+        indexed_heap<int, 3> heap(4);
+        CHECK(heap.empty());
+
+        //! ids beyond the initial bound are accepted
+        for (size_t id{0}; id < 100; ++id) {
+            CHECK(heap.push(id, int((id * 37) % 101)));
+        }
+        CHECK(heap.size() == 100);
+        CHECK(heap.contains(99));
+        CHECK_FALSE(heap.contains(100));
+
+        //! decrease-key in place, a higher priority is ignored
+        CHECK(heap.push(50, -1));
+        CHECK_FALSE(heap.push(50, 10));
+        CHECK(heap.size() == 100);
+        CHECK(heap.top() == 50);
+        CHECK(heap.top_priority() == -1);
+        CHECK(heap.pop() == 50);
+        CHECK_FALSE(heap.contains(50));
+
+        int previous{-1};
+        while (!heap.empty()) {
+            const int priority{heap.top_priority()};
+            CHECK(previous <= priority);
+            CHECK(int((heap.pop() * 37) % 101) == priority);
+            previous = priority;
+        }
+
+        heap.push(3, 3);
+        heap.push(2, 2);
+        heap.clear();
+        CHECK(heap.empty());
+        CHECK_FALSE(heap.contains(2));
+    }
+
+    SECTION("radix_heap") {
+        radix_heap<unsigned, int> heap;
+        CHECK(heap.empty());
+
+        heap.push(5, 50);
+        heap.push(1000, 10000);
+        heap.push(5, 51);
+        heap.push(17, 170);
+        CHECK(heap.size() == 4);
+        CHECK(heap.pop().first == 5);
+        CHECK(heap.pop().first == 5);
+
+        //! keys equal to or above the last popped one
+        heap.push(5, 52);
+        heap.push(6, 60);
+        CHECK(heap.pop() == make_pair(5u, 52));
+        CHECK(heap.pop() == make_pair(6u, 60));
+        CHECK(heap.pop() == make_pair(17u, 170));
+
+        //! pseudo-random monotone sequence, with the largest keys
+        unsigned last{1000}, seed{1};
+        heap.push(numeric_limits<unsigned>::max(), 0);
+        for (int i{0}; i < 1000; ++i) {
+            seed = seed * 1103515245u + 12345u;
+            heap.push(last + seed % 100000u, i);
+            if (i % 3 == 0) {
+                const unsigned key{heap.pop().first};
+                CHECK(last <= key);
+                last = key;
+            }
+        }
+        while (!heap.empty()) {
+            const unsigned key{heap.pop().first};
+            CHECK(last <= key);
+            last = key;
+        }
+        CHECK(last == numeric_limits<unsigned>::max());
+    }
+
+    SECTION("thread_pool") {
+        thread_pool pool(4);
+        CHECK(pool.size() == 4);
+
+        vector<int> calls(pool.size(), 0);
+        const function<void(size_t)> count = [&calls](size_t id) { ++calls[id]; };
+        pool.run(count);
+        pool.run(count);
+        CHECK(calls == vector<int>(4, 2));
+
+        //! the exception of a worker, or of the calling thread, is rethrown once every call has returned
+        const function<void(size_t)> fail_worker = [&calls](size_t id) {
+            ++calls[id];
+            if (id == 2) {
+                throw runtime_error("worker");
+            }
+        };
+        CHECK_THROWS_WITH(pool.run(fail_worker), "worker");
+        CHECK(calls == vector<int>(4, 3));
+
+        const function<void(size_t)> fail_all = [&calls](size_t id) {
+            ++calls[id];
+            throw runtime_error("thread " + to_string(id));
+        };
+        CHECK_THROWS_WITH(pool.run(fail_all), "thread 0");
+        CHECK(calls == vector<int>(4, 4));
+
+        //! the pool is still usable after a failed phase
+        pool.run(count);
+        CHECK(calls == vector<int>(4, 5));
+
+        //! not more threads than shares of work, and no thread started before the first phase
+        CHECK(thread_pool(4, 2).size() == 2);
+        CHECK(thread_pool(4, 0).size() == 1);
+        thread_pool idle(0);
+        CHECK(idle.size() >= 1);
+    }
+
     SECTION("basic_degree") {
         basic_degree<DIRECTED> d1(make_pair<std::size_t, std::size_t>(1, 2));
         CHECK(d1 == make_pair<std::size_t, std::size_t>(1, 2));
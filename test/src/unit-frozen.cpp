@@ -0,0 +1,278 @@
+//
+// Created by Terae on 18/10/26.
+//
+
+#include "catch.hpp"
+
+#if defined(TEST_SINGLE_HEADER_FILE)
+    #include "graph.hpp"
+#else
+    #include "Graph.h"
+#endif
+
+#include <atomic>
+#include <thread>
+
+using namespace std;
+
+TEST_CASE("frozen graph") {
+    SECTION("layout") {
+        using Graph = graph_directed<string, int, double>;
+
+        Graph g;
+        g["node 1"] = 1;
+        g["node 2"] = 2;
+        g["node 3"] = 3;
+        g["isolated"] = 4;
+        g("node 1", "node 3") = 13;
+        g("node 1", "node 2") = 12;
+        g("node 2", "node 3") = 23;
+
+        Graph::frozen_graph empty_frozen;
+        CHECK(empty_frozen.empty());
+        CHECK(empty_frozen.size() == 0);
+
+        Graph::frozen_graph f{g.freeze()};
+        CHECK_FALSE(f.empty());
+        CHECK(f.size() == g.size());
+        CHECK(f.get_nbr_nodes() == 4);
+        CHECK(f.get_nbr_edges() == 3);
+        CHECK(f.get_nature() == DIRECTED);
+
+        // nodes are indexed in the order of the keys
+        CHECK(f.find("isolated") == 0);
+        CHECK(f.find("node 1")   == 1);
+        CHECK(f.find("node 3")   == 3);
+        CHECK(f.find("node 4")   == f.size());
+        CHECK(f.get_key(2) == "node 2");
+        CHECK(f.get(2) == 2);
+
+        // each row is sorted by target
+        const size_t n1{f.find("node 1")};
+        CHECK(f.degree(n1) == 2);
+        CHECK(f.degree(f.find("isolated")) == 0);
+        CHECK(f.edges_end(n1) - f.edges_begin(n1) == 2);
+        CHECK(f.target(f.edges_begin(n1))     == f.find("node 2"));
+        CHECK(f.cost  (f.edges_begin(n1))     == 12);
+        CHECK(f.target(f.edges_begin(n1) + 1) == f.find("node 3"));
+        CHECK(f.cost  (f.edges_begin(n1) + 1) == 13);
+
+        CHECK      (f.existing_edge(n1, f.find("node 3")));
+        CHECK_FALSE(f.existing_edge(f.find("node 3"), n1));
+        CHECK_FALSE(f.existing_edge(n1, f.size()));
+        CHECK(f.get_cost(f.find("node 2"), f.find("node 3")) == 23);
+        CHECK(f.get_cost(f.find("node 3"), f.find("node 2")) == numeric_limits<double>::infinity());
+
+        // the snapshot does not follow the graph
+        g("node 3", "node 1") = 31;
+        g.erase("node 2");
+        CHECK(f.size() == 4);
+        CHECK(f.get_nbr_edges() == 3);
+        CHECK_FALSE(f.existing_edge(f.find("node 3"), n1));
+    }
+
+    SECTION("undirected") {
+        using Graph = graph_undirected<int, int, int>;
+
+        Graph g;
+        g(1, 2) = 3;
+        g(2, 3) = 4;
+
+        Graph::frozen_graph f{g.freeze()};
+        CHECK(f.get_nature() == UNDIRECTED);
+        CHECK(f.get_nbr_edges() == 2);
+        CHECK(f.existing_edge(f.find(2), f.find(1)));
+        CHECK(f.get_cost(f.find(1), f.find(2)) == 3);
+        CHECK(f.get_cost(f.find(2), f.find(1)) == 3);
+        CHECK(f.get_cost(f.find(1), f.find(3)) == numeric_limits<int>::max());
+    }
+
+    SECTION("bfs") {
+        using Graph = graph_undirected<string, int, double>;
+
+        Graph g;
+        g["node 1"] = 1;
+        g["node 2"] = 2;
+        g["node 3"] = 3;
+        g["node 4"] = 4;
+        g["node 5"] = 5;
+        g("node 1", "node 2") = 12;
+        g("node 2", "node 3") = 13;
+        g("node 3", "node 4") = 32;
+        g("node 1", "node 4") = 100;
+
+        Graph::frozen_graph f{g.freeze()};
+
+        CHECK_THROWS_WITH(f.bfs(f.size(), 0), "[graph.exception.invalid_argument] Start point out of the frozen graph when calling 'bfs'.");
+        CHECK(f.bfs(f.find("node 1"), f.find("node 5")).empty());
+        CHECK(f.bfs(f.find("node 1"), f.size()).empty());
+        CHECK(f.bfs(f.find("node 2"), f.find("node 2")).size() == 1);
+
+        Graph::frozen_graph::search_path p{f.bfs(f.find("node 1"), f.find("node 3"))};
+        CHECK(p.size() == 3);
+        CHECK(p.front().first == f.find("node 1"));
+        CHECK(p.back().first  == f.find("node 3"));
+        CHECK(p.contain(f.find("node 2")));
+        CHECK_FALSE(p.contain(f.find("node 4")));
+        CHECK(p.total_cost() == 12 + 13);
+
+        CHECK(f.bfs(f.find("node 1"), f.find("node 4")).size() == 2);
+    }
+
+    SECTION("A*") {
+        using Graph = graph_undirected<string, int, double>;
+
+        Graph g;
+        g["node 1"] = 1;
+        g["node 2"] = 2;
+        g["node 3"] = 3;
+        g["node 4"] = 4;
+        g("unreachable 1", "unreachable 2") = -5;
+        g("node 1", "node 2") = 12;
+        g("node 1", "node 3") = 13;
+        g("node 3", "node 2") = 32;
+        g("node 2", "node 4") = 24;
+
+        Graph::frozen_graph f{g.freeze()};
+        function<double(size_t)> heuristic = [&f](size_t i) -> double {
+            return abs(f.get(i) - 4);
+        };
+
+        CHECK_THROWS_WITH(f.astar(f.size(), f.find("node 1"), heuristic), "[graph.exception.invalid_argument] Start point out of the frozen graph when calling 'astar'.");
+        CHECK(f.astar(f.find("node 1"), f.find("unreachable 1"), heuristic).empty());
+        CHECK(f.astar(f.find("node 1"), f.find("node 1"), heuristic).size() == 1);
+        CHECK(f.astar(f.find("node 1"), f.find("node 1"), heuristic).total_cost() == 0);
+
+        Graph::frozen_graph::search_path p{f.astar(f.find("node 1"), f.find("node 4"), heuristic)};
+        CHECK(p.total_cost() == 36);
+        CHECK(p.size() == 3);
+        CHECK(p[1].first == f.find("node 2"));
+        CHECK(p[1].second == 12);
+        CHECK(p[2].second == 24);
+
+        CHECK_THROWS_WITH(f.astar(f.find("unreachable 1"), f.find("node 1"), heuristic), "[graph.exception.bad_graph.negative_edge] Edge with negative weight when calling 'astar'.");
+    }
+
+    SECTION("dijkstra") {
+        using Graph = graph_directed<string, int, double>;
+
+        Graph g;
+        g("node 1", "node 2") = 7;
+        g("node 1", "node 3") = 9;
+        g("node 1", "node 6") = 14;
+        g("node 2", "node 3") = 10;
+        g("node 2", "node 4") = 15;
+        g("node 3", "node 4") = 11;
+        g("node 3", "node 6") = 2;
+        g("node 4", "node 5") = 6;
+        g("node 6", "node 5") = 9;
+        g["unreachable"] = 0;
+
+        Graph::frozen_graph f{g.freeze()};
+        CHECK_THROWS_WITH(f.dijkstra(f.size()), "[graph.exception.invalid_argument] Start point out of the frozen graph when calling 'dijkstra'.");
+
+        Graph::frozen_graph::shortest_paths sp{f.dijkstra(f.find("node 1"))};
+        CHECK(sp.size() == f.size());
+        CHECK(sp.get_distance(f.find("node 1")) == 0);
+        CHECK(sp.get_distance(f.find("node 5")) == 20);
+        CHECK(sp.get_distance(f.find("node 4")) == 20);
+        CHECK(sp.get_distance(f.find("unreachable")) == numeric_limits<double>::infinity());
+        CHECK(sp.get_previous(f.find("node 6")) == f.find("node 3"));
+        CHECK(sp.get_previous(f.find("unreachable")) == f.size());
+        CHECK(sp.get_path(f.find("unreachable")).empty());
+
+        Graph::frozen_graph::search_path p{sp.get_path(f.find("node 5"))};
+        CHECK(p.size() == 4);
+        CHECK(p.total_cost() == 20);
+        CHECK(p.contain(f.find("node 6")));
+
+        // the results agree with the mutable graph
+        Graph::shortest_paths expected{g.dijkstra("node 1")};
+        for (Graph::const_iterator it{std::next(g.cbegin())}; it != g.cend(); ++it) {
+            CHECK(sp.get_path(f.find(it->first)).size() == expected.get_path(it).size());
+            if (!expected.get_path(it).empty()) {
+                CHECK(sp.get_distance(f.find(it->first)) == expected.get_path(it).total_cost());
+            }
+        }
+
+        g("node 5", "node 1") = -1;
+        CHECK_THROWS_WITH(g.freeze().dijkstra(f.find("node 1")), "[graph.exception.bad_graph.negative_edge] Edge with negative weight when calling 'dijkstra'.");
+    }
+
+    SECTION("snapshots") {
+        using Graph = graph_directed<int, int, int>;
+
+        Graph g;
+        CHECK(g.get_version() == 0);
+        CHECK(g.snapshot()->empty());
+        CHECK(g.snapshot()->get_version() == 0);
+        CHECK(g.freeze().get_version() == 0);
+
+        g(1, 2) = 12;
+        CHECK(g.snapshot()->empty());
+        CHECK(g.publish() == 1);
+        Graph::snapshot_type first{g.snapshot()};
+        CHECK(first->get_version() == 1);
+        CHECK(first->get_nbr_edges() == 1);
+        CHECK(g.snapshot() == first);
+
+        //! the writer goes on while the first snapshot is still held
+        g(2, 3) = 23;
+        g.erase(1);
+        CHECK(first->get_nbr_edges() == 1);
+        CHECK(first->get_cost(first->find(1), first->find(2)) == 12);
+        CHECK(g.publish() == 2);
+        CHECK(g.snapshot()->get_nbr_edges() == 1);
+        CHECK(g.snapshot()->find(1) == g.snapshot()->size());
+        CHECK(first->size() == 2);
+
+        //! copies share the published snapshots
+        Graph copy{g};
+        CHECK(copy.get_version() == 2);
+        CHECK(copy.snapshot() == g.snapshot());
+        copy.publish();
+        CHECK(g.snapshot()->get_version() == 2);
+        swap(g, copy);
+        CHECK(g.snapshot()->get_version() == 3);
+        CHECK(copy.get_version() == 2);
+    }
+
+    SECTION("concurrent readers") {
+        using Graph = graph_directed<int, int, int>;
+
+        Graph g;
+        g[0] = 0;
+        g.publish();
+
+        //! every published version v is a path 0 -> 1 -> ... -> v - 1
+        atomic<bool> done{false};
+        atomic<size_t> errors{0};
+        vector<thread> readers;
+        for (int r{0}; r < 4; ++r) {
+            readers.emplace_back([&g, &done, &errors] {
+                size_t last{0};
+                while (!done) {
+                    Graph::snapshot_type s{g.snapshot()};
+                    const size_t v{s->get_version()};
+                    if (v < last || s->size() != v || s->get_nbr_edges() != v - 1 ||
+                        s->dijkstra(s->find(0)).get_distance(s->find(static_cast<int>(v) - 1)) != static_cast<int>(v) - 1) {
+                        ++errors;
+                    }
+                    last = v;
+                }
+            });
+        }
+
+        for (int i{1}; i < 300; ++i) {
+            g(i - 1, i) = 1;
+            g.publish();
+        }
+        done = true;
+        for (thread &t : readers) {
+            t.join();
+        }
+
+        CHECK(errors == 0);
+        CHECK(g.snapshot()->get_version() == 300);
+    }
+}
@@ -0,0 +1,125 @@
+//
+// Created by Terae on 18/10/26.
+//
+
+#include "catch.hpp"
+
+#if defined(TEST_SINGLE_HEADER_FILE)
+    #include "graph.hpp"
+#else
+    #include "Graph.h"
+#endif
+
+using namespace std;
+
+namespace {
+    using Coord = pair<int, int>;
+
+    //! Unbounded 4-connected grid; moving along x costs 1 and along y costs 2
+    void grid(const Coord &c, vector<pair<Coord, int>> &out) {
+        out.emplace_back(Coord(c.first + 1, c.second), 1);
+        out.emplace_back(Coord(c.first - 1, c.second), 1);
+        out.emplace_back(Coord(c.first, c.second + 1), 2);
+        out.emplace_back(Coord(c.first, c.second - 1), 2);
+    }
+}
+
+TEST_CASE("implicit graph") {
+    using Graph = implicit_graph<Coord, int>;
+
+    Graph g{grid};
+    const Coord origin{0, 0};
+    const Coord target{3, -2};
+
+    SECTION("neighbours") {
+        CHECK_THROWS_WITH(Graph(Graph::neighbours_function()), "[graph.exception.invalid_argument] Empty neighbour function when calling 'implicit_graph'.");
+        CHECK(g.get_neighbours(origin).size() == 4);
+        CHECK(g.get_neighbours(origin)[3].first == Coord(0, -1));
+        CHECK(g.get_max_expansions() == numeric_limits<size_t>::max());
+    }
+
+    SECTION("bfs") {
+        CHECK(g.bfs(origin, origin).size() == 1);
+        CHECK(g.bfs(origin, origin).total_cost() == 0);
+
+        Graph::search_path p{g.bfs(origin, target)};
+        CHECK(p.size() == 6);
+        CHECK(p.front().first == origin);
+        CHECK(p.back().first == target);
+        CHECK(p.total_cost() == 3 + 2 * 2);
+
+        CHECK(g.bfs(origin, [](Coord c) {
+            return c.first * c.first + c.second * c.second == 25;
+        }).size() == 6);
+
+        //! the bound on the expansions stops a search that cannot succeed
+        g.set_max_expansions(1000);
+        CHECK(g.bfs(origin, [](Coord) {
+            return false;
+        }).empty());
+    }
+
+    SECTION("ucs and A*") {
+        Graph::search_path p{g.ucs(origin, target)};
+        CHECK(p.size() == 6);
+        CHECK(p.total_cost() == 7);
+        CHECK(p.contain(Coord(3, 0)) == p.contain(Coord(3, -1)));
+
+        function<int(Coord)> manhattan = [&target](Coord c) {
+            return abs(c.first - target.first) + 2 * abs(c.second - target.second);
+        };
+        CHECK(g.astar(origin, target, manhattan).total_cost() == 7);
+        CHECK(g.astar(origin, origin, manhattan).size() == 1);
+
+        g.set_max_expansions(10);
+        CHECK(g.ucs(origin, Coord(100, 100)).empty());
+
+        Graph negative{[](const Coord &c, vector<pair<Coord, int>> &out) {
+            out.emplace_back(Coord(c.first + 1, c.second), -1);
+        }};
+        CHECK_THROWS_WITH(negative.ucs(origin, target), "[graph.exception.bad_graph.negative_edge] Edge with negative weight when calling 'best_first_search'.");
+    }
+
+    SECTION("dijkstra") {
+        Graph::shortest_paths sp{g.dijkstra(origin, [&target](Coord c) {
+            return c == target;
+        })};
+        CHECK(sp.contain(target));
+        CHECK(sp.get_distance(target) == 7);
+        CHECK(sp.get_path(target).total_cost() == 7);
+        CHECK(sp.get_distance(origin) == 0);
+        CHECK_FALSE(sp.contain(Coord(100, 0)));
+        CHECK(sp.get_distance(Coord(100, 0)) == numeric_limits<int>::max());
+        CHECK(sp.get_path(Coord(100, 0)).empty());
+
+        //! finite state space: a ring of 10 nodes
+        implicit_graph<int, double, unordered_index> ring{[](const int &i, vector<pair<int, double>> &out) {
+            out.emplace_back((i + 1) % 10, 1.5);
+        }};
+        implicit_graph<int, double, unordered_index>::shortest_paths all{ring.dijkstra(0)};
+        CHECK(all.size() == 10);
+        CHECK(all.get_distance(9) == 13.5);
+        CHECK(all.get_path(9).size() == 10);
+    }
+
+    SECTION("materialised graph") {
+        //! Same results as on the materialised part of the grid
+        graph_directed<Coord, int, int> materialised;
+        for (int x{-5}; x <= 5; ++x) {
+            for (int y{-5}; y <= 5; ++y) {
+                vector<pair<Coord, int>> out;
+                grid(Coord(x, y), out);
+                for (const pair<Coord, int> &e : out) {
+                    if (abs(e.first.first) <= 5 && abs(e.first.second) <= 5) {
+                        materialised(Coord(x, y), e.first) = e.second;
+                    }
+                }
+            }
+        }
+
+        graph_directed<Coord, int, int>::shortest_paths expected{materialised.dijkstra(origin)};
+        for (graph_directed<Coord, int, int>::const_iterator it{materialised.cbegin()}; it != materialised.cend(); ++it) {
+            CHECK(g.ucs(origin, it->first).total_cost() == expected.get_path(it).total_cost());
+        }
+    }
+}
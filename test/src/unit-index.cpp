@@ -0,0 +1,151 @@
+//
+// Created by Terae on 18/10/26.
+//
+
+#include "catch.hpp"
+
+#if defined(TEST_SINGLE_HEADER_FILE)
+    #include "graph.hpp"
+#else
+    #include "Graph.h"
+#endif
+
+using namespace std;
+
+TEST_CASE("index") {
+    SECTION("hash_map") {
+        using Map = detail::hash_map<string, int>;
+
+        Map m;
+        CHECK(m.empty());
+        CHECK(m.find("a") == m.end());
+
+        for (int i{0}; i < 1000; ++i) {
+            CHECK(m.emplace(to_string(i), i).second);
+        }
+        CHECK_FALSE(m.emplace("42", 0).second);
+        CHECK(m.size() == 1000);
+        CHECK(m.find("42")->second == 42);
+        CHECK(m.count("1000") == 0);
+
+        //! insertion order
+        int expected{0};
+        for (Map::const_iterator it{m.cbegin()}; it != m.cend(); ++it, ++expected) {
+            CHECK(it->second == expected);
+        }
+        CHECK(m.crbegin()->second == 999);
+
+        //! iterators survive the growth of the table and the erasure of other elements
+        Map::iterator it_500{m.find("500")};
+        for (int i{0}; i < 1000; i += 3) {
+            CHECK(m.erase(to_string(i)) == 1);
+        }
+        CHECK(m.erase("0") == 0);
+        for (int i{1000}; i < 3000; ++i) {
+            m.emplace(to_string(i), i);
+        }
+        CHECK(it_500->second == 500);
+        for (int i{0}; i < 3000; ++i) {
+            CHECK(m.count(to_string(i)) == (i < 1000 && i % 3 == 0 ? 0 : 1));
+        }
+
+        Map copy{m};
+        m.erase(m.begin(), m.find("1000"));
+        CHECK(m.size() == 2000);
+        CHECK(m.find("1000") == m.begin());
+        CHECK(copy.size() == 2666);
+        CHECK(copy.find("500")->second == 500);
+
+        m.clear();
+        CHECK(m.empty());
+        CHECK(m.find("1000") == m.end());
+        m.emplace("a", 1);
+        CHECK(m.find("a")->second == 1);
+    }
+
+    SECTION("graph_unordered") {
+        using Graph = graph_unordered<string, int, double, DIRECTED>;
+
+        Graph g;
+        g["node 3"] = 3;
+        g["node 1"] = 1;
+        g["node 2"] = 2;
+        g("node 1", "node 2") = 12;
+        g("node 2", "node 3") = 23;
+        g("node 1", "node 3") = 13;
+        g("node 4", "node 1") = 41;
+
+        CHECK(g.size() == 4);
+        CHECK(g.get_nbr_edges() == 4);
+        CHECK(g.begin()->first == "node 3");
+        CHECK(g.crbegin()->first == "node 4");
+        CHECK(g.find("node 2")->second->get() == 2);
+        CHECK(g.find("node 5") == g.cend());
+        CHECK(g.count("node 4") == 1);
+        CHECK(g.existing_edge("node 4", "node 1"));
+        CHECK(g.degree("node 1") == make_pair<size_t, size_t>(1, 2));
+        CHECK(g.get_out_edges("node 1").size() == 2);
+
+        //! Same graph with ordered iteration
+        graph_directed<string, int, double> ordered;
+        for (Graph::const_iterator it{g.cbegin()}; it != g.cend(); ++it) {
+            ordered[it->first] = it->second->get();
+        }
+        for (Graph::const_iterator it{g.cbegin()}; it != g.cend(); ++it) {
+            for (const Graph::node::edge &e : g.get_out_edges(it)) {
+                ordered(it->first, e.target()->first) = e.cost();
+            }
+        }
+        CHECK(g == ordered);
+        CHECK(ordered == g);
+        ordered("node 1", "node 2") = 21;
+        CHECK(g != ordered);
+
+        Graph copy{g};
+        CHECK(copy == g);
+
+        CHECK(g.astar("node 4", "node 3", [](Graph::const_iterator) {
+            return 0.;
+        }).total_cost() == 41 + 13);
+        CHECK(g.dijkstra("node 4").get_path("node 3").total_cost() == 41 + 13);
+        CHECK(g.bfs("node 4", "node 3").size() == 3);
+
+        Graph::frozen_graph f{g.freeze()};
+        CHECK(f.get_key(0) == "node 3");
+        for (Graph::const_iterator it{g.cbegin()}; it != g.cend(); ++it) {
+            CHECK(f.get_key(f.find(it->first)) == it->first);
+        }
+        CHECK(f.find("node 0") == f.size());
+        CHECK(f.get_cost(f.find("node 4"), f.find("node 1")) == 41);
+
+        CHECK(g.erase("node 1") == 1);
+        CHECK(g.size() == 3);
+        CHECK(g.get_nbr_edges() == 1);
+        CHECK_FALSE(g.existing_edge("node 4", "node 1"));
+        CHECK(g.degree("node 3") == make_pair<size_t, size_t>(1, 0));
+
+        stringstream ss;
+        ss << g;
+        Graph loaded;
+        ss >> loaded;
+        CHECK(loaded == g);
+        CHECK(copy != g);
+    }
+
+    SECTION("assign_edges") {
+        using Graph = graph_unordered<string, int, int, DIRECTED>;
+
+        //! the keys are looked up in the hash map: the nodes keep the order of their first appearance
+        const vector<tuple<string, string, int>> edges{make_tuple("c", "a", 1),
+                                                       make_tuple("a", "b", 2),
+                                                       make_tuple("c", "a", 3)};
+        Graph g;
+        g.assign_edges(edges.cbegin(), edges.cend());
+        CHECK(g.size() == 3);
+        CHECK(g.get_nbr_edges() == 2);
+        CHECK(g.begin()->first == "c");
+        CHECK(g.crbegin()->first == "b");
+        CHECK(g.get_out_edges("c").begin()->cost() == 3);
+        CHECK(g.existing_edge("a", "b"));
+    }
+}
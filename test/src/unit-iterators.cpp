@@ -294,5 +294,22 @@ TEST_CASE("iterators") {
             cit = g.find("node 0");
             CHECK(cit == g.cbegin());
         }
+
+#if defined(GRAPH_HAS_CPP_17)
+        SECTION("find(const K& k)") {
+            //! transparent lookups: no std::string is built
+            CHECK(g.find(string_view("node 4")) == next(begin(g), 4));
+            CHECK(g.find(string_view("node 42")) == g.end());
+            CHECK(g.count(string_view("node 9")) == 1);
+            CHECK(as_const(g).find(string_view("node 0")) == g.cbegin());
+
+            graph_unordered<string, int> u;
+            u["node 1"] = 1;
+            u["node 2"] = 2;
+            CHECK(u.find(string_view("node 2"))->second->get() == 2);
+            CHECK(u.count(string_view("node 3")) == 0);
+            CHECK(u.find("node 1") == u.begin());
+        }
+#endif
     }
 }
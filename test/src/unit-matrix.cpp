@@ -0,0 +1,112 @@
+//
+// Created by Terae on 18/10/26.
+//
+
+#include "catch.hpp"
+
+#if defined(TEST_SINGLE_HEADER_FILE)
+    #include "graph.hpp"
+#else
+    #include "Graph.h"
+#endif
+
+using namespace std;
+
+TEST_CASE("adjacency matrix") {
+    SECTION("directed") {
+        using Graph = graph_directed<string, int, double>;
+
+        Graph g;
+        g["node 1"] = 1;
+        g["node 2"] = 2;
+        g["node 3"] = 3;
+        g("node 1", "node 2") = 12;
+        g("node 2", "node 3") = 23;
+        g("node 3", "node 3") = 33;
+
+        Graph::adjacency_matrix empty_matrix;
+        CHECK(empty_matrix.empty());
+        CHECK(empty_matrix.size() == 0);
+
+        Graph::adjacency_matrix m{g.to_matrix()};
+        CHECK(m.size() == 3);
+        CHECK(m.get_nbr_nodes() == 3);
+        CHECK(m.get_nbr_edges() == 3);
+        CHECK(m.get_nature() == DIRECTED);
+        CHECK(m.find("node 2") == 1);
+        CHECK(m.find("node 4") == m.size());
+        CHECK(m.get_key(2) == "node 3");
+        CHECK(m.get(2) == 3);
+
+        CHECK      (m.existing_edge(m.find("node 1"), m.find("node 2")));
+        CHECK_FALSE(m.existing_edge(m.find("node 2"), m.find("node 1")));
+        CHECK_FALSE(m.existing_edge(0, m.size()));
+        CHECK(m.get_cost(m.find("node 3"), m.find("node 3")) == 33);
+        CHECK(m.get_cost(m.find("node 3"), m.find("node 1")) == numeric_limits<double>::infinity());
+        CHECK(m.to_graph() == g);
+
+        CHECK      (m.add_edge(2, 0, 31));
+        CHECK_FALSE(m.add_edge(2, 0, 310));
+        CHECK(m.get_cost(2, 0) == 310);
+        CHECK(m.get_nbr_edges() == 4);
+        CHECK(m.del_edge(0, 1) == 1);
+        CHECK(m.del_edge(0, 1) == 0);
+        CHECK(m.get_nbr_edges() == 3);
+        CHECK_THROWS_WITH(m.add_edge(0, 3, 1), "[graph.exception.invalid_argument] Node out of the adjacency matrix when calling 'add_edge'.");
+
+        Graph h{m.to_graph()};
+        CHECK(h.get_nbr_edges() == 3);
+        CHECK(h("node 3", "node 1") == 310);
+        CHECK_FALSE(h.existing_edge("node 1", "node 2"));
+        CHECK(h.degree("node 3") == make_pair<size_t, size_t>(2, 2));
+
+        //! the matrix does not follow the graph
+        g.erase("node 2");
+        CHECK(m.size() == 3);
+
+        m.make_complete(5);
+        CHECK(m.get_nbr_edges() == 6);
+        CHECK_FALSE(m.existing_edge(1, 1));
+        CHECK(m.get_cost(0, 2) == 5);
+        m.clear_edges();
+        CHECK(m.get_nbr_edges() == 0);
+        CHECK_FALSE(m.existing_edge(0, 2));
+        CHECK(m.to_graph().get_nbr_edges() == 0);
+    }
+
+    SECTION("undirected") {
+        using Graph = graph_unordered<int, int, int, UNDIRECTED>;
+
+        Graph g;
+        g(3, 1) = 31;
+        g(1, 2) = 12;
+        g(2, 2) = 22;
+
+        Graph::adjacency_matrix m{g.to_matrix()};
+        CHECK(m.get_nature() == UNDIRECTED);
+        CHECK(m.get_key(0) == 3);
+        CHECK(m.find(1) == 1);
+        CHECK(m.find(2) == 2);
+        CHECK(m.find(4) == m.size());
+        CHECK(m.get_nbr_edges() == 3);
+        CHECK(m.get_cost(m.find(1), m.find(3)) == 31);
+        CHECK(m.to_graph() == g);
+
+        CHECK(m.add_edge(m.find(2), m.find(3), 23));
+        CHECK(m.get_cost(m.find(3), m.find(2)) == 23);
+        CHECK(m.del_edge(m.find(1), m.find(3)) == 1);
+        CHECK_FALSE(m.existing_edge(m.find(3), m.find(1)));
+        CHECK(m.get_nbr_edges() == 3);
+
+        Graph h{m.to_graph()};
+        CHECK(h.get_nbr_edges() == 3);
+        h(3, 2) = 32;
+        CHECK(h(2, 3) == 32);
+        CHECK(h.degree(2) == 3);
+
+        m.make_complete(7);
+        CHECK(m.get_nbr_edges() == 3);
+        g.make_complete(7);
+        CHECK(m.to_graph() == g);
+    }
+}
@@ -123,6 +123,112 @@ TEST_CASE("modifiers") {
                 CHECK(it->second->get() == 12);
                 CHECK(result);
             }
+
+            SECTION("emplace(const key_type& k, const Node& n) - copied edges") {
+                SECTION("directed") {
+                    Graph_directed g;
+                    g.add_edge("a", "b", 1);
+                    g.add_edge("a", "c", 2);
+
+                    //! Existing key: nothing is linked, and deleting a target afterwards is clean
+                    auto [it1, result1] {g.emplace("a", *g.find("a")->second)};
+                    CHECK_FALSE(result1);
+                    CHECK      (g.degree("b") == make_pair<size_t, size_t>(1, 0));
+                    CHECK      (g.del_node("b"));
+                    CHECK      (g.get_nbr_edges() == 1);
+
+                    auto [it2, result2] {g.emplace("d", *g.find("a")->second)};
+                    CHECK(result2);
+                    CHECK(g.get_nbr_edges() == 2);
+                    CHECK(g("d", "c") == 2);
+                    CHECK(g.degree("c") == make_pair<size_t, size_t>(2, 0));
+
+                    CHECK(g.del_node("c"));
+                    CHECK(g.get_nbr_edges() == 0);
+
+                    iterator_directed it3{g.insert(g.begin(), "a", *g.find("d")->second)};
+                    CHECK(it3 == g.find("a"));
+                    CHECK(g.size() == 2);
+                }
+
+                SECTION("undirected") {
+                    Graph_undirected g;
+                    g.add_edge("a", "b", 1);
+
+                    iterator_undirected it{g.insert(g.end(), "c", *g.find("a")->second)};
+                    CHECK(it->second->get() == g["a"]);
+                    CHECK(g.get_nbr_edges() == 2);
+                    CHECK(g("c", "b") == 1);
+                    CHECK(g("b", "c") == 1);
+
+                    //! The copied edge has its own cost slot
+                    g("c", "b") = 3;
+                    CHECK(g("a", "b") == 1);
+                    CHECK(g("b", "a") == 1);
+                    CHECK(g.del_edge("a", "b"));
+                    g.add_edge("a", "d", 4);
+                    CHECK(g("b", "c") == 3);
+                    CHECK(g("d", "a") == 4);
+
+                    CHECK(g.del_node("b"));
+                    CHECK(g.get_nbr_edges() == 1);
+                }
+            }
+
+            SECTION("try_emplace(key_type&& k, Args&&... args)") {
+                //! counts the copies of the graphed values
+                struct payload {
+                    vector<int> data;
+                    size_t *copies;
+
+                    payload() : copies(nullptr) {}
+                    payload(size_t n, size_t *c) : data(n, 7), copies(c) {}
+                    payload(const payload &other) : data(other.data), copies(other.copies) {
+                        if (copies) {
+                            ++*copies;
+                        }
+                    }
+                    payload(payload &&) = default;
+                    payload &operator=(const payload &other) {
+                        data   = other.data;
+                        copies = other.copies;
+                        if (copies) {
+                            ++*copies;
+                        }
+                        return *this;
+                    }
+                    payload &operator=(payload &&) = default;
+                    bool operator==(const payload &other) const {
+                        return data == other.data;
+                    }
+                };
+
+                size_t copies{0};
+                graph_directed<string, payload, size_t> g;
+
+                auto [it1, result1] {g.try_emplace("node 1", 1000, &copies)};
+                CHECK(result1);
+                CHECK(it1->second->get().data.size() == 1000);
+                CHECK(copies == 0);
+
+                //! an existing key leaves the arguments untouched
+                string key{"node 1"};
+                payload p(10, &copies);
+                auto [it2, result2] {g.try_emplace(std::move(key), std::move(p))};
+                CHECK_FALSE(result2);
+                CHECK(it2 == it1);
+                CHECK(key == "node 1");
+                CHECK(p.data.size() == 10);
+
+                auto [it3, result3] {g.add_node(string("node 2"), std::move(p))};
+                CHECK(result3);
+                CHECK(it3->second->get().data.size() == 10);
+                CHECK(g.emplace("node 3", payload(5, &copies)).second);
+                CHECK_FALSE(g.emplace("node 3", payload(6, &copies)).second);
+                g[string("node 4")] = payload(3, &copies);
+                CHECK(g.size() == 4);
+                CHECK(copies == 0);
+            }
         }
 
         SECTION("add_node") {
@@ -253,6 +359,66 @@ TEST_CASE("modifiers") {
             }
         }
 
+        SECTION("add_edge - high degree node") {
+            SECTION("directed") {
+                Graph_directed g;
+                for (size_t i{0}; i < 100; ++i) {
+                    g.add_edge("hub", "node " + to_string(i), i);
+                }
+                for (size_t i{0}; i < 100; ++i) {
+                    g.add_edge("hub", "node " + to_string(i), 2 * i);
+                }
+
+                CHECK(g.get_nbr_edges() == 100);
+                CHECK(g.degree("hub") == make_pair<size_t, size_t>(0, 100));
+                CHECK(g("hub", "node 42") == 84);
+                CHECK_FALSE(g.existing_edge("node 42", "hub"));
+
+                for (size_t i{0}; i < 100; i += 2) {
+                    CHECK(g.del_edge("hub", "node " + to_string(i)) == 1);
+                }
+                CHECK(g.del_edge("hub", "node 0") == 0);
+                CHECK(g.degree("hub") == make_pair<size_t, size_t>(0, 50));
+                for (size_t i{0}; i < 100; ++i) {
+                    CHECK(g.existing_edge("hub", "node " + to_string(i)) == (i % 2 == 1));
+                }
+                CHECK(g("hub", "node 99") == 198);
+
+                //! Back below the threshold
+                for (size_t i{1}; i < 95; i += 2) {
+                    g.del_edge("hub", "node " + to_string(i));
+                }
+                CHECK(g.degree("hub") == make_pair<size_t, size_t>(0, 3));
+                CHECK(g.existing_edge("hub", "node 97"));
+                CHECK_FALSE(g.existing_edge("hub", "node 93"));
+                CHECK(g("hub", "node 95") == 190);
+            }
+
+            SECTION("undirected") {
+                Graph_undirected g;
+                for (size_t i{0}; i < 100; ++i) {
+                    g.add_edge("hub", "node " + to_string(i), i);
+                }
+
+                CHECK(g.get_nbr_edges() == 100);
+                CHECK(g("node 42", "hub") == 42);
+                g.add_edge("node 42", "hub", 420);
+                CHECK(g.get_nbr_edges() == 100);
+                CHECK(g("hub", "node 42") == 420);
+
+                g.erase("node 42");
+                CHECK(g.get_nbr_edges() == 99);
+                CHECK(g.degree("hub") == 99);
+                CHECK(g.existing_edge("node 99", "hub"));
+
+                g.clear_edges("hub");
+                CHECK(g.get_nbr_edges() == 0);
+                CHECK_FALSE(g.existing_edge("hub", "node 99"));
+                g.add_edge("hub", "node 99", 1);
+                CHECK(g.existing_edge("node 99", "hub"));
+            }
+        }
+
         SECTION("make_complete(Cost cost)") {
             SECTION("directed") {
                 Graph_directed g;
@@ -297,6 +463,91 @@ TEST_CASE("modifiers") {
                 g.make_complete(50);
                 CHECK(g.get_nbr_edges() == 55);
                 CHECK(g("node 7", "new node") == 50);
+
+                //! Both directions share the same cost
+                g("node 2", "node 6") = 26;
+                CHECK(g("node 6", "node 2") == 26);
+                CHECK(g.del_edge("node 6", "node 2") == 1);
+                CHECK_FALSE(g.existing_edge("node 2", "node 6"));
+                CHECK(g.get_nbr_edges() == 54);
+            }
+
+            SECTION("above the hashing threshold") {
+                Graph_undirected g;
+                for (int i{0}; i < 40; ++i) {
+                    g["node " + to_string(i)] = i;
+                }
+
+                g.make_complete(5);
+                CHECK(g.get_nbr_edges() == 780);
+                CHECK(g.degree("node 17") == 39);
+
+                g("node 31", "node 4") = 314;
+                CHECK(g("node 4", "node 31") == 314);
+                CHECK(g("node 4", "node 30") == 5);
+                CHECK(g.del_edge("node 4", "node 31") == 1);
+                CHECK_FALSE(g.existing_edge("node 31", "node 4"));
+                g.add_edge("node 31", "node 4", 3);
+                CHECK(g("node 4", "node 31") == 3);
+                CHECK(g.get_nbr_edges() == 780);
+            }
+        }
+
+        SECTION("assign_edges(InputIterator first, InputIterator last)") {
+            //! Duplicates, self-loops and a hub above the hashing threshold
+            vector<tuple<string, string, size_t>> edges;
+            for (size_t i{0}; i < 500; ++i) {
+                edges.emplace_back("node " + to_string(i * 7 % 40), "node " + to_string(i * 13 % 30), i);
+            }
+            for (size_t i{0}; i < 40; ++i) {
+                edges.emplace_back("hub", "node " + to_string(i), i);
+            }
+
+            SECTION("directed") {
+                Graph_directed expected;
+                for (const tuple<string, string, size_t> &e : edges) {
+                    expected.add_edge(get<0>(e), get<1>(e), get<2>(e));
+                }
+
+                Graph_directed g;
+                g["old node"] = 1;
+                g.assign_edges(edges.cbegin(), edges.cend());
+                CHECK(g == expected);
+                CHECK(g.get_nbr_edges() == expected.get_nbr_edges());
+                CHECK(g.degree("hub") == make_pair<size_t, size_t>(0, 40));
+                CHECK(g.degree("node 3") == expected.degree("node 3"));
+                CHECK(g.count("old node") == 0);
+
+                CHECK(g.erase("node 3") == 1);
+                CHECK(expected.erase("node 3") == 1);
+                CHECK(g.del_edge("hub", "node 5") == 1);
+                CHECK(expected.del_edge("hub", "node 5") == 1);
+                CHECK(g == expected);
+                CHECK(g.get_in_edges("node 7").size() == expected.get_in_edges("node 7").size());
+
+                g.assign_edges(edges.cend(), edges.cend());
+                CHECK(g.empty());
+            }
+
+            SECTION("undirected") {
+                Graph_undirected expected;
+                for (const tuple<string, string, size_t> &e : edges) {
+                    expected.add_edge(get<0>(e), get<1>(e), get<2>(e));
+                }
+
+                Graph_undirected g;
+                g.assign_edges(edges.cbegin(), edges.cend());
+                CHECK(g == expected);
+                CHECK(g.get_nbr_edges() == expected.get_nbr_edges());
+                CHECK(g("node 12", "node 2") == expected("node 2", "node 12"));
+
+                g("node 2", "node 12") = 1000;
+                CHECK(g("node 12", "node 2") == 1000);
+                CHECK(g.erase("hub") == 1);
+                CHECK(expected.erase("hub") == 1);
+                CHECK(g.del_edge("node 2", "node 12") == 1);
+                CHECK(expected.del_edge("node 12", "node 2") == 1);
+                CHECK(g == expected);
             }
         }
     }
@@ -610,6 +861,86 @@ TEST_CASE("modifiers") {
             }
         }
 
+        SECTION("del_nodes(const Range& keys)") {
+            //! Dense enough for edges between two deleted nodes, in both directions, and self-loops
+            vector<tuple<string, string, size_t>> edges;
+            for (size_t i{0}; i < 300; ++i) {
+                edges.emplace_back("node " + to_string(i % 30), "node " + to_string(i * 7 % 30), i);
+            }
+            vector<string> keys{"node 3", "node 4", "node 7", "unknown node", "node 4", "node 21"};
+
+            SECTION("directed") {
+                Graph_directed g, expected;
+                g.assign_edges(edges.cbegin(), edges.cend());
+                expected.assign_edges(edges.cbegin(), edges.cend());
+
+                CHECK(g.del_nodes(keys) == 4);
+                for (const string &k : keys) {
+                    expected.del_node(k);
+                }
+                CHECK(g == expected);
+                CHECK(g.get_nbr_edges() == expected.get_nbr_edges());
+                CHECK(g.degree("node 14") == expected.degree("node 14"));
+
+                CHECK(g.del_nodes({"node 0", "node 1"}) == 2);
+                CHECK(g.del_nodes(vector<string>()) == 0);
+                CHECK(g.size() == 24);
+                expected.del_node("node 0");
+                expected.del_node("node 1");
+                g("node 2", "node 5") = 25;
+                expected("node 2", "node 5") = 25;
+                CHECK(g == expected);
+                CHECK(g.get_in_edges("node 5").size() == expected.get_in_edges("node 5").size());
+            }
+
+            SECTION("undirected") {
+                Graph_undirected g, expected;
+                g.assign_edges(edges.cbegin(), edges.cend());
+                expected.assign_edges(edges.cbegin(), edges.cend());
+
+                CHECK(g.del_nodes(keys) == 4);
+                for (const string &k : keys) {
+                    expected.del_node(k);
+                }
+                CHECK(g == expected);
+                CHECK(g.get_nbr_edges() == expected.get_nbr_edges());
+
+                //! the released costs are reused by new edges
+                g("node 3", "node 4") = 34;
+                g("node 7", "node 8") = 78;
+                CHECK(g("node 4", "node 3") == 34);
+                CHECK(g("node 8", "node 7") == 78);
+                CHECK(g.get_nbr_edges() == expected.get_nbr_edges() + 2);
+            }
+        }
+
+        SECTION("del_nodes_if(predicate)") {
+            Graph_directed g;
+            for (int i{0}; i < 100; ++i) {
+                g["node " + to_string(i)] = i;
+                g("node " + to_string(i), "node " + to_string((i + 1) % 100)) = 1;
+                g("node " + to_string(i), "node " + to_string(i * i % 100)) = 2;
+            }
+            Graph_directed expected{g};
+
+            CHECK(g.del_nodes_if([](Graph_directed::const_iterator it) {
+                return it->second->get() % 3 == 0;
+            }) == 34);
+            for (int i{0}; i < 100; i += 3) {
+                expected.erase("node " + to_string(i));
+            }
+            CHECK(g == expected);
+            CHECK(g.get_nbr_edges() == expected.get_nbr_edges());
+            CHECK(g.del_nodes_if([](Graph_directed::const_iterator) {
+                return false;
+            }) == 0);
+            CHECK(g.del_nodes_if([](Graph_directed::const_iterator) {
+                return true;
+            }) == 66);
+            CHECK(g.empty());
+            CHECK(g.get_nbr_edges() == 0);
+        }
+
         SECTION("clear()") {
             Graph g;
             for (int i{0}; i < 10; ++i) {
@@ -714,6 +1045,46 @@ TEST_CASE("modifiers") {
                 CHECK_FALSE(g.existing_edge("node 1", "node 5"));
                 CHECK_FALSE(g.existing_edge("node 5", "node 1"));
             }
+
+            SECTION("undirected - shared costs") {
+                Graph_undirected g;
+                g.add_edge("node 1", "node 2", 12);
+                g.add_edge("node 1", "node 5", 15);
+                g("node 5", "node 1") = 51;
+                CHECK(g("node 1", "node 5") == 51);
+
+                //! The released cost is reused by the next edge without being shared with another one
+                CHECK(g.del_edge("node 1", "node 2"));
+                g.add_edge("node 3", "node 4", 34);
+                g.add_edge("node 3", "node 6", 36);
+                g("node 4", "node 3") = 43;
+                CHECK(g("node 3", "node 4") == 43);
+                CHECK(g("node 6", "node 3") == 36);
+                CHECK(g("node 5", "node 1") == 51);
+
+                Graph_undirected copy{g};
+                copy("node 1", "node 5") = 0;
+                CHECK(copy("node 5", "node 1") == 0);
+                CHECK(g("node 5", "node 1") == 51);
+            }
+        }
+
+        SECTION("del_edges(const Range& edges)") {
+            Graph_undirected g;
+            for (int i{0}; i < 10; ++i) {
+                g("node " + to_string(i), "node " + to_string((i + 1) % 10)) = i;
+            }
+
+            vector<pair<string, string>> edges{{"node 1", "node 2"}, {"node 3", "node 2"}, {"node 1", "node 2"}, {"node 5", "unknown node"}, {"node 5", "node 7"}};
+            CHECK(g.del_edges(edges) == 2);
+            CHECK(g.get_nbr_edges() == 8);
+            CHECK_FALSE(g.existing_edge("node 2", "node 1"));
+            CHECK_FALSE(g.existing_edge("node 2", "node 3"));
+            CHECK(g.size() == 10);
+
+            CHECK(g.del_edges({{"node 0", "node 1"}, {"node 9", "node 0"}}) == 2);
+            CHECK(g.get_nbr_edges() == 6);
+            CHECK(g.degree("node 0") == 0);
         }
 
         SECTION("clear_edges()") {
@@ -810,6 +1181,47 @@ TEST_CASE("modifiers") {
             }
         }
 
+        SECTION("clear_edges(iterator it) - in-edges") {
+            Graph_directed g;
+            iterator_directed hub{g.add_node("hub").first};
+            for (int i{0}; i < 100; ++i) {
+                g("node " + to_string(i), "hub") = i;
+                g("node " + to_string(i), "node " + to_string((i + 1) % 100)) = 1000 + i;
+            }
+            for (int i{0}; i < 50; ++i) {
+                g(hub, g.find("node " + to_string(2 * i))) = 2 * i;
+            }
+            g(hub, hub) = 0;
+
+            CHECK(g.degree(hub) == make_pair<size_t, size_t>(101, 51));
+            CHECK(g.get_in_edges(hub).size() == 100);
+
+            //! the reverse links follow the out-edges moved by the deletions
+            for (int i{0}; i < 100; i += 3) {
+                g.del_edge("node " + to_string(i), "hub");
+            }
+            g.del_edge("hub", "node 0");
+            CHECK(g.degree(hub) == make_pair<size_t, size_t>(67, 50));
+            int sum{0};
+            for (const Graph_directed::node::edge &e : g.get_in_edges(hub)) {
+                CHECK(e.target() == hub);
+                sum += e.cost();
+            }
+            CHECK(sum == 4950 - 1683);
+            CHECK(g.degree("node 2") == make_pair<size_t, size_t>(2, 2));
+
+            CHECK(g.clear_edges(hub) == 67 + 50 - 1);
+            CHECK(g.get_nbr_edges() == 100);
+            CHECK(g.degree(hub) == make_pair<size_t, size_t>(0, 0));
+            CHECK(g.degree("node 2") == make_pair<size_t, size_t>(1, 1));
+            CHECK(g("node 1", "node 2") == 1001);
+
+            g.erase("node 2");
+            CHECK(g.get_nbr_edges() == 98);
+            CHECK(g.get_in_edges("node 3").empty());
+            CHECK(g.degree("node 1") == make_pair<size_t, size_t>(1, 0));
+        }
+
         SECTION("clear_edges(const Key& k)") {
             SECTION("directed") {
                 Graph_directed g;
@@ -12,6 +12,42 @@
 
 using namespace std;
 
+namespace {
+    //! Goal predicate that cannot be wrapped in a std::function: only the templated overloads accept it
+    struct move_only_goal {
+        string target;
+        unique_ptr<size_t> calls;
+
+        move_only_goal(string t) : target(std::move(t)), calls(new size_t(0)) {}
+        move_only_goal(move_only_goal &&) = default;
+        move_only_goal(const move_only_goal &) = delete;
+
+        bool operator()(const string &k) {
+            ++*calls;
+            return k == target;
+        }
+    };
+
+    int zero_heuristic(graph_directed<string, int, int>::const_iterator) {
+        return 0;
+    }
+
+    //! Random graph drawn from a linear congruential generator: the same seed always gives the same edges
+    //! @param cost_fn gives the cost of the edge (from, to) from a third random value
+    template <class G, class CostFn>
+    G random_graph(unsigned seed, int nbr_nodes, int nbr_edges, CostFn cost_fn) {
+        G g;
+        for (int i{0}; i < nbr_edges; ++i) {
+            seed = seed * 1103515245u + 12345u;
+            const int from{int((seed >> 16) % unsigned(nbr_nodes))};
+            seed = seed * 1103515245u + 12345u;
+            const int to{int((seed >> 16) % unsigned(nbr_nodes))};
+            g(from, to) = cost_fn(from, to, seed >> 4);
+        }
+        return g;
+    }
+}
+
 // TODO
 TEST_CASE("search") {
     SECTION("search_path") {
@@ -41,6 +77,85 @@ TEST_CASE("search") {
         }
     }
 
+    SECTION("bfs and dfs") {
+        using Graph = graph_directed<string, int, int>;
+
+        Graph g;
+        g("a", "b") = 1;
+        g("a", "c") = 2;
+        g("b", "d") = 3;
+        g("c", "d") = 4;
+        g("d", "a") = 5;
+        g["isolated"] = 0;
+
+        CHECK_THROWS_WITH(g.bfs(g.cend(), g.find("a")), "[graph.exception.invalid_argument] Start point equals to graph::cend() when calling 'abstract_first_search'.");
+        CHECK(g.bfs("a", "isolated").empty());
+        CHECK(g.dfs("a", "isolated").empty());
+        CHECK(g.bfs("a", "a").size() == 1);
+
+        //! BFS goes through the first discovered parent, DFS through the last pushed edge
+        Graph::search_path p{g.bfs("a", "d")};
+        CHECK(p.size() == 3);
+        CHECK(p.contain(g.find("b")));
+        CHECK(p.total_cost() == 4);
+        Graph::search_path q{g.dfs("a", "d")};
+        CHECK(q.size() == 3);
+        CHECK(q.contain(g.find("c")));
+        CHECK(q.total_cost() == 6);
+        CHECK(g.bfs("b", list<string>{"c", "a"}).size() == 3);
+
+        //! the dense indices of the erased nodes are reused
+        g.erase("b");
+        g.erase("isolated");
+        g("c", "e") = 6;
+        g("e", "f") = 7;
+        CHECK(g.bfs("a", "f").total_cost() == 2 + 6 + 7);
+        CHECK(g.dfs("f", "a").empty());
+        g.shrink_to_fit();
+        CHECK(g.dfs("a", "f").size() == 4);
+        CHECK(g.bfs("d", "f").total_cost() == 5 + 2 + 6 + 7);
+
+        Graph copy{g};
+        g.clear();
+        CHECK(copy.bfs("d", [](string k) {
+            return k == "e";
+        }).size() == 4);
+    }
+
+    SECTION("templated callables") {
+        using Graph = graph_directed<string, int, int>;
+
+        Graph g;
+        g("a", "b") = 1;
+        g("b", "c") = 1;
+        g("a", "c") = 5;
+
+        CHECK(g.bfs("a", move_only_goal("c")).size() == 2);
+        CHECK(g.dfs("a", move_only_goal("b")).size() == 2);
+        CHECK(g.ucs("a", move_only_goal("c")).total_cost() == 2);
+        CHECK(g.astar("a", move_only_goal("c"), zero_heuristic).total_cost() == 2);
+        CHECK(g.ucs("a", move_only_goal("d")).empty());
+
+        //! plain functions and function pointers are accepted as well
+        CHECK(g.astar("a", "c", &zero_heuristic).size() == 3);
+        CHECK(g.astar(g.find("a"), list<Graph::const_iterator>{g.find("c")}, zero_heuristic).total_cost() == 2);
+
+        //! the goal is tested once per expanded node
+        size_t calls{0};
+        CHECK(g.ucs(g.find("a"), [&calls](Graph::const_iterator it) {
+            ++calls;
+            return it->first == "c";
+        }).total_cost() == 2);
+        CHECK(calls == 3);
+
+        //! the std::function overloads stay available
+        function<bool(Graph::const_iterator)> is_goal = [&g](Graph::const_iterator it) {
+            return it == g.find("c");
+        };
+        CHECK(g.bfs(g.find("a"), is_goal).size() == 2);
+        CHECK(g.astar(g.find("a"), is_goal, function<int(Graph::const_iterator)>(zero_heuristic)).total_cost() == 2);
+    }
+
     SECTION("A*") {
         using Graph = graph_undirected<string, int, double>;
 
@@ -83,6 +198,51 @@ TEST_CASE("search") {
         CHECK_THROWS_WITH(g.astar("node 1", "node 4", heuristic), "[graph.exception.bad_graph.negative_edge] Edge with negative weight when calling 'astar'.");
     }
 
+    SECTION("ucs and A* on a grid") {
+        using Grid = graph_undirected<pair<int, int>, int, int>;
+
+        //! 30x30 grid where moving along y costs twice more than along x
+        Grid g;
+        for (int x{0}; x < 30; ++x) {
+            for (int y{0}; y < 30; ++y) {
+                if (x + 1 < 30) {
+                    g(make_pair(x, y), make_pair(x + 1, y)) = 1;
+                }
+                if (y + 1 < 30) {
+                    g(make_pair(x, y), make_pair(x, y + 1)) = 2;
+                }
+            }
+        }
+        const pair<int, int> origin{0, 0}, target{20, 25};
+
+        size_t evaluations{0};
+        function<int(Grid::const_iterator)> manhattan = [&](Grid::const_iterator it) {
+            ++evaluations;
+            return abs(it->first.first - target.first) + 2 * abs(it->first.second - target.second);
+        };
+
+        Grid::search_path p{g.astar(origin, target, manhattan)};
+        CHECK(p.total_cost() == 20 + 2 * 25);
+        CHECK(p.size() == 46);
+        //! the heuristic is evaluated at most once per node
+        CHECK(evaluations <= g.size());
+
+        Grid::search_path u{g.ucs(origin, target)};
+        CHECK(u.total_cost() == 70);
+        CHECK(u.size() == 46);
+        CHECK(g.ucs(origin, list<pair<int, int>>{make_pair(29, 29), make_pair(3, 1)}).total_cost() == 5);
+
+        Grid::shortest_paths expected{g.dijkstra(origin)};
+        for (Grid::const_iterator it{g.cbegin()}; it != g.cend(); it = next(it, 37)) {
+            CHECK(g.ucs(g.find(origin), it).total_cost() == expected.get_path(it).total_cost());
+        }
+
+        g.erase(make_pair(20, 24));
+        g.erase(make_pair(19, 25));
+        CHECK(g.astar(origin, target, manhattan).total_cost() == 72);
+        CHECK(g.ucs(origin, target).total_cost() == 72);
+    }
+
     SECTION("dijkstra") {
         using Graph = graph_undirected<string, int, double>;
 
@@ -112,11 +272,138 @@ TEST_CASE("search") {
         CHECK(p2.get_path("node 2").size() == 2);
         CHECK(p2.get_path("node 2").total_cost() == 12);
 
+        // dense result
+        CHECK(p2.size() == g.size());
+        CHECK(p2.cbegin()->first == g.cbegin());
+        CHECK(p2.get_distance("node 4") == 36);
+        CHECK(p2.get_distance("unreachable 2") == numeric_limits<double>::infinity());
+        CHECK(p2.get_distance("unknown") == numeric_limits<double>::infinity());
+        CHECK(p2.get_previous(g.find("node 4")) == g.find("node 2"));
+        CHECK(p2.get_previous(g.find("unreachable 1")) == g.cend());
+        CHECK(p2.get_path("unknown").empty());
+        CHECK(p2.get_path(g.cend()).empty());
+
+        // the dense indices of the erased nodes are left unused or reused
+        g.erase("node 3");
+        g("node 4", "node 5") = 1;
+        Graph::shortest_paths p3{g.dijkstra("node 1")};
+        CHECK(p3.size() == g.size());
+        CHECK(p3.get_path("node 5").total_cost() == 37);
+        CHECK(p3.get_path("node 5").size() == 4);
+
+        // nodes added after the search, possibly on the dense index of an erased node, are unreached
+        Graph::shortest_paths p4{g.dijkstra("node 1")};
+        for (int i{0}; i < 20; ++i) {
+            g("node 5", "n" + to_string(i)) = 1;
+        }
+        CHECK(p4.get_path("n19").empty());
+        CHECK(p4.get_distance("n0") == numeric_limits<double>::infinity());
+        CHECK(p4.get_previous(g.find("n0")) == g.cend());
+        CHECK(p4.get_distance("node 5") == 37);
+
+        g.erase("n19");
+        Graph::shortest_paths p5{g.dijkstra("node 1")};
+        g("node 4", "node 6") = 1;
+        CHECK(p5.get_path("node 6").empty());
+        CHECK(p5.get_distance("node 6") == numeric_limits<double>::infinity());
+        CHECK(p5.get_path("node 4").total_cost() == 36);
+
         // negative weight
         g("node 1", "new node") = -5;
         CHECK_THROWS_WITH(g.dijkstra("node 1"), "[graph.exception.bad_graph.negative_edge] Edge with negative weight when calling 'dijkstra'.");
     }
 
+    SECTION("dijkstra with integral costs") {
+        //! Same random graph with integral and floating costs: the radix heap and the indexed heap give the same distances
+        graph_directed<int, int, size_t> integral{random_graph<graph_directed<int, int, size_t>>(42, 300, 2000, [](int, int, unsigned r) {
+            return size_t(r % 1000);
+        })};
+        graph_directed<int, int, double> floating{random_graph<graph_directed<int, int, double>>(42, 300, 2000, [](int, int, unsigned r) {
+            return double(r % 1000);
+        })};
+
+        graph_directed<int, int, size_t>::shortest_paths p{integral.dijkstra(0)};
+        graph_directed<int, int, double>::shortest_paths q{floating.dijkstra(0)};
+        for (graph_directed<int, int, size_t>::const_iterator it{integral.cbegin()}; it != integral.cend(); ++it) {
+            if (q.get_distance(it->first) == numeric_limits<double>::infinity()) {
+                CHECK(p.get_distance(it) == numeric_limits<size_t>::max());
+            } else {
+                CHECK(double(p.get_distance(it)) == q.get_distance(it->first));
+                CHECK(p.get_path(it).total_cost() == p.get_distance(it));
+            }
+        }
+
+        CHECK(p.get_distance(299) < numeric_limits<size_t>::max());
+
+        //! early exit on the goal
+        CHECK(integral.dijkstra(0, 1).get_distance(1) == p.get_distance(1));
+
+        //! an edge of infinite cost leads nowhere: the sum must not wrap below the last popped distance
+        graph_directed<int, int, int> blocked;
+        blocked(0, 1) = 5;
+        blocked(1, 2) = numeric_limits<int>::max();
+        blocked(2, 3) = 1;
+        blocked(0, 3) = 100;
+        graph_directed<int, int, int>::shortest_paths b{blocked.dijkstra(0)};
+        CHECK(b.get_distance(3) == 100);
+        CHECK(b.get_distance(2) == numeric_limits<int>::max());
+
+        graph_directed<string, int, int> negative;
+        negative("a", "b") = 1;
+        negative("b", "c") = -1;
+        CHECK_THROWS_WITH(negative.dijkstra("a"), "[graph.exception.bad_graph.negative_edge] Edge with negative weight when calling 'dijkstra'.");
+    }
+
+    SECTION("delta-stepping") {
+        using Graph = graph_directed<int, int, double>;
+
+        Graph g{random_graph<Graph>(7, 5000, 30000, [](int, int, unsigned r) {
+            return double(r % 100) / 4;
+        })};
+        g[-1] = 0;
+
+        CHECK_THROWS_WITH(g.delta_stepping(g.cend(), 1.), "[graph.exception.invalid_argument] Start point equals to graph::cend() when calling 'delta_stepping'.");
+        CHECK_THROWS_WITH(g.delta_stepping(0, 0.), "[graph.exception.invalid_argument] Non-positive bucket width when calling 'delta_stepping'.");
+
+        //! same distances as Dijkstra's algorithm, whatever the bucket width and the number of threads
+        Graph::shortest_paths expected{g.dijkstra(0)};
+        CHECK(expected.get_distance(4999) < numeric_limits<double>::infinity());
+        for (double delta : {0.5, 5., 1000.}) {
+            for (size_t threads : {1, 4}) {
+                Graph::shortest_paths p{g.delta_stepping(0, delta, threads)};
+                CHECK(p.size() == expected.size());
+                for (Graph::const_iterator it{g.cbegin()}; it != g.cend(); ++it) {
+                    CHECK(p.get_distance(it) == expected.get_distance(it));
+                    CHECK(p.get_path(it).total_cost() == expected.get_path(it).total_cost());
+                }
+            }
+        }
+        CHECK(g.delta_stepping(0, 5.).get_path(-1).empty());
+
+        graph_undirected<string, int, int> small;
+        small("a", "b") = 4;
+        small("b", "c") = 1;
+        small("a", "c") = 7;
+        graph_undirected<string, int, int>::shortest_paths p{small.delta_stepping("a", 2, 2)};
+        CHECK(p.get_distance("c") == 5);
+        CHECK(p.get_previous(small.find("c")) == small.find("b"));
+
+        //! the distances may span many more buckets than there are nodes
+        graph_directed<int, int, size_t> far;
+        far(0, 1) = 1000000000;
+        far(1, 2) = 1;
+        CHECK(far.delta_stepping(0, 1).get_distance(2) == 1000000001);
+
+        //! an edge of infinite cost leads nowhere
+        far(1, 3) = numeric_limits<size_t>::max();
+        far(3, 2) = 0;
+        CHECK(far.delta_stepping(0, 1).get_distance(3) == numeric_limits<size_t>::max());
+        CHECK(far.delta_stepping(0, 1).get_distance(2) == 1000000001);
+
+        small("c", "d") = -1;
+        CHECK_THROWS_WITH(small.delta_stepping("a", 2), "[graph.exception.bad_graph.negative_edge] Edge with negative weight when calling 'delta_stepping'.");
+    }
+
     SECTION("Bellman-Ford") {
         using Graph = graph_directed<string, int, double>;
 
@@ -149,8 +436,146 @@ TEST_CASE("search") {
         CHECK(p.get_path("node 5").total_cost() == 7);
         CHECK(p.get_path("node 5").size() == 5);
 
+        CHECK(p.get_distance("unreachable") == numeric_limits<double>::infinity());
+        CHECK(p.get_previous(g.find("node 3")) == g.find("node 4"));
+
+        // parallel rounds
+        CHECK_THROWS_WITH(g.bellman_ford(g.cend(), 2), "[graph.exception.invalid_argument] Start point equals to graph::cend() when calling 'bellman_ford'.");
+        for (size_t threads : {1, 4}) {
+            Graph::shortest_paths q{g.bellman_ford("node 1", threads)};
+            for (Graph::const_iterator it{g.cbegin()}; it != g.cend(); ++it) {
+                CHECK(q.get_distance(it) == p.get_distance(it));
+                CHECK(q.get_path(it).size() == p.get_path(it).size());
+            }
+        }
+
+        // a negative-weight cycle that cannot be reached from the start
+        g("unreachable", "other") = -1;
+        g("other", "unreachable") = -1;
+        CHECK(g.bellman_ford("node 1").get_path("node 6").total_cost() == 9);
+        CHECK(g.bellman_ford("node 1", 2).get_path("node 6").total_cost() == 9);
+
         // negative-weight cycle
         g("node 5", "node 4") = -2;
         CHECK_THROWS_WITH(g.bellman_ford("node 1"), "[graph.exception.bad_graph.negative_weight_cycle] Negative-weight cycle when calling 'bellman_ford'.");
+        CHECK_THROWS_WITH(g.bellman_ford("node 1", 1), "[graph.exception.bad_graph.negative_weight_cycle] Negative-weight cycle when calling 'bellman_ford'.");
+        CHECK_THROWS_WITH(g.bellman_ford("node 1", 4), "[graph.exception.bad_graph.negative_weight_cycle] Negative-weight cycle when calling 'bellman_ford'.");
+
+        // negative edges without negative cycles: costs w(u, v) + h(u) - h(v) with w >= 0 shift every distance from 0 by h(0) - h(v)
+        graph_directed<int, int, int> positive{random_graph<graph_directed<int, int, int>>(3, 1000, 6000, [](int, int, unsigned r) {
+            return int(r % 50);
+        })};
+        graph_directed<int, int, int> shifted{random_graph<graph_directed<int, int, int>>(3, 1000, 6000, [](int from, int to, unsigned r) {
+            return int(r % 50) + from % 7 - to % 7;
+        })};
+        graph_directed<int, int, int>::shortest_paths expected{positive.dijkstra(0)};
+        graph_directed<int, int, int>::shortest_paths queued{shifted.bellman_ford(0)};
+        for (size_t threads : {1, 4}) {
+            graph_directed<int, int, int>::shortest_paths rounds{shifted.bellman_ford(0, threads)};
+            for (graph_directed<int, int, int>::const_iterator it{shifted.cbegin()}; it != shifted.cend(); ++it) {
+                const int key{it->first};
+                if (expected.get_distance(key) == numeric_limits<int>::max()) {
+                    CHECK(queued.get_distance(key) == numeric_limits<int>::max());
+                    CHECK(rounds.get_distance(key) == numeric_limits<int>::max());
+                } else {
+                    CHECK(queued.get_distance(key) == expected.get_distance(key) - key % 7);
+                    CHECK(rounds.get_distance(key) == expected.get_distance(key) - key % 7);
+                    CHECK(rounds.get_path(key).total_cost() == queued.get_distance(key));
+                }
+            }
+        }
+    }
+
+    SECTION("all-pairs shortest paths") {
+        using Graph = graph_directed<int, int, double>;
+
+        Graph g{random_graph<Graph>(11, 300, 3000, [](int from, int to, unsigned r) {
+            return double(r % 100) / 4 + from % 5 - to % 5;
+        })};
+        g[-1] = 0;
+
+        Graph::distance_matrix empty_matrix;
+        CHECK(empty_matrix.empty());
+        CHECK(Graph().all_pairs_shortest_paths(true).size() == 0);
+        CHECK(Graph().johnson(true).size() == 0);
+
+        //! same distances as Bellman-Ford from every node, on several blocks and threads
+        Graph::distance_matrix m{g.all_pairs_shortest_paths()};
+        CHECK(m.size() == g.size());
+        CHECK_FALSE(m.has_paths());
+        CHECK_THROWS_WITH(m.get_next(0, 1), "[graph.exception.invalid_argument] Paths not kept by all_pairs_shortest_paths when calling 'get_next'.");
+        CHECK(m.find(-1) == 0);
+        CHECK(m.find(300) == m.size());
+        CHECK(m.get_key(1) == 0);
+        CHECK(m.get_distance(0, m.size()) == numeric_limits<double>::infinity());
+
+        //! Johnson's algorithm gives the same distances, up to the rounding of the reweighted costs
+        Graph::distance_matrix johnson{g.johnson()};
+        CHECK_FALSE(johnson.has_paths());
+        CHECK(johnson.size() == m.size());
+
+        for (const Graph::distance_matrix &paths : {g.all_pairs_shortest_paths(true, 4), g.johnson(true, 1), g.johnson(true, 4)}) {
+            CHECK(paths.has_paths());
+            for (Graph::const_iterator from{g.cbegin()}; from != g.cend(); ++from) {
+                const size_t i{m.find(from->first)};
+                Graph::shortest_paths expected{g.bellman_ford(from)};
+                for (Graph::const_iterator to{g.cbegin()}; to != g.cend(); ++to) {
+                    const size_t j{m.find(to->first)};
+                    CHECK(m.get_distance(i, j) == Approx(expected.get_distance(to)));
+                    CHECK(johnson.get_distance(i, j) == Approx(m.get_distance(i, j)));
+                    CHECK(paths.get_distance(i, j) == Approx(m.get_distance(i, j)));
+
+                    //! the rebuilt path follows existing edges and has the same cost
+                    const vector<size_t> path{paths.get_path(i, j)};
+                    if (m.get_distance(i, j) == numeric_limits<double>::infinity()) {
+                        CHECK(path.empty());
+                        CHECK(paths.get_next(i, j) == paths.size());
+                    } else {
+                        REQUIRE(!path.empty());
+                        CHECK(path.front() == i);
+                        CHECK(path.back() == j);
+                        double cost{0};
+                        for (size_t p{1}; p < path.size(); ++p) {
+                            cost += g(paths.get_key(path[p - 1]), paths.get_key(path[p]));
+                        }
+                        CHECK(cost == Approx(m.get_distance(i, j)));
+                    }
+                }
+            }
+            CHECK(paths.get_path(1, 1) == vector<size_t>{1});
+        }
+
+        graph_unordered<string, int, int, UNDIRECTED> small;
+        small("a", "b") = 4;
+        small("b", "c") = 1;
+        small("a", "c") = 7;
+        small["d"] = 0;
+        graph_unordered<string, int, int, UNDIRECTED>::distance_matrix d{small.all_pairs_shortest_paths(true, 2)};
+        CHECK(d.get_distance(d.find("c"), d.find("a")) == 5);
+        CHECK(d.get_distance(d.find("a"), d.find("d")) == numeric_limits<int>::max());
+        CHECK(d.get_path(d.find("a"), d.find("c")).size() == 3);
+        CHECK(d.get_next(d.find("a"), d.find("c")) == d.find("b"));
+        graph_unordered<string, int, int, UNDIRECTED>::distance_matrix j{small.johnson(true, 2)};
+        CHECK(j.get_distance(j.find("c"), j.find("a")) == 5);
+        CHECK(j.get_distance(j.find("d"), j.find("b")) == numeric_limits<int>::max());
+        CHECK(j.get_path(j.find("a"), j.find("c")) == d.get_path(d.find("a"), d.find("c")));
+
+        //! an edge of infinite cost leads nowhere, even once reweighted by negative potentials
+        graph_directed<int, int, int> blocked;
+        blocked(0, 1) = 5;
+        blocked(1, 2) = numeric_limits<int>::max();
+        blocked(2, 3) = -1;
+        blocked(0, 3) = 100;
+        graph_directed<int, int, int>::distance_matrix b{blocked.johnson()};
+        CHECK(b.get_distance(b.find(0), b.find(3)) == 100);
+        CHECK(b.get_distance(b.find(0), b.find(2)) == numeric_limits<int>::max());
+        CHECK(b.get_distance(b.find(2), b.find(3)) == -1);
+
+        //! negative-weight cycle
+        g(5, 6) = -100;
+        g(6, 5) = -100;
+        CHECK_THROWS_WITH(g.all_pairs_shortest_paths(), "[graph.exception.bad_graph.negative_weight_cycle] Negative-weight cycle when calling 'all_pairs_shortest_paths'.");
+        CHECK_THROWS_WITH(g.all_pairs_shortest_paths(true, 4), "[graph.exception.bad_graph.negative_weight_cycle] Negative-weight cycle when calling 'all_pairs_shortest_paths'.");
+        CHECK_THROWS_WITH(g.johnson(), "[graph.exception.bad_graph.negative_weight_cycle] Negative-weight cycle when calling 'johnson'.");
     }
 }